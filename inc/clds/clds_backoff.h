@@ -0,0 +1,46 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_BACKOFF_H
+#define CLDS_BACKOFF_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#include "windows.h"
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// what a thread does when it has to retry a CAS or wait for another thread
+#define CLDS_BACKOFF_POLICY_VALUES \
+    CLDS_BACKOFF_POLICY_NONE, \
+    CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD, \
+    CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT
+
+MU_DEFINE_ENUM(CLDS_BACKOFF_POLICY, CLDS_BACKOFF_POLICY_VALUES);
+
+// backoff state for one operation, it lives on the stack of the thread performing the operation
+typedef struct CLDS_BACKOFF_TAG
+{
+    CLDS_BACKOFF_POLICY policy;
+    uint32_t attempt_count;
+} CLDS_BACKOFF;
+
+#define CLDS_BACKOFF_INITIALIZER(policy) { (policy), 0 }
+
+MOCKABLE_FUNCTION(, void, clds_backoff_retry, CLDS_BACKOFF*, backoff);
+MOCKABLE_FUNCTION(, void, clds_backoff_wait_while_equal, CLDS_BACKOFF*, backoff, volatile LONG*, address, LONG, value);
+MOCKABLE_FUNCTION(, void, clds_backoff_wake_all, volatile LONG*, address);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLDS_BACKOFF_H */
@@ -0,0 +1,114 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_FLAT_HASH_TABLE_H
+#define CLDS_FLAT_HASH_TABLE_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#endif
+
+#include "windows.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+#include "clds_backoff.h"
+#include "clds_hazard_pointers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct CLDS_FLAT_HASH_TABLE_ITEM_TAG;
+
+typedef struct CLDS_FLAT_HASH_TABLE_TAG* CLDS_FLAT_HASH_TABLE_HANDLE;
+typedef uint64_t(*FLAT_HASH_TABLE_COMPUTE_HASH_FUNC)(void* key);
+typedef int(*FLAT_HASH_TABLE_KEY_COMPARE_FUNC)(void* key_1, void* key_2);
+typedef void(*FLAT_HASH_TABLE_ITEM_CLEANUP_CB)(void* context, struct CLDS_FLAT_HASH_TABLE_ITEM_TAG* item);
+typedef void(*FLAT_HASH_TABLE_SKIPPED_SEQ_NO_CB)(void* context, int64_t skipped_sequence_no);
+
+// this is the structure needed for one flat hash table item
+// it contains information like ref count, the key and its hash, etc.
+typedef struct CLDS_FLAT_HASH_TABLE_ITEM_TAG
+{
+    // these are internal variables used by the flat hash table
+    volatile LONG ref_count;
+    FLAT_HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback;
+    void* item_cleanup_callback_context;
+    // set when the item is put in the table
+    void* key;
+    uint64_t hash;
+} CLDS_FLAT_HASH_TABLE_ITEM;
+
+// these are macros that help declaring a type that can be stored in the flat hash table
+#define DECLARE_FLAT_HASH_TABLE_NODE_TYPE(record_type) \
+typedef struct MU_C3(FLAT_HASH_TABLE_NODE_,record_type,_TAG) \
+{ \
+    CLDS_FLAT_HASH_TABLE_ITEM item; \
+    record_type record; \
+} MU_C2(FLAT_HASH_TABLE_NODE_,record_type); \
+
+#define CLDS_FLAT_HASH_TABLE_NODE_CREATE(record_type, item_cleanup_callback, item_cleanup_callback_context) \
+clds_flat_hash_table_node_create(sizeof(MU_C2(FLAT_HASH_TABLE_NODE_,record_type)), item_cleanup_callback, item_cleanup_callback_context)
+
+#define CLDS_FLAT_HASH_TABLE_NODE_INC_REF(record_type, ptr) \
+clds_flat_hash_table_node_inc_ref(ptr)
+
+#define CLDS_FLAT_HASH_TABLE_NODE_RELEASE(record_type, ptr) \
+clds_flat_hash_table_node_release(ptr)
+
+#define CLDS_FLAT_HASH_TABLE_GET_VALUE(record_type, ptr) \
+((record_type*)((unsigned char*)ptr + offsetof(MU_C2(FLAT_HASH_TABLE_NODE_,record_type), record)))
+
+#define CLDS_FLAT_HASH_TABLE_INSERT_RESULT_VALUES \
+    CLDS_FLAT_HASH_TABLE_INSERT_OK, \
+    CLDS_FLAT_HASH_TABLE_INSERT_ERROR, \
+    CLDS_FLAT_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS
+
+MU_DEFINE_ENUM(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_RESULT_VALUES);
+
+#define CLDS_FLAT_HASH_TABLE_DELETE_RESULT_VALUES \
+    CLDS_FLAT_HASH_TABLE_DELETE_OK, \
+    CLDS_FLAT_HASH_TABLE_DELETE_ERROR, \
+    CLDS_FLAT_HASH_TABLE_DELETE_NOT_FOUND
+
+MU_DEFINE_ENUM(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_RESULT_VALUES);
+
+#define CLDS_FLAT_HASH_TABLE_REMOVE_RESULT_VALUES \
+    CLDS_FLAT_HASH_TABLE_REMOVE_OK, \
+    CLDS_FLAT_HASH_TABLE_REMOVE_ERROR, \
+    CLDS_FLAT_HASH_TABLE_REMOVE_NOT_FOUND
+
+MU_DEFINE_ENUM(CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, CLDS_FLAT_HASH_TABLE_REMOVE_RESULT_VALUES);
+
+#define CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT_VALUES \
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_OK, \
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR
+
+MU_DEFINE_ENUM(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT_VALUES);
+
+// only the insert/delete/remove/set_value/find part of the clds_hash_table API is available,
+// there are no snapshots, no change log, no sequence number blocks and no other setters than the backoff policy
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_TABLE_HANDLE, clds_flat_hash_table_create, FLAT_HASH_TABLE_COMPUTE_HASH_FUNC, compute_hash, FLAT_HASH_TABLE_KEY_COMPARE_FUNC, key_compare_func, size_t, initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, volatile int64_t*, start_sequence_number, FLAT_HASH_TABLE_SKIPPED_SEQ_NO_CB, skipped_seq_no_cb, void*, skipped_seq_no_cb_context);
+MOCKABLE_FUNCTION(, void, clds_flat_hash_table_destroy, CLDS_FLAT_HASH_TABLE_HANDLE, clds_flat_hash_table);
+MOCKABLE_FUNCTION(, int, clds_flat_hash_table_set_backoff_policy, CLDS_FLAT_HASH_TABLE_HANDLE, clds_flat_hash_table, CLDS_BACKOFF_POLICY, backoff_policy);
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_TABLE_INSERT_RESULT, clds_flat_hash_table_insert, CLDS_FLAT_HASH_TABLE_HANDLE, clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_FLAT_HASH_TABLE_ITEM*, value, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_TABLE_DELETE_RESULT, clds_flat_hash_table_delete, CLDS_FLAT_HASH_TABLE_HANDLE, clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_TABLE_DELETE_RESULT, clds_flat_hash_table_delete_key_value, CLDS_FLAT_HASH_TABLE_HANDLE, clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_FLAT_HASH_TABLE_ITEM*, value, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, clds_flat_hash_table_remove, CLDS_FLAT_HASH_TABLE_HANDLE, clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_FLAT_HASH_TABLE_ITEM**, item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, clds_flat_hash_table_set_value, CLDS_FLAT_HASH_TABLE_HANDLE, clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, const void*, key, CLDS_FLAT_HASH_TABLE_ITEM*, new_item, CLDS_FLAT_HASH_TABLE_ITEM**, old_item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_TABLE_ITEM*, clds_flat_hash_table_find, CLDS_FLAT_HASH_TABLE_HANDLE, clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key);
+
+// helper APIs for creating/destroying a flat hash table node
+MOCKABLE_FUNCTION(, CLDS_FLAT_HASH_TABLE_ITEM*, clds_flat_hash_table_node_create, size_t, node_size, FLAT_HASH_TABLE_ITEM_CLEANUP_CB, item_cleanup_callback, void*, item_cleanup_callback_context);
+MOCKABLE_FUNCTION(, int, clds_flat_hash_table_node_inc_ref, CLDS_FLAT_HASH_TABLE_ITEM*, item);
+MOCKABLE_FUNCTION(, void, clds_flat_hash_table_node_release, CLDS_FLAT_HASH_TABLE_ITEM*, item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLDS_FLAT_HASH_TABLE_H */
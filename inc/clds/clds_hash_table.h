@@ -7,10 +7,12 @@
 #include <cstdint>
 #else
 #include <stdint.h>
+#include <stdbool.h>
 #endif
 
 #include "windows.h"
 #include "umock_c/umock_c_prod.h"
+#include "clds_backoff.h"
 #include "clds_hazard_pointers.h"
 #include "clds_sorted_list.h"
 
@@ -26,18 +28,25 @@ typedef int (*KEY_COMPARE_FUNC)(void* key_1, void* key_2);
 typedef void(*HASH_TABLE_ITEM_CLEANUP_CB)(void* context, struct CLDS_HASH_TABLE_ITEM_TAG* item);
 typedef void(*HASH_TABLE_SKIPPED_SEQ_NO_CB)(void* context, int64_t skipped_sequence_no);
 
+struct HASH_TABLE_ITEM_SNAPSHOT_STATE_TAG;
+
 typedef struct HASH_TABLE_ITEM_TAG
 {
     // these are internal variables used by the hash table
     HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback;
     void* item_cleanup_callback_context;
     void* key;
+    // allocated when a running snapshot first has to keep track of the item
+    struct HASH_TABLE_ITEM_SNAPSHOT_STATE_TAG* volatile snapshot_state;
 } HASH_TABLE_ITEM;
 
 DECLARE_SORTED_LIST_NODE_TYPE(HASH_TABLE_ITEM)
 
 typedef struct SORTED_LIST_NODE_HASH_TABLE_ITEM_TAG CLDS_HASH_TABLE_ITEM;
 
+// return false to stop the visit
+typedef bool(*HASH_TABLE_SNAPSHOT_VISIT_CB)(void* context, CLDS_HASH_TABLE_ITEM* item);
+
 // these are macros that help declaring a type that can be stored in the hash table
 #define DECLARE_HASH_TABLE_NODE_TYPE(record_type) \
 typedef struct MU_C3(HASH_TABLE_NODE_,record_type,_TAG) \
@@ -87,12 +96,38 @@ MU_DEFINE_ENUM(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESUL
 
 #define CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES \
     CLDS_HASH_TABLE_SNAPSHOT_OK, \
-    CLDS_HASH_TABLE_SNAPSHOT_ERROR
+    CLDS_HASH_TABLE_SNAPSHOT_ERROR, \
+    CLDS_HASH_TABLE_SNAPSHOT_ABORTED, \
+    CLDS_HASH_TABLE_SNAPSHOT_SEQ_NO_TOO_OLD
 
 MU_DEFINE_ENUM(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
 
+#define CLDS_HASH_TABLE_CHANGE_TYPE_VALUES \
+    CLDS_HASH_TABLE_CHANGE_INSERT, \
+    CLDS_HASH_TABLE_CHANGE_REPLACE, \
+    CLDS_HASH_TABLE_CHANGE_DELETE
+
+MU_DEFINE_ENUM(CLDS_HASH_TABLE_CHANGE_TYPE, CLDS_HASH_TABLE_CHANGE_TYPE_VALUES);
+
+// a change returned by clds_hash_table_snapshot_since, holding a reference on item
+typedef struct CLDS_HASH_TABLE_CHANGE_TAG
+{
+    CLDS_HASH_TABLE_CHANGE_TYPE change_type;
+    int64_t sequence_number;
+    void* key;
+    // the item put in the table, or the item taken out of the table for CLDS_HASH_TABLE_CHANGE_DELETE
+    CLDS_HASH_TABLE_ITEM* item;
+} CLDS_HASH_TABLE_CHANGE;
+
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_HANDLE, clds_hash_table_create, COMPUTE_HASH_FUNC, compute_hash, KEY_COMPARE_FUNC, key_compare_func, size_t, initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, volatile int64_t*, start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB, skipped_seq_no_cb, void*, skipped_seq_no_cb_context);
 MOCKABLE_FUNCTION(, void, clds_hash_table_destroy, CLDS_HASH_TABLE_HANDLE, clds_hash_table);
+MOCKABLE_FUNCTION(, int, clds_hash_table_set_sequence_number_block_size, CLDS_HASH_TABLE_HANDLE, clds_hash_table, uint32_t, block_size);
+MOCKABLE_FUNCTION(, int, clds_hash_table_set_backoff_policy, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_BACKOFF_POLICY, backoff_policy);
+MOCKABLE_FUNCTION(, int, clds_hash_table_set_migration_batch_size, CLDS_HASH_TABLE_HANDLE, clds_hash_table, uint32_t, batch_size);
+MOCKABLE_FUNCTION(, int, clds_hash_table_set_shrink_load_factor, CLDS_HASH_TABLE_HANDLE, clds_hash_table, uint32_t, load_factor_percent);
+MOCKABLE_FUNCTION(, int, clds_hash_table_set_bloom_filter_bits_per_bucket, CLDS_HASH_TABLE_HANDLE, clds_hash_table, uint32_t, bits_per_bucket);
+MOCKABLE_FUNCTION(, int, clds_hash_table_set_change_log_enabled, CLDS_HASH_TABLE_HANDLE, clds_hash_table, bool, enabled);
+MOCKABLE_FUNCTION(, int, clds_hash_table_trim_change_log, CLDS_HASH_TABLE_HANDLE, clds_hash_table, int64_t, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_INSERT_RESULT, clds_hash_table_insert, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_HASH_TABLE_ITEM*, value, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_DELETE_RESULT, clds_hash_table_delete, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_DELETE_RESULT, clds_hash_table_delete_key_value, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_HASH_TABLE_ITEM*, value, int64_t*, sequence_number);
@@ -101,6 +136,11 @@ MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SET_VALUE_RESULT, clds_hash_table_set_value,
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_ITEM*, clds_hash_table_find, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key);
 
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_hash_table_snapshot, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM***, items, uint64_t*, item_count);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_hash_table_snapshot_parallel, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE*, clds_hazard_pointers_threads, uint32_t, thread_count, CLDS_HASH_TABLE_ITEM***, items, uint64_t*, item_count);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_hash_table_snapshot_concurrent, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM***, items, uint64_t*, item_count);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_hash_table_snapshot_at_current_sequence_number, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM***, items, uint64_t*, item_count, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_hash_table_snapshot_since, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, int64_t, since_sequence_number, CLDS_HASH_TABLE_CHANGE**, changes, uint64_t*, change_count, int64_t*, last_sequence_number);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_hash_table_snapshot_visit, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, HASH_TABLE_SNAPSHOT_VISIT_CB, visit_cb, void*, visit_cb_context);
 
 // helper APIs for creating/destroying a hash table node
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_ITEM*, clds_hash_table_node_create, size_t, node_size, HASH_TABLE_ITEM_CLEANUP_CB, item_cleanup_callback, void*, item_cleanup_callback_context);
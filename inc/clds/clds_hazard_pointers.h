@@ -19,8 +19,10 @@ extern "C" {
 typedef struct CLDS_HAZARD_POINTERS_TAG* CLDS_HAZARD_POINTERS_HANDLE;
 typedef struct CLDS_HAZARD_POINTERS_THREAD_TAG* CLDS_HAZARD_POINTERS_THREAD_HANDLE;
 typedef struct CLDS_HAZARD_POINTER_RECORD_TAG* CLDS_HAZARD_POINTER_RECORD_HANDLE;
+typedef struct CLDS_SEQUENCE_NUMBER_BLOCKS_TAG* CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE;
 
 typedef void(*RECLAIM_FUNC)(void* node);
+typedef void(*CLDS_HAZARD_POINTERS_SKIPPED_SEQ_NO_CB)(void* context, int64_t skipped_sequence_no);
 
 MOCKABLE_FUNCTION(, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers_create);
 MOCKABLE_FUNCTION(, void, clds_hazard_pointers_destroy, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers);
@@ -30,6 +32,11 @@ MOCKABLE_FUNCTION(, CLDS_HAZARD_POINTER_RECORD_HANDLE, clds_hazard_pointers_acqu
 MOCKABLE_FUNCTION(, void, clds_hazard_pointers_release, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE, clds_hazard_pointer_record);
 MOCKABLE_FUNCTION(, void, clds_hazard_pointers_reclaim, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, node, RECLAIM_FUNC, reclaim_func);
 MOCKABLE_FUNCTION(, int, clds_hazard_pointers_set_reclaim_threshold, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, size_t, reclaim_threshold);
+MOCKABLE_FUNCTION(, CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE, clds_hazard_pointers_sequence_number_blocks_create, volatile int64_t*, sequence_number, CLDS_HAZARD_POINTERS_SKIPPED_SEQ_NO_CB, skipped_seq_no_cb, void*, skipped_seq_no_cb_context);
+MOCKABLE_FUNCTION(, void, clds_hazard_pointers_sequence_number_blocks_destroy, CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE, sequence_number_blocks);
+MOCKABLE_FUNCTION(, int64_t, clds_hazard_pointers_thread_get_sequence_number, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE, sequence_number_blocks, uint32_t, block_size);
+MOCKABLE_FUNCTION(, void*, clds_hazard_pointers_thread_get_finger, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t, owner_id);
+MOCKABLE_FUNCTION(, void, clds_hazard_pointers_thread_set_finger, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t, owner_id, void*, node, CLDS_HAZARD_POINTER_RECORD_HANDLE, clds_hazard_pointer_record);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,86 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_QUEUE_H
+#define CLDS_QUEUE_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#include <stdbool.h>
+#endif
+
+#include "windows.h"
+
+#include "azure_macro_utils/macro_utils.h"
+#include "clds_backoff.h"
+#include "clds_hazard_pointers.h"
+
+#include "umock_c/umock_c_prod.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// handle to the queue
+typedef struct CLDS_QUEUE_TAG* CLDS_QUEUE_HANDLE;
+
+struct CLDS_QUEUE_ITEM_TAG;
+
+typedef void(*QUEUE_ITEM_CLEANUP_CB)(void* context, struct CLDS_QUEUE_ITEM_TAG* item);
+
+// this is the structure needed for one queue item
+// it contains information like ref count, next pointer, etc.
+typedef struct CLDS_QUEUE_ITEM_TAG
+{
+    // these are internal variables used by the queue
+    volatile LONG ref_count;
+    QUEUE_ITEM_CLEANUP_CB item_cleanup_callback;
+    void* item_cleanup_callback_context;
+    volatile struct CLDS_QUEUE_ITEM_TAG* next;
+} CLDS_QUEUE_ITEM;
+
+// these are macros that help declaring a type that can be stored in the queue
+#define DECLARE_QUEUE_NODE_TYPE(record_type) \
+typedef struct MU_C3(QUEUE_NODE_,record_type,_TAG) \
+{ \
+    CLDS_QUEUE_ITEM item; \
+    record_type record; \
+} MU_C2(QUEUE_NODE_,record_type); \
+
+#define CLDS_QUEUE_NODE_CREATE(record_type, item_cleanup_callback, item_cleanup_callback_context) \
+clds_queue_node_create(sizeof(MU_C2(QUEUE_NODE_,record_type)), item_cleanup_callback, item_cleanup_callback_context)
+
+#define CLDS_QUEUE_NODE_INC_REF(record_type, ptr) \
+clds_queue_node_inc_ref(ptr)
+
+#define CLDS_QUEUE_NODE_RELEASE(record_type, ptr) \
+clds_queue_node_release(ptr)
+
+#define CLDS_QUEUE_GET_VALUE(record_type, ptr) \
+((record_type*)((unsigned char*)ptr + offsetof(MU_C2(QUEUE_NODE_,record_type), record)))
+
+#define CLDS_QUEUE_DEQUEUE_RESULT_VALUES \
+    CLDS_QUEUE_DEQUEUE_OK, \
+    CLDS_QUEUE_DEQUEUE_ERROR, \
+    CLDS_QUEUE_DEQUEUE_EMPTY
+
+MU_DEFINE_ENUM(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_RESULT_VALUES);
+
+// queue API
+MOCKABLE_FUNCTION(, CLDS_QUEUE_HANDLE, clds_queue_create, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers);
+MOCKABLE_FUNCTION(, void, clds_queue_destroy, CLDS_QUEUE_HANDLE, clds_queue);
+MOCKABLE_FUNCTION(, int, clds_queue_set_backoff_policy, CLDS_QUEUE_HANDLE, clds_queue, CLDS_BACKOFF_POLICY, backoff_policy);
+
+MOCKABLE_FUNCTION(, int, clds_queue_enqueue, CLDS_QUEUE_HANDLE, clds_queue, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_QUEUE_ITEM*, item);
+MOCKABLE_FUNCTION(, CLDS_QUEUE_DEQUEUE_RESULT, clds_queue_dequeue, CLDS_QUEUE_HANDLE, clds_queue, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_QUEUE_ITEM**, item);
+
+// helper APIs for creating/destroying a queue node
+MOCKABLE_FUNCTION(, CLDS_QUEUE_ITEM*, clds_queue_node_create, size_t, node_size, QUEUE_ITEM_CLEANUP_CB, item_cleanup_callback, void*, item_cleanup_callback_context);
+MOCKABLE_FUNCTION(, int, clds_queue_node_inc_ref, CLDS_QUEUE_ITEM*, item);
+MOCKABLE_FUNCTION(, void, clds_queue_node_release, CLDS_QUEUE_ITEM*, item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLDS_QUEUE_H */
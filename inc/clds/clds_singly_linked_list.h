@@ -13,6 +13,7 @@
 #include "windows.h"
 
 #include "azure_macro_utils/macro_utils.h"
+#include "clds_backoff.h"
 #include "clds_hazard_pointers.h"
 
 #include "umock_c/umock_c_prod.h"
@@ -27,6 +28,8 @@ struct CLDS_SINGLY_LINKED_LIST_ITEM_TAG;
 
 typedef bool(*SINGLY_LINKED_LIST_ITEM_COMPARE_CB)(void* item_compare_context, struct CLDS_SINGLY_LINKED_LIST_ITEM_TAG* item);
 typedef void(*SINGLY_LINKED_LIST_ITEM_CLEANUP_CB)(void* context, struct CLDS_SINGLY_LINKED_LIST_ITEM_TAG* item);
+typedef void(*SINGLY_LINKED_LIST_ITEM_POPPED_CB)(void* context, struct CLDS_SINGLY_LINKED_LIST_ITEM_TAG* item);
+typedef bool(*SINGLY_LINKED_LIST_ITEM_VISIT_CB)(void* context, struct CLDS_SINGLY_LINKED_LIST_ITEM_TAG* item);
 
 // this is the structure needed for one singly linked list item
 // it contains information like ref count, next pointer, etc.
@@ -66,13 +69,33 @@ clds_singly_linked_list_node_release(ptr)
 
 MU_DEFINE_ENUM(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_RESULT_VALUES);
 
+#define CLDS_SINGLY_LINKED_LIST_POP_RESULT_VALUES \
+    CLDS_SINGLY_LINKED_LIST_POP_OK, \
+    CLDS_SINGLY_LINKED_LIST_POP_ERROR, \
+    CLDS_SINGLY_LINKED_LIST_POP_EMPTY
+
+MU_DEFINE_ENUM(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_RESULT_VALUES);
+
+#define CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT_VALUES \
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK, \
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR, \
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_INTERRUPTED
+
+MU_DEFINE_ENUM(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT_VALUES);
+
 // singly linked list API
 MOCKABLE_FUNCTION(, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list_create, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers);
 MOCKABLE_FUNCTION(, void, clds_singly_linked_list_destroy, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list);
+MOCKABLE_FUNCTION(, int, clds_singly_linked_list_set_backoff_policy, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list, CLDS_BACKOFF_POLICY, backoff_policy);
+MOCKABLE_FUNCTION(, int, clds_singly_linked_list_enable_elimination, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list, uint32_t, slot_count);
 
 MOCKABLE_FUNCTION(, int, clds_singly_linked_list_insert, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SINGLY_LINKED_LIST_ITEM*, item);
 MOCKABLE_FUNCTION(, CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, clds_singly_linked_list_delete, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SINGLY_LINKED_LIST_ITEM*, item);
 MOCKABLE_FUNCTION(, CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, clds_singly_linked_list_delete_if, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_COMPARE_CB, item_compare_callback, void*, item_compare_callback_context);
+MOCKABLE_FUNCTION(, CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, clds_singly_linked_list_delete_all_if, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_COMPARE_CB, item_compare_callback, void*, item_compare_callback_context, size_t*, deleted_item_count);
+MOCKABLE_FUNCTION(, CLDS_SINGLY_LINKED_LIST_POP_RESULT, clds_singly_linked_list_pop_head, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SINGLY_LINKED_LIST_ITEM**, item);
+MOCKABLE_FUNCTION(, CLDS_SINGLY_LINKED_LIST_POP_RESULT, clds_singly_linked_list_pop_all, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_POPPED_CB, item_popped_cb, void*, item_popped_cb_context);
+MOCKABLE_FUNCTION(, CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, clds_singly_linked_list_for_each, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_VISIT_CB, item_visit_callback, void*, item_visit_callback_context);
 MOCKABLE_FUNCTION(, CLDS_SINGLY_LINKED_LIST_ITEM*, clds_singly_linked_list_find, CLDS_SINGLY_LINKED_LIST_HANDLE, clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_COMPARE_CB, item_compare_callback, void*, item_compare_callback_context);
 
 // helper APIs for creating/destroying a singly linked list node
@@ -13,6 +13,7 @@
 #include "windows.h"
 
 #include "azure_macro_utils/macro_utils.h"
+#include "clds_backoff.h"
 #include "clds_hazard_pointers.h"
 
 #include "umock_c/umock_c_prod.h"
@@ -29,6 +30,9 @@ typedef void*(*SORTED_LIST_GET_ITEM_KEY_CB)(void* context, struct CLDS_SORTED_LI
 typedef int(*SORTED_LIST_KEY_COMPARE_CB)(void* context, void* key1, void* key2);
 typedef void(*SORTED_LIST_ITEM_CLEANUP_CB)(void* context, struct CLDS_SORTED_LIST_ITEM_TAG* item);
 typedef void(*SORTED_LIST_SKIPPED_SEQ_NO_CB)(void* context, int64_t skipped_sequence_no);
+typedef uint64_t(*SORTED_LIST_GET_KEY_FINGERPRINT_CB)(void* context, void* key);
+typedef void(*SORTED_LIST_ITEM_DELETED_CB)(void* context, struct CLDS_SORTED_LIST_ITEM_TAG* item, int64_t sequence_number);
+typedef bool(*SORTED_LIST_VISIT_CB)(void* context, struct CLDS_SORTED_LIST_ITEM_TAG* item);
 
 // this is the structure needed for one sorted list item
 // it contains information like ref count, next pointer, etc.
@@ -40,6 +44,10 @@ typedef struct CLDS_SORTED_LIST_ITEM_TAG
     void* item_cleanup_callback_context;
     volatile struct CLDS_SORTED_LIST_ITEM_TAG* next;
     int64_t seq_no;
+    // cached fingerprint of the item key, only valid when a fingerprint callback is set on the list
+    uint64_t key_fingerprint;
+    // finger owner id of the list the item was inserted in, 0 while the item is being linked or if the list does not use finger search
+    volatile LONG64 finger_owner_id;
 } CLDS_SORTED_LIST_ITEM;
 
 // these are macros that help declaring a type that can be stored in the sorted list
@@ -62,6 +70,80 @@ clds_sorted_list_node_release(ptr)
 #define CLDS_SORTED_LIST_GET_VALUE(record_type, ptr) \
 ((record_type*)((unsigned char*)ptr + offsetof(MU_C2(SORTED_LIST_NODE_,record_type), record)))
 
+// these macros declare type safe wrappers over a sorted list of one record type, whose key is the field key_field of type key_type
+// the generated functions are prefixed with name and take keys as const key_type*
+// compare_expr is an int expression comparing the keys pointed to by key1 and key2 (both const key_type*)
+// the list code is not specialized: compare_expr is wrapped in a key compare callback that the list still calls through a function pointer
+#define DECLARE_CLDS_TYPED_SORTED_LIST(name, record_type, key_type, key_field, compare_expr) \
+    CLDS_TYPED_SORTED_LIST_FUNCTIONS(name, record_type, key_type, key_field, compare_expr, NULL)
+
+// integer keys are compared in the list nodes through an order preserving fingerprint of the key cached in each item,
+// so traversals only call the key callbacks for the items that have the same key as the one looked up
+#define DECLARE_CLDS_INTEGER_KEY_SORTED_LIST(name, record_type, key_type, key_field) \
+static inline uint64_t MU_C2(name,_get_key_fingerprint)(void* context, void* key) \
+{ \
+    key_type key_value = *(const key_type*)key; \
+    (void)context; \
+    /* flip the sign bit for signed keys so that negative keys sort first */ \
+    return (((key_type)-1) < ((key_type)0)) ? ((uint64_t)(int64_t)key_value ^ ((uint64_t)1 << 63)) : (uint64_t)key_value; \
+} \
+CLDS_TYPED_SORTED_LIST_FUNCTIONS(name, record_type, key_type, key_field, ((*key1 < *key2) ? -1 : ((*key1 > *key2) ? 1 : 0)), MU_C2(name,_get_key_fingerprint))
+
+#define CLDS_TYPED_SORTED_LIST_FUNCTIONS(name, record_type, key_type, key_field, compare_expr, get_key_fingerprint_cb) \
+static inline void* MU_C2(name,_get_item_key)(void* context, struct CLDS_SORTED_LIST_ITEM_TAG* item) \
+{ \
+    (void)context; \
+    return (void*)&(CLDS_SORTED_LIST_GET_VALUE(record_type, item)->key_field); \
+} \
+static inline int MU_C2(name,_key_compare)(void* context, void* key1_arg, void* key2_arg) \
+{ \
+    const key_type* key1 = (const key_type*)key1_arg; \
+    const key_type* key2 = (const key_type*)key2_arg; \
+    (void)context; \
+    return (compare_expr); \
+} \
+static inline CLDS_SORTED_LIST_HANDLE MU_C2(name,_create)(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile int64_t* start_sequence_number, SORTED_LIST_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context) \
+{ \
+    SORTED_LIST_GET_KEY_FINGERPRINT_CB key_fingerprint_cb = get_key_fingerprint_cb; \
+    CLDS_SORTED_LIST_HANDLE result = clds_sorted_list_create(clds_hazard_pointers, MU_C2(name,_get_item_key), NULL, MU_C2(name,_key_compare), NULL, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context); \
+    if ((result != NULL) && \
+        (key_fingerprint_cb != NULL) && \
+        (clds_sorted_list_set_key_fingerprint_cb(result, key_fingerprint_cb, NULL, SORTED_LIST_KEY_FINGERPRINT_ORDER_PRESERVING) != 0)) \
+    { \
+        clds_sorted_list_destroy(result); \
+        result = NULL; \
+    } \
+    return result; \
+} \
+static inline CLDS_SORTED_LIST_ITEM* MU_C2(name,_node_create)(SORTED_LIST_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context) \
+{ \
+    return CLDS_SORTED_LIST_NODE_CREATE(record_type, item_cleanup_callback, item_cleanup_callback_context); \
+} \
+static inline record_type* MU_C2(name,_get_value)(CLDS_SORTED_LIST_ITEM* item) \
+{ \
+    return CLDS_SORTED_LIST_GET_VALUE(record_type, item); \
+} \
+static inline CLDS_SORTED_LIST_INSERT_RESULT MU_C2(name,_insert)(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number) \
+{ \
+    return clds_sorted_list_insert(clds_sorted_list, clds_hazard_pointers_thread, item, sequence_number); \
+} \
+static inline CLDS_SORTED_LIST_DELETE_RESULT MU_C2(name,_delete_key)(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key, int64_t* sequence_number) \
+{ \
+    return clds_sorted_list_delete_key(clds_sorted_list, clds_hazard_pointers_thread, (void*)key, sequence_number); \
+} \
+static inline CLDS_SORTED_LIST_REMOVE_RESULT MU_C2(name,_remove_key)(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_number) \
+{ \
+    return clds_sorted_list_remove_key(clds_sorted_list, clds_hazard_pointers_thread, (void*)key, item, sequence_number); \
+} \
+static inline CLDS_SORTED_LIST_ITEM* MU_C2(name,_find_key)(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key) \
+{ \
+    return clds_sorted_list_find_key(clds_sorted_list, clds_hazard_pointers_thread, (void*)key); \
+} \
+static inline CLDS_SORTED_LIST_SET_VALUE_RESULT MU_C2(name,_set_value)(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key, CLDS_SORTED_LIST_ITEM* new_item, CLDS_SORTED_LIST_ITEM** old_item, int64_t* sequence_number, bool only_if_exists) \
+{ \
+    return clds_sorted_list_set_value(clds_sorted_list, clds_hazard_pointers_thread, (const void*)key, new_item, old_item, sequence_number, only_if_exists); \
+} \
+
 #define CLDS_SORTED_LIST_INSERT_RESULT_VALUES \
     CLDS_SORTED_LIST_INSERT_OK, \
     CLDS_SORTED_LIST_INSERT_ERROR, \
@@ -90,6 +172,17 @@ MU_DEFINE_ENUM(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_RESULT_VA
 
 MU_DEFINE_ENUM(CLDS_SORTED_LIST_SET_VALUE_RESULT, CLDS_SORTED_LIST_SET_VALUE_RESULT_VALUES);
 
+// how the order of the key fingerprints relates to the order of the keys
+// UNRELATED: fingerprints say nothing about the key order (for example a hash), so the list is not in key order
+// PRESERVING: a smaller fingerprint always means a smaller key (for example an integer key or a key prefix), so the list is in key order
+// REMOVE_FIRST_BY_FINGERPRINT: like UNRELATED, but clds_sorted_list_remove_first is allowed and removes the item with the smallest fingerprint
+#define SORTED_LIST_KEY_FINGERPRINT_ORDER_VALUES \
+    SORTED_LIST_KEY_FINGERPRINT_ORDER_UNRELATED, \
+    SORTED_LIST_KEY_FINGERPRINT_ORDER_PRESERVING, \
+    SORTED_LIST_KEY_FINGERPRINT_ORDER_REMOVE_FIRST_BY_FINGERPRINT
+
+MU_DEFINE_ENUM(SORTED_LIST_KEY_FINGERPRINT_ORDER, SORTED_LIST_KEY_FINGERPRINT_ORDER_VALUES);
+
 #define CLDS_SORTED_LIST_GET_COUNT_RESULT_VALUES \
     CLDS_SORTED_LIST_GET_COUNT_OK, \
     CLDS_SORTED_LIST_GET_COUNT_NOT_LOCKED, \
@@ -105,14 +198,29 @@ MU_DEFINE_ENUM(CLDS_SORTED_LIST_GET_COUNT_RESULT, CLDS_SORTED_LIST_GET_COUNT_RES
 
 MU_DEFINE_ENUM(CLDS_SORTED_LIST_GET_ALL_RESULT, CLDS_SORTED_LIST_GET_ALL_RESULT_VALUES);
 
+#define CLDS_SORTED_LIST_VISIT_RESULT_VALUES \
+    CLDS_SORTED_LIST_VISIT_OK, \
+    CLDS_SORTED_LIST_VISIT_ABORTED, \
+    CLDS_SORTED_LIST_VISIT_ERROR
+
+MU_DEFINE_ENUM(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_RESULT_VALUES);
+
 // sorted list API
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_HANDLE, clds_sorted_list_create, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, SORTED_LIST_GET_ITEM_KEY_CB, get_item_key_cb, void*, get_item_key_cb_context, SORTED_LIST_KEY_COMPARE_CB, key_compare_cb, void*, key_compare_cb_context, volatile int64_t*, start_sequence_number, SORTED_LIST_SKIPPED_SEQ_NO_CB, skipped_seq_no_cb, void*, skipped_seq_no_cb_context);
 MOCKABLE_FUNCTION(, void, clds_sorted_list_destroy, CLDS_SORTED_LIST_HANDLE, clds_sorted_list);
+MOCKABLE_FUNCTION(, int, clds_sorted_list_set_key_fingerprint_cb, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, SORTED_LIST_GET_KEY_FINGERPRINT_CB, get_key_fingerprint_cb, void*, get_key_fingerprint_cb_context, SORTED_LIST_KEY_FINGERPRINT_ORDER, key_fingerprint_order);
+MOCKABLE_FUNCTION(, int, clds_sorted_list_set_sequence_number_block_size, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, uint32_t, block_size);
+MOCKABLE_FUNCTION(, int, clds_sorted_list_set_sequence_number_blocks, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE, sequence_number_blocks, uint32_t, block_size);
+MOCKABLE_FUNCTION(, int, clds_sorted_list_set_backoff_policy, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_BACKOFF_POLICY, backoff_policy);
+MOCKABLE_FUNCTION(, int, clds_sorted_list_set_finger_search, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, bool, enable);
 
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_INSERT_RESULT, clds_sorted_list_insert, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM*, item, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_DELETE_RESULT, clds_sorted_list_delete_item, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM*, item, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_DELETE_RESULT, clds_sorted_list_delete_key, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_DELETE_RESULT, clds_sorted_list_delete_range, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, low_key, void*, high_key, SORTED_LIST_ITEM_DELETED_CB, item_deleted_cb, void*, item_deleted_cb_context);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_REMOVE_RESULT, clds_sorted_list_remove_key, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_SORTED_LIST_ITEM**, item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_REMOVE_RESULT, clds_sorted_list_remove_item, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM*, item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_REMOVE_RESULT, clds_sorted_list_remove_first, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM**, item, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_ITEM*, clds_sorted_list_find_key, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_SET_VALUE_RESULT, clds_sorted_list_set_value, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, const void*, key, CLDS_SORTED_LIST_ITEM*, new_item, CLDS_SORTED_LIST_ITEM**, old_item, int64_t*, sequence_number, bool, only_if_exists);
 
@@ -122,6 +230,9 @@ MOCKABLE_FUNCTION(, void, clds_sorted_list_unlock_writes, CLDS_SORTED_LIST_HANDL
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_GET_COUNT_RESULT, clds_sorted_list_get_count, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t*, item_count);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_GET_ALL_RESULT, clds_sorted_list_get_all, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t, item_count, CLDS_SORTED_LIST_ITEM**, items);
 
+// walks the list without locking it, writers keep going while the walk is in progress
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_VISIT_RESULT, clds_sorted_list_visit, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, SORTED_LIST_VISIT_CB, visit_cb, void*, visit_cb_context);
+
 // helper APIs for creating/destroying a sorted list node
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_ITEM*, clds_sorted_list_node_create, size_t, node_size, SORTED_LIST_ITEM_CLEANUP_CB, item_cleanup_callback, void*, item_cleanup_callback_context);
 MOCKABLE_FUNCTION(, int, clds_sorted_list_node_inc_ref, CLDS_SORTED_LIST_ITEM*, item);
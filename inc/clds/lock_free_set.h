@@ -5,6 +5,7 @@
 
 #include "umock_c/umock_c_prod.h"
 #include "clds/clds_atomics.h"
+#include "clds/clds_backoff.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +23,7 @@ typedef void(*NODE_CLEANUP_FUNC)(void* context, LOCK_FREE_SET_ITEM* item);
 
 MOCKABLE_FUNCTION(, LOCK_FREE_SET_HANDLE, lock_free_set_create);
 MOCKABLE_FUNCTION(, void, lock_free_set_destroy, LOCK_FREE_SET_HANDLE, lock_free_set, NODE_CLEANUP_FUNC, node_cleanup_callback, void*, context);
+MOCKABLE_FUNCTION(, int, lock_free_set_set_backoff_policy, LOCK_FREE_SET_HANDLE, lock_free_set, CLDS_BACKOFF_POLICY, backoff_policy);
 MOCKABLE_FUNCTION(, int, lock_free_set_insert, LOCK_FREE_SET_HANDLE, lock_free_set, LOCK_FREE_SET_ITEM*, item);
 MOCKABLE_FUNCTION(, int, lock_free_set_remove, LOCK_FREE_SET_HANDLE, lock_free_set, LOCK_FREE_SET_ITEM*, item);
 MOCKABLE_FUNCTION(, int, lock_free_set_purge_not_thread_safe, LOCK_FREE_SET_HANDLE, lock_free_set, NODE_CLEANUP_FUNC, node_cleanup_callback, void*, context);
@@ -0,0 +1,146 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "windows.h"
+
+#include "azure_c_logging/xlogging.h"
+#include "clds/clds_backoff.h"
+
+/* this module implements the backoff policies used by the lock free data structures when retrying CAS operations or waiting for other threads */
+
+// exponential backoff spins 1, 2, 4 ... 512 pause instructions, after that it yields the time slice on every attempt
+#define EXPONENTIAL_MAX_SPIN_SHIFT 10
+
+// spin then wait spins this many pause instructions for the first SPIN_THEN_WAIT_SPIN_ATTEMPTS attempts
+#define SPIN_THEN_WAIT_SPIN_COUNT 64
+#define SPIN_THEN_WAIT_SPIN_ATTEMPTS 32
+
+// the wait is bounded so that a waiter never depends on a wake from a thread that does not use the same policy
+#define SPIN_THEN_WAIT_TIMEOUT_MS 1
+
+MU_DEFINE_ENUM_STRINGS(CLDS_BACKOFF_POLICY, CLDS_BACKOFF_POLICY_VALUES);
+
+static void spin(uint32_t pause_count)
+{
+    uint32_t i;
+
+    for (i = 0; i < pause_count; i++)
+    {
+        YieldProcessor();
+    }
+}
+
+// runs the spin/yield part of a policy, returns false if the spin budget of the policy is used up
+static bool backoff_spin_or_yield(CLDS_BACKOFF* backoff)
+{
+    bool result;
+
+    switch (backoff->policy)
+    {
+    case CLDS_BACKOFF_POLICY_NONE:
+        /* Codes_SRS_CLDS_BACKOFF_01_004: [ If the policy is CLDS_BACKOFF_POLICY_NONE, clds_backoff_retry shall return immediately. ]*/
+        result = true;
+        break;
+
+    case CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD:
+        if (backoff->attempt_count < EXPONENTIAL_MAX_SPIN_SHIFT)
+        {
+            /* Codes_SRS_CLDS_BACKOFF_01_005: [ If the policy is CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD, clds_backoff_retry shall execute a number of CPU pause instructions that doubles with each attempt, starting at 1 and up to 512. ]*/
+            spin((uint32_t)1 << backoff->attempt_count);
+            backoff->attempt_count++;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_BACKOFF_01_006: [ After 10 attempts, clds_backoff_retry shall yield the time slice of the calling thread instead. ]*/
+            (void)SwitchToThread();
+        }
+
+        result = true;
+        break;
+
+    case CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT:
+        if (backoff->attempt_count < SPIN_THEN_WAIT_SPIN_ATTEMPTS)
+        {
+            /* Codes_SRS_CLDS_BACKOFF_01_007: [ If the policy is CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT, for the first 32 attempts clds_backoff_retry shall execute 64 CPU pause instructions. ]*/
+            spin(SPIN_THEN_WAIT_SPIN_COUNT);
+            backoff->attempt_count++;
+            result = true;
+        }
+        else
+        {
+            result = false;
+        }
+        break;
+
+    default:
+        /* Codes_SRS_CLDS_BACKOFF_01_003: [ If the policy in backoff is not a valid CLDS_BACKOFF_POLICY value, clds_backoff_retry shall behave as for CLDS_BACKOFF_POLICY_NONE. ]*/
+        LogError("Invalid backoff policy: %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_BACKOFF_POLICY, backoff->policy));
+        result = true;
+        break;
+    }
+
+    return result;
+}
+
+void clds_backoff_retry(CLDS_BACKOFF* backoff)
+{
+    if (backoff == NULL)
+    {
+        /* Codes_SRS_CLDS_BACKOFF_01_002: [ If backoff is NULL, clds_backoff_retry shall return. ]*/
+        LogError("Invalid arguments: CLDS_BACKOFF* backoff=%p", backoff);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_BACKOFF_01_001: [ clds_backoff_retry shall delay the calling thread according to the policy in backoff and the number of attempts already made. ]*/
+        if (!backoff_spin_or_yield(backoff))
+        {
+            // there is no address to wait on for a CAS retry, so give up the time slice
+            /* Codes_SRS_CLDS_BACKOFF_01_008: [ After 32 attempts, clds_backoff_retry shall yield the time slice of the calling thread. ]*/
+            (void)SwitchToThread();
+        }
+    }
+}
+
+void clds_backoff_wait_while_equal(CLDS_BACKOFF* backoff, volatile LONG* address, LONG value)
+{
+    if (
+        /* Codes_SRS_CLDS_BACKOFF_01_010: [ If backoff is NULL, clds_backoff_wait_while_equal shall return. ]*/
+        (backoff == NULL) ||
+        /* Codes_SRS_CLDS_BACKOFF_01_011: [ If address is NULL, clds_backoff_wait_while_equal shall return. ]*/
+        (address == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_BACKOFF* backoff=%p, volatile LONG* address=%p, LONG value=%ld",
+            backoff, address, value);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_BACKOFF_01_012: [ If the value at address is different than value, clds_backoff_wait_while_equal shall return immediately. ]*/
+        if (InterlockedAdd(address, 0) == value)
+        {
+            /* Codes_SRS_CLDS_BACKOFF_01_009: [ clds_backoff_wait_while_equal shall delay the calling thread according to the policy in backoff, in the same way as clds_backoff_retry. ]*/
+            if (!backoff_spin_or_yield(backoff))
+            {
+                /* Codes_SRS_CLDS_BACKOFF_01_013: [ After 32 attempts with the policy CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT, clds_backoff_wait_while_equal shall block the calling thread (WaitOnAddress) until the value at address changes, clds_backoff_wake_all is called for address or 1 ms elapses. ]*/
+                (void)WaitOnAddress(address, &value, sizeof(value), SPIN_THEN_WAIT_TIMEOUT_MS);
+            }
+        }
+    }
+}
+
+void clds_backoff_wake_all(volatile LONG* address)
+{
+    if (address == NULL)
+    {
+        /* Codes_SRS_CLDS_BACKOFF_01_015: [ If address is NULL, clds_backoff_wake_all shall return. ]*/
+        LogError("Invalid arguments: volatile LONG* address=%p", address);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_BACKOFF_01_014: [ clds_backoff_wake_all shall wake all threads blocked in clds_backoff_wait_while_equal on address. ]*/
+        WakeByAddressAll((PVOID)address);
+    }
+}
@@ -0,0 +1,1327 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include "windows.h"
+#include "azure_c_util/gballoc.h"
+#include "azure_c_logging/xlogging.h"
+#include "clds/clds_flat_hash_table.h"
+#include "clds/clds_atomics.h"
+#include "clds/clds_backoff.h"
+#include "clds/clds_hazard_pointers.h"
+
+/* this is an open addressing hash table, the items are kept in groups of slots with one control byte per slot */
+
+// the control byte of a used slot holds the low 7 bits of the hash of its item (a fragment of the hash),
+// so that a lookup only looks at the items whose fragment matches the fragment of the key
+// a slot goes from empty to holding an item and then to holding a tombstone, it never becomes empty again until the groups are rebuilt,
+// which is what keeps two inserts of the same key from claiming different slots
+
+MU_DEFINE_ENUM_STRINGS(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, CLDS_FLAT_HASH_TABLE_REMOVE_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT_VALUES);
+
+// all the control bytes of a group fit in one 64-bit word, so they are matched 8 at a time with plain integer operations
+#define GROUP_SLOT_COUNT 8
+#define FRAGMENT_BITS 7
+#define FRAGMENT_MASK 0x7F
+#define SLOT_HASH_SHIFT 32
+
+#define CONTROL_EMPTY 0x80
+#define CONTROL_DELETED 0xFE
+
+#define CONTROL_BYTES_LOW_BITS 0x0101010101010101ULL
+#define CONTROL_BYTES_HIGH_BITS 0x8080808080808080ULL
+
+// at most 7 out of 8 slots are used (by items or tombstones) before the groups are rebuilt
+#define MAX_USED_SLOTS_PER_GROUP 7
+
+// the item pointer left in the slot of a deleted item
+#define TOMBSTONE ((CLDS_FLAT_HASH_TABLE_ITEM*)(uintptr_t)1)
+
+// the count of pending write operations is split in per processor shards, so that writers on different processors do not contend on one cache line
+#define WRITE_GATE_SHARD_COUNT 16
+#define WRITE_GATE_CACHE_LINE_SIZE 64
+
+typedef struct WRITE_GATE_SHARD_TAG
+{
+    volatile LONG pending_write_operations;
+    uint8_t padding[WRITE_GATE_CACHE_LINE_SIZE - sizeof(LONG)];
+} WRITE_GATE_SHARD;
+
+typedef struct GROUP_TAG
+{
+    volatile LONG64 control;
+    CLDS_FLAT_HASH_TABLE_ITEM* volatile slots[GROUP_SLOT_COUNT];
+    // the high 32 bits of the hash of the item put in each slot, valid once the control byte of the slot holds the fragment
+    volatile LONG slot_hashes[GROUP_SLOT_COUNT];
+} GROUP;
+
+typedef struct GROUP_ARRAY_TAG
+{
+    // always a power of 2
+    LONG group_count;
+    LONG max_used_slot_count;
+    volatile LONG used_slot_count;
+    volatile LONG item_count;
+    GROUP groups[];
+} GROUP_ARRAY;
+
+typedef struct CLDS_FLAT_HASH_TABLE_TAG
+{
+    FLAT_HASH_TABLE_COMPUTE_HASH_FUNC compute_hash;
+    FLAT_HASH_TABLE_KEY_COMPARE_FUNC key_compare_func;
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    volatile LONG64* sequence_number;
+    FLAT_HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb;
+    void* skipped_seq_no_cb_context;
+    volatile LONG backoff_policy;
+    GROUP_ARRAY* volatile group_array;
+
+    // Support for rebuilding the groups
+    volatile LONG rebuild_in_progress;
+
+    // Support for locking the table for writes while the groups are rebuilt
+    volatile LONG locked_for_write;
+    volatile LONG write_waiter_count;
+    WRITE_GATE_SHARD pending_write_operations[WRITE_GATE_SHARD_COUNT];
+} CLDS_FLAT_HASH_TABLE;
+
+#define LOOKUP_RESULT_VALUES \
+    LOOKUP_FOUND, \
+    LOOKUP_NOT_FOUND, \
+    LOOKUP_FULL, \
+    LOOKUP_RESTART, \
+    LOOKUP_ERROR
+
+MU_DEFINE_ENUM(LOOKUP_RESULT, LOOKUP_RESULT_VALUES);
+
+typedef struct SLOT_LOOKUP_TAG
+{
+    // the slot holding the item found for the key, or the empty slot where the lookup stopped
+    GROUP* group;
+    uint32_t slot_index;
+    // only set for LOOKUP_FOUND, the item stays protected by item_hp until the caller releases it
+    CLDS_FLAT_HASH_TABLE_ITEM* item;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp;
+} SLOT_LOOKUP;
+
+static void internal_node_destroy(CLDS_FLAT_HASH_TABLE_ITEM* item)
+{
+    if (InterlockedDecrement(&item->ref_count) == 0)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_096: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the freed item. ]*/
+        if (item->item_cleanup_callback != NULL)
+        {
+            /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_095: [ When the reference count reaches 0, the item_cleanup_callback passed to clds_flat_hash_table_node_create shall be called with item_cleanup_callback_context and the item, and the item shall be freed. ]*/
+            item->item_cleanup_callback(item->item_cleanup_callback_context, item);
+        }
+
+        free((void*)item);
+    }
+}
+
+static void reclaim_flat_hash_table_node(void* node)
+{
+    internal_node_destroy((CLDS_FLAT_HASH_TABLE_ITEM*)node);
+}
+
+static void reclaim_group_array(void* node)
+{
+    free(node);
+}
+
+static CLDS_BACKOFF_POLICY get_backoff_policy(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table)
+{
+    return (CLDS_BACKOFF_POLICY)InterlockedAdd(&clds_flat_hash_table->backoff_policy, 0);
+}
+
+static GROUP_ARRAY* get_group_array(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table)
+{
+    return (GROUP_ARRAY*)InterlockedCompareExchangePointer((volatile PVOID*)&clds_flat_hash_table->group_array, NULL, NULL);
+}
+
+static GROUP_ARRAY* create_group_array(LONG group_count)
+{
+    GROUP_ARRAY* result;
+
+    if ((size_t)group_count > (SIZE_MAX - sizeof(GROUP_ARRAY)) / sizeof(GROUP))
+    {
+        LogError("Group count %" PRId32 " is too large", (int32_t)group_count);
+        result = NULL;
+    }
+    else
+    {
+        result = (GROUP_ARRAY*)malloc(sizeof(GROUP_ARRAY) + (sizeof(GROUP) * (size_t)group_count));
+        if (result == NULL)
+        {
+            LogError("Cannot allocate memory for %" PRId32 " groups", (int32_t)group_count);
+        }
+        else
+        {
+            LONG i;
+            uint32_t j;
+
+            result->group_count = group_count;
+            result->max_used_slot_count = group_count * MAX_USED_SLOTS_PER_GROUP;
+            (void)InterlockedExchange(&result->used_slot_count, 0);
+            (void)InterlockedExchange(&result->item_count, 0);
+
+            for (i = 0; i < group_count; i++)
+            {
+                (void)InterlockedExchange64(&result->groups[i].control, (LONG64)(CONTROL_BYTES_LOW_BITS * CONTROL_EMPTY));
+                for (j = 0; j < GROUP_SLOT_COUNT; j++)
+                {
+                    (void)InterlockedExchangePointer((volatile PVOID*)&result->groups[i].slots[j], NULL);
+                    (void)InterlockedExchange(&result->groups[i].slot_hashes[j], 0);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+/* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_022: [ The control bytes of a group shall be matched against the fragment of the key and against the empty marker 8 at a time with 64-bit integer operations, and only the slots with a matching control byte shall be looked at. ]*/
+// returns the high bit of each control byte that is equal to value
+// a byte right above a matching byte can also be flagged, these false positives are filtered out by looking at the slot
+static uint64_t match_control_bytes(uint64_t control_word, uint8_t value)
+{
+    uint64_t x = control_word ^ (CONTROL_BYTES_LOW_BITS * value);
+    return (x - CONTROL_BYTES_LOW_BITS) & ~x & CONTROL_BYTES_HIGH_BITS;
+}
+
+static void set_control_byte(GROUP* group, uint32_t slot_index, uint8_t value, bool only_if_empty)
+{
+    uint32_t shift = slot_index * 8;
+    LONG64 current_control = InterlockedAdd64(&group->control, 0);
+    bool done = false;
+
+    do
+    {
+        if (only_if_empty && ((((uint64_t)current_control >> shift) & 0xFF) != CONTROL_EMPTY))
+        {
+            // the item was deleted before its fragment was set, leave the deleted marker in place
+            done = true;
+        }
+        else
+        {
+            LONG64 new_control = (LONG64)(((uint64_t)current_control & ~(0xFFULL << shift)) | ((uint64_t)value << shift));
+            LONG64 previous_control = InterlockedCompareExchange64(&group->control, new_control, current_control);
+            if (previous_control == current_control)
+            {
+                done = true;
+            }
+            else
+            {
+                // another slot of the group changed, try again with the new control word
+                current_control = previous_control;
+            }
+        }
+    } while (!done);
+}
+
+// the sequence number is taken before the change is published, so that the sequence numbers follow the order in which the changes become visible
+static int64_t take_sequence_number(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table)
+{
+    return (clds_flat_hash_table->sequence_number == NULL) ? 0 : InterlockedIncrement64(clds_flat_hash_table->sequence_number);
+}
+
+static void report_sequence_number(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, int64_t operation_sequence_number, int64_t* sequence_number)
+{
+    if ((clds_flat_hash_table->sequence_number != NULL) &&
+        (sequence_number != NULL))
+    {
+        *sequence_number = operation_sequence_number;
+    }
+}
+
+static void skip_sequence_number(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, int64_t operation_sequence_number)
+{
+    if ((clds_flat_hash_table->sequence_number != NULL) &&
+        (clds_flat_hash_table->skipped_seq_no_cb != NULL))
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_105: [ If the compare exchange publishing the change fails or the item cannot be put in a slot, the sequence number taken for it shall be reported by calling skipped_seq_no_cb with skipped_seq_no_cb_context and the sequence number. ]*/
+        clds_flat_hash_table->skipped_seq_no_cb(clds_flat_hash_table->skipped_seq_no_cb_context, operation_sequence_number);
+    }
+}
+
+static WRITE_GATE_SHARD* begin_write_operation(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table)
+{
+    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_106: [ The count of pending write operations shall be split in per processor counters that do not share a cache line, and each write operation shall increment and decrement the counter picked by the processor it started on. ]*/
+    WRITE_GATE_SHARD* shard = &clds_flat_hash_table->pending_write_operations[GetCurrentProcessorNumber() % WRITE_GATE_SHARD_COUNT];
+    LONG locked_for_write;
+    do
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_026: [ Write operations shall increment the count of pending write operations and, if the table is locked for writes, decrement it, wait for the table to be unlocked and try again. ]*/
+        (void)InterlockedIncrement(&shard->pending_write_operations);
+        locked_for_write = InterlockedAdd(&clds_flat_hash_table->locked_for_write, 0);
+        if (locked_for_write != 0)
+        {
+            (void)InterlockedDecrement(&shard->pending_write_operations);
+            WakeByAddressAll((void*)&shard->pending_write_operations);
+
+            // Wait for unlock, counted so that the unlock only wakes when somebody waits
+            (void)InterlockedIncrement(&clds_flat_hash_table->write_waiter_count);
+            (void)WaitOnAddress(&clds_flat_hash_table->locked_for_write, &locked_for_write, sizeof(locked_for_write), INFINITE);
+            (void)InterlockedDecrement(&clds_flat_hash_table->write_waiter_count);
+        }
+    } while (locked_for_write != 0);
+
+    return shard;
+}
+
+static void end_write_operation(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, WRITE_GATE_SHARD* shard)
+{
+    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_027: [ Write operations shall decrement the count of pending write operations when they complete and wake the thread waiting for it only if the table is locked for writes. ]*/
+    (void)InterlockedDecrement(&shard->pending_write_operations);
+    if (InterlockedAdd(&clds_flat_hash_table->locked_for_write, 0) != 0)
+    {
+        WakeByAddressAll((void*)&shard->pending_write_operations);
+    }
+}
+
+static void lock_writes(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table)
+{
+    uint32_t i;
+
+    (void)InterlockedIncrement(&clds_flat_hash_table->locked_for_write);
+
+    for (i = 0; i < WRITE_GATE_SHARD_COUNT; i++)
+    {
+        LONG pending_writes;
+        do
+        {
+            pending_writes = InterlockedAdd(&clds_flat_hash_table->pending_write_operations[i].pending_write_operations, 0);
+            if (pending_writes != 0)
+            {
+                // Wait for writes
+                (void)WaitOnAddress(&clds_flat_hash_table->pending_write_operations[i].pending_write_operations, &pending_writes, sizeof(pending_writes), INFINITE);
+            }
+        } while (pending_writes != 0);
+    }
+}
+
+static void unlock_writes(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table)
+{
+    (void)InterlockedDecrement(&clds_flat_hash_table->locked_for_write);
+    if (InterlockedAdd(&clds_flat_hash_table->write_waiter_count, 0) != 0)
+    {
+        WakeByAddressAll((void*)&clds_flat_hash_table->locked_for_write);
+    }
+}
+
+/* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_020: [ The low 7 bits of the hash of a key shall be the fragment kept in the control byte of the slot of the item and the remaining bits shall pick the home group of the key. ]*/
+static LONG get_slot_hash(uint64_t hash)
+{
+    return (LONG)(uint32_t)(hash >> SLOT_HASH_SHIFT);
+}
+
+static GROUP* get_home_group(GROUP_ARRAY* group_array, uint64_t hash, LONG* group_index)
+{
+    *group_index = (LONG)((hash >> FRAGMENT_BITS) & (uint64_t)(group_array->group_count - 1));
+    return &group_array->groups[*group_index];
+}
+
+static LOOKUP_RESULT lookup_key(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, GROUP_ARRAY* group_array, uint64_t hash, void* key, SLOT_LOOKUP* slot_lookup)
+{
+    LOOKUP_RESULT result = LOOKUP_FULL;
+    uint8_t fragment = (uint8_t)(hash & FRAGMENT_MASK);
+    LONG slot_hash = get_slot_hash(hash);
+    LONG group_index;
+    LONG probed_group_count;
+    bool done = false;
+
+    (void)get_home_group(group_array, hash, &group_index);
+
+    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_021: [ The groups shall be probed starting with the home group of the key and moving to the next group, wrapping around at the end of the array, until a slot that was never used is found. ]*/
+    for (probed_group_count = 0; (probed_group_count < group_array->group_count) && !done; probed_group_count++)
+    {
+        GROUP* group = &group_array->groups[group_index];
+        uint64_t control_word = (uint64_t)InterlockedAdd64(&group->control, 0);
+
+        // an item that was just put in a slot might not have its fragment set yet, so the empty slots are looked at too
+        uint64_t candidates = match_control_bytes(control_word, fragment) | match_control_bytes(control_word, CONTROL_EMPTY);
+        uint32_t slot_index;
+
+        for (slot_index = 0; (slot_index < GROUP_SLOT_COUNT) && !done; slot_index++)
+        {
+            if (((candidates >> (slot_index * 8)) & 0x80) == 0)
+            {
+                // not a candidate
+            }
+            /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_108: [ A slot whose control byte is not the empty marker and whose kept hash bits are different than the ones of the key shall be skipped without acquiring a hazard pointer and without looking at its item. ]*/
+            else if ((((control_word >> (slot_index * 8)) & 0xFF) != CONTROL_EMPTY) &&
+                (InterlockedAdd(&group->slot_hashes[slot_index], 0) != slot_hash))
+            {
+                // the fragment matched, but the item has a different hash
+            }
+            else
+            {
+                CLDS_FLAT_HASH_TABLE_ITEM* item = InterlockedCompareExchangePointer((volatile PVOID*)&group->slots[slot_index], NULL, NULL);
+                if (item == NULL)
+                {
+                    // never used slot, the key cannot be further down the probe sequence
+                    slot_lookup->group = group;
+                    slot_lookup->slot_index = slot_index;
+                    result = LOOKUP_NOT_FOUND;
+                    done = true;
+                }
+                else if (item != TOMBSTONE)
+                {
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_024: [ An item shall only be looked at while protected by a hazard pointer acquired with clds_hazard_pointers_acquire, and only if after acquiring it the slot still holds the item and the array of groups is still the current one. ]*/
+                    CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, item);
+                    if (item_hp == NULL)
+                    {
+                        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_025: [ If acquiring a hazard pointer fails, the operation shall fail and return its ERROR result, or NULL for clds_flat_hash_table_find. ]*/
+                        LogError("Cannot acquire hazard pointer");
+                        result = LOOKUP_ERROR;
+                        done = true;
+                    }
+                    else
+                    {
+                        if ((InterlockedCompareExchangePointer((volatile PVOID*)&group->slots[slot_index], NULL, NULL) != item) ||
+                            (get_group_array(clds_flat_hash_table) != group_array))
+                        {
+                            // the slot changed or the groups were rebuilt, the item might have been reclaimed before the hazard pointer was set
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp);
+                            result = LOOKUP_RESTART;
+                            done = true;
+                        }
+                        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_023: [ An item with a different hash than the key shall be skipped without calling key_compare_func. ]*/
+                        else if ((item->hash == hash) &&
+                            (clds_flat_hash_table->key_compare_func(item->key, key) == 0))
+                        {
+                            slot_lookup->group = group;
+                            slot_lookup->slot_index = slot_index;
+                            slot_lookup->item = item;
+                            slot_lookup->item_hp = item_hp;
+                            result = LOOKUP_FOUND;
+                            done = true;
+                        }
+                        else
+                        {
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp);
+                        }
+                    }
+                }
+                else
+                {
+                    // deleted item, keep going
+                }
+            }
+        }
+
+        group_index = (group_index + 1) & (group_array->group_count - 1);
+    }
+
+    return result;
+}
+
+// only used while the table is locked for writes and before the new array is published, so no atomic claim is needed
+static void place_item(GROUP_ARRAY* group_array, CLDS_FLAT_HASH_TABLE_ITEM* item)
+{
+    LONG group_index;
+    bool placed = false;
+
+    (void)get_home_group(group_array, item->hash, &group_index);
+
+    do
+    {
+        GROUP* group = &group_array->groups[group_index];
+        uint32_t slot_index;
+
+        for (slot_index = 0; slot_index < GROUP_SLOT_COUNT; slot_index++)
+        {
+            if (group->slots[slot_index] == NULL)
+            {
+                group->slots[slot_index] = item;
+                group->slot_hashes[slot_index] = get_slot_hash(item->hash);
+                set_control_byte(group, slot_index, (uint8_t)(item->hash & FRAGMENT_MASK), false);
+                placed = true;
+                break;
+            }
+        }
+
+        group_index = (group_index + 1) & (group_array->group_count - 1);
+    } while (!placed);
+
+    group_array->used_slot_count++;
+    group_array->item_count++;
+}
+
+static int rebuild_group_array(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, GROUP_ARRAY* full_group_array)
+{
+    int result;
+    LONG rebuild_in_progress = InterlockedCompareExchange(&clds_flat_hash_table->rebuild_in_progress, 1, 0);
+
+    if (rebuild_in_progress != 0)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_042: [ If another thread is already rebuilding the groups, the operation shall wait for it to complete and retry. ]*/
+        do
+        {
+            (void)WaitOnAddress(&clds_flat_hash_table->rebuild_in_progress, &rebuild_in_progress, sizeof(rebuild_in_progress), INFINITE);
+            rebuild_in_progress = InterlockedAdd(&clds_flat_hash_table->rebuild_in_progress, 0);
+        } while (rebuild_in_progress != 0);
+
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_041: [ Rebuilding the groups shall lock the table for writes and wait for the pending write operations to complete. ]*/
+        lock_writes(clds_flat_hash_table);
+
+        if (get_group_array(clds_flat_hash_table) != full_group_array)
+        {
+            // somebody else rebuilt the groups in the meanwhile
+            result = 0;
+        }
+        else
+        {
+            LONG item_count = InterlockedAdd(&full_group_array->item_count, 0);
+            LONG group_count = full_group_array->group_count;
+
+            /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_043: [ The new array of groups shall have the same number of groups, doubled for as long as the items would use more than half of the slots. ]*/
+            while ((group_count <= INT32_MAX / 2) &&
+                (((int64_t)item_count + 1) * 2 > (int64_t)group_count * GROUP_SLOT_COUNT))
+            {
+                group_count *= 2;
+            }
+
+            GROUP_ARRAY* new_group_array = create_group_array(group_count);
+            if (new_group_array == NULL)
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_045: [ If allocating the new array of groups fails, the operation that needed it shall fail and return its ERROR result. ]*/
+                LogError("Cannot allocate the new array of groups");
+                result = MU_FAILURE;
+            }
+            else
+            {
+                LONG i;
+                uint32_t j;
+
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_044: [ The items shall be placed in the new array of groups by using the hash stored in each item, without calling compute_hash, and the tombstones shall be dropped. ]*/
+                for (i = 0; i < full_group_array->group_count; i++)
+                {
+                    for (j = 0; j < GROUP_SLOT_COUNT; j++)
+                    {
+                        CLDS_FLAT_HASH_TABLE_ITEM* item = InterlockedCompareExchangePointer((volatile PVOID*)&full_group_array->groups[i].slots[j], NULL, NULL);
+                        if ((item != NULL) && (item != TOMBSTONE))
+                        {
+                            place_item(new_group_array, item);
+                        }
+                    }
+                }
+
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_046: [ The new array of groups shall replace the old one and the old one shall be released by calling clds_hazard_pointers_reclaim, since readers might still be looking at it. ]*/
+                (void)InterlockedExchangePointer((volatile PVOID*)&clds_flat_hash_table->group_array, new_group_array);
+                clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, full_group_array, reclaim_group_array);
+
+                result = 0;
+            }
+        }
+
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_047: [ Once the groups are rebuilt, the table shall be unlocked for writes and the write operations waiting for it shall be woken. ]*/
+        unlock_writes(clds_flat_hash_table);
+
+        (void)InterlockedExchange(&clds_flat_hash_table->rebuild_in_progress, 0);
+        WakeByAddressAll((void*)&clds_flat_hash_table->rebuild_in_progress);
+    }
+
+    return result;
+}
+
+// the outcome of claiming the empty slot found by a lookup for a new item
+#define CLAIM_RESULT_VALUES \
+    CLAIM_OK, \
+    CLAIM_SLOT_TAKEN, \
+    CLAIM_REBUILD_NEEDED
+
+MU_DEFINE_ENUM(CLAIM_RESULT, CLAIM_RESULT_VALUES);
+
+static CLAIM_RESULT claim_empty_slot(GROUP_ARRAY* group_array, SLOT_LOOKUP* slot_lookup, CLDS_FLAT_HASH_TABLE_ITEM* item)
+{
+    CLAIM_RESULT result;
+
+    if (InterlockedIncrement(&group_array->used_slot_count) > group_array->max_used_slot_count)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_039: [ If putting the item in the table would make more than 7 out of 8 slots used by items or tombstones, the groups shall be rebuilt and the operation shall be retried. ]*/
+        (void)InterlockedDecrement(&group_array->used_slot_count);
+        result = CLAIM_REBUILD_NEEDED;
+    }
+    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_037: [ The item shall be put in the table by changing the first never used slot of the probe sequence from NULL to the item with a compare exchange and then setting the control byte of the slot to the fragment of the hash. ]*/
+    else if (InterlockedCompareExchangePointer((volatile PVOID*)&slot_lookup->group->slots[slot_lookup->slot_index], item, NULL) != NULL)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_038: [ If another item took the slot first, the operation shall look up the key again. ]*/
+        (void)InterlockedDecrement(&group_array->used_slot_count);
+        result = CLAIM_SLOT_TAKEN;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_107: [ The high 32 bits of the hash of the item shall be kept in the group next to its slot, and they shall be stored before the control byte of the slot is set to the fragment. ]*/
+        (void)InterlockedExchange(&slot_lookup->group->slot_hashes[slot_lookup->slot_index], get_slot_hash(item->hash));
+        set_control_byte(slot_lookup->group, slot_lookup->slot_index, (uint8_t)(item->hash & FRAGMENT_MASK), true);
+        (void)InterlockedIncrement(&group_array->item_count);
+        result = CLAIM_OK;
+    }
+
+    return result;
+}
+
+static CLDS_FLAT_HASH_TABLE_DELETE_RESULT internal_delete(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_FLAT_HASH_TABLE_ITEM* value, CLDS_FLAT_HASH_TABLE_ITEM** removed_item, int64_t* sequence_number)
+{
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    bool restart_needed;
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_flat_hash_table));
+
+    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_050: [ clds_flat_hash_table_delete, clds_flat_hash_table_delete_key_value and clds_flat_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_flat_hash_table_create. ]*/
+    uint64_t hash = clds_flat_hash_table->compute_hash(key);
+
+    do
+    {
+        SLOT_LOOKUP slot_lookup;
+        GROUP_ARRAY* group_array;
+        int64_t operation_sequence_number;
+
+        restart_needed = false;
+
+        WRITE_GATE_SHARD* write_gate_shard = begin_write_operation(clds_flat_hash_table);
+
+        group_array = get_group_array(clds_flat_hash_table);
+        switch (lookup_key(clds_flat_hash_table, clds_hazard_pointers_thread, group_array, hash, key, &slot_lookup))
+        {
+        default:
+        case LOOKUP_ERROR:
+            result = CLDS_FLAT_HASH_TABLE_DELETE_ERROR;
+            break;
+
+        case LOOKUP_RESTART:
+            restart_needed = true;
+            break;
+
+        case LOOKUP_NOT_FOUND:
+        case LOOKUP_FULL:
+            /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_051: [ If the key is not found, clds_flat_hash_table_delete, clds_flat_hash_table_delete_key_value and clds_flat_hash_table_remove shall return their respective NOT_FOUND result. ]*/
+            result = CLDS_FLAT_HASH_TABLE_DELETE_NOT_FOUND;
+            break;
+
+        case LOOKUP_FOUND:
+            if ((value != NULL) && (slot_lookup.item != value))
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_067: [ If the item in the table for key is not value, clds_flat_hash_table_delete_key_value shall return CLDS_FLAT_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, slot_lookup.item_hp);
+                result = CLDS_FLAT_HASH_TABLE_DELETE_NOT_FOUND;
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_055: [ If a start sequence number was given to clds_flat_hash_table_create, the sequence number shall be incremented right before the compare exchange publishing the change and on success stored in sequence_number if sequence_number is not NULL. ]*/
+                operation_sequence_number = take_sequence_number(clds_flat_hash_table);
+
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_052: [ The item shall be taken out of the table by changing its slot to a tombstone with a compare exchange and setting the control byte of the slot to the deleted marker, the slot shall not be used again until the groups are rebuilt. ]*/
+                if (InterlockedCompareExchangePointer((volatile PVOID*)&slot_lookup.group->slots[slot_lookup.slot_index], TOMBSTONE, slot_lookup.item) != slot_lookup.item)
+                {
+                    skip_sequence_number(clds_flat_hash_table, operation_sequence_number);
+
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_053: [ If the slot changed before the item could be taken out, the key shall be looked up again. ]*/
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, slot_lookup.item_hp);
+                    restart_needed = true;
+                }
+                else
+                {
+                    set_control_byte(slot_lookup.group, slot_lookup.slot_index, CONTROL_DELETED, false);
+                    (void)InterlockedDecrement(&group_array->item_count);
+
+                    report_sequence_number(clds_flat_hash_table, operation_sequence_number, sequence_number);
+
+                    if (removed_item != NULL)
+                    {
+                        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_069: [ clds_flat_hash_table_remove shall return the removed item in item with its reference count incremented. ]*/
+                        (void)InterlockedIncrement(&slot_lookup.item->ref_count);
+                        *removed_item = slot_lookup.item;
+                    }
+
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, slot_lookup.item_hp);
+
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_054: [ The reference held by the table on the item shall be released by calling clds_hazard_pointers_reclaim. ]*/
+                    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, slot_lookup.item, reclaim_flat_hash_table_node);
+
+                    result = CLDS_FLAT_HASH_TABLE_DELETE_OK;
+                }
+            }
+            break;
+        }
+
+        end_write_operation(clds_flat_hash_table, write_gate_shard);
+
+        if (restart_needed)
+        {
+            /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_019: [ Before retrying because of a concurrent change, the flat hash table operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the table. ]*/
+            clds_backoff_retry(&backoff);
+        }
+    } while (restart_needed);
+
+    return result;
+}
+
+CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table_create(FLAT_HASH_TABLE_COMPUTE_HASH_FUNC compute_hash, FLAT_HASH_TABLE_KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile int64_t* start_sequence_number, FLAT_HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
+{
+    CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table;
+
+    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_010: [ skipped_seq_no_cb shall be allowed to be NULL. ]*/
+    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_011: [ skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_003: [ If compute_hash is NULL, clds_flat_hash_table_create shall fail and return NULL. ]*/
+        (compute_hash == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_004: [ If key_compare_func is NULL, clds_flat_hash_table_create shall fail and return NULL. ]*/
+        (key_compare_func == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_005: [ If initial_bucket_size is 0, clds_flat_hash_table_create shall fail and return NULL. ]*/
+        (initial_bucket_size == 0) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_006: [ If clds_hazard_pointers is NULL, clds_flat_hash_table_create shall fail and return NULL. ]*/
+        (clds_hazard_pointers == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_012: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_flat_hash_table_create shall fail and return NULL. ]*/
+        ((start_sequence_number == NULL) && (skipped_seq_no_cb != NULL))
+        )
+    {
+        LogError("Invalid arguments: FLAT_HASH_TABLE_COMPUTE_HASH_FUNC compute_hash=%p, FLAT_HASH_TABLE_KEY_COMPARE_FUNC key_compare_func=%p, size_t initial_bucket_size=%zu, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, volatile int64_t* start_sequence_number=%p, FLAT_HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb=%p, void* skipped_seq_no_cb_context=%p",
+            compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+        clds_flat_hash_table = NULL;
+    }
+    else
+    {
+        LONG group_count = 1;
+
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_007: [ clds_flat_hash_table_create shall allocate an array of groups of 8 slots, with the number of groups being the smallest power of 2 that keeps initial_bucket_size items under 7 out of 8 used slots, all slots being empty. ]*/
+        while ((group_count <= INT32_MAX / 2) &&
+            ((uint64_t)group_count * MAX_USED_SLOTS_PER_GROUP < (uint64_t)initial_bucket_size))
+        {
+            group_count *= 2;
+        }
+
+        if ((uint64_t)group_count * MAX_USED_SLOTS_PER_GROUP < (uint64_t)initial_bucket_size)
+        {
+            /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_002: [ If any error happens, clds_flat_hash_table_create shall fail and return NULL. ]*/
+            LogError("initial_bucket_size=%zu is too large", initial_bucket_size);
+            clds_flat_hash_table = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_001: [ clds_flat_hash_table_create shall create a new flat hash table object and on success it shall return a non-NULL handle to the newly created flat hash table. ]*/
+            clds_flat_hash_table = (CLDS_FLAT_HASH_TABLE_HANDLE)malloc(sizeof(CLDS_FLAT_HASH_TABLE));
+            if (clds_flat_hash_table == NULL)
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_002: [ If any error happens, clds_flat_hash_table_create shall fail and return NULL. ]*/
+                LogError("Cannot allocate memory for the flat hash table");
+            }
+            else
+            {
+                GROUP_ARRAY* group_array = create_group_array(group_count);
+                if (group_array == NULL)
+                {
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_002: [ If any error happens, clds_flat_hash_table_create shall fail and return NULL. ]*/
+                    LogError("Cannot allocate the array of groups");
+                    free(clds_flat_hash_table);
+                    clds_flat_hash_table = NULL;
+                }
+                else
+                {
+                    uint32_t i;
+
+                    // all ok
+                    clds_flat_hash_table->compute_hash = compute_hash;
+                    clds_flat_hash_table->key_compare_func = key_compare_func;
+                    clds_flat_hash_table->clds_hazard_pointers = clds_hazard_pointers;
+
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_008: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every attempt of a write operation to publish its change. ]*/
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_009: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+                    clds_flat_hash_table->sequence_number = start_sequence_number;
+                    clds_flat_hash_table->skipped_seq_no_cb = skipped_seq_no_cb;
+                    clds_flat_hash_table->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
+
+                    (void)InterlockedExchange(&clds_flat_hash_table->backoff_policy, CLDS_BACKOFF_POLICY_NONE);
+                    (void)InterlockedExchange(&clds_flat_hash_table->rebuild_in_progress, 0);
+                    (void)InterlockedExchange(&clds_flat_hash_table->locked_for_write, 0);
+                    (void)InterlockedExchange(&clds_flat_hash_table->write_waiter_count, 0);
+                    for (i = 0; i < WRITE_GATE_SHARD_COUNT; i++)
+                    {
+                        (void)InterlockedExchange(&clds_flat_hash_table->pending_write_operations[i].pending_write_operations, 0);
+                    }
+                    (void)InterlockedExchangePointer((volatile PVOID*)&clds_flat_hash_table->group_array, group_array);
+                }
+            }
+        }
+    }
+
+    return clds_flat_hash_table;
+}
+
+void clds_flat_hash_table_destroy(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table)
+{
+    if (clds_flat_hash_table == NULL)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_014: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_destroy shall return. ]*/
+        LogError("Invalid arguments: CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table=%p", clds_flat_hash_table);
+    }
+    else
+    {
+        GROUP_ARRAY* group_array = get_group_array(clds_flat_hash_table);
+        LONG i;
+        uint32_t j;
+
+        for (i = 0; i < group_array->group_count; i++)
+        {
+            for (j = 0; j < GROUP_SLOT_COUNT; j++)
+            {
+                CLDS_FLAT_HASH_TABLE_ITEM* item = InterlockedCompareExchangePointer((volatile PVOID*)&group_array->groups[i].slots[j], NULL, NULL);
+                if ((item != NULL) && (item != TOMBSTONE))
+                {
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_015: [ clds_flat_hash_table_destroy shall release the reference held by the table on each item still in the table. ]*/
+                    internal_node_destroy(item);
+                }
+            }
+        }
+
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_013: [ clds_flat_hash_table_destroy shall free all resources associated with the flat hash table instance. ]*/
+        free(group_array);
+        free(clds_flat_hash_table);
+    }
+}
+
+int clds_flat_hash_table_set_backoff_policy(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_BACKOFF_POLICY backoff_policy)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_017: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_set_backoff_policy shall fail and return a non-zero value. ]*/
+        (clds_flat_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_018: [ If backoff_policy is not a valid CLDS_BACKOFF_POLICY value, clds_flat_hash_table_set_backoff_policy shall fail and return a non-zero value. ]*/
+        ((int)backoff_policy < (int)CLDS_BACKOFF_POLICY_NONE) ||
+        ((int)backoff_policy > (int)CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT)
+        )
+    {
+        LogError("Invalid arguments: CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table=%p, CLDS_BACKOFF_POLICY backoff_policy=%" PRI_MU_ENUM "",
+            clds_flat_hash_table, MU_ENUM_VALUE(CLDS_BACKOFF_POLICY, backoff_policy));
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_016: [ clds_flat_hash_table_set_backoff_policy shall set the backoff policy used by all subsequent operations on the table when they have to retry because of a concurrent change and return 0. ]*/
+        (void)InterlockedExchange(&clds_flat_hash_table->backoff_policy, (LONG)backoff_policy);
+        result = 0;
+    }
+
+    return result;
+}
+
+CLDS_FLAT_HASH_TABLE_INSERT_RESULT clds_flat_hash_table_insert(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_FLAT_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_029: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_flat_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_030: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_031: [ If key is NULL, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_032: [ If value is NULL, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+        (value == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_033: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_flat_hash_table_create, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_flat_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_FLAT_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_flat_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
+        result = CLDS_FLAT_HASH_TABLE_INSERT_ERROR;
+    }
+    else
+    {
+        bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_flat_hash_table));
+
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_034: [ clds_flat_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_flat_hash_table_create. ]*/
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_035: [ clds_flat_hash_table_insert shall store the key and its hash in value. ]*/
+        value->key = key;
+        value->hash = clds_flat_hash_table->compute_hash(key);
+
+        do
+        {
+            SLOT_LOOKUP slot_lookup;
+            GROUP_ARRAY* group_array;
+            bool rebuild_needed = false;
+            int64_t operation_sequence_number;
+
+            restart_needed = false;
+
+            WRITE_GATE_SHARD* write_gate_shard = begin_write_operation(clds_flat_hash_table);
+
+            group_array = get_group_array(clds_flat_hash_table);
+            switch (lookup_key(clds_flat_hash_table, clds_hazard_pointers_thread, group_array, value->hash, key, &slot_lookup))
+            {
+            default:
+            case LOOKUP_ERROR:
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_040: [ If any error occurs, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+                result = CLDS_FLAT_HASH_TABLE_INSERT_ERROR;
+                break;
+
+            case LOOKUP_RESTART:
+                restart_needed = true;
+                break;
+
+            case LOOKUP_FOUND:
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_036: [ If the key already exists in the table, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, slot_lookup.item_hp);
+                result = CLDS_FLAT_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+                break;
+
+            case LOOKUP_FULL:
+                rebuild_needed = true;
+                break;
+
+            case LOOKUP_NOT_FOUND:
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_055: [ If a start sequence number was given to clds_flat_hash_table_create, the sequence number shall be incremented right before the compare exchange publishing the change and on success stored in sequence_number if sequence_number is not NULL. ]*/
+                operation_sequence_number = take_sequence_number(clds_flat_hash_table);
+
+                switch (claim_empty_slot(group_array, &slot_lookup, value))
+                {
+                default:
+                case CLAIM_REBUILD_NEEDED:
+                    skip_sequence_number(clds_flat_hash_table, operation_sequence_number);
+                    rebuild_needed = true;
+                    break;
+
+                case CLAIM_SLOT_TAKEN:
+                    skip_sequence_number(clds_flat_hash_table, operation_sequence_number);
+                    restart_needed = true;
+                    break;
+
+                case CLAIM_OK:
+                    report_sequence_number(clds_flat_hash_table, operation_sequence_number, sequence_number);
+
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_028: [ On success clds_flat_hash_table_insert shall return CLDS_FLAT_HASH_TABLE_INSERT_OK. ]*/
+                    result = CLDS_FLAT_HASH_TABLE_INSERT_OK;
+                    break;
+                }
+                break;
+            }
+
+            end_write_operation(clds_flat_hash_table, write_gate_shard);
+
+            if (rebuild_needed)
+            {
+                if (rebuild_group_array(clds_flat_hash_table, clds_hazard_pointers_thread, group_array) != 0)
+                {
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_040: [ If any error occurs, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+                    LogError("Cannot rebuild the groups");
+                    result = CLDS_FLAT_HASH_TABLE_INSERT_ERROR;
+                }
+                else
+                {
+                    restart_needed = true;
+                }
+            }
+            else if (restart_needed)
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_019: [ Before retrying because of a concurrent change, the flat hash table operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the table. ]*/
+                clds_backoff_retry(&backoff);
+            }
+        } while (restart_needed);
+    }
+
+    return result;
+}
+
+CLDS_FLAT_HASH_TABLE_DELETE_RESULT clds_flat_hash_table_delete(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+{
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_057: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_delete shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_flat_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_058: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_delete shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_059: [ If key is NULL, clds_flat_hash_table_delete shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_060: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_flat_hash_table_create, clds_flat_hash_table_delete shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_flat_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
+            clds_flat_hash_table, clds_hazard_pointers_thread, key, sequence_number);
+        result = CLDS_FLAT_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_056: [ clds_flat_hash_table_delete shall delete the item with the key key from the table and return CLDS_FLAT_HASH_TABLE_DELETE_OK. ]*/
+        result = internal_delete(clds_flat_hash_table, clds_hazard_pointers_thread, key, NULL, NULL, sequence_number);
+    }
+
+    return result;
+}
+
+CLDS_FLAT_HASH_TABLE_DELETE_RESULT clds_flat_hash_table_delete_key_value(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_FLAT_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_062: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_delete_key_value shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_flat_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_063: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_delete_key_value shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_064: [ If key is NULL, clds_flat_hash_table_delete_key_value shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_065: [ If value is NULL, clds_flat_hash_table_delete_key_value shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+        (value == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_flat_hash_table_create, clds_flat_hash_table_delete_key_value shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_flat_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_FLAT_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_flat_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
+        result = CLDS_FLAT_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_061: [ clds_flat_hash_table_delete_key_value shall delete the item with the key key from the table only if the item is value and return CLDS_FLAT_HASH_TABLE_DELETE_OK. ]*/
+        result = internal_delete(clds_flat_hash_table, clds_hazard_pointers_thread, key, value, NULL, sequence_number);
+    }
+
+    return result;
+}
+
+CLDS_FLAT_HASH_TABLE_REMOVE_RESULT clds_flat_hash_table_remove(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_FLAT_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_FLAT_HASH_TABLE_REMOVE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_070: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_remove shall fail and return CLDS_FLAT_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_flat_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_071: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_remove shall fail and return CLDS_FLAT_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_072: [ If key is NULL, clds_flat_hash_table_remove shall fail and return CLDS_FLAT_HASH_TABLE_REMOVE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_073: [ If item is NULL, clds_flat_hash_table_remove shall fail and return CLDS_FLAT_HASH_TABLE_REMOVE_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_074: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_flat_hash_table_create, clds_flat_hash_table_remove shall fail and return CLDS_FLAT_HASH_TABLE_REMOVE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_flat_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_FLAT_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_flat_hash_table, clds_hazard_pointers_thread, key, item, sequence_number);
+        result = CLDS_FLAT_HASH_TABLE_REMOVE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_068: [ clds_flat_hash_table_remove shall take the item with the key key out of the table and return CLDS_FLAT_HASH_TABLE_REMOVE_OK. ]*/
+        switch (internal_delete(clds_flat_hash_table, clds_hazard_pointers_thread, key, NULL, item, sequence_number))
+        {
+        default:
+        case CLDS_FLAT_HASH_TABLE_DELETE_ERROR:
+            result = CLDS_FLAT_HASH_TABLE_REMOVE_ERROR;
+            break;
+        case CLDS_FLAT_HASH_TABLE_DELETE_NOT_FOUND:
+            result = CLDS_FLAT_HASH_TABLE_REMOVE_NOT_FOUND;
+            break;
+        case CLDS_FLAT_HASH_TABLE_DELETE_OK:
+            result = CLDS_FLAT_HASH_TABLE_REMOVE_OK;
+            break;
+        }
+    }
+
+    return result;
+}
+
+CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT clds_flat_hash_table_set_value(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const void* key, CLDS_FLAT_HASH_TABLE_ITEM* new_item, CLDS_FLAT_HASH_TABLE_ITEM** old_item, int64_t* sequence_number)
+{
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_076: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (clds_flat_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_077: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_078: [ If key is NULL, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_079: [ If new_item is NULL, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (new_item == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_080: [ If old_item is NULL, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (old_item == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_081: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_flat_hash_table_create, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_flat_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, const void* key=%p, CLDS_FLAT_HASH_TABLE_ITEM* new_item=%p, CLDS_FLAT_HASH_TABLE_ITEM** old_item=%p, int64_t* sequence_number=%p",
+            clds_flat_hash_table, clds_hazard_pointers_thread, key, new_item, old_item, sequence_number);
+        result = CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR;
+    }
+    else
+    {
+        bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_flat_hash_table));
+
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_082: [ clds_flat_hash_table_set_value shall hash the key by calling the compute_hash function passed to clds_flat_hash_table_create and store the key and its hash in new_item. ]*/
+        new_item->key = (void*)key;
+        new_item->hash = clds_flat_hash_table->compute_hash((void*)key);
+
+        do
+        {
+            SLOT_LOOKUP slot_lookup;
+            GROUP_ARRAY* group_array;
+            bool rebuild_needed = false;
+            int64_t operation_sequence_number;
+
+            restart_needed = false;
+
+            WRITE_GATE_SHARD* write_gate_shard = begin_write_operation(clds_flat_hash_table);
+
+            group_array = get_group_array(clds_flat_hash_table);
+            switch (lookup_key(clds_flat_hash_table, clds_hazard_pointers_thread, group_array, new_item->hash, (void*)key, &slot_lookup))
+            {
+            default:
+            case LOOKUP_ERROR:
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_086: [ If any error occurs, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                result = CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR;
+                break;
+
+            case LOOKUP_RESTART:
+                restart_needed = true;
+                break;
+
+            case LOOKUP_FOUND:
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_055: [ If a start sequence number was given to clds_flat_hash_table_create, the sequence number shall be incremented right before the compare exchange publishing the change and on success stored in sequence_number if sequence_number is not NULL. ]*/
+                operation_sequence_number = take_sequence_number(clds_flat_hash_table);
+
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_083: [ If the key is in the table, clds_flat_hash_table_set_value shall replace the item in its slot with new_item with a compare exchange, return the replaced item in old_item with its reference count incremented and release the reference held by the table on the replaced item by calling clds_hazard_pointers_reclaim. ]*/
+                if (InterlockedCompareExchangePointer((volatile PVOID*)&slot_lookup.group->slots[slot_lookup.slot_index], new_item, slot_lookup.item) != slot_lookup.item)
+                {
+                    skip_sequence_number(clds_flat_hash_table, operation_sequence_number);
+
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_053: [ If the slot changed before the item could be taken out, the key shall be looked up again. ]*/
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, slot_lookup.item_hp);
+                    restart_needed = true;
+                }
+                else
+                {
+                    report_sequence_number(clds_flat_hash_table, operation_sequence_number, sequence_number);
+
+                    (void)InterlockedIncrement(&slot_lookup.item->ref_count);
+                    *old_item = slot_lookup.item;
+
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, slot_lookup.item_hp);
+                    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, slot_lookup.item, reclaim_flat_hash_table_node);
+
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_075: [ On success clds_flat_hash_table_set_value shall return CLDS_FLAT_HASH_TABLE_SET_VALUE_OK. ]*/
+                    result = CLDS_FLAT_HASH_TABLE_SET_VALUE_OK;
+                }
+                break;
+
+            case LOOKUP_FULL:
+                rebuild_needed = true;
+                break;
+
+            case LOOKUP_NOT_FOUND:
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_084: [ If the key is not in the table, clds_flat_hash_table_set_value shall put new_item in the table the same way clds_flat_hash_table_insert does and set old_item to NULL. ]*/
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_055: [ If a start sequence number was given to clds_flat_hash_table_create, the sequence number shall be incremented right before the compare exchange publishing the change and on success stored in sequence_number if sequence_number is not NULL. ]*/
+                operation_sequence_number = take_sequence_number(clds_flat_hash_table);
+
+                switch (claim_empty_slot(group_array, &slot_lookup, new_item))
+                {
+                default:
+                case CLAIM_REBUILD_NEEDED:
+                    skip_sequence_number(clds_flat_hash_table, operation_sequence_number);
+                    rebuild_needed = true;
+                    break;
+
+                case CLAIM_SLOT_TAKEN:
+                    skip_sequence_number(clds_flat_hash_table, operation_sequence_number);
+                    restart_needed = true;
+                    break;
+
+                case CLAIM_OK:
+                    report_sequence_number(clds_flat_hash_table, operation_sequence_number, sequence_number);
+
+                    *old_item = NULL;
+
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_075: [ On success clds_flat_hash_table_set_value shall return CLDS_FLAT_HASH_TABLE_SET_VALUE_OK. ]*/
+                    result = CLDS_FLAT_HASH_TABLE_SET_VALUE_OK;
+                    break;
+                }
+                break;
+            }
+
+            end_write_operation(clds_flat_hash_table, write_gate_shard);
+
+            if (rebuild_needed)
+            {
+                if (rebuild_group_array(clds_flat_hash_table, clds_hazard_pointers_thread, group_array) != 0)
+                {
+                    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_086: [ If any error occurs, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                    LogError("Cannot rebuild the groups");
+                    result = CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR;
+                }
+                else
+                {
+                    restart_needed = true;
+                }
+            }
+            else if (restart_needed)
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_019: [ Before retrying because of a concurrent change, the flat hash table operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the table. ]*/
+                clds_backoff_retry(&backoff);
+            }
+        } while (restart_needed);
+    }
+
+    return result;
+}
+
+CLDS_FLAT_HASH_TABLE_ITEM* clds_flat_hash_table_find(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    CLDS_FLAT_HASH_TABLE_ITEM* result;
+
+    if (
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_088: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_find shall fail and return NULL. ]*/
+        (clds_flat_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_089: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_find shall fail and return NULL. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_090: [ If key is NULL, clds_flat_hash_table_find shall fail and return NULL. ]*/
+        (key == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
+            clds_flat_hash_table, clds_hazard_pointers_thread, key);
+        result = NULL;
+    }
+    else
+    {
+        bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_flat_hash_table));
+
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_092: [ clds_flat_hash_table_find shall hash the key by calling the compute_hash function passed to clds_flat_hash_table_create. ]*/
+        uint64_t hash = clds_flat_hash_table->compute_hash(key);
+
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_093: [ clds_flat_hash_table_find shall not wait for write operations or for the groups to be rebuilt. ]*/
+        do
+        {
+            GROUP_ARRAY* group_array = get_group_array(clds_flat_hash_table);
+
+            /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_094: [ clds_flat_hash_table_find shall protect the array of groups it looks at by calling clds_hazard_pointers_acquire, since the groups can be rebuilt while it looks at them. ]*/
+            CLDS_HAZARD_POINTER_RECORD_HANDLE group_array_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, group_array);
+            restart_needed = false;
+
+            if (group_array_hp == NULL)
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_025: [ If acquiring a hazard pointer fails, the operation shall fail and return its ERROR result, or NULL for clds_flat_hash_table_find. ]*/
+                LogError("Cannot acquire hazard pointer");
+                result = NULL;
+            }
+            else
+            {
+                if (get_group_array(clds_flat_hash_table) != group_array)
+                {
+                    // the groups were rebuilt, the array might have been reclaimed before the hazard pointer was set, restart
+                    restart_needed = true;
+                }
+                else
+                {
+                    SLOT_LOOKUP slot_lookup;
+
+                    switch (lookup_key(clds_flat_hash_table, clds_hazard_pointers_thread, group_array, hash, key, &slot_lookup))
+                    {
+                    default:
+                    case LOOKUP_ERROR:
+                        result = NULL;
+                        break;
+
+                    case LOOKUP_RESTART:
+                        restart_needed = true;
+                        break;
+
+                    case LOOKUP_NOT_FOUND:
+                    case LOOKUP_FULL:
+                        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_091: [ If the key is not found, clds_flat_hash_table_find shall return NULL. ]*/
+                        result = NULL;
+                        break;
+
+                    case LOOKUP_FOUND:
+                        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_087: [ clds_flat_hash_table_find shall return the item with the key key with its reference count incremented. ]*/
+                        (void)InterlockedIncrement(&slot_lookup.item->ref_count);
+                        result = slot_lookup.item;
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, slot_lookup.item_hp);
+                        break;
+                    }
+                }
+
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, group_array_hp);
+            }
+
+            if (restart_needed)
+            {
+                /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_019: [ Before retrying because of a concurrent change, the flat hash table operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the table. ]*/
+                clds_backoff_retry(&backoff);
+            }
+        } while (restart_needed);
+    }
+
+    return result;
+}
+
+CLDS_FLAT_HASH_TABLE_ITEM* clds_flat_hash_table_node_create(size_t node_size, FLAT_HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context)
+{
+    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_097: [ item_cleanup_callback shall be allowed to be NULL. ]*/
+    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_098: [ item_cleanup_callback_context shall be allowed to be NULL. ]*/
+
+    /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_099: [ clds_flat_hash_table_node_create shall allocate node_size bytes for the node and set its reference count to 1. ]*/
+    CLDS_FLAT_HASH_TABLE_ITEM* result = (CLDS_FLAT_HASH_TABLE_ITEM*)malloc(node_size);
+    if (result == NULL)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_100: [ If allocating memory fails, clds_flat_hash_table_node_create shall fail and return NULL. ]*/
+        LogError("malloc failed");
+    }
+    else
+    {
+        result->item_cleanup_callback = item_cleanup_callback;
+        result->item_cleanup_callback_context = item_cleanup_callback_context;
+        result->key = NULL;
+        result->hash = 0;
+        (void)InterlockedExchange(&result->ref_count, 1);
+    }
+
+    return result;
+}
+
+int clds_flat_hash_table_node_inc_ref(CLDS_FLAT_HASH_TABLE_ITEM* item)
+{
+    int result;
+
+    if (item == NULL)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_102: [ If item is NULL, clds_flat_hash_table_node_inc_ref shall fail and return a non-zero value. ]*/
+        LogError("Invalid arguments: CLDS_FLAT_HASH_TABLE_ITEM* item=%p", item);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_101: [ clds_flat_hash_table_node_inc_ref shall increment the reference count of item and return 0. ]*/
+        (void)InterlockedIncrement(&item->ref_count);
+        result = 0;
+    }
+
+    return result;
+}
+
+void clds_flat_hash_table_node_release(CLDS_FLAT_HASH_TABLE_ITEM* item)
+{
+    if (item == NULL)
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_103: [ If item is NULL, clds_flat_hash_table_node_release shall return. ]*/
+        LogError("Invalid arguments: CLDS_FLAT_HASH_TABLE_ITEM* item=%p", item);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_FLAT_HASH_TABLE_01_104: [ clds_flat_hash_table_node_release shall decrement the reference count of item. ]*/
+        internal_node_destroy(item);
+    }
+}
@@ -5,9 +5,11 @@
 #include <stdbool.h>
 #include "windows.h"
 #include "azure_c_util/gballoc.h"
+#include "azure_c_util/threadapi.h"
 #include "azure_c_logging/xlogging.h"
 #include "clds/clds_hash_table.h"
 #include "clds/clds_atomics.h"
+#include "clds/clds_backoff.h"
 #include "clds/clds_sorted_list.h"
 #include "clds/clds_hazard_pointers.h"
 
@@ -18,6 +20,25 @@ MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RES
 MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT_VALUES);
 MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESULT_VALUES);
 MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_CHANGE_TYPE, CLDS_HASH_TABLE_CHANGE_TYPE_VALUES);
+
+// the count of pending write operations is split in per processor shards, so that writers on different processors do not contend on one cache line
+#define WRITE_GATE_SHARD_COUNT 16
+#define WRITE_GATE_CACHE_LINE_SIZE 64
+
+// sequence numbers of an item for clds_hash_table_snapshot_at_current_sequence_number: an item put in the table while no such snapshot was capturing
+// counts as put in the table before any snapshot sequence number, and an item that was not taken out counts as taken out after it
+#define SEQUENCE_NUMBER_NOT_STAMPED INT64_MIN
+#define SEQUENCE_NUMBER_NOT_REMOVED INT64_MAX
+
+// after this many restarts because items were moved between arrays of buckets, a lookup is done while holding the migration lock
+#define MAX_LOOKUP_MIGRATION_RESTARTS 4
+
+typedef struct WRITE_GATE_SHARD_TAG
+{
+    volatile LONG pending_write_operations;
+    uint8_t padding[WRITE_GATE_CACHE_LINE_SIZE - sizeof(LONG)];
+} WRITE_GATE_SHARD;
 
 typedef struct BUCKET_ARRAY_TAG
 {
@@ -25,9 +46,29 @@ typedef struct BUCKET_ARRAY_TAG
     volatile LONG bucket_count;
     volatile LONG item_count;
     volatile LONG pending_insert_count;
+    volatile LONG pending_insert_waiter_count;
+
+    // Support for migrating the items of the array to the top level array
+    volatile LONG pending_write_count;
+    volatile LONG pending_write_waiter_count;
+    volatile LONG migrating;
+    volatile LONG migrating_waiter_count;
+    volatile LONG retired;
+    volatile LONG migration_bucket_index;
+
+    // Bloom filter of the hashes of the keys inserted in the array, allocated after the buckets
+    LONG bloom_filter_word_count;
+    volatile LONG* bloom_filter;
     CLDS_SORTED_LIST_HANDLE hash_table[];
 } BUCKET_ARRAY;
 
+// a change kept in the change log, the log is a stack of records with the most recent record on top
+typedef struct CHANGE_LOG_RECORD_TAG
+{
+    struct CHANGE_LOG_RECORD_TAG* volatile next;
+    CLDS_HASH_TABLE_CHANGE change;
+} CHANGE_LOG_RECORD;
+
 typedef struct CLDS_HASH_TABLE_TAG
 {
     COMPUTE_HASH_FUNC compute_hash;
@@ -37,10 +78,45 @@ typedef struct CLDS_HASH_TABLE_TAG
     volatile LONG64* sequence_number;
     HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb;
     void* skipped_seq_no_cb_context;
+    volatile LONG sequence_number_block_size;
+    // per thread blocks of sequence numbers shared by all the bucket lists, owned by the table
+    volatile CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks;
+    volatile LONG backoff_policy;
+
+    // Support for migrating items out of the older bucket arrays
+    volatile LONG migration_batch_size;
+    volatile LONG migration_in_progress;
+    volatile LONG migration_sequence;
+
+    // Support for shrinking the hash table
+    LONG initial_bucket_count;
+    volatile LONG shrink_load_factor;
+
+    // Support for Bloom filters on the bucket arrays
+    volatile LONG bloom_filter_bits_per_bucket;
+
+    // Support for snapshots that do not block the writers
+    volatile LONG64 write_generation;
+    volatile LONG64 snapshot_generation;
+    volatile LONG snapshot_in_progress;
+    volatile LONG snapshot_failed;
+    CLDS_HASH_TABLE_ITEM* volatile captured_items;
+
+    // Support for snapshots at a given sequence number
+    volatile LONG snapshot_at_capturing;
+    volatile LONG64 snapshot_at_id;
+    volatile LONG64 snapshot_at_sequence_number;
+
+    // Support for the change log used by clds_hash_table_snapshot_since
+    volatile LONG change_log_enabled;
+    volatile LONG change_log_in_use;
+    volatile LONG64 change_log_start_sequence_number;
+    CHANGE_LOG_RECORD* volatile change_log;
 
     // Support for locking the list for writes
     volatile LONG locked_for_write;
-    volatile LONG pending_write_operations;
+    volatile LONG write_waiter_count;
+    WRITE_GATE_SHARD pending_write_operations[WRITE_GATE_SHARD_COUNT];
 } CLDS_HASH_TABLE;
 
 typedef struct FIND_BY_KEY_VALUE_CONTEXT_TAG
@@ -50,66 +126,230 @@ typedef struct FIND_BY_KEY_VALUE_CONTEXT_TAG
     KEY_COMPARE_FUNC key_compare_func;
 } FIND_BY_KEY_VALUE_CONTEXT;
 
-static void check_lock_and_begin_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+typedef struct BUCKET_ARRAY_CURSOR_TAG
+{
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    bool protect;
+    BUCKET_ARRAY* bucket_array;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE bucket_array_hp;
+} BUCKET_ARRAY_CURSOR;
+
+typedef struct LOOKUP_RESTARTS_TAG
+{
+    uint32_t count;
+    bool holds_migration_lock;
+} LOOKUP_RESTARTS;
+
+#define KEY_LOOKUP_RESULT_VALUES \
+    KEY_LOOKUP_NOT_FOUND, \
+    KEY_LOOKUP_DONE, \
+    KEY_LOOKUP_ERROR
+
+MU_DEFINE_ENUM(KEY_LOOKUP_RESULT, KEY_LOOKUP_RESULT_VALUES);
+
+// does the work of an operation on the bucket list of the key in one array of buckets
+// returns KEY_LOOKUP_NOT_FOUND to have the key looked up in the next array of buckets and KEY_LOOKUP_DONE when the operation is over
+typedef KEY_LOOKUP_RESULT(*ON_KEY_BUCKET_LIST)(void* context, BUCKET_ARRAY* bucket_array, CLDS_SORTED_LIST_HANDLE bucket_list);
+
+// puts the item of clds_hash_table_insert or clds_hash_table_set_value in the top level array of buckets, called with the writes to it begun
+typedef void(*PUT_IN_TOP_LEVEL)(void* context, BUCKET_ARRAY* top_level_bucket_array);
+
+typedef struct FIND_CONTEXT_TAG
+{
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    void* lookup_key;
+    CLDS_SORTED_LIST_ITEM* item;
+} FIND_CONTEXT;
+
+typedef struct INSERT_CONTEXT_TAG
+{
+    CLDS_HASH_TABLE* clds_hash_table;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    uint64_t hash;
+    void* key;
+    void* lookup_key;
+    CLDS_HASH_TABLE_ITEM* value;
+    bool value_was_captured;
+    int64_t* sequence_number;
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+} INSERT_CONTEXT;
+
+typedef struct DELETE_CONTEXT_TAG
+{
+    CLDS_HASH_TABLE* clds_hash_table;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    bool migration_enabled;
+    // the key for clds_hash_table_delete, the item for clds_hash_table_delete_key_value
+    void* lookup_key;
+    CLDS_SORTED_LIST_ITEM* item;
+    int64_t* sequence_number;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+} DELETE_CONTEXT;
+
+typedef struct REMOVE_CONTEXT_TAG
+{
+    CLDS_HASH_TABLE* clds_hash_table;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    bool migration_enabled;
+    void* lookup_key;
+    CLDS_HASH_TABLE_ITEM** item;
+    int64_t* sequence_number;
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+} REMOVE_CONTEXT;
+
+typedef struct SET_VALUE_CONTEXT_TAG
+{
+    CLDS_HASH_TABLE* clds_hash_table;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    bool migration_enabled;
+    uint64_t hash;
+    void* key;
+    void* lookup_key;
+    CLDS_HASH_TABLE_ITEM* new_item;
+    CLDS_HASH_TABLE_ITEM** old_item;
+    int64_t* sequence_number;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+} SET_VALUE_CONTEXT;
+
+// the bookkeeping of the snapshots is kept out of the items and only allocated for the items a running snapshot has to keep track of
+// an item without it was put in the table before the running snapshot started, was not captured yet and has no sequence numbers recorded
+typedef struct HASH_TABLE_ITEM_SNAPSHOT_STATE_TAG
+{
+    // used by clds_hash_table_snapshot_concurrent
+    volatile LONG64 write_generation;
+    volatile LONG64 captured_generation;
+    CLDS_HASH_TABLE_ITEM* volatile next_captured;
+    // used by clds_hash_table_snapshot_at_current_sequence_number
+    volatile LONG64 insert_sequence_number;
+    volatile LONG64 remove_sequence_number;
+} HASH_TABLE_ITEM_SNAPSHOT_STATE;
+
+typedef struct SNAPSHOT_AT_ITEM_SEQUENCE_NUMBERS_TAG
+{
+    int64_t insert_sequence_number;
+    int64_t remove_sequence_number;
+} SNAPSHOT_AT_ITEM_SEQUENCE_NUMBERS;
+
+static WRITE_GATE_SHARD* check_lock_and_begin_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table)
 {
-    ULONG locked_for_write;
+    /* Codes_SRS_CLDS_HASH_TABLE_01_156: [ The count of pending write operations shall be split in per processor counters that do not share a cache line, and each write operation shall increment and decrement the counter picked by the processor it started on. ]*/
+    WRITE_GATE_SHARD* shard = &clds_hash_table->pending_write_operations[GetCurrentProcessorNumber() % WRITE_GATE_SHARD_COUNT];
+    LONG locked_for_write;
     do
     {
-        (void)InterlockedIncrement(&clds_hash_table->pending_write_operations);
+        (void)InterlockedIncrement(&shard->pending_write_operations);
         locked_for_write = InterlockedAdd(&clds_hash_table->locked_for_write, 0);
         if (locked_for_write != 0)
         {
-            (void)InterlockedDecrement(&clds_hash_table->pending_write_operations);
-            WakeByAddressAll((void*)&clds_hash_table->pending_write_operations);
+            (void)InterlockedDecrement(&shard->pending_write_operations);
 
-            // Wait for unlock
+            /* Codes_SRS_CLDS_HASH_TABLE_01_157: [ Write operations shall call clds_backoff_wake_all for the count of pending write operations only if the counter to lock the table for writes is non-zero. ]*/
+            clds_backoff_wake_all(&shard->pending_write_operations);
+
+            // Wait for unlock, counted so that the unlock only wakes when somebody waits
+            (void)InterlockedIncrement(&clds_hash_table->write_waiter_count);
             (void)WaitOnAddress(&clds_hash_table->locked_for_write, &locked_for_write, sizeof(locked_for_write), INFINITE);
+            (void)InterlockedDecrement(&clds_hash_table->write_waiter_count);
         }
     } while (locked_for_write != 0);
+
+    return shard;
 }
 
-static void end_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+static void end_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table, WRITE_GATE_SHARD* shard)
 {
-    (void)InterlockedDecrement(&clds_hash_table->pending_write_operations);
-    WakeByAddressAll((void*)&clds_hash_table->pending_write_operations);
+    (void)InterlockedDecrement(&shard->pending_write_operations);
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_157: [ Write operations shall call clds_backoff_wake_all for the count of pending write operations only if the counter to lock the table for writes is non-zero. ]*/
+    if (InterlockedAdd(&clds_hash_table->locked_for_write, 0) != 0)
+    {
+        clds_backoff_wake_all(&shard->pending_write_operations);
+    }
 }
 
 static void internal_lock_writes(CLDS_HASH_TABLE_HANDLE clds_hash_table)
 {
+    uint32_t i;
+
     /*Codes_SRS_CLDS_HASH_TABLE_42_017: [ clds_hash_table_snapshot shall increment a counter to lock the table for writes. ]*/
     (void)InterlockedIncrement(&clds_hash_table->locked_for_write);
 
     /*Codes_SRS_CLDS_HASH_TABLE_42_018: [ clds_hash_table_snapshot shall wait for the ongoing write operations to complete. ]*/
-    ULONG pending_writes;
-    do
+    for (i = 0; i < WRITE_GATE_SHARD_COUNT; i++)
     {
-        pending_writes = InterlockedAdd(&clds_hash_table->pending_write_operations, 0);
-        if (pending_writes != 0)
+        LONG pending_writes;
+        do
         {
-            // Wait for writes
-            (void)WaitOnAddress(&clds_hash_table->pending_write_operations, &pending_writes, sizeof(pending_writes), INFINITE);
-        }
-    } while (pending_writes != 0);
+            pending_writes = InterlockedAdd(&clds_hash_table->pending_write_operations[i].pending_write_operations, 0);
+            if (pending_writes != 0)
+            {
+                // Wait for writes
+                (void)WaitOnAddress(&clds_hash_table->pending_write_operations[i].pending_write_operations, &pending_writes, sizeof(pending_writes), INFINITE);
+            }
+        } while (pending_writes != 0);
+    }
 }
 
 static void internal_unlock_writes(CLDS_HASH_TABLE_HANDLE clds_hash_table)
 {
     /*Codes_SRS_CLDS_HASH_TABLE_42_030: [ clds_hash_table_snapshot shall decrement the counter to unlock the table for writes. ]*/
     (void)InterlockedDecrement(&clds_hash_table->locked_for_write);
-    WakeByAddressAll((void*)&clds_hash_table->locked_for_write);
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_158: [ clds_hash_table_snapshot shall call clds_backoff_wake_all for the counter to lock the table for writes only if there are write operations waiting for the table to be unlocked. ]*/
+    if (InterlockedAdd(&clds_hash_table->write_waiter_count, 0) != 0)
+    {
+        clds_backoff_wake_all(&clds_hash_table->locked_for_write);
+    }
 }
 
+// the bucket lists are keyed by the nodes themselves: the hash of an item is the key fingerprint that its bucket list caches in the node,
+// so the nodes are ordered by hash first and key_compare_func is only called for equal hashes
+// a key that is looked up is passed to the bucket lists as a node that is not in any list, see init_lookup_item
 static void* get_item_key_cb(void* context, CLDS_SORTED_LIST_ITEM* item)
 {
-    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
     (void)context;
-    return hash_table_item->key;
+    return item;
 }
 
 static int key_compare_cb(void* context, void* key1, void* key2)
 {
     CLDS_HASH_TABLE_HANDLE clds_hash_table = (CLDS_HASH_TABLE_HANDLE)context;
-    return clds_hash_table->key_compare_func(key1, key2);
+    CLDS_SORTED_LIST_ITEM* item_1 = (CLDS_SORTED_LIST_ITEM*)key1;
+    CLDS_SORTED_LIST_ITEM* item_2 = (CLDS_SORTED_LIST_ITEM*)key2;
+    int result;
+
+    if (item_1->key_fingerprint != item_2->key_fingerprint)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_256: [ If the hashes of the keys compared by the bucket lists differ, the keys shall be ordered by their hash without calling key_compare_func. ]*/
+        result = (item_1->key_fingerprint < item_2->key_fingerprint) ? -1 : 1;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_257: [ If the hashes of the keys compared by the bucket lists are equal, the keys shall be ordered by calling key_compare_func. ]*/
+        result = clds_hash_table->key_compare_func(CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item_1)->key, CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item_2)->key);
+    }
+
+    return result;
+}
+
+static uint64_t get_key_fingerprint_cb(void* context, void* key)
+{
+    (void)context;
+    return ((CLDS_SORTED_LIST_ITEM*)key)->key_fingerprint;
+}
+
+// the bucket lists compute the fingerprint of an item when it is linked, which reads back the hash set here
+static void set_item_key(CLDS_HASH_TABLE_ITEM* item, uint64_t hash, void* key)
+{
+    item->item.key_fingerprint = hash;
+    item->record.key = key;
+}
+
+// wraps a key that is looked up in a node, which is only used as the key passed to the bucket lists
+static void* init_lookup_item(CLDS_HASH_TABLE_ITEM* lookup_item, uint64_t hash, void* key)
+{
+    set_item_key(lookup_item, hash, key);
+    return lookup_item;
 }
 
 static void on_sorted_list_skipped_seq_no(void* context, int64_t skipped_sequence_no)
@@ -128,1178 +368,3775 @@ static void on_sorted_list_skipped_seq_no(void* context, int64_t skipped_sequenc
     }
 }
 
-static BUCKET_ARRAY* get_first_bucket_array(CLDS_HASH_TABLE* clds_hash_table)
+static CLDS_SORTED_LIST_HANDLE create_bucket_list(CLDS_HASH_TABLE* clds_hash_table)
 {
-    // always insert in the first bucket array
-    BUCKET_ARRAY* first_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
-    LONG bucket_count = InterlockedAdd(&first_bucket_array->bucket_count, 0);
-    while (InterlockedAdd(&first_bucket_array->item_count, 0) >= bucket_count)
+    /* Codes_SRS_CLDS_HASH_TABLE_01_071: [ When a new list is created, the start sequence number passed to clds_hash_tabel_create shall be passed as the start_sequence_number argument. ]*/
+    CLDS_SORTED_LIST_HANDLE result = clds_sorted_list_create(clds_hash_table->clds_hazard_pointers, get_item_key_cb, clds_hash_table, key_compare_cb, clds_hash_table, clds_hash_table->sequence_number, clds_hash_table->sequence_number == NULL ? NULL : on_sorted_list_skipped_seq_no, clds_hash_table);
+    if (result != NULL)
     {
-        // allocate a new bucket array
-        BUCKET_ARRAY* new_bucket_array = (BUCKET_ARRAY*)malloc(sizeof(BUCKET_ARRAY) + (sizeof(CLDS_SORTED_LIST_HANDLE) * bucket_count * 2));
-        if (new_bucket_array == NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_01_258: [ When a new list is created, the hash of the keys shall be set as the key fingerprint of the list by calling clds_sorted_list_set_key_fingerprint_cb with SORTED_LIST_KEY_FINGERPRINT_ORDER_REMOVE_FIRST_BY_FINGERPRINT, so that the list skips the nodes with a different hash without reading their keys and the migration can empty the list with clds_sorted_list_remove_first. ]*/
+        if (clds_sorted_list_set_key_fingerprint_cb(result, get_key_fingerprint_cb, NULL, SORTED_LIST_KEY_FINGERPRINT_ORDER_REMOVE_FIRST_BY_FINGERPRINT) != 0)
         {
-            // cannot allocate new bucket, will stick to what we have, but do not fail
-            break;
+            LogError("Cannot set the key fingerprint callback on bucket list");
+            clds_sorted_list_destroy(result);
+            result = NULL;
         }
-        else
-        {
-            // insert new bucket
-            /* Codes_SRS_CLDS_HASH_TABLE_01_030: [ If the number of items in the list reaches the number of buckets, the number of buckets shall be doubled. ]*/
-            bucket_count = bucket_count * 2;
-            (void)InterlockedExchange(&new_bucket_array->bucket_count, bucket_count);
-            (void)InterlockedExchange(&new_bucket_array->item_count, 0);
-            (void)InterlockedExchange(&new_bucket_array->pending_insert_count, 0);
+    }
 
-            // initialize buckets
-            (void)memset(new_bucket_array->hash_table, 0, sizeof(CLDS_SORTED_LIST_HANDLE) * bucket_count);
+    if (result != NULL)
+    {
+        uint32_t block_size = (uint32_t)InterlockedAdd(&clds_hash_table->sequence_number_block_size, 0);
+        if (block_size != 0)
+        {
+            // the blocks are always set before the block size, so they are never NULL here
+            CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks = (CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE)InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->sequence_number_blocks, NULL, NULL);
 
-            (void)InterlockedExchangePointer((volatile PVOID*)&new_bucket_array->next_bucket, first_bucket_array);
-            if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, new_bucket_array, first_bucket_array) == first_bucket_array)
+            /* Codes_SRS_CLDS_HASH_TABLE_01_116: [ When a new list is created and the sequence number block size is non-zero, the sequence number blocks of the table and the block size shall be passed to the list by calling clds_sorted_list_set_sequence_number_blocks. ]*/
+            if (clds_sorted_list_set_sequence_number_blocks(result, sequence_number_blocks, block_size) != 0)
             {
-                first_bucket_array = new_bucket_array;
-                break;
+                LogError("Cannot set sequence number block size %" PRIu32 " on bucket list", block_size);
+                clds_sorted_list_destroy(result);
+                result = NULL;
             }
-            else
-            {
-                // first bucket array changed, drop ours and use the one that was inserted
-                free(new_bucket_array);
+        }
 
-                first_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
-                bucket_count = InterlockedAdd(&first_bucket_array->bucket_count, 0);
+        if (result != NULL)
+        {
+            CLDS_BACKOFF_POLICY backoff_policy = (CLDS_BACKOFF_POLICY)InterlockedAdd(&clds_hash_table->backoff_policy, 0);
+            if (backoff_policy != CLDS_BACKOFF_POLICY_NONE)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_122: [ When a new list is created and the backoff policy is not CLDS_BACKOFF_POLICY_NONE, the backoff policy shall be passed to the list by calling clds_sorted_list_set_backoff_policy. ]*/
+                if (clds_sorted_list_set_backoff_policy(result, backoff_policy) != 0)
+                {
+                    LogError("Cannot set backoff policy %" PRI_MU_ENUM " on bucket list", MU_ENUM_VALUE(CLDS_BACKOFF_POLICY, backoff_policy));
+                    clds_sorted_list_destroy(result);
+                    result = NULL;
+                }
             }
         }
     }
 
-    return first_bucket_array;
+    return result;
 }
 
-CLDS_HASH_TABLE_HANDLE clds_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
+// backoff policy used when waiting for other threads (as opposed to retrying a CAS)
+static CLDS_BACKOFF_POLICY get_wait_backoff_policy(CLDS_HASH_TABLE* clds_hash_table)
 {
-    CLDS_HASH_TABLE_HANDLE clds_hash_table;
-
-    /* Codes_SRS_CLDS_HASH_TABLE_01_058: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
-    /* Codes_S_R_S_CLDS_HASH_TABLE_01_072: [ skipped_seq_no_cb shall be allowed to be NULL. ]*/
-    /* Codes_S_R_S_CLDS_HASH_TABLE_01_073: [ skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+    CLDS_BACKOFF_POLICY result = (CLDS_BACKOFF_POLICY)InterlockedAdd(&clds_hash_table->backoff_policy, 0);
 
-    if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_003: [ If compute_hash is NULL, clds_hash_table_create shall fail and return NULL. ]*/
-        (compute_hash == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_045: [ If key_compare_func is NULL, clds_hash_table_create shall fail and return NULL. ]*/
-        (key_compare_func == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_004: [ If initial_bucket_size is 0, clds_hash_table_create shall fail and return NULL. ]*/
-        (initial_bucket_size == 0) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_005: [ If clds_hazard_pointers is NULL, clds_hash_table_create shall fail and return NULL. ]*/
-        (clds_hazard_pointers == NULL) ||
-        /* Codes_S_R_S_CLDS_HASH_TABLE_01_074: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_sorted_list_create shall fail and return NULL. ]*/
-        ((start_sequence_number == NULL) && (skipped_seq_no_cb != NULL))
-        )
+    // waiting for a preempted thread has no bound, so it never spins without giving up the CPU
+    if (result == CLDS_BACKOFF_POLICY_NONE)
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
-        LogError("Invalid arguments: COMPUTE_HASH_FUNC compute_hash=%p, KEY_COMPARE_FUNC key_compare_func=%p, size_t initial_bucket_size=%zu, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, volatile int64_t* start_sequence_number=%p, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb=%p, void* skipped_seq_no_cb_context=%p",
-            compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+        result = CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT;
     }
-    else
+
+    return result;
+}
+
+static void wait_for_pending_inserts(CLDS_HASH_TABLE* clds_hash_table, BUCKET_ARRAY* bucket_array)
+{
+    LONG pending_insert_count = InterlockedAdd(&bucket_array->pending_insert_count, 0);
+
+    if (pending_insert_count != 0)
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_01_001: [ clds_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
-        clds_hash_table = (CLDS_HASH_TABLE_HANDLE)malloc(sizeof(CLDS_HASH_TABLE));
-        if (clds_hash_table == NULL)
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_wait_backoff_policy(clds_hash_table));
+
+        // the waiter count is incremented before the pending insert count is looked at again, so that an inserter
+        // bringing the count to 0 either sees the waiter and wakes it or the waiter sees the count at 0
+        (void)InterlockedIncrement(&bucket_array->pending_insert_waiter_count);
+
+        // wait for all outstanding inserts in the lower levels to complete
+        while ((pending_insert_count = InterlockedAdd(&bucket_array->pending_insert_count, 0)) != 0)
         {
-            /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
-            LogError("Cannot allocate memory for hash table");
+            /* Codes_SRS_CLDS_HASH_TABLE_01_125: [ While waiting for the pending inserts in the lower level bucket arrays to complete, clds_hash_table_insert and clds_hash_table_set_value shall call clds_backoff_wait_while_equal with a backoff state initialized with the backoff policy of the hash table (CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT if the backoff policy is CLDS_BACKOFF_POLICY_NONE) and the pending insert count. ]*/
+            clds_backoff_wait_while_equal(&backoff, &bucket_array->pending_insert_count, pending_insert_count);
         }
-        else
-        {
-            /* Codes_SRS_CLDS_HASH_TABLE_01_027: [ The hash table shall maintain a list of arrays of buckets, so that it can be resized as needed. ]*/
-            clds_hash_table->first_hash_table = malloc(sizeof(BUCKET_ARRAY) + (sizeof(CLDS_SORTED_LIST_HANDLE) * initial_bucket_size));
-            if (clds_hash_table->first_hash_table == NULL)
-            {
-                LogError("Cannot allocate memory for hash table array");
-            }
-            else
-            {
-                size_t i;
 
-                // all OK
-                clds_hash_table->clds_hazard_pointers = clds_hazard_pointers;
-                clds_hash_table->compute_hash = compute_hash;
-                clds_hash_table->key_compare_func = key_compare_func;
-                clds_hash_table->skipped_seq_no_cb = skipped_seq_no_cb;
-                clds_hash_table->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
+        (void)InterlockedDecrement(&bucket_array->pending_insert_waiter_count);
+    }
+}
 
-                (void)InterlockedExchange(&clds_hash_table->pending_write_operations, 0);
-                (void)InterlockedExchange(&clds_hash_table->locked_for_write, 0);
+static void end_pending_insert(BUCKET_ARRAY* bucket_array)
+{
+    if ((InterlockedDecrement(&bucket_array->pending_insert_count) == 0) &&
+        (InterlockedAdd(&bucket_array->pending_insert_waiter_count, 0) != 0))
+    {
+        // waking is a system call, so it is only done when somebody waits
+        /* Codes_SRS_CLDS_HASH_TABLE_01_126: [ If the pending insert count reaches 0 and there are threads waiting for the pending inserts, clds_hash_table_insert and clds_hash_table_set_value shall call clds_backoff_wake_all for the pending insert count. ]*/
+        clds_backoff_wake_all(&bucket_array->pending_insert_count);
+    }
+}
 
-                /* Codes_SRS_CLDS_HASH_TABLE_01_057: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every operation that is done on the hash table. ]*/
-                clds_hash_table->sequence_number = start_sequence_number;
+static void init_bucket_array_cursor(BUCKET_ARRAY_CURSOR* cursor, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, bool protect)
+{
+    cursor->clds_hazard_pointers_thread = clds_hazard_pointers_thread;
+    cursor->protect = protect;
+    cursor->bucket_array = NULL;
+    cursor->bucket_array_hp = NULL;
+}
 
-                // set the initial bucket count
-                (void)InterlockedExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table->next_bucket, NULL);
-                (void)InterlockedExchange(&clds_hash_table->first_hash_table->bucket_count, (LONG)initial_bucket_size);
-                (void)InterlockedExchange(&clds_hash_table->first_hash_table->item_count, 0);
-                (void)InterlockedExchange(&clds_hash_table->first_hash_table->pending_insert_count, 0);
+// moves the cursor to the bucket array pointed to by link (the first bucket array or the next bucket of the current one)
+// bucket arrays are only reclaimed when migration is enabled, so only then they need to be protected by hazard pointers
+static int move_bucket_array_cursor(BUCKET_ARRAY_CURSOR* cursor, volatile PVOID* link)
+{
+    int result;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE previous_bucket_array_hp = cursor->bucket_array_hp;
+    BUCKET_ARRAY* bucket_array;
 
-                for (i = 0; i < initial_bucket_size; i++)
-                {
-                    (void)InterlockedExchangePointer(&clds_hash_table->first_hash_table->hash_table[i], NULL);
-                }
+    cursor->bucket_array_hp = NULL;
 
-                goto all_ok;
-            }
+    do
+    {
+        bucket_array = InterlockedCompareExchangePointer(link, NULL, NULL);
+        if ((!cursor->protect) || (bucket_array == NULL))
+        {
+            result = 0;
+            break;
+        }
 
-            free(clds_hash_table);
+        /* Codes_SRS_CLDS_HASH_TABLE_01_139: [ If the migration batch size is non-zero, the arrays of buckets shall be protected while they are looked at by calling clds_hazard_pointers_acquire and clds_hazard_pointers_release. ]*/
+        cursor->bucket_array_hp = clds_hazard_pointers_acquire(cursor->clds_hazard_pointers_thread, bucket_array);
+        if (cursor->bucket_array_hp == NULL)
+        {
+            LogError("Cannot acquire hazard pointer for bucket array");
+            bucket_array = NULL;
+            result = MU_FAILURE;
+            break;
+        }
+
+        if (InterlockedCompareExchangePointer(link, NULL, NULL) == bucket_array)
+        {
+            // the array was still linked after the hazard pointer was set, so it cannot be reclaimed under us
+            result = 0;
+            break;
         }
+
+        // the link changed, try again
+        clds_hazard_pointers_release(cursor->clds_hazard_pointers_thread, cursor->bucket_array_hp);
+        cursor->bucket_array_hp = NULL;
+    } while (1);
+
+    if (previous_bucket_array_hp != NULL)
+    {
+        clds_hazard_pointers_release(cursor->clds_hazard_pointers_thread, previous_bucket_array_hp);
     }
 
-    clds_hash_table = NULL;
+    cursor->bucket_array = bucket_array;
+    return result;
+}
 
-all_ok:
-    return clds_hash_table;
+static void release_bucket_array_cursor(BUCKET_ARRAY_CURSOR* cursor)
+{
+    if (cursor->bucket_array_hp != NULL)
+    {
+        clds_hazard_pointers_release(cursor->clds_hazard_pointers_thread, cursor->bucket_array_hp);
+        cursor->bucket_array_hp = NULL;
+    }
+
+    cursor->bucket_array = NULL;
 }
 
-static void sorted_list_item_cleanup(void* context, CLDS_SORTED_LIST_ITEM* item)
+static bool is_migration_enabled(CLDS_HASH_TABLE* clds_hash_table)
 {
-    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+    return (InterlockedAdd(&clds_hash_table->migration_batch_size, 0) != 0);
+}
 
-    (void)context;
-    if (hash_table_item->item_cleanup_callback != NULL)
+static LONG get_migration_sequence(CLDS_HASH_TABLE* clds_hash_table)
+{
+    return InterlockedAdd(&clds_hash_table->migration_sequence, 0);
+}
+
+// the migration sequence is odd while the items of a bucket are being moved between bucket arrays
+static bool items_were_moved_since(CLDS_HASH_TABLE* clds_hash_table, LONG migration_sequence)
+{
+    return ((migration_sequence & 1) != 0) ||
+        (InterlockedAdd(&clds_hash_table->migration_sequence, 0) != migration_sequence);
+}
+
+static void end_pending_write(BUCKET_ARRAY* bucket_array)
+{
+    if ((InterlockedDecrement(&bucket_array->pending_write_count) == 0) &&
+        (InterlockedAdd(&bucket_array->pending_write_waiter_count, 0) != 0))
     {
-        hash_table_item->item_cleanup_callback(hash_table_item->item_cleanup_callback_context, (void*)item);
+        /* Codes_SRS_CLDS_HASH_TABLE_01_264: [ When the count of pending writes to the oldest array of buckets reaches 0 or the move of the items of a bucket completes, clds_backoff_wake_all shall be called only if there are threads waiting for it. ]*/
+        clds_backoff_wake_all(&bucket_array->pending_write_count);
     }
 }
 
-void clds_hash_table_destroy(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+// returns false if the bucket array was retired, in which case it has no items and the caller has to move on
+static bool begin_bucket_array_write(CLDS_HASH_TABLE* clds_hash_table, BUCKET_ARRAY* bucket_array, bool migration_enabled)
 {
-    if (clds_hash_table == NULL)
+    bool result;
+
+    if (!migration_enabled)
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_01_007: [ If clds_hash_table is NULL, clds_hash_table_destroy shall return. ]*/
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p", clds_hash_table);
+        result = true;
     }
     else
     {
-        LONG i;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_wait_backoff_policy(clds_hash_table));
 
-        BUCKET_ARRAY* bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (bucket_array != NULL)
+        do
         {
-            BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&bucket_array->next_bucket, NULL, NULL);
+            LONG migrating;
 
-            /* Codes_SRS_CLDS_HASH_TABLE_01_006: [ clds_hash_table_destroy shall free all resources associated with the hash table instance. ]*/
-            for (i = 0; i < bucket_array->bucket_count; i++)
+            (void)InterlockedIncrement(&bucket_array->pending_write_count);
+            if (InterlockedAdd(&bucket_array->retired, 0) != 0)
             {
-                if (bucket_array->hash_table[i] != NULL)
-                {
-                    CLDS_SORTED_LIST_HANDLE linked_list = InterlockedCompareExchangePointer(&bucket_array->hash_table[i], NULL, NULL);
-                    if (linked_list != NULL)
-                    {
-                        clds_sorted_list_destroy(linked_list);
-                    }
-                }
+                end_pending_write(bucket_array);
+                result = false;
+                break;
             }
 
-            free(bucket_array);
-            bucket_array = next_bucket_array;
-        }
+            migrating = InterlockedAdd(&bucket_array->migrating, 0);
+            if (migrating == 0)
+            {
+                result = true;
+                break;
+            }
 
-        free(clds_hash_table);
+            /* Codes_SRS_CLDS_HASH_TABLE_01_134: [ While the items of a bucket are moved, writes to the lists of the oldest array of buckets shall wait for the move to complete. ]*/
+            // the waiter count is incremented before the flag is looked at again, so that the migrating thread either sees the waiter and wakes it or the waiter sees the flag cleared
+            (void)InterlockedIncrement(&bucket_array->migrating_waiter_count);
+            end_pending_write(bucket_array);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_263: [ While waiting for the move of the items of a bucket or for the pending writes to the oldest array of buckets to complete, the hash table shall call clds_backoff_wait_while_equal with a backoff state initialized with the backoff policy of the hash table (CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT if the backoff policy is CLDS_BACKOFF_POLICY_NONE). ]*/
+            clds_backoff_wait_while_equal(&backoff, &bucket_array->migrating, migrating);
+            (void)InterlockedDecrement(&bucket_array->migrating_waiter_count);
+        } while (1);
     }
+
+    return result;
 }
 
-CLDS_HASH_TABLE_INSERT_RESULT clds_hash_table_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+static void end_bucket_array_write(BUCKET_ARRAY* bucket_array, bool migration_enabled)
 {
-    CLDS_HASH_TABLE_INSERT_RESULT result;
-
-    if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_010: [ If clds_hash_table is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-        (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_011: [ If key is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_012: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_062: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
-        )
+    if (migration_enabled)
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
-            clds_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
-        result = CLDS_HASH_TABLE_INSERT_ERROR;
+        end_pending_write(bucket_array);
     }
-    else
-    {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_032: [ clds_hash_table_insert shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_033: [ clds_hash_table_insert shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_034: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_035: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_036: [ clds_hash_table_insert shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
+}
 
-        bool restart_needed;
-        CLDS_SORTED_LIST_HANDLE bucket_list = NULL;
-        HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, value);
-        uint64_t hash;
-        BUCKET_ARRAY* current_bucket_array;
-        LONG bucket_count;
-        uint64_t bucket_index;
-        bool found_in_lower_levels = false;
+static void lock_bucket_array_writes(CLDS_HASH_TABLE* clds_hash_table, BUCKET_ARRAY* bucket_array)
+{
+    LONG pending_write_count;
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_wait_backoff_policy(clds_hash_table));
 
-        // find or allocate a new bucket array
-        current_bucket_array = get_first_bucket_array(clds_hash_table);
-        bucket_count = InterlockedAdd(&current_bucket_array->bucket_count, 0);
+    (void)InterlockedExchange(&bucket_array->migrating, 1);
 
-        (void)InterlockedIncrement(&current_bucket_array->pending_insert_count);
+    // the waiter count is incremented before the pending write count is looked at, so that the last writer either sees the waiter and wakes it or the waiter sees the count at 0
+    (void)InterlockedIncrement(&bucket_array->pending_write_waiter_count);
 
-        // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        hash = clds_hash_table->compute_hash(key);
+    while ((pending_write_count = InterlockedAdd(&bucket_array->pending_write_count, 0)) != 0)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_263: [ While waiting for the move of the items of a bucket or for the pending writes to the oldest array of buckets to complete, the hash table shall call clds_backoff_wait_while_equal with a backoff state initialized with the backoff policy of the hash table (CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT if the backoff policy is CLDS_BACKOFF_POLICY_NONE). ]*/
+        clds_backoff_wait_while_equal(&backoff, &bucket_array->pending_write_count, pending_write_count);
+    }
 
-        found_in_lower_levels = false;
+    (void)InterlockedDecrement(&bucket_array->pending_write_waiter_count);
+}
 
-        // check if the key exists in the lower level bucket arrays
-        BUCKET_ARRAY* find_bucket_array = current_bucket_array;
-        BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&find_bucket_array->next_bucket, NULL, NULL);
+static void unlock_bucket_array_writes(BUCKET_ARRAY* bucket_array)
+{
+    (void)InterlockedExchange(&bucket_array->migrating, 0);
+    if (InterlockedAdd(&bucket_array->migrating_waiter_count, 0) != 0)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_264: [ When the count of pending writes to the oldest array of buckets reaches 0 or the move of the items of a bucket completes, clds_backoff_wake_all shall be called only if there are threads waiting for it. ]*/
+        clds_backoff_wake_all(&bucket_array->migrating);
+    }
+}
 
-        if (next_bucket_array != NULL)
-        {
-            // wait for all outstanding inserts in the lower levels to complete
-            do
-            {
-                if (InterlockedAdd(&next_bucket_array->pending_insert_count, 0) == 0)
-                {
-                    break;
-                }
-            } while (1);
-        }
+static void lock_migration(CLDS_HASH_TABLE* clds_hash_table)
+{
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER((CLDS_BACKOFF_POLICY)InterlockedAdd(&clds_hash_table->backoff_policy, 0));
 
-        find_bucket_array = next_bucket_array;
-        while (find_bucket_array != NULL)
-        {
-            next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&find_bucket_array->next_bucket, NULL, NULL);
+    while (InterlockedCompareExchange(&clds_hash_table->migration_in_progress, 1, 0) != 0)
+    {
+        clds_backoff_retry(&backoff);
+    }
+}
 
-            bucket_index = hash % InterlockedAdd(&find_bucket_array->bucket_count, 0);
-            bucket_list = InterlockedCompareExchangePointer(&find_bucket_array->hash_table[bucket_index], NULL, NULL);
+static void unlock_migration(CLDS_HASH_TABLE* clds_hash_table)
+{
+    (void)InterlockedExchange(&clds_hash_table->migration_in_progress, 0);
+}
 
-            if (bucket_list != NULL)
-            {
-                CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
-                if (sorted_list_item != NULL)
-                {
-                    clds_sorted_list_node_release(sorted_list_item);
+static void init_lookup_restarts(LOOKUP_RESTARTS* restarts)
+{
+    restarts->count = 0;
+    restarts->holds_migration_lock = false;
+}
 
-                    found_in_lower_levels = true;
-                    break;
-                }
-            }
+// has to be called before the lookup marks itself as a pending insert, the lookup holding the migration lock may wait for those
+static void begin_lookup_attempt(CLDS_HASH_TABLE* clds_hash_table, LOOKUP_RESTARTS* restarts)
+{
+    if ((restarts->count >= MAX_LOOKUP_MIGRATION_RESTARTS) &&
+        !restarts->holds_migration_lock)
+    {
+        // no items move while the migration lock is held, so this attempt cannot miss the key because of a move
+        /* Codes_SRS_CLDS_HASH_TABLE_01_265: [ After a lookup was done again 4 times because items were being moved between arrays of buckets, clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove, clds_hash_table_set_value and clds_hash_table_find shall do the next lookup while holding the migration lock, so that no items are moved during it. ]*/
+        lock_migration(clds_hash_table);
+        restarts->holds_migration_lock = true;
+    }
+}
 
-            find_bucket_array = next_bucket_array;
-        }
+static bool lookup_must_restart(CLDS_HASH_TABLE* clds_hash_table, LOOKUP_RESTARTS* restarts, LONG migration_sequence)
+{
+    bool result;
 
-        if (found_in_lower_levels)
-        {
-            result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
-        }
-        else
-        {
-            (void)InterlockedIncrement(&current_bucket_array->item_count);
+    if (items_were_moved_since(clds_hash_table, migration_sequence))
+    {
+        restarts->count++;
+        result = true;
+    }
+    else
+    {
+        result = false;
+    }
 
-            // find the bucket
-            /* Codes_SRS_CLDS_HASH_TABLE_01_018: [ clds_hash_table_insert shall obtain the bucket index to be used by calling compute_hash and passing to it the key value. ]*/
-            bucket_index = hash % bucket_count;
+    return result;
+}
 
-            do
-            {
-                // do we have a list here or do we create one?
-                bucket_list = InterlockedCompareExchangePointer(&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list != NULL)
-                {
-                    restart_needed = false;
-                }
-                else
-                {
-                    // create a list
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_019: [ If no sorted list exists at the determined bucket index then a new list shall be created. ]*/
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_071: [ When a new list is created, the start sequence number passed to clds_hash_tabel_create shall be passed as the start_sequence_number argument. ]*/
-                    bucket_list = clds_sorted_list_create(clds_hash_table->clds_hazard_pointers, get_item_key_cb, clds_hash_table, key_compare_cb, clds_hash_table, clds_hash_table->sequence_number, clds_hash_table->sequence_number == NULL ? NULL : on_sorted_list_skipped_seq_no, clds_hash_table);
-                    if (bucket_list == NULL)
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-                        LogError("Cannot allocate list for hash table bucket");
-                        restart_needed = false;
-                    }
-                    else
-                    {
-                        // now put the list in the bucket
-                        if (InterlockedCompareExchangePointer(&current_bucket_array->hash_table[bucket_index], bucket_list, NULL) != NULL)
-                        {
-                            // oops, someone else inserted a new list, just bail on our list and restart
-                            clds_sorted_list_destroy(bucket_list);
-                            restart_needed = true;
-                        }
-                        else
-                        {
-                            // set new list
-                            restart_needed = false;
-                        }
-                    }
-                }
-            } while (restart_needed);
+static void end_lookup_attempts(CLDS_HASH_TABLE* clds_hash_table, LOOKUP_RESTARTS* restarts)
+{
+    if (restarts->holds_migration_lock)
+    {
+        unlock_migration(clds_hash_table);
+        restarts->holds_migration_lock = false;
+    }
+}
 
-            if (bucket_list == NULL)
-            {
-                LogError("Cannot acquire bucket list");
-                result = CLDS_HASH_TABLE_INSERT_ERROR;
-            }
-            else
-            {
-                CLDS_SORTED_LIST_INSERT_RESULT list_insert_result;
+static LONG get_bloom_filter_word_count(CLDS_HASH_TABLE* clds_hash_table, LONG bucket_count)
+{
+    LONG bits_per_bucket = InterlockedAdd(&clds_hash_table->bloom_filter_bits_per_bucket, 0);
+    return (LONG)((((int64_t)bucket_count * bits_per_bucket) + 31) / 32);
+}
 
-                /* Codes_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
-                hash_table_item->key = key;
+static size_t get_bucket_array_size(LONG bucket_count, LONG bloom_filter_word_count)
+{
+    return sizeof(BUCKET_ARRAY) + (sizeof(CLDS_SORTED_LIST_HANDLE) * bucket_count) + (sizeof(LONG) * bloom_filter_word_count);
+}
 
-                /* Codes_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
-                /* Codes_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_insert. ]*/
-                list_insert_result = clds_sorted_list_insert(bucket_list, clds_hazard_pointers_thread, (void*)value, sequence_number);
+static void get_bloom_filter_position(BUCKET_ARRAY* bucket_array, uint64_t hash, LONG* word_index, LONG* bit_mask)
+{
+    // spread the hash, so that the bits do not correlate with the bucket index
+    uint64_t mixed_hash = hash * 0x9E3779B97F4A7C15;
 
-                if (list_insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
-                {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_046: [ If the key already exists in the hash table, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ALREADY_EXISTS. ]*/
-                    result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
-                }
-                else if (list_insert_result != CLDS_SORTED_LIST_INSERT_OK)
-                {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-                    LogError("Cannot insert hash table item into list");
-                    result = CLDS_HASH_TABLE_INSERT_ERROR;
-                }
-                else
-                {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_009: [ On success clds_hash_table_insert shall return CLDS_HASH_TABLE_INSERT_OK. ]*/
-                    result = CLDS_HASH_TABLE_INSERT_OK;
-                }
-            }
-        }
+    // blocked Bloom filter, all the bits for a hash are in the same word
+    *word_index = (LONG)((mixed_hash >> 32) % (uint64_t)bucket_array->bloom_filter_word_count);
+    *bit_mask = (LONG)((1U << (mixed_hash & 31)) | (1U << ((mixed_hash >> 5) & 31)) | (1U << ((mixed_hash >> 10) & 31)) | (1U << ((mixed_hash >> 15) & 31)));
+}
 
-        (void)InterlockedDecrement(&current_bucket_array->pending_insert_count);
+static void add_to_bloom_filter(BUCKET_ARRAY* bucket_array, uint64_t hash)
+{
+    if (bucket_array->bloom_filter_word_count != 0)
+    {
+        LONG word_index;
+        LONG bit_mask;
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_063: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
+        /* Codes_SRS_CLDS_HASH_TABLE_01_154: [ Before an item is inserted in a list of an array of buckets that has a Bloom filter, the hash of its key shall be added to the Bloom filter. ]*/
+        get_bloom_filter_position(bucket_array, hash, &word_index, &bit_mask);
+        (void)InterlockedOr(&bucket_array->bloom_filter[word_index], bit_mask);
     }
-    return result;
 }
 
-static bool find_by_key_value(void* item_compare_context, CLDS_SORTED_LIST_ITEM* item)
+static bool bloom_filter_may_contain(BUCKET_ARRAY* bucket_array, uint64_t hash)
 {
     bool result;
-    FIND_BY_KEY_VALUE_CONTEXT* find_by_key_value_context = (FIND_BY_KEY_VALUE_CONTEXT*)item_compare_context;
-    HASH_TABLE_ITEM* hash_table_item = (HASH_TABLE_ITEM*)CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
 
-    if ((item != find_by_key_value_context->value) ||
-        (find_by_key_value_context->key_compare_func(hash_table_item->key, find_by_key_value_context->key) != 0))
+    if (bucket_array->bloom_filter_word_count == 0)
     {
-        result = false;
+        result = true;
     }
     else
     {
-        result = true;
+        LONG word_index;
+        LONG bit_mask;
+
+        get_bloom_filter_position(bucket_array, hash, &word_index, &bit_mask);
+        result = ((InterlockedAdd(&bucket_array->bloom_filter[word_index], 0) & bit_mask) == bit_mask);
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+static void initialize_bucket_array(BUCKET_ARRAY* bucket_array, LONG bucket_count, LONG bloom_filter_word_count, BUCKET_ARRAY* next_bucket_array)
 {
-    CLDS_HASH_TABLE_DELETE_RESULT result;
+    (void)InterlockedExchange(&bucket_array->bucket_count, bucket_count);
+    (void)InterlockedExchange(&bucket_array->item_count, 0);
+    (void)InterlockedExchange(&bucket_array->pending_insert_count, 0);
+    (void)InterlockedExchange(&bucket_array->pending_insert_waiter_count, 0);
+    (void)InterlockedExchange(&bucket_array->pending_write_count, 0);
+    (void)InterlockedExchange(&bucket_array->pending_write_waiter_count, 0);
+    (void)InterlockedExchange(&bucket_array->migrating, 0);
+    (void)InterlockedExchange(&bucket_array->migrating_waiter_count, 0);
+    (void)InterlockedExchange(&bucket_array->retired, 0);
+    (void)InterlockedExchange(&bucket_array->migration_bucket_index, 0);
+
+    // initialize buckets
+    (void)memset(bucket_array->hash_table, 0, sizeof(CLDS_SORTED_LIST_HANDLE) * bucket_count);
+
+    bucket_array->bloom_filter_word_count = bloom_filter_word_count;
+    bucket_array->bloom_filter = (volatile LONG*)&bucket_array->hash_table[bucket_count];
+    (void)memset((void*)bucket_array->bloom_filter, 0, sizeof(LONG) * bloom_filter_word_count);
+
+    (void)InterlockedExchangePointer((volatile PVOID*)&bucket_array->next_bucket, next_bucket_array);
+}
 
-    if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_015: [ If clds_hash_table is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_016: [ If key is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
-        )
+static BUCKET_ARRAY* get_first_bucket_array(CLDS_HASH_TABLE* clds_hash_table, BUCKET_ARRAY_CURSOR* cursor)
+{
+    BUCKET_ARRAY* first_bucket_array;
+
+    // always insert in the first bucket array
+    if (move_bucket_array_cursor(cursor, (volatile PVOID*)&clds_hash_table->first_hash_table) != 0)
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, clds_hazard_pointers_thread, sequence_number);
-        result = CLDS_HASH_TABLE_DELETE_ERROR;
+        LogError("Cannot get the first bucket array");
+        first_bucket_array = NULL;
     }
     else
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_037: [ clds_hash_table_delete shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_038: [ clds_hash_table_delete shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_039: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_040: [ clds_hash_table_delete shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_041: [ clds_hash_table_delete shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
-
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-        BUCKET_ARRAY* current_bucket_array;
-
-        // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_039: [ clds_hash_table_delete shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
-
-        result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+        first_bucket_array = cursor->bucket_array;
 
-        // always delete starting with the first bucket array
-        /* Codes_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-        current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
+        LONG bucket_count = InterlockedAdd(&first_bucket_array->bucket_count, 0);
+        while (InterlockedAdd(&first_bucket_array->item_count, 0) >= bucket_count)
         {
-            BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&current_bucket_array->next_bucket, NULL, NULL);
-
-            if (InterlockedAdd(&current_bucket_array->item_count, 0) != 0)
+            // allocate a new bucket array
+            /* Codes_SRS_CLDS_HASH_TABLE_01_153: [ If the number of Bloom filter bits per bucket is non-zero, each new array of buckets shall be allocated with a Bloom filter having that number of bits for each bucket. ]*/
+            LONG bloom_filter_word_count = get_bloom_filter_word_count(clds_hash_table, bucket_count * 2);
+            BUCKET_ARRAY* new_bucket_array = (BUCKET_ARRAY*)malloc(get_bucket_array_size(bucket_count * 2, bloom_filter_word_count));
+            if (new_bucket_array == NULL)
             {
-                // find the bucket
-                uint64_t bucket_index = hash % InterlockedAdd(&current_bucket_array->bucket_count, 0);
+                // cannot allocate new bucket, will stick to what we have, but do not fail
+                break;
+            }
+            else
+            {
+                bool inserted;
 
-                bucket_list = InterlockedCompareExchangePointer(&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list == NULL)
+                // insert new bucket
+                /* Codes_SRS_CLDS_HASH_TABLE_01_030: [ If the number of items in the list reaches the number of buckets, the number of buckets shall be doubled. ]*/
+                initialize_bucket_array(new_bucket_array, bucket_count * 2, bloom_filter_word_count, first_bucket_array);
+
+                inserted = (InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, new_bucket_array, first_bucket_array) == first_bucket_array);
+                if (!inserted)
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-                    result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+                    // first bucket array changed, drop ours and use the one that was inserted
+                    free(new_bucket_array);
                 }
-                else
-                {
-                    CLDS_SORTED_LIST_DELETE_RESULT list_delete_result;
 
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
-                    list_delete_result = clds_sorted_list_delete_key(bucket_list, clds_hazard_pointers_thread, key, sequence_number);
-                    if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
-                    {
-                        // not found
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-                    }
-                    else if (list_delete_result == CLDS_SORTED_LIST_DELETE_OK)
-                    {
-                        (void)InterlockedDecrement(&current_bucket_array->item_count);
+                if (move_bucket_array_cursor(cursor, (volatile PVOID*)&clds_hash_table->first_hash_table) != 0)
+                {
+                    LogError("Cannot get the first bucket array");
+                    first_bucket_array = NULL;
+                    break;
+                }
 
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_014: [ On success clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_OK;
-                        break;
-                    }
-                    else
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_024: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_ERROR;
-                        break;
-                    }
+                first_bucket_array = cursor->bucket_array;
+                if (inserted)
+                {
+                    break;
                 }
-            }
 
-            /* Codes_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
-            current_bucket_array = next_bucket_array;
+                bucket_count = InterlockedAdd(&first_bucket_array->bucket_count, 0);
+            }
         }
-
-        /* Codes_SRS_CLDS_HASH_TABLE_42_042: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
     }
 
-    return result;
+    return first_bucket_array;
 }
 
-CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete_key_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+static CLDS_SORTED_LIST_HANDLE get_or_create_bucket_list(CLDS_HASH_TABLE* clds_hash_table, BUCKET_ARRAY* bucket_array, uint64_t bucket_index)
 {
-    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_SORTED_LIST_HANDLE bucket_list;
 
-    if (
-        /*Codes_SRS_CLDS_HASH_TABLE_42_003: [ If clds_hash_table is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (clds_hash_table == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_005: [ If key is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (key == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_006: [ If value is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (value == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_004: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_012: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
-        )
+    do
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, value, clds_hazard_pointers_thread, sequence_number);
-        result = CLDS_HASH_TABLE_DELETE_ERROR;
-    }
-    else
+        bucket_list = InterlockedCompareExchangePointer(&bucket_array->hash_table[bucket_index], NULL, NULL);
+        if (bucket_list != NULL)
+        {
+            break;
+        }
+
+        bucket_list = create_bucket_list(clds_hash_table);
+        if (bucket_list == NULL)
+        {
+            LogError("Cannot allocate list for hash table bucket");
+            break;
+        }
+
+        if (InterlockedCompareExchangePointer(&bucket_array->hash_table[bucket_index], bucket_list, NULL) == NULL)
+        {
+            break;
+        }
+
+        // someone else inserted a new list, bail on ours and use theirs
+        clds_sorted_list_destroy(bucket_list);
+    } while (1);
+
+    return bucket_list;
+}
+
+// the lookup shared by the operations on a key: on_bucket_list is called with the bucket list of the key in each array of buckets that may hold it, newest first, until it does not return KEY_LOOKUP_NOT_FOUND
+// with put_in_top_level (clds_hash_table_insert and clds_hash_table_set_value) only the arrays below the top level one are looked at and if the key is in none of them put_in_top_level is called
+static KEY_LOOKUP_RESULT lookup_key(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, bool migration_enabled, uint64_t hash, ON_KEY_BUCKET_LIST on_bucket_list, PUT_IN_TOP_LEVEL put_in_top_level, void* context)
+{
+    KEY_LOOKUP_RESULT result;
+    BUCKET_ARRAY_CURSOR top_level_cursor;
+    BUCKET_ARRAY_CURSOR cursor;
+    LOOKUP_RESTARTS restarts;
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER((CLDS_BACKOFF_POLICY)InterlockedAdd(&clds_hash_table->backoff_policy, 0));
+    bool restart_needed;
+
+    init_bucket_array_cursor(&top_level_cursor, clds_hazard_pointers_thread, migration_enabled);
+    init_bucket_array_cursor(&cursor, clds_hazard_pointers_thread, migration_enabled);
+    init_lookup_restarts(&restarts);
+
+    do
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_043: [ clds_hash_table_delete_key_value shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_044: [ clds_hash_table_delete_key_value shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_045: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_046: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_047: [ clds_hash_table_delete_key_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
+        BUCKET_ARRAY* top_level_bucket_array = NULL;
+        LONG migration_sequence;
 
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-        BUCKET_ARRAY* current_bucket_array;
+        begin_lookup_attempt(clds_hash_table, &restarts);
+        restart_needed = false;
+        result = KEY_LOOKUP_NOT_FOUND;
 
-        // compute the hash
-        /*Codes_SRS_CLDS_HASH_TABLE_42_001: [ clds_hash_table_delete_key_value shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
+        if (put_in_top_level != NULL)
+        {
+            // find or allocate a new bucket array
+            top_level_bucket_array = get_first_bucket_array(clds_hash_table, &top_level_cursor);
+            if (top_level_bucket_array == NULL)
+            {
+                result = KEY_LOOKUP_ERROR;
+            }
+            else
+            {
+                (void)InterlockedIncrement(&top_level_bucket_array->pending_insert_count);
+            }
+        }
 
-        result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+        migration_sequence = get_migration_sequence(clds_hash_table);
 
-        // always insert in the first bucket array
-        /*Codes_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-        current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
+        if (result == KEY_LOOKUP_ERROR)
         {
-            BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&current_bucket_array->next_bucket, NULL, NULL);
+            // no array of buckets to look at
+        }
+        else if (move_bucket_array_cursor(&cursor, (top_level_bucket_array == NULL) ? (volatile PVOID*)&clds_hash_table->first_hash_table : (volatile PVOID*)&top_level_bucket_array->next_bucket) != 0)
+        {
+            result = KEY_LOOKUP_ERROR;
+        }
+        else
+        {
+            if ((top_level_bucket_array != NULL) && (cursor.bucket_array != NULL))
+            {
+                // the first array below the top level one was the top level array before, inserts in it may still be in progress
+                wait_for_pending_inserts(clds_hash_table, cursor.bucket_array);
+            }
 
-            if (InterlockedAdd(&current_bucket_array->item_count, 0) != 0)
+            while (cursor.bucket_array != NULL)
             {
-                // find the bucket
-                uint64_t bucket_index = hash % InterlockedAdd(&current_bucket_array->bucket_count, 0);
+                BUCKET_ARRAY* bucket_array = cursor.bucket_array;
 
-                bucket_list = InterlockedCompareExchangePointer(&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list == NULL)
-                {
-                    /*Codes_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-                    result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
-                }
-                else
+                if (InterlockedAdd(&bucket_array->item_count, 0) != 0)
                 {
-                    CLDS_SORTED_LIST_DELETE_RESULT list_delete_result;
+                    // find the bucket
+                    uint64_t bucket_index = hash % InterlockedAdd(&bucket_array->bucket_count, 0);
+                    CLDS_SORTED_LIST_HANDLE bucket_list = InterlockedCompareExchangePointer(&bucket_array->hash_table[bucket_index], NULL, NULL);
 
-                    /*Codes_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
-                    list_delete_result = clds_sorted_list_delete_item(bucket_list, clds_hazard_pointers_thread, (void*)value, sequence_number);
-                    if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_155: [ If the Bloom filter of an array of buckets rules out the hash of the key, clds_hash_table_find, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove, clds_hash_table_set_value and the lookup of the key in the lower level arrays of buckets done by clds_hash_table_insert shall skip that array of buckets. ]*/
+                    if ((bucket_list != NULL) && bloom_filter_may_contain(bucket_array, hash))
                     {
-                        // not found
+                        result = on_bucket_list(context, bucket_array, bucket_list);
+                        if (result != KEY_LOOKUP_NOT_FOUND)
+                        {
+                            break;
+                        }
                     }
-                    else if (list_delete_result == CLDS_SORTED_LIST_DELETE_OK)
-                    {
-                        (void)InterlockedDecrement(&current_bucket_array->item_count);
+                }
 
-                        /*Codes_SRS_CLDS_HASH_TABLE_42_002: [ On success clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_OK;
-                        break;
-                    }
-                    else
-                    {
-                        /*Codes_SRS_CLDS_HASH_TABLE_42_009: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_ERROR;
-                        break;
-                    }
+                if (move_bucket_array_cursor(&cursor, (volatile PVOID*)&bucket_array->next_bucket) != 0)
+                {
+                    result = KEY_LOOKUP_ERROR;
+                    break;
                 }
             }
-
-            /*Codes_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
-            current_bucket_array = next_bucket_array;
         }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_048: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
-    }
-
-    return result;
-}
+        release_bucket_array_cursor(&cursor);
 
-CLDS_HASH_TABLE_REMOVE_RESULT clds_hash_table_remove(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number)
-{
-    CLDS_HASH_TABLE_DELETE_RESULT result;
+        if (result == KEY_LOOKUP_ERROR)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_140: [ If acquiring the hazard pointer for an array of buckets fails, clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall fail and return their respective ERROR result and clds_hash_table_find shall fail and return NULL. ]*/
+            LogError("Cannot acquire the hazard pointer for an array of buckets");
+        }
+        else if ((result == KEY_LOOKUP_NOT_FOUND) && lookup_must_restart(clds_hash_table, &restarts, migration_sequence))
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_141: [ If the key is not found while items were being moved between arrays of buckets, the key shall be looked up again. ]*/
+            restart_needed = true;
+        }
+        else if ((result == KEY_LOOKUP_NOT_FOUND) && (top_level_bucket_array != NULL))
+        {
+            if (!begin_bucket_array_write(clds_hash_table, top_level_bucket_array, migration_enabled))
+            {
+                // the array stopped being the top level array and got retired, start over with the new top level array
+                restart_needed = true;
+            }
+            else
+            {
+                put_in_top_level(context, top_level_bucket_array);
+                end_bucket_array_write(top_level_bucket_array, migration_enabled);
+                result = KEY_LOOKUP_DONE;
+            }
+        }
+        else
+        {
+            // the operation is over
+        }
+
+        if (top_level_bucket_array != NULL)
+        {
+            end_pending_insert(top_level_bucket_array);
+        }
+
+        if (restart_needed)
+        {
+            clds_backoff_retry(&backoff);
+        }
+    } while (restart_needed);
+
+    end_lookup_attempts(clds_hash_table, &restarts);
+    release_bucket_array_cursor(&top_level_cursor);
+
+    return result;
+}
+
+static void report_migration_sequence_number(CLDS_HASH_TABLE* clds_hash_table, int64_t sequence_number)
+{
+    /* Codes_SRS_CLDS_HASH_TABLE_01_135: [ The sequence numbers used for moving items shall be reported as skipped by calling the skipped sequence number callback passed to clds_hash_table_create. ]*/
+    if (clds_hash_table->skipped_seq_no_cb != NULL)
+    {
+        clds_hash_table->skipped_seq_no_cb(clds_hash_table->skipped_seq_no_cb_context, sequence_number);
+    }
+}
+
+static HASH_TABLE_ITEM_SNAPSHOT_STATE* get_item_snapshot_state(CLDS_SORTED_LIST_ITEM* item)
+{
+    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+    return InterlockedCompareExchangePointer((volatile PVOID*)&hash_table_item->snapshot_state, NULL, NULL);
+}
+
+// must be called with the write gate held or by the running snapshot, returns NULL if the snapshot state cannot be allocated
+static HASH_TABLE_ITEM_SNAPSHOT_STATE* get_or_create_item_snapshot_state(CLDS_HASH_TABLE* clds_hash_table, CLDS_SORTED_LIST_ITEM* item)
+{
+    HASH_TABLE_ITEM_SNAPSHOT_STATE* result = get_item_snapshot_state(item);
+
+    if (result == NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_271: [ The state kept by the snapshots for an item shall be allocated the first time a running snapshot has to record anything on the item and freed when the item is freed. ]*/
+        HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = malloc(sizeof(HASH_TABLE_ITEM_SNAPSHOT_STATE));
+        if (snapshot_state == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_272: [ If allocating the state kept by the snapshots for an item fails, the write operation shall still succeed and the running clds_hash_table_snapshot_concurrent or clds_hash_table_snapshot_at_current_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            LogError("malloc(%zu) failed for the snapshot state of an item, the running snapshot fails", sizeof(HASH_TABLE_ITEM_SNAPSHOT_STATE));
+            (void)InterlockedExchange(&clds_hash_table->snapshot_failed, 1);
+        }
+        else
+        {
+            HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+
+            (void)InterlockedExchange64(&snapshot_state->write_generation, 0);
+            (void)InterlockedExchange64(&snapshot_state->captured_generation, 0);
+            snapshot_state->next_captured = NULL;
+            (void)InterlockedExchange64(&snapshot_state->insert_sequence_number, SEQUENCE_NUMBER_NOT_STAMPED);
+            (void)InterlockedExchange64(&snapshot_state->remove_sequence_number, SEQUENCE_NUMBER_NOT_REMOVED);
+
+            // the running snapshot may visit the item while a writer works on it, only one of them gets to set the state
+            result = InterlockedCompareExchangePointer((volatile PVOID*)&hash_table_item->snapshot_state, snapshot_state, NULL);
+            if (result == NULL)
+            {
+                result = snapshot_state;
+            }
+            else
+            {
+                free(snapshot_state);
+            }
+        }
+    }
+
+    return result;
+}
+
+static CLDS_HASH_TABLE_ITEM* get_next_captured_item(CLDS_HASH_TABLE_ITEM* captured_item)
+{
+    return get_item_snapshot_state((void*)captured_item)->next_captured;
+}
+
+// adds the item to the items captured by the running snapshot, together with a reference on it, unless it was already added under the same capture id
+static void add_to_captured_items(CLDS_HASH_TABLE* clds_hash_table, CLDS_SORTED_LIST_ITEM* item, int64_t capture_id)
+{
+    HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = get_or_create_item_snapshot_state(clds_hash_table, item);
+
+    if (snapshot_state != NULL)
+    {
+        int64_t captured_generation = InterlockedAdd64(&snapshot_state->captured_generation, 0);
+
+        while (captured_generation < capture_id)
+        {
+            int64_t current_captured_generation = InterlockedCompareExchange64(&snapshot_state->captured_generation, capture_id, captured_generation);
+            if (current_captured_generation == captured_generation)
+            {
+                CLDS_HASH_TABLE_ITEM* captured_items;
+
+                // the snapshot holds its own reference
+                (void)clds_sorted_list_node_inc_ref(item);
+
+                do
+                {
+                    captured_items = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->captured_items, NULL, NULL);
+                    snapshot_state->next_captured = captured_items;
+                } while (InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->captured_items, (PVOID)item, (PVOID)captured_items) != (PVOID)captured_items);
+
+                break;
+            }
+
+            captured_generation = current_captured_generation;
+        }
+    }
+}
+
+// the snapshot taken by clds_hash_table_snapshot_concurrent is the content of the table when its generation was bumped
+// a write operation that takes an item out of the table while the snapshot runs hands it to the snapshot, unless the item
+// was put in the table after the snapshot started or was already captured
+// must be called with the write gate held, so that the snapshot generation does not change under the caller
+static void capture_item(CLDS_HASH_TABLE* clds_hash_table, CLDS_SORTED_LIST_ITEM* item, int64_t item_write_generation)
+{
+    int64_t snapshot_generation = InterlockedAdd64(&clds_hash_table->snapshot_generation, 0);
+
+    if ((snapshot_generation != 0) && (item_write_generation <= snapshot_generation))
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_169: [ While a snapshot taken with clds_hash_table_snapshot_concurrent is running, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove, clds_hash_table_set_value and the migration of items shall add each item they take out of the table to the snapshot, if the item was in the table when the snapshot started and was not yet added to it. ]*/
+        add_to_captured_items(clds_hash_table, item, snapshot_generation);
+    }
+}
+
+// an item without snapshot state was put in the table while no snapshot was running, so it is older than any snapshot started since
+static int64_t get_item_write_generation(CLDS_SORTED_LIST_ITEM* item)
+{
+    HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = get_item_snapshot_state(item);
+    return (snapshot_state == NULL) ? 0 : InterlockedAdd64(&snapshot_state->write_generation, 0);
+}
+
+// stamps an item that is about to be put in the table with the current generation and returns its previous one
+// the generation only has to be kept for items put in the table while a snapshot is running and for items that already have snapshot state
+static int64_t stamp_item_write_generation(CLDS_HASH_TABLE* clds_hash_table, CLDS_SORTED_LIST_ITEM* item)
+{
+    int64_t result = 0;
+    HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = get_item_snapshot_state(item);
+
+    if ((snapshot_state == NULL) && (InterlockedAdd64(&clds_hash_table->snapshot_generation, 0) != 0))
+    {
+        snapshot_state = get_or_create_item_snapshot_state(clds_hash_table, item);
+    }
+
+    if (snapshot_state != NULL)
+    {
+        result = InterlockedExchange64(&snapshot_state->write_generation, InterlockedAdd64(&clds_hash_table->write_generation, 0));
+    }
+
+    return result;
+}
+
+// the snapshot taken by clds_hash_table_snapshot_at_current_sequence_number captures every item that may have been in the table at its sequence number
+// and decides at the end which ones were, from the sequence numbers of the operations that put them in the table and took them out
+// the sequence numbers of a captured item only follow the operations done at or before the snapshot sequence number,
+// so that putting the item back in the table later does not lose whether it was there at the snapshot sequence number
+static bool is_snapshot_at_capturing(CLDS_HASH_TABLE* clds_hash_table)
+{
+    return (InterlockedAdd(&clds_hash_table->snapshot_at_capturing, 0) != 0);
+}
+
+static bool is_change_log_enabled(CLDS_HASH_TABLE* clds_hash_table)
+{
+    return (InterlockedAdd(&clds_hash_table->change_log_enabled, 0) != 0);
+}
+
+// snapshots since a sequence number before the start of the change log return CLDS_HASH_TABLE_SNAPSHOT_SEQ_NO_TOO_OLD
+static void advance_change_log_start(CLDS_HASH_TABLE* clds_hash_table, int64_t sequence_number)
+{
+    int64_t start_sequence_number = InterlockedAdd64(&clds_hash_table->change_log_start_sequence_number, 0);
+
+    while (start_sequence_number < sequence_number)
+    {
+        int64_t current_start_sequence_number = InterlockedCompareExchange64(&clds_hash_table->change_log_start_sequence_number, sequence_number, start_sequence_number);
+        if (current_start_sequence_number == start_sequence_number)
+        {
+            break;
+        }
+
+        start_sequence_number = current_start_sequence_number;
+    }
+}
+
+static void free_change_log_records(CHANGE_LOG_RECORD* change_log_records)
+{
+    while (change_log_records != NULL)
+    {
+        CHANGE_LOG_RECORD* next_change_log_record = change_log_records->next;
+        clds_sorted_list_node_release((void*)change_log_records->change.item);
+        free(change_log_records);
+        change_log_records = next_change_log_record;
+    }
+}
+
+// records a change done by the write operation with the given sequence number, must be called with the write gate held
+static void log_change(CLDS_HASH_TABLE* clds_hash_table, CLDS_HASH_TABLE_CHANGE_TYPE change_type, CLDS_SORTED_LIST_ITEM* item, const int64_t* sequence_number)
+{
+    if (is_change_log_enabled(clds_hash_table))
+    {
+        CHANGE_LOG_RECORD* change_log_record = malloc(sizeof(CHANGE_LOG_RECORD));
+        if (change_log_record == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_254: [ If allocating the change log record fails, the write operation shall still succeed and the start of the change log shall be moved to the sequence number of the operation. ]*/
+            LogError("malloc(%zu) failed for the change log record of sequence number %" PRId64 ", changes before it cannot be returned anymore",
+                sizeof(CHANGE_LOG_RECORD), *sequence_number);
+            advance_change_log_start(clds_hash_table, *sequence_number);
+        }
+        else
+        {
+            HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+            CHANGE_LOG_RECORD* change_log;
+
+            change_log_record->change.change_type = change_type;
+            change_log_record->change.sequence_number = *sequence_number;
+            change_log_record->change.key = hash_table_item->key;
+            change_log_record->change.item = (CLDS_HASH_TABLE_ITEM*)item;
+
+            // the change log holds its own reference
+            (void)clds_sorted_list_node_inc_ref(item);
+
+            do
+            {
+                change_log = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->change_log, NULL, NULL);
+                change_log_record->next = change_log;
+            } while (InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->change_log, (PVOID)change_log_record, (PVOID)change_log) != (PVOID)change_log);
+        }
+    }
+}
+
+// write operations need their sequence number while clds_hash_table_snapshot_at_current_sequence_number captures items or the change log is enabled, even when the caller did not ask for it
+static int64_t* get_operation_sequence_number_ptr(CLDS_HASH_TABLE* clds_hash_table, int64_t* sequence_number, int64_t* local_sequence_number)
+{
+    /* Codes_SRS_CLDS_HASH_TABLE_01_199: [ While clds_hash_table_snapshot_at_current_sequence_number captures items, clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall obtain the sequence number of the operation even if sequence_number is NULL. ]*/
+    /* Codes_SRS_CLDS_HASH_TABLE_01_250: [ While the change log is enabled, clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall obtain the sequence number of the operation even if sequence_number is NULL. ]*/
+    return ((sequence_number == NULL) && (is_snapshot_at_capturing(clds_hash_table) || is_change_log_enabled(clds_hash_table))) ? local_sequence_number : sequence_number;
+}
+
+static bool is_captured_by_snapshot_at(CLDS_HASH_TABLE* clds_hash_table, CLDS_SORTED_LIST_ITEM* item)
+{
+    HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = get_item_snapshot_state(item);
+    int64_t snapshot_at_id = InterlockedAdd64(&clds_hash_table->snapshot_at_id, 0);
+    return (snapshot_at_id != 0) && (snapshot_state != NULL) && (InterlockedAdd64(&snapshot_state->captured_generation, 0) == snapshot_at_id);
+}
+
+// an item without snapshot state is marked as put in the table before any snapshot sequence number and not taken out
+static void get_item_sequence_numbers(CLDS_SORTED_LIST_ITEM* item, SNAPSHOT_AT_ITEM_SEQUENCE_NUMBERS* sequence_numbers)
+{
+    HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = get_item_snapshot_state(item);
+
+    if (snapshot_state == NULL)
+    {
+        sequence_numbers->insert_sequence_number = SEQUENCE_NUMBER_NOT_STAMPED;
+        sequence_numbers->remove_sequence_number = SEQUENCE_NUMBER_NOT_REMOVED;
+    }
+    else
+    {
+        sequence_numbers->insert_sequence_number = InterlockedAdd64(&snapshot_state->insert_sequence_number, 0);
+        sequence_numbers->remove_sequence_number = InterlockedAdd64(&snapshot_state->remove_sequence_number, 0);
+    }
+}
+
+static void reset_item_sequence_numbers(CLDS_SORTED_LIST_ITEM* item)
+{
+    HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = get_item_snapshot_state(item);
+
+    if (snapshot_state != NULL)
+    {
+        (void)InterlockedExchange64(&snapshot_state->insert_sequence_number, SEQUENCE_NUMBER_NOT_STAMPED);
+        (void)InterlockedExchange64(&snapshot_state->remove_sequence_number, SEQUENCE_NUMBER_NOT_REMOVED);
+    }
+}
+
+// captures an item found in the table or moved between arrays of buckets if it may have been in the table at the snapshot sequence number
+static void snapshot_at_capture_item(CLDS_HASH_TABLE* clds_hash_table, CLDS_SORTED_LIST_ITEM* item)
+{
+    if (is_snapshot_at_capturing(clds_hash_table))
+    {
+        SNAPSHOT_AT_ITEM_SEQUENCE_NUMBERS sequence_numbers;
+        get_item_sequence_numbers(item, &sequence_numbers);
+        if (sequence_numbers.insert_sequence_number <= InterlockedAdd64(&clds_hash_table->snapshot_at_sequence_number, 0))
+        {
+            add_to_captured_items(clds_hash_table, item, InterlockedAdd64(&clds_hash_table->snapshot_at_id, 0));
+        }
+    }
+}
+
+// called before an item is put in the table, returns whether the item is captured and keeps its sequence numbers
+static bool snapshot_at_begin_insert(CLDS_HASH_TABLE* clds_hash_table, CLDS_SORTED_LIST_ITEM* item, SNAPSHOT_AT_ITEM_SEQUENCE_NUMBERS* previous_sequence_numbers)
+{
+    bool result = is_captured_by_snapshot_at(clds_hash_table, item);
+
+    get_item_sequence_numbers(item, previous_sequence_numbers);
+
+    if (!result)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_200: [ Before putting an item in the table, clds_hash_table_insert and clds_hash_table_set_value shall mark the item as put in the table before any snapshot sequence number and not taken out, unless the item is captured by the running clds_hash_table_snapshot_at_current_sequence_number. ]*/
+        reset_item_sequence_numbers(item);
+    }
+
+    return result;
+}
+
+// called after an item was put in the table by the operation with the given sequence number
+static void snapshot_at_end_insert(CLDS_HASH_TABLE* clds_hash_table, CLDS_SORTED_LIST_ITEM* item, bool was_captured, const int64_t* sequence_number)
+{
+    if (is_snapshot_at_capturing(clds_hash_table))
+    {
+        int64_t snapshot_sequence_number = InterlockedAdd64(&clds_hash_table->snapshot_at_sequence_number, 0);
+
+        if (!was_captured)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_201: [ While clds_hash_table_snapshot_at_current_sequence_number captures items, clds_hash_table_insert and clds_hash_table_set_value shall record the sequence number of the operation as the insert sequence number of an item they put in the table that is not captured, and capture the item if that sequence number is at or before the snapshot sequence number. ]*/
+            HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = get_or_create_item_snapshot_state(clds_hash_table, item);
+            if (snapshot_state != NULL)
+            {
+                (void)InterlockedExchange64(&snapshot_state->insert_sequence_number, *sequence_number);
+                if (*sequence_number <= snapshot_sequence_number)
+                {
+                    add_to_captured_items(clds_hash_table, item, InterlockedAdd64(&clds_hash_table->snapshot_at_id, 0));
+                }
+            }
+        }
+        else if (*sequence_number <= snapshot_sequence_number)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_202: [ While clds_hash_table_snapshot_at_current_sequence_number captures items, clds_hash_table_insert and clds_hash_table_set_value shall record the sequence number of the operation as the insert sequence number of a captured item they put back in the table and mark it as not taken out, if that sequence number is at or before the snapshot sequence number. ]*/
+            HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = get_item_snapshot_state(item);
+            (void)InterlockedExchange64(&snapshot_state->remove_sequence_number, SEQUENCE_NUMBER_NOT_REMOVED);
+            (void)InterlockedExchange64(&snapshot_state->insert_sequence_number, *sequence_number);
+        }
+    }
+}
+
+// an item replaced with itself stays in the table, so it keeps the sequence numbers it had before
+static void snapshot_at_cancel_insert(CLDS_SORTED_LIST_ITEM* item, const SNAPSHOT_AT_ITEM_SEQUENCE_NUMBERS* previous_sequence_numbers)
+{
+    // an item that still has no snapshot state has kept its sequence numbers
+    HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = get_item_snapshot_state(item);
+
+    if (snapshot_state != NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_205: [ If clds_hash_table_set_value replaces an item with itself, the item shall keep the insert and remove sequence numbers it had before. ]*/
+        (void)InterlockedExchange64(&snapshot_state->insert_sequence_number, previous_sequence_numbers->insert_sequence_number);
+        (void)InterlockedExchange64(&snapshot_state->remove_sequence_number, previous_sequence_numbers->remove_sequence_number);
+    }
+}
+
+// called after an item was taken out of the table by the operation with the given sequence number
+static void snapshot_at_item_removed(CLDS_HASH_TABLE* clds_hash_table, CLDS_SORTED_LIST_ITEM* item, const int64_t* sequence_number)
+{
+    if (is_snapshot_at_capturing(clds_hash_table))
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_203: [ While clds_hash_table_snapshot_at_current_sequence_number captures items, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall record the sequence number of the operation as the remove sequence number of each item they take out of the table if that sequence number is at or before the snapshot sequence number, and otherwise capture the item if its insert sequence number is at or before the snapshot sequence number. ]*/
+        if (*sequence_number <= InterlockedAdd64(&clds_hash_table->snapshot_at_sequence_number, 0))
+        {
+            HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = get_or_create_item_snapshot_state(clds_hash_table, item);
+            if (snapshot_state != NULL)
+            {
+                (void)InterlockedExchange64(&snapshot_state->remove_sequence_number, *sequence_number);
+            }
+        }
+        else
+        {
+            snapshot_at_capture_item(clds_hash_table, item);
+        }
+    }
+}
+
+// hands an item that a delete or a remove took out of the table to the running snapshots and the change log
+static void hand_over_removed_item(CLDS_HASH_TABLE* clds_hash_table, CLDS_SORTED_LIST_ITEM* removed_item, const int64_t* sequence_number)
+{
+    capture_item(clds_hash_table, removed_item, get_item_write_generation(removed_item));
+    snapshot_at_item_removed(clds_hash_table, removed_item, sequence_number);
+    /* Codes_SRS_CLDS_HASH_TABLE_01_252: [ While the change log is enabled, clds_hash_table_delete, clds_hash_table_delete_key_value and clds_hash_table_remove shall add to the change log a CLDS_HASH_TABLE_CHANGE_DELETE change with the sequence number of the operation, holding a reference to the item they took out of the table. ]*/
+    log_change(clds_hash_table, CLDS_HASH_TABLE_CHANGE_DELETE, removed_item, sequence_number);
+}
+
+// same as hand_over_removed_item, also releasing the reference that the bucket list held on the deleted item
+static void hand_over_deleted_item(CLDS_HASH_TABLE* clds_hash_table, CLDS_SORTED_LIST_ITEM* removed_item, const int64_t* sequence_number)
+{
+    hand_over_removed_item(clds_hash_table, removed_item, sequence_number);
+    clds_sorted_list_node_release(removed_item);
+}
+
+// when a snapshot is running the deleted item has to be handed to the snapshot, so it is removed and released instead
+static CLDS_SORTED_LIST_DELETE_RESULT delete_key_from_bucket_list(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_HANDLE bucket_list, void* lookup_key, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_204: [ While clds_hash_table_snapshot_at_current_sequence_number captures items, clds_hash_table_delete shall call clds_sorted_list_remove_key instead of clds_sorted_list_delete_key and release the removed item after handing it to the snapshot. ]*/
+    /* Codes_SRS_CLDS_HASH_TABLE_01_253: [ While the change log is enabled, clds_hash_table_delete shall call clds_sorted_list_remove_key instead of clds_sorted_list_delete_key and release the removed item after adding the change to the change log. ]*/
+    if ((InterlockedAdd64(&clds_hash_table->snapshot_generation, 0) == 0) && !is_snapshot_at_capturing(clds_hash_table) && !is_change_log_enabled(clds_hash_table))
+    {
+        result = clds_sorted_list_delete_key(bucket_list, clds_hazard_pointers_thread, lookup_key, sequence_number);
+    }
+    else
+    {
+        CLDS_SORTED_LIST_ITEM* removed_item;
+        CLDS_SORTED_LIST_REMOVE_RESULT remove_result = clds_sorted_list_remove_key(bucket_list, clds_hazard_pointers_thread, lookup_key, &removed_item, sequence_number);
+        switch (remove_result)
+        {
+        default:
+        case CLDS_SORTED_LIST_REMOVE_ERROR:
+            result = CLDS_SORTED_LIST_DELETE_ERROR;
+            break;
+
+        case CLDS_SORTED_LIST_REMOVE_NOT_FOUND:
+            result = CLDS_SORTED_LIST_DELETE_NOT_FOUND;
+            break;
+
+        case CLDS_SORTED_LIST_REMOVE_OK:
+            hand_over_deleted_item(clds_hash_table, removed_item, sequence_number);
+            result = CLDS_SORTED_LIST_DELETE_OK;
+            break;
+        }
+    }
+
+    return result;
+}
+
+// same as delete_key_from_bucket_list, for clds_hash_table_delete_key_value which deletes a given item
+static CLDS_SORTED_LIST_DELETE_RESULT delete_item_from_bucket_list(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_HANDLE bucket_list, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_270: [ While a snapshot taken with clds_hash_table_snapshot_concurrent is running, clds_hash_table_snapshot_at_current_sequence_number captures items or the change log is enabled, clds_hash_table_delete_key_value shall call clds_sorted_list_remove_item instead of clds_sorted_list_delete_item and release the removed item after handing it to the snapshots and the change log. ]*/
+    if ((InterlockedAdd64(&clds_hash_table->snapshot_generation, 0) == 0) && !is_snapshot_at_capturing(clds_hash_table) && !is_change_log_enabled(clds_hash_table))
+    {
+        /*Codes_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
+        result = clds_sorted_list_delete_item(bucket_list, clds_hazard_pointers_thread, item, sequence_number);
+    }
+    else
+    {
+        CLDS_SORTED_LIST_REMOVE_RESULT remove_result = clds_sorted_list_remove_item(bucket_list, clds_hazard_pointers_thread, item, sequence_number);
+        switch (remove_result)
+        {
+        default:
+        case CLDS_SORTED_LIST_REMOVE_ERROR:
+            result = CLDS_SORTED_LIST_DELETE_ERROR;
+            break;
+
+        case CLDS_SORTED_LIST_REMOVE_NOT_FOUND:
+            result = CLDS_SORTED_LIST_DELETE_NOT_FOUND;
+            break;
+
+        case CLDS_SORTED_LIST_REMOVE_OK:
+            hand_over_deleted_item(clds_hash_table, item, sequence_number);
+            result = CLDS_SORTED_LIST_DELETE_OK;
+            break;
+        }
+    }
+
+    return result;
+}
+
+static void reclaim_bucket_array(void* node)
+{
+    BUCKET_ARRAY* bucket_array = (BUCKET_ARRAY*)node;
+    LONG i;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_138: [ When a retired array of buckets is reclaimed, all its bucket lists shall be destroyed and its memory shall be freed. ]*/
+    for (i = 0; i < bucket_array->bucket_count; i++)
+    {
+        CLDS_SORTED_LIST_HANDLE bucket_list = InterlockedCompareExchangePointer(&bucket_array->hash_table[i], NULL, NULL);
+        if (bucket_list != NULL)
+        {
+            clds_sorted_list_destroy(bucket_list);
+        }
+    }
+
+    free(bucket_array);
+}
+
+// moves all the items of bucket_list (which belongs to source_bucket_array) to the target bucket array
+// the caller holds the writes to source_bucket_array locked
+static void migrate_bucket(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_HANDLE bucket_list, BUCKET_ARRAY* source_bucket_array, BUCKET_ARRAY* target_bucket_array)
+{
+    int64_t sequence_number;
+    int64_t* sequence_number_ptr = (clds_hash_table->sequence_number == NULL) ? NULL : &sequence_number;
+
+    // make the sequence odd, so that misses of concurrent lookups are retried
+    (void)InterlockedIncrement(&clds_hash_table->migration_sequence);
+
+    do
+    {
+        CLDS_SORTED_LIST_ITEM* item;
+        CLDS_SORTED_LIST_REMOVE_RESULT remove_result = clds_sorted_list_remove_first(bucket_list, clds_hazard_pointers_thread, &item, sequence_number_ptr);
+        if (remove_result == CLDS_SORTED_LIST_REMOVE_NOT_FOUND)
+        {
+            // bucket is empty
+            break;
+        }
+        else if (remove_result != CLDS_SORTED_LIST_REMOVE_OK)
+        {
+            LogError("Cannot remove item from bucket list: failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_REMOVE_RESULT, remove_result));
+            break;
+        }
+        else
+        {
+            uint64_t hash;
+            CLDS_SORTED_LIST_HANDLE target_bucket_list;
+            CLDS_SORTED_LIST_INSERT_RESULT insert_result;
+
+            if (sequence_number_ptr != NULL)
+            {
+                report_migration_sequence_number(clds_hash_table, sequence_number);
+            }
+
+            (void)InterlockedDecrement(&source_bucket_array->item_count);
+
+            // the item is out of the table until it is inserted in the target, a running snapshot could miss it
+            capture_item(clds_hash_table, item, get_item_write_generation(item));
+            /* Codes_SRS_CLDS_HASH_TABLE_01_206: [ While clds_hash_table_snapshot_at_current_sequence_number captures items, the migration of items shall capture each item it takes out of the table if its insert sequence number is at or before the snapshot sequence number. ]*/
+            snapshot_at_capture_item(clds_hash_table, item);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_133: [ For each of the next batch_size buckets of the oldest array of buckets, the items in the bucket shall be moved one by one to the top level array of buckets by calling clds_sorted_list_remove_first and inserting them with clds_sorted_list_insert in the list of the bucket corresponding to the hash of the key, creating the list if needed. ]*/
+            /* Codes_SRS_CLDS_HASH_TABLE_01_259: [ The migration of items shall use the hash stored in each moved item instead of hashing its key again. ]*/
+            hash = item->key_fingerprint;
+            target_bucket_list = get_or_create_bucket_list(clds_hash_table, target_bucket_array, hash % InterlockedAdd(&target_bucket_array->bucket_count, 0));
+            if (target_bucket_list == NULL)
+            {
+                insert_result = CLDS_SORTED_LIST_INSERT_ERROR;
+            }
+            else
+            {
+                (void)InterlockedIncrement(&target_bucket_array->item_count);
+                add_to_bloom_filter(target_bucket_array, hash);
+                insert_result = clds_sorted_list_insert(target_bucket_list, clds_hazard_pointers_thread, item, sequence_number_ptr);
+                if (insert_result != CLDS_SORTED_LIST_INSERT_OK)
+                {
+                    (void)InterlockedDecrement(&target_bucket_array->item_count);
+                }
+                else if (sequence_number_ptr != NULL)
+                {
+                    report_migration_sequence_number(clds_hash_table, sequence_number);
+                }
+            }
+
+            if (insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
+            {
+                // lookups start with the top level array, so the item there is the one the table returns and the moved item is a stale copy
+                // putting it back would leave it in the old array with no writer ever taking it out, so that the array would never be retired
+                /* Codes_SRS_CLDS_HASH_TABLE_01_268: [ If the key of a moved item already exists in the top level array of buckets, the item in the top level array of buckets shall be kept, the moved item shall be released and the migration of the bucket shall continue. ]*/
+                LogInfo("Migrated item key already exists in the top level bucket array, dropping the stale item");
+                clds_sorted_list_node_release(item);
+            }
+            else if (insert_result != CLDS_SORTED_LIST_INSERT_OK)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_136: [ If inserting a moved item in the top level array of buckets fails for any other reason, the item shall be inserted back in the list it was removed from and the migration of the bucket shall stop. ]*/
+                LogError("Cannot insert migrated item in the top level bucket array: failed with %" PRI_MU_ENUM ", putting it back", MU_ENUM_VALUE(CLDS_SORTED_LIST_INSERT_RESULT, insert_result));
+                (void)InterlockedIncrement(&source_bucket_array->item_count);
+                if (clds_sorted_list_insert(bucket_list, clds_hazard_pointers_thread, item, sequence_number_ptr) != CLDS_SORTED_LIST_INSERT_OK)
+                {
+                    LogError("Cannot put migrated item back in its bucket list, the item is lost");
+                    (void)InterlockedDecrement(&source_bucket_array->item_count);
+                    clds_sorted_list_node_release(item);
+                }
+                else if (sequence_number_ptr != NULL)
+                {
+                    report_migration_sequence_number(clds_hash_table, sequence_number);
+                }
+
+                break;
+            }
+        }
+    } while (1);
+
+    (void)InterlockedIncrement(&clds_hash_table->migration_sequence);
+}
+
+// pushes a smaller array of buckets on top of bucket_array if its load dropped under the shrink load factor
+// the items are then moved to the smaller array by the migration
+// the caller holds the migration lock and bucket_array is the only array of buckets
+static void shrink_if_needed(CLDS_HASH_TABLE* clds_hash_table, BUCKET_ARRAY* bucket_array)
+{
+    LONG shrink_load_factor = InterlockedAdd(&clds_hash_table->shrink_load_factor, 0);
+    if (shrink_load_factor != 0)
+    {
+        LONG bucket_count = InterlockedAdd(&bucket_array->bucket_count, 0);
+        int64_t item_count = InterlockedAdd(&bucket_array->item_count, 0);
+        LONG new_bucket_count = bucket_count;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_146: [ If the migration batch size and the shrink load factor are non-zero, there is only one array of buckets and the number of items multiplied by 100 is less than the number of buckets multiplied by the shrink load factor, a new array of buckets shall be placed on top of it with the number of buckets halved for as long as the load stays under the shrink load factor, but not lower than the initial bucket size. ]*/
+        while (((new_bucket_count / 2) >= clds_hash_table->initial_bucket_count) &&
+            ((item_count * 100) < ((int64_t)new_bucket_count * shrink_load_factor)))
+        {
+            new_bucket_count /= 2;
+        }
+
+        if (new_bucket_count < bucket_count)
+        {
+            LONG bloom_filter_word_count = get_bloom_filter_word_count(clds_hash_table, new_bucket_count);
+            BUCKET_ARRAY* new_bucket_array = (BUCKET_ARRAY*)malloc(get_bucket_array_size(new_bucket_count, bloom_filter_word_count));
+            if (new_bucket_array == NULL)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_148: [ If allocating the smaller array of buckets fails, the hash table shall not be shrunk and the write operation shall not fail. ]*/
+                LogError("Cannot allocate smaller bucket array, not shrinking");
+            }
+            else
+            {
+                initialize_bucket_array(new_bucket_array, new_bucket_count, bloom_filter_word_count, bucket_array);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_147: [ The items of the larger array of buckets shall be moved to the smaller array of buckets by the migration of items out of the older arrays of buckets. ]*/
+                if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, new_bucket_array, bucket_array) != bucket_array)
+                {
+                    // the table grew in the meanwhile, no need to shrink
+                    free(new_bucket_array);
+                }
+            }
+        }
+    }
+}
+
+static void migrate_buckets(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    LONG batch_size = InterlockedAdd(&clds_hash_table->migration_batch_size, 0);
+
+    if ((batch_size != 0) &&
+        /* Codes_SRS_CLDS_HASH_TABLE_01_132: [ If another thread is already migrating items, no items shall be migrated. ]*/
+        (InterlockedCompareExchange(&clds_hash_table->migration_in_progress, 1, 0) == 0))
+    {
+        // only the migrating thread unlinks bucket arrays, so it can walk them without hazard pointers
+        BUCKET_ARRAY* target_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
+        BUCKET_ARRAY* previous_bucket_array = target_bucket_array;
+        BUCKET_ARRAY* oldest_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&target_bucket_array->next_bucket, NULL, NULL);
+
+        if (oldest_bucket_array == NULL)
+        {
+            shrink_if_needed(clds_hash_table, target_bucket_array);
+        }
+        else
+        {
+            BUCKET_ARRAY* next_bucket_array;
+            LONG bucket_count;
+            LONG migrated_count = 0;
+
+            while ((next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&oldest_bucket_array->next_bucket, NULL, NULL)) != NULL)
+            {
+                previous_bucket_array = oldest_bucket_array;
+                oldest_bucket_array = next_bucket_array;
+            }
+
+            bucket_count = InterlockedAdd(&oldest_bucket_array->bucket_count, 0);
+            while ((migrated_count < batch_size) &&
+                (InterlockedAdd(&oldest_bucket_array->migration_bucket_index, 0) < bucket_count))
+            {
+                LONG bucket_index = InterlockedAdd(&oldest_bucket_array->migration_bucket_index, 0);
+                CLDS_SORTED_LIST_HANDLE bucket_list = InterlockedCompareExchangePointer(&oldest_bucket_array->hash_table[bucket_index], NULL, NULL);
+                if (bucket_list != NULL)
+                {
+                    lock_bucket_array_writes(clds_hash_table, oldest_bucket_array);
+                    migrate_bucket(clds_hash_table, clds_hazard_pointers_thread, bucket_list, oldest_bucket_array, target_bucket_array);
+                    unlock_bucket_array_writes(oldest_bucket_array);
+                }
+
+                (void)InterlockedIncrement(&oldest_bucket_array->migration_bucket_index);
+                migrated_count++;
+            }
+
+            if (InterlockedAdd(&oldest_bucket_array->migration_bucket_index, 0) == bucket_count)
+            {
+                lock_bucket_array_writes(clds_hash_table, oldest_bucket_array);
+
+                if (InterlockedAdd(&oldest_bucket_array->item_count, 0) == 0)
+                {
+                    // nothing can be added to the array anymore, so it can go
+                    (void)InterlockedExchange(&oldest_bucket_array->retired, 1);
+                    unlock_bucket_array_writes(oldest_bucket_array);
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_137: [ Once all the buckets of the oldest array of buckets have been visited, if the array has no items it shall be unlinked from the list of arrays of buckets and released by calling clds_hazard_pointers_reclaim, otherwise its buckets shall be visited again starting with the first one. ]*/
+                    (void)InterlockedExchangePointer((volatile PVOID*)&previous_bucket_array->next_bucket, NULL);
+                    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, oldest_bucket_array, reclaim_bucket_array);
+                }
+                else
+                {
+                    // items were inserted in the meanwhile by operations that started while this was the top level array
+                    (void)InterlockedExchange(&oldest_bucket_array->migration_bucket_index, 0);
+                    unlock_bucket_array_writes(oldest_bucket_array);
+                }
+            }
+        }
+
+        unlock_migration(clds_hash_table);
+    }
+}
+
+CLDS_HASH_TABLE_HANDLE clds_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
+{
+    CLDS_HASH_TABLE_HANDLE clds_hash_table;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_058: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+    /* Codes_S_R_S_CLDS_HASH_TABLE_01_072: [ skipped_seq_no_cb shall be allowed to be NULL. ]*/
+    /* Codes_S_R_S_CLDS_HASH_TABLE_01_073: [ skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_003: [ If compute_hash is NULL, clds_hash_table_create shall fail and return NULL. ]*/
+        (compute_hash == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_045: [ If key_compare_func is NULL, clds_hash_table_create shall fail and return NULL. ]*/
+        (key_compare_func == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_004: [ If initial_bucket_size is 0, clds_hash_table_create shall fail and return NULL. ]*/
+        (initial_bucket_size == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_005: [ If clds_hazard_pointers is NULL, clds_hash_table_create shall fail and return NULL. ]*/
+        (clds_hazard_pointers == NULL) ||
+        /* Codes_S_R_S_CLDS_HASH_TABLE_01_074: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_sorted_list_create shall fail and return NULL. ]*/
+        ((start_sequence_number == NULL) && (skipped_seq_no_cb != NULL))
+        )
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
+        LogError("Invalid arguments: COMPUTE_HASH_FUNC compute_hash=%p, KEY_COMPARE_FUNC key_compare_func=%p, size_t initial_bucket_size=%zu, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, volatile int64_t* start_sequence_number=%p, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb=%p, void* skipped_seq_no_cb_context=%p",
+            compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_001: [ clds_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
+        clds_hash_table = (CLDS_HASH_TABLE_HANDLE)malloc(sizeof(CLDS_HASH_TABLE));
+        if (clds_hash_table == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
+            LogError("Cannot allocate memory for hash table");
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_027: [ The hash table shall maintain a list of arrays of buckets, so that it can be resized as needed. ]*/
+            clds_hash_table->first_hash_table = malloc(get_bucket_array_size((LONG)initial_bucket_size, 0));
+            if (clds_hash_table->first_hash_table == NULL)
+            {
+                LogError("Cannot allocate memory for hash table array");
+            }
+            else
+            {
+                uint32_t i;
+
+                // all OK
+                clds_hash_table->clds_hazard_pointers = clds_hazard_pointers;
+                clds_hash_table->compute_hash = compute_hash;
+                clds_hash_table->key_compare_func = key_compare_func;
+                clds_hash_table->skipped_seq_no_cb = skipped_seq_no_cb;
+                clds_hash_table->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
+                (void)InterlockedExchange(&clds_hash_table->sequence_number_block_size, 0);
+                (void)InterlockedExchangePointer((volatile PVOID*)&clds_hash_table->sequence_number_blocks, NULL);
+                (void)InterlockedExchange(&clds_hash_table->backoff_policy, CLDS_BACKOFF_POLICY_NONE);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_130: [ If batch_size is 0, no items shall be migrated, which is also the behavior when clds_hash_table_set_migration_batch_size is not called. ]*/
+                (void)InterlockedExchange(&clds_hash_table->migration_batch_size, 0);
+                (void)InterlockedExchange(&clds_hash_table->migration_in_progress, 0);
+                (void)InterlockedExchange(&clds_hash_table->migration_sequence, 0);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_145: [ If load_factor_percent is 0, the hash table shall not be shrunk, which is also the behavior when clds_hash_table_set_shrink_load_factor is not called. ]*/
+                clds_hash_table->initial_bucket_count = (LONG)initial_bucket_size;
+                (void)InterlockedExchange(&clds_hash_table->shrink_load_factor, 0);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_152: [ If bits_per_bucket is 0, no Bloom filters shall be allocated for new arrays of buckets, which is also the behavior when clds_hash_table_set_bloom_filter_bits_per_bucket is not called. ]*/
+                (void)InterlockedExchange(&clds_hash_table->bloom_filter_bits_per_bucket, 0);
+
+                for (i = 0; i < WRITE_GATE_SHARD_COUNT; i++)
+                {
+                    (void)InterlockedExchange(&clds_hash_table->pending_write_operations[i].pending_write_operations, 0);
+                }
+                (void)InterlockedExchange(&clds_hash_table->locked_for_write, 0);
+                (void)InterlockedExchange(&clds_hash_table->write_waiter_count, 0);
+
+                (void)InterlockedExchange64(&clds_hash_table->write_generation, 1);
+                (void)InterlockedExchange64(&clds_hash_table->snapshot_generation, 0);
+                (void)InterlockedExchange(&clds_hash_table->snapshot_in_progress, 0);
+                (void)InterlockedExchange(&clds_hash_table->snapshot_failed, 0);
+                (void)InterlockedExchangePointer((volatile PVOID*)&clds_hash_table->captured_items, NULL);
+                (void)InterlockedExchange(&clds_hash_table->snapshot_at_capturing, 0);
+                (void)InterlockedExchange64(&clds_hash_table->snapshot_at_id, 0);
+                (void)InterlockedExchange64(&clds_hash_table->snapshot_at_sequence_number, 0);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_227: [ The change log shall be disabled, which is also the behavior when clds_hash_table_set_change_log_enabled is not called. ]*/
+                (void)InterlockedExchange(&clds_hash_table->change_log_enabled, 0);
+                (void)InterlockedExchange(&clds_hash_table->change_log_in_use, 0);
+                (void)InterlockedExchange64(&clds_hash_table->change_log_start_sequence_number, 0);
+                (void)InterlockedExchangePointer((volatile PVOID*)&clds_hash_table->change_log, NULL);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_057: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every operation that is done on the hash table. ]*/
+                clds_hash_table->sequence_number = start_sequence_number;
+
+                // set the initial bucket count
+                initialize_bucket_array((BUCKET_ARRAY*)clds_hash_table->first_hash_table, (LONG)initial_bucket_size, 0, NULL);
+
+                goto all_ok;
+            }
+
+            free(clds_hash_table);
+        }
+    }
+
+    clds_hash_table = NULL;
+
+all_ok:
+    return clds_hash_table;
+}
+
+static void sorted_list_item_cleanup(void* context, CLDS_SORTED_LIST_ITEM* item)
+{
+    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+
+    (void)context;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_271: [ The state kept by the snapshots for an item shall be allocated the first time a running snapshot has to record anything on the item and freed when the item is freed. ]*/
+    if (hash_table_item->snapshot_state != NULL)
+    {
+        free(hash_table_item->snapshot_state);
+    }
+
+    if (hash_table_item->item_cleanup_callback != NULL)
+    {
+        hash_table_item->item_cleanup_callback(hash_table_item->item_cleanup_callback_context, (void*)item);
+    }
+}
+
+void clds_hash_table_destroy(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+{
+    if (clds_hash_table == NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_007: [ If clds_hash_table is NULL, clds_hash_table_destroy shall return. ]*/
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p", clds_hash_table);
+    }
+    else
+    {
+        LONG i;
+
+        BUCKET_ARRAY* bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (bucket_array != NULL)
+        {
+            BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&bucket_array->next_bucket, NULL, NULL);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_006: [ clds_hash_table_destroy shall free all resources associated with the hash table instance. ]*/
+            for (i = 0; i < bucket_array->bucket_count; i++)
+            {
+                if (bucket_array->hash_table[i] != NULL)
+                {
+                    CLDS_SORTED_LIST_HANDLE linked_list = InterlockedCompareExchangePointer(&bucket_array->hash_table[i], NULL, NULL);
+                    if (linked_list != NULL)
+                    {
+                        clds_sorted_list_destroy(linked_list);
+                    }
+                }
+            }
+
+            free(bucket_array);
+            bucket_array = next_bucket_array;
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_249: [ clds_hash_table_destroy shall release the items held by the change log and free it. ]*/
+        free_change_log_records(InterlockedExchangePointer((volatile PVOID*)&clds_hash_table->change_log, NULL));
+
+        CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks = (CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE)InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->sequence_number_blocks, NULL, NULL);
+        if (sequence_number_blocks != NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_261: [ If sequence number blocks were created, clds_hash_table_destroy shall report the sequence numbers reserved by threads but never used through skipped_seq_no_cb by calling clds_hazard_pointers_sequence_number_blocks_destroy. ]*/
+            clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks);
+        }
+
+        free(clds_hash_table);
+    }
+}
+
+int clds_hash_table_set_sequence_number_block_size(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t block_size)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_114: [ If clds_hash_table is NULL, clds_hash_table_set_sequence_number_block_size shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_115: [ If block_size is non-zero and no start sequence number was specified in clds_hash_table_create, clds_hash_table_set_sequence_number_block_size shall fail and return a non-zero value. ]*/
+        ((block_size != 0) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, uint32_t block_size=%" PRIu32,
+            clds_hash_table, block_size);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        LONG i;
+        CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks = (CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE)InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->sequence_number_blocks, NULL, NULL);
+
+        if ((block_size != 0) && (sequence_number_blocks == NULL))
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_262: [ If block_size is non-zero and the sequence number blocks of the table were not created yet, clds_hash_table_set_sequence_number_block_size shall create them by calling clds_hazard_pointers_sequence_number_blocks_create with the start sequence number. ]*/
+            CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE new_sequence_number_blocks = clds_hazard_pointers_sequence_number_blocks_create((volatile int64_t*)clds_hash_table->sequence_number, clds_hash_table->skipped_seq_no_cb == NULL ? NULL : on_sorted_list_skipped_seq_no, clds_hash_table);
+            if (new_sequence_number_blocks == NULL)
+            {
+                LogError("Cannot create sequence number blocks");
+            }
+            else
+            {
+                sequence_number_blocks = (CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE)InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->sequence_number_blocks, new_sequence_number_blocks, NULL);
+                if (sequence_number_blocks == NULL)
+                {
+                    sequence_number_blocks = new_sequence_number_blocks;
+                }
+                else
+                {
+                    // someone else set the block size at the same time, use their blocks
+                    clds_hazard_pointers_sequence_number_blocks_destroy(new_sequence_number_blocks);
+                }
+            }
+        }
+
+        if ((block_size != 0) && (sequence_number_blocks == NULL))
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_118: [ If any error occurs, clds_hash_table_set_sequence_number_block_size shall fail and return a non-zero value. ]*/
+            result = MU_FAILURE;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_113: [ clds_hash_table_set_sequence_number_block_size shall store block_size as the number of sequence numbers that each thread reserves at once and on success return 0. ]*/
+            (void)InterlockedExchange(&clds_hash_table->sequence_number_block_size, (LONG)block_size);
+
+            result = 0;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_117: [ clds_hash_table_set_sequence_number_block_size shall call clds_sorted_list_set_sequence_number_blocks with the sequence number blocks of the table for all the existing bucket lists. ]*/
+            // keep the migration from reclaiming bucket arrays while walking them
+            lock_migration(clds_hash_table);
+
+            BUCKET_ARRAY* bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
+            while (bucket_array != NULL)
+            {
+                for (i = 0; i < InterlockedAdd(&bucket_array->bucket_count, 0); i++)
+                {
+                    CLDS_SORTED_LIST_HANDLE bucket_list = InterlockedCompareExchangePointer(&bucket_array->hash_table[i], NULL, NULL);
+                    if ((bucket_list != NULL) &&
+                        (clds_sorted_list_set_sequence_number_blocks(bucket_list, sequence_number_blocks, block_size) != 0))
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_118: [ If any error occurs, clds_hash_table_set_sequence_number_block_size shall fail and return a non-zero value. ]*/
+                        LogError("Cannot set sequence number block size %" PRIu32 " on bucket list", block_size);
+                        result = MU_FAILURE;
+                    }
+                }
+
+                bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&bucket_array->next_bucket, NULL, NULL);
+            }
+
+            unlock_migration(clds_hash_table);
+        }
+    }
+
+    return result;
+}
+
+int clds_hash_table_set_backoff_policy(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_BACKOFF_POLICY backoff_policy)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_120: [ If clds_hash_table is NULL, clds_hash_table_set_backoff_policy shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_121: [ If backoff_policy is not a valid CLDS_BACKOFF_POLICY value, clds_hash_table_set_backoff_policy shall fail and return a non-zero value. ]*/
+        ((int)backoff_policy < (int)CLDS_BACKOFF_POLICY_NONE) ||
+        ((int)backoff_policy > (int)CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_BACKOFF_POLICY backoff_policy=%" PRI_MU_ENUM "",
+            clds_hash_table, MU_ENUM_VALUE(CLDS_BACKOFF_POLICY, backoff_policy));
+        result = MU_FAILURE;
+    }
+    else
+    {
+        LONG i;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_119: [ clds_hash_table_set_backoff_policy shall store backoff_policy as the backoff policy used by the hash table and its bucket lists and on success return 0. ]*/
+        (void)InterlockedExchange(&clds_hash_table->backoff_policy, (LONG)backoff_policy);
+
+        result = 0;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_123: [ clds_hash_table_set_backoff_policy shall call clds_sorted_list_set_backoff_policy for all the existing bucket lists. ]*/
+        // keep the migration from reclaiming bucket arrays while walking them
+        lock_migration(clds_hash_table);
+
+        BUCKET_ARRAY* bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (bucket_array != NULL)
+        {
+            for (i = 0; i < InterlockedAdd(&bucket_array->bucket_count, 0); i++)
+            {
+                CLDS_SORTED_LIST_HANDLE bucket_list = InterlockedCompareExchangePointer(&bucket_array->hash_table[i], NULL, NULL);
+                if ((bucket_list != NULL) &&
+                    (clds_sorted_list_set_backoff_policy(bucket_list, backoff_policy) != 0))
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_124: [ If any error occurs, clds_hash_table_set_backoff_policy shall fail and return a non-zero value. ]*/
+                    LogError("Cannot set backoff policy %" PRI_MU_ENUM " on bucket list", MU_ENUM_VALUE(CLDS_BACKOFF_POLICY, backoff_policy));
+                    result = MU_FAILURE;
+                }
+            }
+
+            bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&bucket_array->next_bucket, NULL, NULL);
+        }
+
+        unlock_migration(clds_hash_table);
+    }
+
+    return result;
+}
+
+int clds_hash_table_set_migration_batch_size(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t batch_size)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_128: [ If clds_hash_table is NULL, clds_hash_table_set_migration_batch_size shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_129: [ If batch_size is greater than INT32_MAX, clds_hash_table_set_migration_batch_size shall fail and return a non-zero value. ]*/
+        (batch_size > INT32_MAX)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, uint32_t batch_size=%" PRIu32,
+            clds_hash_table, batch_size);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_127: [ clds_hash_table_set_migration_batch_size shall store batch_size as the number of buckets of the oldest array of buckets whose items are moved to the top level array of buckets by each write operation and on success return 0. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_130: [ If batch_size is 0, no items shall be migrated, which is also the behavior when clds_hash_table_set_migration_batch_size is not called. ]*/
+        (void)InterlockedExchange(&clds_hash_table->migration_batch_size, (LONG)batch_size);
+
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_hash_table_set_shrink_load_factor(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t load_factor_percent)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_143: [ If clds_hash_table is NULL, clds_hash_table_set_shrink_load_factor shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_144: [ If load_factor_percent is greater than or equal to 50, clds_hash_table_set_shrink_load_factor shall fail and return a non-zero value. ]*/
+        (load_factor_percent >= 50)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, uint32_t load_factor_percent=%" PRIu32,
+            clds_hash_table, load_factor_percent);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_142: [ clds_hash_table_set_shrink_load_factor shall store load_factor_percent as the load (in percents of the number of buckets) under which the hash table is shrunk and on success return 0. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_145: [ If load_factor_percent is 0, the hash table shall not be shrunk, which is also the behavior when clds_hash_table_set_shrink_load_factor is not called. ]*/
+        (void)InterlockedExchange(&clds_hash_table->shrink_load_factor, (LONG)load_factor_percent);
+
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_hash_table_set_bloom_filter_bits_per_bucket(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t bits_per_bucket)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_150: [ If clds_hash_table is NULL, clds_hash_table_set_bloom_filter_bits_per_bucket shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_151: [ If bits_per_bucket is greater than 32, clds_hash_table_set_bloom_filter_bits_per_bucket shall fail and return a non-zero value. ]*/
+        (bits_per_bucket > 32)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, uint32_t bits_per_bucket=%" PRIu32,
+            clds_hash_table, bits_per_bucket);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_149: [ clds_hash_table_set_bloom_filter_bits_per_bucket shall store bits_per_bucket as the number of Bloom filter bits allocated for each bucket of the arrays of buckets created afterwards and on success return 0. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_152: [ If bits_per_bucket is 0, no Bloom filters shall be allocated for new arrays of buckets, which is also the behavior when clds_hash_table_set_bloom_filter_bits_per_bucket is not called. ]*/
+        (void)InterlockedExchange(&clds_hash_table->bloom_filter_bits_per_bucket, (LONG)bits_per_bucket);
+
+        result = 0;
+    }
+
+    return result;
+}
+
+// clds_hash_table_snapshot_since, clds_hash_table_trim_change_log and disabling the change log do not run at the same time,
+// so that the records read by a snapshot are not freed under it
+static void acquire_change_log(CLDS_HASH_TABLE* clds_hash_table)
+{
+    while (InterlockedCompareExchange(&clds_hash_table->change_log_in_use, 1, 0) != 0)
+    {
+        LONG change_log_in_use = 1;
+        (void)WaitOnAddress(&clds_hash_table->change_log_in_use, &change_log_in_use, sizeof(LONG), INFINITE);
+    }
+}
+
+static void release_change_log(CLDS_HASH_TABLE* clds_hash_table)
+{
+    (void)InterlockedExchange(&clds_hash_table->change_log_in_use, 0);
+    WakeByAddressAll((PVOID)&clds_hash_table->change_log_in_use);
+}
+
+int clds_hash_table_set_change_log_enabled(CLDS_HASH_TABLE_HANDLE clds_hash_table, bool enabled)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_223: [ If clds_hash_table is NULL, clds_hash_table_set_change_log_enabled shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_224: [ If enabled is true and no start sequence number was specified in clds_hash_table_create or the sequence number block size is non-zero, clds_hash_table_set_change_log_enabled shall fail and return a non-zero value. ]*/
+        (enabled && ((clds_hash_table->sequence_number == NULL) || (InterlockedAdd(&clds_hash_table->sequence_number_block_size, 0) != 0)))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, bool enabled=%d",
+            clds_hash_table, (int)enabled);
+        result = MU_FAILURE;
+    }
+    else if (enabled)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_225: [ If enabled is true, clds_hash_table_set_change_log_enabled shall lock the table for writes, enable the change log starting at the last sequence number used by the table if it is not already enabled, unlock the table for writes and return 0. ]*/
+        internal_lock_writes(clds_hash_table);
+        if (!is_change_log_enabled(clds_hash_table))
+        {
+            (void)InterlockedExchange64(&clds_hash_table->change_log_start_sequence_number, InterlockedAdd64(clds_hash_table->sequence_number, 0));
+            (void)InterlockedExchange(&clds_hash_table->change_log_enabled, 1);
+        }
+        internal_unlock_writes(clds_hash_table);
+
+        result = 0;
+    }
+    else
+    {
+        CHANGE_LOG_RECORD* change_log;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_226: [ If enabled is false, clds_hash_table_set_change_log_enabled shall wait for any clds_hash_table_snapshot_since or clds_hash_table_trim_change_log call on the same table to complete, lock the table for writes, disable the change log, unlock the table for writes, release the items held by the change log, free it and return 0. ]*/
+        acquire_change_log(clds_hash_table);
+
+        internal_lock_writes(clds_hash_table);
+        (void)InterlockedExchange(&clds_hash_table->change_log_enabled, 0);
+        change_log = InterlockedExchangePointer((volatile PVOID*)&clds_hash_table->change_log, NULL);
+        internal_unlock_writes(clds_hash_table);
+
+        release_change_log(clds_hash_table);
+
+        free_change_log_records(change_log);
+
+        result = 0;
+    }
+
+    return result;
+}
+
+// takes a record out of the change log, the writers only ever push records on top of the log, so only the top of the log is contended
+static void unlink_change_log_record(CLDS_HASH_TABLE* clds_hash_table, CHANGE_LOG_RECORD* previous_record, CHANGE_LOG_RECORD* change_log_record)
+{
+    if (previous_record != NULL)
+    {
+        previous_record->next = change_log_record->next;
+    }
+    else if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->change_log, (PVOID)change_log_record->next, (PVOID)change_log_record) != (PVOID)change_log_record)
+    {
+        // records were pushed on top of it in the meanwhile, find the one right above it
+        previous_record = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->change_log, NULL, NULL);
+        while (previous_record->next != change_log_record)
+        {
+            previous_record = previous_record->next;
+        }
+
+        previous_record->next = change_log_record->next;
+    }
+}
+
+int clds_hash_table_trim_change_log(CLDS_HASH_TABLE_HANDLE clds_hash_table, int64_t sequence_number)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_228: [ If clds_hash_table is NULL, clds_hash_table_trim_change_log shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, int64_t sequence_number=%" PRId64,
+            clds_hash_table, sequence_number);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_229: [ clds_hash_table_trim_change_log shall wait for any clds_hash_table_snapshot_since or other clds_hash_table_trim_change_log call on the same table to complete. ]*/
+        acquire_change_log(clds_hash_table);
+
+        if (!is_change_log_enabled(clds_hash_table))
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_230: [ If the change log is not enabled, clds_hash_table_trim_change_log shall fail and return a non-zero value. ]*/
+            LogError("The change log is not enabled");
+            result = MU_FAILURE;
+        }
+        else
+        {
+            CHANGE_LOG_RECORD* previous_record = NULL;
+            CHANGE_LOG_RECORD* change_log_record = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->change_log, NULL, NULL);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_232: [ clds_hash_table_trim_change_log shall move the start of the change log to sequence_number if it is before it and return 0. ]*/
+            advance_change_log_start(clds_hash_table, sequence_number);
+
+            while (change_log_record != NULL)
+            {
+                CHANGE_LOG_RECORD* next_change_log_record = change_log_record->next;
+
+                if (change_log_record->change.sequence_number <= sequence_number)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_231: [ clds_hash_table_trim_change_log shall take out of the change log each change with a sequence number at or before sequence_number, release the item it holds and free it. ]*/
+                    unlink_change_log_record(clds_hash_table, previous_record, change_log_record);
+                    clds_sorted_list_node_release((void*)change_log_record->change.item);
+                    free(change_log_record);
+                }
+                else
+                {
+                    previous_record = change_log_record;
+                }
+
+                change_log_record = next_change_log_record;
+            }
+
+            result = 0;
+        }
+
+        release_change_log(clds_hash_table);
+    }
+
+    return result;
+}
+
+static KEY_LOOKUP_RESULT find_key_to_insert(void* context, BUCKET_ARRAY* bucket_array, CLDS_SORTED_LIST_HANDLE bucket_list)
+{
+    KEY_LOOKUP_RESULT result;
+    INSERT_CONTEXT* insert_context = (INSERT_CONTEXT*)context;
+    CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_find_key(bucket_list, insert_context->clds_hazard_pointers_thread, insert_context->lookup_key);
+
+    (void)bucket_array;
+
+    if (sorted_list_item == NULL)
+    {
+        result = KEY_LOOKUP_NOT_FOUND;
+    }
+    else
+    {
+        clds_sorted_list_node_release(sorted_list_item);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_046: [ If the key already exists in the hash table, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ALREADY_EXISTS. ]*/
+        insert_context->result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+        result = KEY_LOOKUP_DONE;
+    }
+
+    return result;
+}
+
+static void insert_in_top_level(void* context, BUCKET_ARRAY* top_level_bucket_array)
+{
+    INSERT_CONTEXT* insert_context = (INSERT_CONTEXT*)context;
+    CLDS_HASH_TABLE* clds_hash_table = insert_context->clds_hash_table;
+    CLDS_SORTED_LIST_HANDLE bucket_list;
+
+    (void)InterlockedIncrement(&top_level_bucket_array->item_count);
+
+    // find the bucket
+    /* Codes_SRS_CLDS_HASH_TABLE_01_018: [ clds_hash_table_insert shall obtain the bucket index to be used by calling compute_hash and passing to it the key value. ]*/
+    /* Codes_SRS_CLDS_HASH_TABLE_01_019: [ If no sorted list exists at the determined bucket index then a new list shall be created. ]*/
+    bucket_list = get_or_create_bucket_list(clds_hash_table, top_level_bucket_array, insert_context->hash % InterlockedAdd(&top_level_bucket_array->bucket_count, 0));
+    if (bucket_list == NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        LogError("Cannot acquire bucket list");
+        insert_context->result = CLDS_HASH_TABLE_INSERT_ERROR;
+    }
+    else
+    {
+        CLDS_SORTED_LIST_INSERT_RESULT list_insert_result;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_255: [ clds_hash_table_insert and clds_hash_table_set_value shall store the key and its hash in the item they put in the table, with the hash set as the key fingerprint of the node. ]*/
+        set_item_key(insert_context->value, insert_context->hash, insert_context->key);
+
+        add_to_bloom_filter(top_level_bucket_array, insert_context->hash);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_insert. ]*/
+        list_insert_result = clds_sorted_list_insert(bucket_list, insert_context->clds_hazard_pointers_thread, (void*)insert_context->value, insert_context->sequence_number);
+
+        if (list_insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_046: [ If the key already exists in the hash table, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ALREADY_EXISTS. ]*/
+            insert_context->result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+        }
+        else if (list_insert_result != CLDS_SORTED_LIST_INSERT_OK)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+            LogError("Cannot insert hash table item into list");
+            insert_context->result = CLDS_HASH_TABLE_INSERT_ERROR;
+        }
+        else
+        {
+            snapshot_at_end_insert(clds_hash_table, (void*)insert_context->value, insert_context->value_was_captured, insert_context->sequence_number);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_251: [ While the change log is enabled, clds_hash_table_insert and clds_hash_table_set_value shall add to the change log a change with the sequence number of the operation, holding a reference to the item they put in the table, CLDS_HASH_TABLE_CHANGE_REPLACE if it replaced an item and CLDS_HASH_TABLE_CHANGE_INSERT otherwise. ]*/
+            log_change(clds_hash_table, CLDS_HASH_TABLE_CHANGE_INSERT, (void*)insert_context->value, insert_context->sequence_number);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_009: [ On success clds_hash_table_insert shall return CLDS_HASH_TABLE_INSERT_OK. ]*/
+            insert_context->result = CLDS_HASH_TABLE_INSERT_OK;
+        }
+    }
+
+    if (insert_context->result != CLDS_HASH_TABLE_INSERT_OK)
+    {
+        // the item did not make it in the array, so it must not keep the array from being retired or count towards its load
+        /* Codes_SRS_CLDS_HASH_TABLE_01_267: [ If clds_hash_table_insert does not insert the item, the count of items of the top level array of buckets shall be left as it was before the insert. ]*/
+        (void)InterlockedDecrement(&top_level_bucket_array->item_count);
+    }
+}
+
+CLDS_HASH_TABLE_INSERT_RESULT clds_hash_table_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_010: [ If clds_hash_table is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_011: [ If key is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_012: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_062: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
+        result = CLDS_HASH_TABLE_INSERT_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_032: [ clds_hash_table_insert shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_033: [ clds_hash_table_insert shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_034: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_035: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_036: [ clds_hash_table_insert shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        WRITE_GATE_SHARD* write_gate_shard = check_lock_and_begin_write_operation(clds_hash_table);
+
+        INSERT_CONTEXT insert_context;
+        CLDS_HASH_TABLE_ITEM lookup_item;
+        int64_t operation_sequence_number;
+        SNAPSHOT_AT_ITEM_SEQUENCE_NUMBERS previous_sequence_numbers;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_168: [ clds_hash_table_insert and clds_hash_table_set_value shall stamp the item they put in the table with the current generation of the table. ]*/
+        (void)stamp_item_write_generation(clds_hash_table, (void*)value);
+
+        insert_context.clds_hash_table = clds_hash_table;
+        insert_context.clds_hazard_pointers_thread = clds_hazard_pointers_thread;
+        insert_context.key = key;
+        insert_context.value = value;
+        insert_context.sequence_number = get_operation_sequence_number_ptr(clds_hash_table, sequence_number, &operation_sequence_number);
+        insert_context.value_was_captured = snapshot_at_begin_insert(clds_hash_table, (void*)value, &previous_sequence_numbers);
+        insert_context.result = CLDS_HASH_TABLE_INSERT_ERROR;
+
+        // compute the hash
+        /* Codes_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        insert_context.hash = clds_hash_table->compute_hash(key);
+        /* Codes_SRS_CLDS_HASH_TABLE_01_260: [ clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_remove, clds_hash_table_set_value and clds_hash_table_find shall pass the key together with its hash to the bucket lists. ]*/
+        insert_context.lookup_key = init_lookup_item(&lookup_item, insert_context.hash, key);
+
+        // check if the key exists in the lower level bucket arrays, then insert in the top level one
+        if (lookup_key(clds_hash_table, clds_hazard_pointers_thread, is_migration_enabled(clds_hash_table), insert_context.hash, find_key_to_insert, insert_in_top_level, &insert_context) == KEY_LOOKUP_ERROR)
+        {
+            result = CLDS_HASH_TABLE_INSERT_ERROR;
+        }
+        else
+        {
+            result = insert_context.result;
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_131: [ If the migration batch size is non-zero and there is more than one array of buckets, clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall migrate items out of the oldest array of buckets before decrementing the count of pending write operations. ]*/
+        migrate_buckets(clds_hash_table, clds_hazard_pointers_thread);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_063: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, write_gate_shard);
+    }
+    return result;
+}
+
+static bool find_by_key_value(void* item_compare_context, CLDS_SORTED_LIST_ITEM* item)
+{
+    bool result;
+    FIND_BY_KEY_VALUE_CONTEXT* find_by_key_value_context = (FIND_BY_KEY_VALUE_CONTEXT*)item_compare_context;
+    HASH_TABLE_ITEM* hash_table_item = (HASH_TABLE_ITEM*)CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+
+    if ((item != find_by_key_value_context->value) ||
+        (find_by_key_value_context->key_compare_func(hash_table_item->key, find_by_key_value_context->key) != 0))
+    {
+        result = false;
+    }
+    else
+    {
+        result = true;
+    }
+
+    return result;
+}
+
+static KEY_LOOKUP_RESULT delete_from_bucket_list(void* context, BUCKET_ARRAY* bucket_array, CLDS_SORTED_LIST_HANDLE bucket_list)
+{
+    KEY_LOOKUP_RESULT result;
+    DELETE_CONTEXT* delete_context = (DELETE_CONTEXT*)context;
+
+    if (!begin_bucket_array_write(delete_context->clds_hash_table, bucket_array, delete_context->migration_enabled))
+    {
+        // the array was retired, its items were moved to the newer arrays
+        result = KEY_LOOKUP_NOT_FOUND;
+    }
+    else
+    {
+        CLDS_SORTED_LIST_DELETE_RESULT list_delete_result;
+
+        if (delete_context->item == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
+            /* Codes_SRS_CLDS_HASH_TABLE_01_170: [ While a snapshot taken with clds_hash_table_snapshot_concurrent is running, clds_hash_table_delete shall call clds_sorted_list_remove_key instead of clds_sorted_list_delete_key and release the removed item after adding it to the snapshot. ]*/
+            list_delete_result = delete_key_from_bucket_list(delete_context->clds_hash_table, delete_context->clds_hazard_pointers_thread, bucket_list, delete_context->lookup_key, delete_context->sequence_number);
+        }
+        else
+        {
+            list_delete_result = delete_item_from_bucket_list(delete_context->clds_hash_table, delete_context->clds_hazard_pointers_thread, bucket_list, delete_context->item, delete_context->sequence_number);
+        }
+
+        if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
+        {
+            // not found
+            /* Codes_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+            /*Codes_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+            result = KEY_LOOKUP_NOT_FOUND;
+        }
+        else if (list_delete_result == CLDS_SORTED_LIST_DELETE_OK)
+        {
+            (void)InterlockedDecrement(&bucket_array->item_count);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_014: [ On success clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
+            /*Codes_SRS_CLDS_HASH_TABLE_42_002: [ On success clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
+            delete_context->result = CLDS_HASH_TABLE_DELETE_OK;
+            result = KEY_LOOKUP_DONE;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_024: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+            /*Codes_SRS_CLDS_HASH_TABLE_42_009: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+            delete_context->result = CLDS_HASH_TABLE_DELETE_ERROR;
+            result = KEY_LOOKUP_DONE;
+        }
+
+        end_bucket_array_write(bucket_array, delete_context->migration_enabled);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_015: [ If clds_hash_table is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_016: [ If key is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, clds_hazard_pointers_thread, sequence_number);
+        result = CLDS_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_037: [ clds_hash_table_delete shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_038: [ clds_hash_table_delete shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_039: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_040: [ clds_hash_table_delete shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_041: [ clds_hash_table_delete shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        WRITE_GATE_SHARD* write_gate_shard = check_lock_and_begin_write_operation(clds_hash_table);
+
+        DELETE_CONTEXT delete_context;
+        CLDS_HASH_TABLE_ITEM lookup_item;
+        int64_t operation_sequence_number;
+
+        // compute the hash
+        /* Codes_SRS_CLDS_HASH_TABLE_01_039: [ clds_hash_table_delete shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = clds_hash_table->compute_hash(key);
+
+        delete_context.clds_hash_table = clds_hash_table;
+        delete_context.clds_hazard_pointers_thread = clds_hazard_pointers_thread;
+        delete_context.migration_enabled = is_migration_enabled(clds_hash_table);
+        /* Codes_SRS_CLDS_HASH_TABLE_01_260: [ clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_remove, clds_hash_table_set_value and clds_hash_table_find shall pass the key together with its hash to the bucket lists. ]*/
+        delete_context.lookup_key = init_lookup_item(&lookup_item, hash, key);
+        delete_context.item = NULL;
+        delete_context.sequence_number = get_operation_sequence_number_ptr(clds_hash_table, sequence_number, &operation_sequence_number);
+        delete_context.result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+
+        // always delete starting with the first bucket array
+        /* Codes_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
+        if (lookup_key(clds_hash_table, clds_hazard_pointers_thread, delete_context.migration_enabled, hash, delete_from_bucket_list, NULL, &delete_context) == KEY_LOOKUP_ERROR)
+        {
+            result = CLDS_HASH_TABLE_DELETE_ERROR;
+        }
+        else
+        {
+            result = delete_context.result;
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_131: [ If the migration batch size is non-zero and there is more than one array of buckets, clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall migrate items out of the oldest array of buckets before decrementing the count of pending write operations. ]*/
+        migrate_buckets(clds_hash_table, clds_hazard_pointers_thread);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_042: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, write_gate_shard);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete_key_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /*Codes_SRS_CLDS_HASH_TABLE_42_003: [ If clds_hash_table is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_005: [ If key is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (key == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_006: [ If value is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (value == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_004: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_012: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, value, clds_hazard_pointers_thread, sequence_number);
+        result = CLDS_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_043: [ clds_hash_table_delete_key_value shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_044: [ clds_hash_table_delete_key_value shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_045: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_046: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_047: [ clds_hash_table_delete_key_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        WRITE_GATE_SHARD* write_gate_shard = check_lock_and_begin_write_operation(clds_hash_table);
+
+        DELETE_CONTEXT delete_context;
+        int64_t operation_sequence_number;
+
+        // compute the hash
+        /*Codes_SRS_CLDS_HASH_TABLE_42_001: [ clds_hash_table_delete_key_value shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = clds_hash_table->compute_hash(key);
+
+        delete_context.clds_hash_table = clds_hash_table;
+        delete_context.clds_hazard_pointers_thread = clds_hazard_pointers_thread;
+        delete_context.migration_enabled = is_migration_enabled(clds_hash_table);
+        delete_context.lookup_key = NULL;
+        delete_context.item = (void*)value;
+        delete_context.sequence_number = get_operation_sequence_number_ptr(clds_hash_table, sequence_number, &operation_sequence_number);
+        delete_context.result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+
+        /*Codes_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+        /*Codes_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
+        if (lookup_key(clds_hash_table, clds_hazard_pointers_thread, delete_context.migration_enabled, hash, delete_from_bucket_list, NULL, &delete_context) == KEY_LOOKUP_ERROR)
+        {
+            result = CLDS_HASH_TABLE_DELETE_ERROR;
+        }
+        else
+        {
+            result = delete_context.result;
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_131: [ If the migration batch size is non-zero and there is more than one array of buckets, clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall migrate items out of the oldest array of buckets before decrementing the count of pending write operations. ]*/
+        migrate_buckets(clds_hash_table, clds_hazard_pointers_thread);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_048: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, write_gate_shard);
+    }
+
+    return result;
+}
+
+static KEY_LOOKUP_RESULT remove_from_bucket_list(void* context, BUCKET_ARRAY* bucket_array, CLDS_SORTED_LIST_HANDLE bucket_list)
+{
+    KEY_LOOKUP_RESULT result;
+    REMOVE_CONTEXT* remove_context = (REMOVE_CONTEXT*)context;
+
+    if (!begin_bucket_array_write(remove_context->clds_hash_table, bucket_array, remove_context->migration_enabled))
+    {
+        // the array was retired, its items were moved to the newer arrays
+        result = KEY_LOOKUP_NOT_FOUND;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove_key. ]*/
+        CLDS_SORTED_LIST_REMOVE_RESULT list_remove_result = clds_sorted_list_remove_key(bucket_list, remove_context->clds_hazard_pointers_thread, remove_context->lookup_key, (void*)remove_context->item, remove_context->sequence_number);
+        if (list_remove_result == CLDS_SORTED_LIST_REMOVE_NOT_FOUND)
+        {
+            // not found
+            /* Codes_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+            result = KEY_LOOKUP_NOT_FOUND;
+        }
+        else if (list_remove_result == CLDS_SORTED_LIST_REMOVE_OK)
+        {
+            (void)InterlockedDecrement(&bucket_array->item_count);
+
+            hand_over_removed_item(remove_context->clds_hash_table, (void*)*remove_context->item, remove_context->sequence_number);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_049: [ On success clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_OK. ]*/
+            remove_context->result = CLDS_HASH_TABLE_REMOVE_OK;
+            result = KEY_LOOKUP_DONE;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_054: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+            remove_context->result = CLDS_HASH_TABLE_REMOVE_ERROR;
+            result = KEY_LOOKUP_DONE;
+        }
+
+        end_bucket_array_write(bucket_array, remove_context->migration_enabled);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_REMOVE_RESULT clds_hash_table_remove(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_050: [ If clds_hash_table is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_052: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_051: [ If key is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_056: [ If item is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_070: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, clds_hazard_pointers_thread, item, sequence_number);
+        result = CLDS_HASH_TABLE_REMOVE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_049: [ clds_hash_table_remove shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_050: [ clds_hash_table_remove shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_051: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_052: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_053: [ clds_hash_table_remove shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        WRITE_GATE_SHARD* write_gate_shard = check_lock_and_begin_write_operation(clds_hash_table);
+
+        REMOVE_CONTEXT remove_context;
+        CLDS_HASH_TABLE_ITEM lookup_item;
+        int64_t operation_sequence_number;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_047: [ clds_hash_table_remove shall remove a key from the hash table and return a pointer to the item to the user. ]*/
+
+        // compute the hash
+        /* Codes_SRS_CLDS_HASH_TABLE_01_048: [ clds_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = clds_hash_table->compute_hash(key);
+
+        remove_context.clds_hash_table = clds_hash_table;
+        remove_context.clds_hazard_pointers_thread = clds_hazard_pointers_thread;
+        remove_context.migration_enabled = is_migration_enabled(clds_hash_table);
+        /* Codes_SRS_CLDS_HASH_TABLE_01_260: [ clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_remove, clds_hash_table_set_value and clds_hash_table_find shall pass the key together with its hash to the bucket lists. ]*/
+        remove_context.lookup_key = init_lookup_item(&lookup_item, hash, key);
+        remove_context.item = item;
+        remove_context.sequence_number = get_operation_sequence_number_ptr(clds_hash_table, sequence_number, &operation_sequence_number);
+        remove_context.result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
+        if (lookup_key(clds_hash_table, clds_hazard_pointers_thread, remove_context.migration_enabled, hash, remove_from_bucket_list, NULL, &remove_context) == KEY_LOOKUP_ERROR)
+        {
+            result = CLDS_HASH_TABLE_REMOVE_ERROR;
+        }
+        else
+        {
+            result = remove_context.result;
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_131: [ If the migration batch size is non-zero and there is more than one array of buckets, clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall migrate items out of the oldest array of buckets before decrementing the count of pending write operations. ]*/
+        migrate_buckets(clds_hash_table, clds_hazard_pointers_thread);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_054: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, write_gate_shard);
+    }
+
+    return result;
+}
+
+static KEY_LOOKUP_RESULT set_value_in_lower_level(void* context, BUCKET_ARRAY* bucket_array, CLDS_SORTED_LIST_HANDLE bucket_list)
+{
+    KEY_LOOKUP_RESULT result;
+    SET_VALUE_CONTEXT* set_value_context = (SET_VALUE_CONTEXT*)context;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_108: [ If there is a sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall find the key in the list. ]*/
+    CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_find_key(bucket_list, set_value_context->clds_hazard_pointers_thread, set_value_context->lookup_key);
+    if (sorted_list_item == NULL)
+    {
+        result = KEY_LOOKUP_NOT_FOUND;
+    }
+    else
+    {
+        clds_sorted_list_node_release(sorted_list_item);
+
+        if (!begin_bucket_array_write(set_value_context->clds_hash_table, bucket_array, set_value_context->migration_enabled))
+        {
+            // the array was retired, its items were moved to the newer arrays
+            result = KEY_LOOKUP_NOT_FOUND;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_255: [ clds_hash_table_insert and clds_hash_table_set_value shall store the key and its hash in the item they put in the table, with the hash set as the key fingerprint of the node. ]*/
+            set_item_key(set_value_context->new_item, set_value_context->hash, set_value_context->key);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item and old_item and only_if_exists set to true. ]*/
+            CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value_result = clds_sorted_list_set_value(bucket_list, set_value_context->clds_hazard_pointers_thread, set_value_context->lookup_key, (void*)set_value_context->new_item, (void*)set_value_context->old_item, set_value_context->sequence_number, true);
+
+            end_bucket_array_write(bucket_array, set_value_context->migration_enabled);
+
+            switch (sorted_list_set_value_result)
+            {
+            default:
+            case CLDS_SORTED_LIST_SET_VALUE_ERROR:
+                /* Codes_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                LogError("Cannot set key in sorted list: failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value_result));
+                set_value_context->result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+                result = KEY_LOOKUP_DONE;
+                break;
+
+            case CLDS_SORTED_LIST_SET_VALUE_OK:
+                /* Codes_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+                set_value_context->result = CLDS_HASH_TABLE_SET_VALUE_OK;
+                result = KEY_LOOKUP_DONE;
+                break;
+
+            case CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND:
+                /* Codes_SRS_CLDS_HASH_TABLE_01_109: [ If the key is not found, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
+                result = KEY_LOOKUP_NOT_FOUND;
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+static void set_value_in_top_level(void* context, BUCKET_ARRAY* top_level_bucket_array)
+{
+    SET_VALUE_CONTEXT* set_value_context = (SET_VALUE_CONTEXT*)context;
+    CLDS_SORTED_LIST_HANDLE bucket_list;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucked corresponding to the hash of the key. ]*/
+    /* Codes_SRS_CLDS_HASH_TABLE_01_104: [  If no list exists at the designated bucket, one shall be created. ]*/
+    bucket_list = get_or_create_bucket_list(set_value_context->clds_hash_table, top_level_bucket_array, set_value_context->hash % InterlockedAdd(&top_level_bucket_array->bucket_count, 0));
+    if (bucket_list == NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        LogError("Cannot acquire bucket list");
+        set_value_context->result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_255: [ clds_hash_table_insert and clds_hash_table_set_value shall store the key and its hash in the item they put in the table, with the hash set as the key fingerprint of the node. ]*/
+        set_item_key(set_value_context->new_item, set_value_context->hash, set_value_context->key);
+
+        add_to_bloom_filter(top_level_bucket_array, set_value_context->hash);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, old_item and only_if_exists set to false. ]*/
+        CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value = clds_sorted_list_set_value(bucket_list, set_value_context->clds_hazard_pointers_thread, set_value_context->lookup_key, (void*)set_value_context->new_item, (void*)set_value_context->old_item, set_value_context->sequence_number, false);
+        if (sorted_list_set_value != CLDS_SORTED_LIST_SET_VALUE_OK)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+            LogError("Cannot set key in sorted list");
+            set_value_context->result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+        }
+        else
+        {
+            if (*set_value_context->old_item == NULL)
+            {
+                (void)InterlockedIncrement(&top_level_bucket_array->item_count);
+            }
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+            set_value_context->result = CLDS_HASH_TABLE_SET_VALUE_OK;
+        }
+    }
+}
+
+CLDS_HASH_TABLE_SET_VALUE_RESULT clds_hash_table_set_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* new_item, CLDS_HASH_TABLE_ITEM** old_item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_079: [ If clds_hash_table is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_080: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_081: [ If key is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_082: [ If new_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (new_item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_083: [ If old_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (old_item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_084: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* new_item=%p, CLDS_HASH_TABLE_ITEM** old_item=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, clds_hazard_pointers_thread, new_item, old_item, sequence_number);
+        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_055: [ clds_hash_table_set_value shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_056: [ clds_hash_table_set_value shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_057: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_058: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_059: [ clds_hash_table_set_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        WRITE_GATE_SHARD* write_gate_shard = check_lock_and_begin_write_operation(clds_hash_table);
+
+        SET_VALUE_CONTEXT set_value_context;
+        CLDS_HASH_TABLE_ITEM lookup_item;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_168: [ clds_hash_table_insert and clds_hash_table_set_value shall stamp the item they put in the table with the current generation of the table. ]*/
+        int64_t new_item_previous_write_generation = stamp_item_write_generation(clds_hash_table, (void*)new_item);
+
+        int64_t operation_sequence_number;
+        int64_t* operation_sequence_number_ptr = get_operation_sequence_number_ptr(clds_hash_table, sequence_number, &operation_sequence_number);
+        SNAPSHOT_AT_ITEM_SEQUENCE_NUMBERS new_item_previous_sequence_numbers;
+        bool new_item_was_captured = snapshot_at_begin_insert(clds_hash_table, (void*)new_item, &new_item_previous_sequence_numbers);
+
+        set_value_context.clds_hash_table = clds_hash_table;
+        set_value_context.clds_hazard_pointers_thread = clds_hazard_pointers_thread;
+        set_value_context.migration_enabled = is_migration_enabled(clds_hash_table);
+        set_value_context.key = key;
+        set_value_context.new_item = new_item;
+        set_value_context.old_item = old_item;
+        set_value_context.sequence_number = operation_sequence_number_ptr;
+        set_value_context.result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+
+        // compute the hash
+        set_value_context.hash = clds_hash_table->compute_hash(key);
+        /* Codes_SRS_CLDS_HASH_TABLE_01_260: [ clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_remove, clds_hash_table_set_value and clds_hash_table_find shall pass the key together with its hash to the bucket lists. ]*/
+        set_value_context.lookup_key = init_lookup_item(&lookup_item, set_value_context.hash, key);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_107: [ If there is no sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
+        if (lookup_key(clds_hash_table, clds_hazard_pointers_thread, set_value_context.migration_enabled, set_value_context.hash, set_value_in_lower_level, set_value_in_top_level, &set_value_context) == KEY_LOOKUP_ERROR)
+        {
+            result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+        }
+        else
+        {
+            result = set_value_context.result;
+        }
+
+        if ((result == CLDS_HASH_TABLE_SET_VALUE_OK) && (*old_item != NULL))
+        {
+            // replacing an item with itself keeps it in the table, so it is judged by the generation it had before
+            capture_item(clds_hash_table, (void*)*old_item, (*old_item == new_item) ? new_item_previous_write_generation : get_item_write_generation((void*)*old_item));
+        }
+
+        if (result == CLDS_HASH_TABLE_SET_VALUE_OK)
+        {
+            if (*old_item == new_item)
+            {
+                snapshot_at_cancel_insert((void*)new_item, &new_item_previous_sequence_numbers);
+            }
+            else
+            {
+                snapshot_at_end_insert(clds_hash_table, (void*)new_item, new_item_was_captured, operation_sequence_number_ptr);
+
+                if (*old_item != NULL)
+                {
+                    snapshot_at_item_removed(clds_hash_table, (void*)*old_item, operation_sequence_number_ptr);
+                }
+            }
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_251: [ While the change log is enabled, clds_hash_table_insert and clds_hash_table_set_value shall add to the change log a change with the sequence number of the operation, holding a reference to the item they put in the table, CLDS_HASH_TABLE_CHANGE_REPLACE if it replaced an item and CLDS_HASH_TABLE_CHANGE_INSERT otherwise. ]*/
+            log_change(clds_hash_table, (*old_item == NULL) ? CLDS_HASH_TABLE_CHANGE_INSERT : CLDS_HASH_TABLE_CHANGE_REPLACE, (void*)new_item, operation_sequence_number_ptr);
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_131: [ If the migration batch size is non-zero and there is more than one array of buckets, clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall migrate items out of the oldest array of buckets before decrementing the count of pending write operations. ]*/
+        migrate_buckets(clds_hash_table, clds_hazard_pointers_thread);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_060: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, write_gate_shard);
+    }
+
+    return result;
+}
+
+static KEY_LOOKUP_RESULT find_in_bucket_list(void* context, BUCKET_ARRAY* bucket_array, CLDS_SORTED_LIST_HANDLE bucket_list)
+{
+    KEY_LOOKUP_RESULT result;
+    FIND_CONTEXT* find_context = (FIND_CONTEXT*)context;
+
+    (void)bucket_array;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
+    find_context->item = clds_sorted_list_find_key(bucket_list, find_context->clds_hazard_pointers_thread, find_context->lookup_key);
+    if (find_context->item == NULL)
+    {
+        // go to the next level of buckets
+        result = KEY_LOOKUP_NOT_FOUND;
+    }
+    else
+    {
+        // found
+        result = KEY_LOOKUP_DONE;
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_ITEM* clds_hash_table_find(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    CLDS_HASH_TABLE_ITEM* result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_035: [ If clds_hash_table is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_036: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_037: [ If key is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        (key == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
+            clds_hash_table, clds_hazard_pointers_thread, key);
+        result = NULL;
+    }
+    else
+    {
+        FIND_CONTEXT find_context;
+        CLDS_HASH_TABLE_ITEM lookup_item;
+
+        // compute the hash
+        /* Codes_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = clds_hash_table->compute_hash(key);
+
+        find_context.clds_hazard_pointers_thread = clds_hazard_pointers_thread;
+        /* Codes_SRS_CLDS_HASH_TABLE_01_260: [ clds_hash_table_insert, clds_hash_table_delete, clds_hash_table_remove, clds_hash_table_set_value and clds_hash_table_find shall pass the key together with its hash to the bucket lists. ]*/
+        find_context.lookup_key = init_lookup_item(&lookup_item, hash, key);
+        find_context.item = NULL;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_041: [ clds_hash_table_find shall look up the key in the biggest array of buckets. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_044: [ Looking up the key in the array of buckets is done by obtaining the list in the bucket correspoding to the hash and looking up the key in the list by calling clds_sorted_list_find. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_042: [ If the key is not found in the biggest array of buckets, the next bucket arrays shall be looked up. ]*/
+        if (lookup_key(clds_hash_table, clds_hazard_pointers_thread, is_migration_enabled(clds_hash_table), hash, find_in_bucket_list, NULL, &find_context) != KEY_LOOKUP_DONE)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_043: [ If the key is not found at all, clds_hash_table_find shall return NULL. ]*/
+            result = NULL;
+        }
+        else
+        {
+            result = (void*)find_context.item;
+        }
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count)
+{
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_42_013: [ If clds_hash_table is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_42_014: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_42_015: [ If items is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_42_016: [ If item_count is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (item_count == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p",
+            clds_hash_table, clds_hazard_pointers_thread, items, item_count);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+    }
+    else
+    {
+        internal_lock_writes(clds_hash_table);
+
+        uint64_t temp_item_count = 0;
+        bool failed = false;
+        bool need_to_unlock_all = false;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
+        BUCKET_ARRAY* current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (current_bucket_array != NULL)
+        {
+            BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&current_bucket_array->next_bucket, NULL, NULL);
+
+            if (InterlockedAdd(&current_bucket_array->item_count, 0) != 0)
+            {
+                LONG bucket_count = InterlockedAdd(&current_bucket_array->bucket_count, 0);
+                LONG i;
+                for (i = 0; i < bucket_count; i++)
+                {
+                    if (current_bucket_array->hash_table[i] != NULL)
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes. ]*/
+                        clds_sorted_list_lock_writes(current_bucket_array->hash_table[i]);
+                        need_to_unlock_all = true;
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count and add to the running total. ]*/
+                        uint64_t list_item_count;
+                        CLDS_SORTED_LIST_GET_COUNT_RESULT count_result = clds_sorted_list_get_count(current_bucket_array->hash_table[i], clds_hazard_pointers_thread, &list_item_count);
+                        if (count_result != CLDS_SORTED_LIST_GET_COUNT_OK)
+                        {
+                            /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                            LogError("clds_sorted_list_get_count failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_COUNT_RESULT, count_result));
+                            clds_sorted_list_unlock_writes(current_bucket_array->hash_table[i]);
+                            break;
+                        }
+                        else
+                        {
+                            if (list_item_count + temp_item_count < temp_item_count)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_42_022: [ If the addition of the list count causes overflow then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                LogError("overflow in computing total count (%" PRIu64 " + %" PRIu64 ")", temp_item_count, list_item_count);
+                                clds_sorted_list_unlock_writes(current_bucket_array->hash_table[i]);
+                                break;
+                            }
+                            else
+                            {
+                                temp_item_count += list_item_count;
+                            }
+                        }
+                    }
+                }
+
+                if (i < bucket_count)
+                {
+                    for (LONG index_to_clean = 0; index_to_clean < i; index_to_clean++)
+                    {
+                        if (current_bucket_array->hash_table[index_to_clean] != NULL)
+                        {
+                            clds_sorted_list_unlock_writes(current_bucket_array->hash_table[index_to_clean]);
+                        }
+                    }
+                    failed = true;
+                    break;
+                }
+            }
+
+            current_bucket_array = next_bucket_array;
+        }
+
+        if (failed)
+        {
+            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+        }
+        else if (temp_item_count > SIZE_MAX / sizeof(CLDS_SORTED_LIST_ITEM*))
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_42_062: [ If the number of items multiplied by the size of CLDS_HASH_TABLE_ITEM exceeds SIZE_MAX then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            LogError("Unable to allocate array of %" PRIu64 " items, requires more than %zu bytes", temp_item_count, SIZE_MAX);
+            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+        }
+        else
+        {
+            if (temp_item_count == 0)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_42_064: [ If there are no items then clds_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                *items = NULL;
+                *item_count = 0;
+                result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+                CLDS_SORTED_LIST_ITEM** items_to_return = malloc(sizeof(CLDS_SORTED_LIST_ITEM*) * (size_t)temp_item_count);
+
+                if (items_to_return == NULL)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                    LogError("malloc(%zu) failed for the items to return", sizeof(CLDS_SORTED_LIST_ITEM*) * (size_t)temp_item_count);
+                    result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+                }
+                else
+                {
+                    uint64_t result_index = 0;
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+                    current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
+                    while (current_bucket_array != NULL)
+                    {
+                        BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&current_bucket_array->next_bucket, NULL, NULL);
+
+                        if (InterlockedAdd(&current_bucket_array->item_count, 0) != 0)
+                        {
+                            LONG bucket_count = InterlockedAdd(&current_bucket_array->bucket_count, 0);
+                            LONG i;
+                            for (i = 0; i < bucket_count; i++)
+                            {
+                                if (current_bucket_array->hash_table[i] != NULL)
+                                {
+                                    if (!failed)
+                                    {
+                                        /* Codes_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count. ]*/
+                                        uint64_t list_item_count;
+                                        CLDS_SORTED_LIST_GET_COUNT_RESULT count_result = clds_sorted_list_get_count(current_bucket_array->hash_table[i], clds_hazard_pointers_thread, &list_item_count);
+                                        if (count_result != CLDS_SORTED_LIST_GET_COUNT_OK)
+                                        {
+                                            /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                            LogError("clds_sorted_list_get_count failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_COUNT_RESULT, count_result));
+                                            failed = true;
+                                        }
+                                        else
+                                        {
+                                            if (list_item_count == 0)
+                                            {
+                                                // skip
+                                            }
+                                            else
+                                            {
+                                                /* Codes_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array. ]*/
+                                                CLDS_SORTED_LIST_GET_ALL_RESULT get_all_result = clds_sorted_list_get_all(current_bucket_array->hash_table[i], clds_hazard_pointers_thread, list_item_count, items_to_return + result_index);
+                                                if (get_all_result != CLDS_SORTED_LIST_GET_ALL_OK)
+                                                {
+                                                    /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                                    LogError("clds_sorted_list_get_all failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_ALL_RESULT, get_all_result));
+                                                    failed = true;
+                                                }
+                                                else
+                                                {
+                                                    result_index += list_item_count;
+                                                }
+                                            }
+                                        }
+                                    }
+
+                                    /* Codes_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes. ]*/
+                                    clds_sorted_list_unlock_writes(current_bucket_array->hash_table[i]);
+                                }
+                            }
+                        }
+
+                        current_bucket_array = next_bucket_array;
+                    }
+
+                    need_to_unlock_all = false; // Unlocked
+
+                    if (failed)
+                    {
+                        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+
+                        for (uint64_t i = 0; i < result_index; i++)
+                        {
+                            clds_sorted_list_node_release(items_to_return[i]);
+                        }
+                        free(items_to_return);
+                    }
+                    else
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+                        *items = (CLDS_HASH_TABLE_ITEM**)items_to_return;
+                        items_to_return = NULL;
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+                        *item_count = result_index;
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                        result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+                    }
+                }
+            }
+        }
+
+        if (need_to_unlock_all)
+        {
+            // Unlock all the lists that have been locked so far
+            // If we only looked at part of the table, the old "current_bucket_array" is already in a cleaned up state
+            // Otherwise it is NULL and we will unlock everything
+            BUCKET_ARRAY* bucket_array_to_clean = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
+            while (bucket_array_to_clean != current_bucket_array)
+            {
+                BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&bucket_array_to_clean->next_bucket, NULL, NULL);
+
+                if (InterlockedAdd(&bucket_array_to_clean->item_count, 0) != 0)
+                {
+                    LONG bucket_count = InterlockedAdd(&bucket_array_to_clean->bucket_count, 0);
+                    for (LONG i = 0; i < bucket_count; i++)
+                    {
+                        if (bucket_array_to_clean->hash_table[i] != NULL)
+                        {
+                            clds_sorted_list_unlock_writes(bucket_array_to_clean->hash_table[i]);
+                        }
+                    }
+                }
+
+                bucket_array_to_clean = next_bucket_array;
+            }
+        }
+
+        internal_unlock_writes(clds_hash_table);
+    }
+
+    return result;
+}
+
+typedef struct SNAPSHOT_WORKER_TAG
+{
+    CLDS_HASH_TABLE* clds_hash_table;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    uint32_t worker_index;
+    uint32_t worker_count;
+    // NULL while counting, then the part of the snapshot array where this worker puts its items
+    CLDS_SORTED_LIST_ITEM** items;
+    bool collect;
+    uint64_t item_count;
+    uint64_t collected_count;
+    bool failed;
+    THREAD_HANDLE thread_handle;
+    bool thread_created;
+} SNAPSHOT_WORKER;
+
+static int snapshot_worker_thread(void* arg)
+{
+    SNAPSHOT_WORKER* worker = (SNAPSHOT_WORKER*)arg;
+    BUCKET_ARRAY* current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&worker->clds_hash_table->first_hash_table, NULL, NULL);
+
+    while (current_bucket_array != NULL)
+    {
+        if (InterlockedAdd(&current_bucket_array->item_count, 0) != 0)
+        {
+            LONG bucket_count = InterlockedAdd(&current_bucket_array->bucket_count, 0);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_190: [ Each array of buckets shall be split in thread_count ranges of consecutive buckets of about the same size, the range with index i being processed by the worker with index i using clds_hazard_pointers_threads[i]. ]*/
+            LONG range_start = (LONG)(((int64_t)bucket_count * worker->worker_index) / worker->worker_count);
+            LONG range_end = (LONG)(((int64_t)bucket_count * (worker->worker_index + 1)) / worker->worker_count);
+            LONG i;
+
+            for (i = range_start; i < range_end; i++)
+            {
+                CLDS_SORTED_LIST_HANDLE bucket_list = current_bucket_array->hash_table[i];
+                if (bucket_list != NULL)
+                {
+                    if (!worker->collect)
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_191: [ In the first phase each worker shall call clds_sorted_list_lock_writes and clds_sorted_list_get_count for each sorted list in its ranges and add up the counts. ]*/
+                        clds_sorted_list_lock_writes(bucket_list);
+
+                        if (!worker->failed)
+                        {
+                            uint64_t list_item_count;
+                            CLDS_SORTED_LIST_GET_COUNT_RESULT count_result = clds_sorted_list_get_count(bucket_list, worker->clds_hazard_pointers_thread, &list_item_count);
+                            if (count_result != CLDS_SORTED_LIST_GET_COUNT_OK)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_01_196: [ If any error occurs, clds_hash_table_snapshot_parallel shall release the items collected so far, unlock all the sorted lists it locked, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                LogError("clds_sorted_list_get_count failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_COUNT_RESULT, count_result));
+                                worker->failed = true;
+                            }
+                            else if (worker->item_count + list_item_count < worker->item_count)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_01_196: [ If any error occurs, clds_hash_table_snapshot_parallel shall release the items collected so far, unlock all the sorted lists it locked, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                LogError("overflow in computing total count (%" PRIu64 " + %" PRIu64 ")", worker->item_count, list_item_count);
+                                worker->failed = true;
+                            }
+                            else
+                            {
+                                worker->item_count += list_item_count;
+                            }
+                        }
+                    }
+                    else
+                    {
+                        if ((worker->items != NULL) && !worker->failed)
+                        {
+                            /* Codes_SRS_CLDS_HASH_TABLE_01_193: [ In the second phase each worker shall call clds_sorted_list_get_count and clds_sorted_list_get_all for each sorted list in its ranges, filling its part of the array. ]*/
+                            uint64_t list_item_count;
+                            CLDS_SORTED_LIST_GET_COUNT_RESULT count_result = clds_sorted_list_get_count(bucket_list, worker->clds_hazard_pointers_thread, &list_item_count);
+                            if (count_result != CLDS_SORTED_LIST_GET_COUNT_OK)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_01_196: [ If any error occurs, clds_hash_table_snapshot_parallel shall release the items collected so far, unlock all the sorted lists it locked, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                LogError("clds_sorted_list_get_count failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_COUNT_RESULT, count_result));
+                                worker->failed = true;
+                            }
+                            else if (list_item_count > worker->item_count - worker->collected_count)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_01_196: [ If any error occurs, clds_hash_table_snapshot_parallel shall release the items collected so far, unlock all the sorted lists it locked, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                LogError("list has %" PRIu64 " items, only %" PRIu64 " were counted", list_item_count, worker->item_count - worker->collected_count);
+                                worker->failed = true;
+                            }
+                            else if (list_item_count != 0)
+                            {
+                                CLDS_SORTED_LIST_GET_ALL_RESULT get_all_result = clds_sorted_list_get_all(bucket_list, worker->clds_hazard_pointers_thread, list_item_count, worker->items + worker->collected_count);
+                                if (get_all_result != CLDS_SORTED_LIST_GET_ALL_OK)
+                                {
+                                    /* Codes_SRS_CLDS_HASH_TABLE_01_196: [ If any error occurs, clds_hash_table_snapshot_parallel shall release the items collected so far, unlock all the sorted lists it locked, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                    LogError("clds_sorted_list_get_all failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_ALL_RESULT, get_all_result));
+                                    worker->failed = true;
+                                }
+                                else
+                                {
+                                    worker->collected_count += list_item_count;
+                                }
+                            }
+                        }
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_194: [ In the second phase each worker shall call clds_sorted_list_unlock_writes for each sorted list in its ranges. ]*/
+                        clds_sorted_list_unlock_writes(bucket_list);
+                    }
+                }
+            }
+        }
+
+        current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&current_bucket_array->next_bucket, NULL, NULL);
+    }
+
+    return 0;
+}
+
+static void run_snapshot_workers(SNAPSHOT_WORKER* workers, uint32_t worker_count)
+{
+    uint32_t i;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_189: [ For each phase, clds_hash_table_snapshot_parallel shall start thread_count - 1 worker threads with ThreadAPI_Create, run the worker with index 0 on the calling thread and wait for the worker threads with ThreadAPI_Join. ]*/
+    for (i = 1; i < worker_count; i++)
+    {
+        workers[i].thread_created = (ThreadAPI_Create(&workers[i].thread_handle, snapshot_worker_thread, &workers[i]) == THREADAPI_OK);
+        if (!workers[i].thread_created)
+        {
+            LogError("ThreadAPI_Create failed for snapshot worker %" PRIu32 ", running it on the calling thread", i);
+        }
+    }
+
+    (void)snapshot_worker_thread(&workers[0]);
+
+    for (i = 1; i < worker_count; i++)
+    {
+        if (workers[i].thread_created)
+        {
+            int dont_care;
+            if (ThreadAPI_Join(workers[i].thread_handle, &dont_care) != THREADAPI_OK)
+            {
+                LogError("ThreadAPI_Join failed for snapshot worker %" PRIu32, i);
+            }
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_195: [ If starting a worker thread fails, clds_hash_table_snapshot_parallel shall run that worker on the calling thread. ]*/
+            (void)snapshot_worker_thread(&workers[i]);
+        }
+    }
+}
+
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot_parallel(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE* clds_hazard_pointers_threads, uint32_t thread_count, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count)
+{
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_050: [ If clds_hash_table is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_184: [ If clds_hash_table is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
         (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_052: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_051: [ If key is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_056: [ If item is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        (item == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_070: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        /* Codes_SRS_CLDS_HASH_TABLE_01_185: [ If clds_hazard_pointers_threads is NULL, thread_count is 0 or any of the first thread_count entries of clds_hazard_pointers_threads is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hazard_pointers_threads == NULL) ||
+        (thread_count == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_186: [ If items is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_187: [ If item_count is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (item_count == NULL)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, clds_hazard_pointers_thread, item, sequence_number);
-        result = CLDS_HASH_TABLE_REMOVE_ERROR;
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE* clds_hazard_pointers_threads=%p, uint32_t thread_count=%" PRIu32 ", CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p",
+            clds_hash_table, clds_hazard_pointers_threads, thread_count, items, item_count);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
     }
     else
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_049: [ clds_hash_table_remove shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_050: [ clds_hash_table_remove shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_051: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_052: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_053: [ clds_hash_table_remove shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
+        uint32_t i;
 
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-        BUCKET_ARRAY* current_bucket_array;
+        for (i = 0; i < thread_count; i++)
+        {
+            if (clds_hazard_pointers_threads[i] == NULL)
+            {
+                break;
+            }
+        }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_01_047: [ clds_hash_table_remove shall remove a key from the hash table and return a pointer to the item to the user. ]*/
+        if (i < thread_count)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_185: [ If clds_hazard_pointers_threads is NULL, thread_count is 0 or any of the first thread_count entries of clds_hazard_pointers_threads is NULL then clds_hash_table_snapshot_parallel shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            LogError("Invalid arguments: clds_hazard_pointers_threads[%" PRIu32 "] is NULL", i);
+            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+        }
+        else
+        {
+            SNAPSHOT_WORKER* workers = malloc(sizeof(SNAPSHOT_WORKER) * thread_count);
+            if (workers == NULL)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_196: [ If any error occurs, clds_hash_table_snapshot_parallel shall release the items collected so far, unlock all the sorted lists it locked, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                LogError("malloc(%zu) failed for the snapshot workers", sizeof(SNAPSHOT_WORKER) * thread_count);
+                result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+            }
+            else
+            {
+                uint64_t temp_item_count = 0;
+                bool failed = false;
+                CLDS_SORTED_LIST_ITEM** items_to_return = NULL;
 
-        // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_048: [ clds_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
+                for (i = 0; i < thread_count; i++)
+                {
+                    workers[i].clds_hash_table = clds_hash_table;
+                    workers[i].clds_hazard_pointers_thread = clds_hazard_pointers_threads[i];
+                    workers[i].worker_index = i;
+                    workers[i].worker_count = thread_count;
+                    workers[i].items = NULL;
+                    workers[i].collect = false;
+                    workers[i].item_count = 0;
+                    workers[i].collected_count = 0;
+                    workers[i].failed = false;
+                }
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_188: [ clds_hash_table_snapshot_parallel shall lock the table for writes and wait for the ongoing write operations to complete. ]*/
+                internal_lock_writes(clds_hash_table);
 
-        result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+                run_snapshot_workers(workers, thread_count);
+
+                for (i = 0; i < thread_count; i++)
+                {
+                    if (workers[i].failed)
+                    {
+                        failed = true;
+                    }
+                    else if (temp_item_count + workers[i].item_count < temp_item_count)
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_196: [ If any error occurs, clds_hash_table_snapshot_parallel shall release the items collected so far, unlock all the sorted lists it locked, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                        LogError("overflow in computing total count (%" PRIu64 " + %" PRIu64 ")", temp_item_count, workers[i].item_count);
+                        failed = true;
+                    }
+                    else
+                    {
+                        temp_item_count += workers[i].item_count;
+                    }
+                }
 
-        // always insert in the first bucket array
-        current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
-        {
-            BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&current_bucket_array->next_bucket, NULL, NULL);
+                if (!failed && (temp_item_count > SIZE_MAX / sizeof(CLDS_SORTED_LIST_ITEM*)))
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_196: [ If any error occurs, clds_hash_table_snapshot_parallel shall release the items collected so far, unlock all the sorted lists it locked, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                    LogError("Unable to allocate array of %" PRIu64 " items, requires more than %zu bytes", temp_item_count, SIZE_MAX);
+                    failed = true;
+                }
 
-            if (InterlockedAdd(&current_bucket_array->item_count, 0) != 0)
-            {
-                // find the bucket
-                uint64_t bucket_index = hash % InterlockedAdd(&current_bucket_array->bucket_count, 0);
+                if (!failed && (temp_item_count != 0))
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_192: [ clds_hash_table_snapshot_parallel shall allocate an array of CLDS_HASH_TABLE_ITEM* for all the counted items and give each worker the part of the array following the parts of the workers with lower indices. ]*/
+                    items_to_return = malloc(sizeof(CLDS_SORTED_LIST_ITEM*) * (size_t)temp_item_count);
+                    if (items_to_return == NULL)
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_196: [ If any error occurs, clds_hash_table_snapshot_parallel shall release the items collected so far, unlock all the sorted lists it locked, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                        LogError("malloc(%zu) failed for the items to return", sizeof(CLDS_SORTED_LIST_ITEM*) * (size_t)temp_item_count);
+                        failed = true;
+                    }
+                    else
+                    {
+                        uint64_t offset = 0;
+                        for (i = 0; i < thread_count; i++)
+                        {
+                            workers[i].items = items_to_return + offset;
+                            offset += workers[i].item_count;
+                        }
+                    }
+                }
 
-                bucket_list = InterlockedCompareExchangePointer(&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list == NULL)
+                // the second phase always runs so that the lists locked in the first phase get unlocked
+                for (i = 0; i < thread_count; i++)
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
-                    result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+                    workers[i].collect = true;
                 }
-                else
+
+                run_snapshot_workers(workers, thread_count);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_197: [ clds_hash_table_snapshot_parallel shall unlock the table for writes. ]*/
+                internal_unlock_writes(clds_hash_table);
+
+                for (i = 0; i < thread_count; i++)
                 {
-                    CLDS_SORTED_LIST_REMOVE_RESULT list_remove_result;
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove_key. ]*/
-                    list_remove_result = clds_sorted_list_remove_key(bucket_list, clds_hazard_pointers_thread, key, (void*)item, sequence_number);
-                    if (list_remove_result == CLDS_SORTED_LIST_REMOVE_NOT_FOUND)
+                    if (workers[i].failed || (workers[i].collected_count != workers[i].item_count))
                     {
-                        // not found
+                        failed = true;
                     }
-                    else if (list_remove_result == CLDS_SORTED_LIST_REMOVE_OK)
+                }
+
+                if (failed)
+                {
+                    if (items_to_return != NULL)
                     {
-                        (void)InterlockedDecrement(&current_bucket_array->item_count);
+                        for (i = 0; i < thread_count; i++)
+                        {
+                            for (uint64_t j = 0; j < workers[i].collected_count; j++)
+                            {
+                                clds_sorted_list_node_release(workers[i].items[j]);
+                            }
+                        }
 
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_049: [ On success clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_OK. ]*/
-                        result = CLDS_HASH_TABLE_REMOVE_OK;
-                        break;
+                        free(items_to_return);
                     }
-                    else
+
+                    result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_198: [ clds_hash_table_snapshot_parallel shall store the array of items in items (NULL if there are no items) and the count of items in item_count, succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                    *items = (CLDS_HASH_TABLE_ITEM**)items_to_return;
+                    *item_count = temp_item_count;
+                    result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+                }
+
+                free(workers);
+            }
+        }
+    }
+
+    return result;
+}
+
+// calls clds_sorted_list_visit with visit_cb for each sorted list in each array of buckets, the table being the context of visit_cb
+static int visit_bucket_lists(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SORTED_LIST_VISIT_CB visit_cb)
+{
+    int result = 0;
+    BUCKET_ARRAY_CURSOR cursor;
+
+    init_bucket_array_cursor(&cursor, clds_hazard_pointers_thread, is_migration_enabled(clds_hash_table));
+
+    if (move_bucket_array_cursor(&cursor, (volatile PVOID*)&clds_hash_table->first_hash_table) != 0)
+    {
+        LogError("Cannot get the first bucket array");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        while (cursor.bucket_array != NULL)
+        {
+            BUCKET_ARRAY* current_bucket_array = cursor.bucket_array;
+            LONG bucket_count = InterlockedAdd(&current_bucket_array->bucket_count, 0);
+            LONG i;
+
+            for (i = 0; i < bucket_count; i++)
+            {
+                CLDS_SORTED_LIST_HANDLE bucket_list = InterlockedCompareExchangePointer(&current_bucket_array->hash_table[i], NULL, NULL);
+                if (bucket_list != NULL)
+                {
+                    CLDS_SORTED_LIST_VISIT_RESULT visit_result = clds_sorted_list_visit(bucket_list, clds_hazard_pointers_thread, visit_cb, clds_hash_table);
+                    if (visit_result != CLDS_SORTED_LIST_VISIT_OK)
                     {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_054: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-                        result = CLDS_HASH_TABLE_REMOVE_ERROR;
+                        LogError("clds_sorted_list_visit failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_VISIT_RESULT, visit_result));
+                        result = MU_FAILURE;
                         break;
                     }
                 }
             }
 
-            /* Codes_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
-            current_bucket_array = next_bucket_array;
-        }
+            if (result != 0)
+            {
+                break;
+            }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_054: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
+            if (move_bucket_array_cursor(&cursor, (volatile PVOID*)&current_bucket_array->next_bucket) != 0)
+            {
+                LogError("Cannot get the next bucket array");
+                result = MU_FAILURE;
+                break;
+            }
+        }
     }
 
+    release_bucket_array_cursor(&cursor);
+
     return result;
 }
 
-CLDS_HASH_TABLE_SET_VALUE_RESULT clds_hash_table_set_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* new_item, CLDS_HASH_TABLE_ITEM** old_item, int64_t* sequence_number)
+static bool capture_visited_item(void* context, CLDS_SORTED_LIST_ITEM* item)
 {
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE* clds_hash_table = (CLDS_HASH_TABLE*)context;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_165: [ For each sorted list in each array of buckets, clds_hash_table_snapshot_concurrent shall call clds_sorted_list_visit and add to the snapshot each visited item that was put in the table at or before the snapshot generation and was not yet added to the snapshot. ]*/
+    capture_item(clds_hash_table, item, get_item_write_generation(item));
+    return true;
+}
+
+static void release_captured_items(CLDS_HASH_TABLE_ITEM* captured_items)
+{
+    while (captured_items != NULL)
+    {
+        CLDS_HASH_TABLE_ITEM* next_captured_item = get_next_captured_item(captured_items);
+        clds_sorted_list_node_release((void*)captured_items);
+        captured_items = next_captured_item;
+    }
+}
+
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot_concurrent(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count)
+{
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_079: [ If clds_hash_table is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_159: [ If clds_hash_table is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
         (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_080: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_160: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_081: [ If key is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_082: [ If new_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        (new_item == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_083: [ If old_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        (old_item == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_084: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        /* Codes_SRS_CLDS_HASH_TABLE_01_161: [ If items is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_162: [ If item_count is NULL then clds_hash_table_snapshot_concurrent shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (item_count == NULL)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* new_item=%p, CLDS_HASH_TABLE_ITEM** old_item=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, clds_hazard_pointers_thread, new_item, old_item, sequence_number);
-        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p",
+            clds_hash_table, clds_hazard_pointers_thread, items, item_count);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
     }
     else
     {
-        uint64_t bucket_index;
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-
-        /* Codes_SRS_CLDS_HASH_TABLE_42_055: [ clds_hash_table_set_value shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_056: [ clds_hash_table_set_value shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_057: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_058: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_059: [ clds_hash_table_set_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
-
-        // compute the hash
-        uint64_t hash = clds_hash_table->compute_hash(key);
-
-        // find or allocate a new bucket array
-        BUCKET_ARRAY* first_bucket_array = get_first_bucket_array(clds_hash_table);
-
-        // increment pending inserts count
-        (void)InterlockedIncrement(&first_bucket_array->pending_insert_count);
+        bool failed = false;
+        CLDS_HASH_TABLE_ITEM* captured_items;
 
-        BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&first_bucket_array->next_bucket, NULL, NULL);
-        if (next_bucket_array != NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_01_163: [ clds_hash_table_snapshot_concurrent shall wait for any other clds_hash_table_snapshot_concurrent or clds_hash_table_snapshot_at_current_sequence_number call on the same table to complete. ]*/
+        while (InterlockedCompareExchange(&clds_hash_table->snapshot_in_progress, 1, 0) != 0)
         {
-            // wait for all outstanding inserts in the lower levels to complete
-            do
-            {
-                if (InterlockedAdd(&next_bucket_array->pending_insert_count, 0) == 0)
-                {
-                    break;
-                }
-            } while (1);
+            LONG snapshot_in_progress = 1;
+            (void)WaitOnAddress(&clds_hash_table->snapshot_in_progress, &snapshot_in_progress, sizeof(LONG), INFINITE);
         }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
-        bool set_value_in_top_level = true;
-        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+        /* Codes_SRS_CLDS_HASH_TABLE_01_164: [ clds_hash_table_snapshot_concurrent shall lock the table for writes, increment the generation of the table, use the previous generation as the snapshot generation and unlock the table for writes. ]*/
+        internal_lock_writes(clds_hash_table);
+        (void)InterlockedExchangePointer((volatile PVOID*)&clds_hash_table->captured_items, NULL);
+        (void)InterlockedExchange(&clds_hash_table->snapshot_failed, 0);
+        (void)InterlockedExchange64(&clds_hash_table->snapshot_generation, InterlockedIncrement64(&clds_hash_table->write_generation) - 1);
+        internal_unlock_writes(clds_hash_table);
 
-        BUCKET_ARRAY* find_bucket_array = next_bucket_array;
-        while (find_bucket_array != NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_01_165: [ For each sorted list in each array of buckets, clds_hash_table_snapshot_concurrent shall call clds_sorted_list_visit and add to the snapshot each visited item that was put in the table at or before the snapshot generation and was not yet added to the snapshot. ]*/
+        if (visit_bucket_lists(clds_hash_table, clds_hazard_pointers_thread, capture_visited_item) != 0)
         {
-            next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&find_bucket_array->next_bucket, NULL, NULL);
-
-            bucket_index = hash % InterlockedAdd(&find_bucket_array->bucket_count, 0);
-            bucket_list = InterlockedCompareExchangePointer(&find_bucket_array->hash_table[bucket_index], NULL, NULL);
-
-            if (bucket_list != NULL)
-            {
-                /* Codes_SRS_CLDS_HASH_TABLE_01_108: [ If there is a sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall find the key in the list. ]*/
-                CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
-                if (sorted_list_item != NULL)
-                {
-                    clds_sorted_list_node_release(sorted_list_item);
-
-                    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, new_item);
-                    hash_table_item->key = key;
-
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item and old_item and only_if_exists set to true. ]*/
-                    CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value_result = clds_sorted_list_set_value(bucket_list, clds_hazard_pointers_thread, key, (void*)new_item, (void*)old_item, sequence_number, true);
-                    switch (sorted_list_set_value_result)
-                    {
-                    default:
-                    case CLDS_SORTED_LIST_SET_VALUE_ERROR:
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-                        LogError("Cannot set key in sorted list: failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value_result));
-                        set_value_in_top_level = false;
-                        break;
-
-                    case CLDS_SORTED_LIST_SET_VALUE_OK:
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-                        result = CLDS_HASH_TABLE_SET_VALUE_OK;
-                        set_value_in_top_level = false;
-                        break;
+            /* Codes_SRS_CLDS_HASH_TABLE_01_167: [ If any error occurs, clds_hash_table_snapshot_concurrent shall release the items added to the snapshot, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            failed = true;
+        }
 
-                    case CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND:
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_109: [ If the key is not found, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                /* Codes_SRS_CLDS_HASH_TABLE_01_107: [ If there is no sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
-            }
+        // once the writers are drained no one can add to the captured items anymore
+        /* Codes_SRS_CLDS_HASH_TABLE_01_166: [ clds_hash_table_snapshot_concurrent shall then lock the table for writes, end the snapshot and unlock the table for writes. ]*/
+        internal_lock_writes(clds_hash_table);
+        (void)InterlockedExchange64(&clds_hash_table->snapshot_generation, 0);
+        captured_items = InterlockedExchangePointer((volatile PVOID*)&clds_hash_table->captured_items, NULL);
+        internal_unlock_writes(clds_hash_table);
 
-            find_bucket_array = next_bucket_array;
+        if (InterlockedAdd(&clds_hash_table->snapshot_failed, 0) != 0)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_272: [ If allocating the state kept by the snapshots for an item fails, the write operation shall still succeed and the running clds_hash_table_snapshot_concurrent or clds_hash_table_snapshot_at_current_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            failed = true;
         }
 
-        if (set_value_in_top_level)
+        if (failed)
         {
-            /* Codes_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
-            BUCKET_ARRAY* current_bucket_array = first_bucket_array;
-
-            // look for the item in this bucket array
-            // find the bucket
-            bucket_index = hash % InterlockedAdd(&current_bucket_array->bucket_count, 0);
-            bool restart_needed = false;
+            release_captured_items(captured_items);
+            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+        }
+        else
+        {
+            uint64_t temp_item_count = 0;
+            CLDS_HASH_TABLE_ITEM* captured_item;
 
-            do
+            for (captured_item = captured_items; captured_item != NULL; captured_item = get_next_captured_item(captured_item))
             {
-                /* Codes_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucked corresponding to the hash of the key. ]*/
-                // do we have a list here or do we create one?
-                bucket_list = InterlockedCompareExchangePointer(&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list != NULL)
-                {
-                    restart_needed = false;
-                }
-                else
-                {
-                    // create a list
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_104: [  If no list exists at the designated bucket, one shall be created. ]*/
-                    bucket_list = clds_sorted_list_create(clds_hash_table->clds_hazard_pointers, get_item_key_cb, clds_hash_table, key_compare_cb, clds_hash_table, clds_hash_table->sequence_number, clds_hash_table->sequence_number == NULL ? NULL : on_sorted_list_skipped_seq_no, clds_hash_table);
-                    if (bucket_list == NULL)
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-                        LogError("Cannot allocate list for hash table bucket");
-                        restart_needed = false;
-                    }
-                    else
-                    {
-                        // now put the list in the bucket
-                        if (InterlockedCompareExchangePointer(&current_bucket_array->hash_table[bucket_index], bucket_list, NULL) != NULL)
-                        {
-                            // oops, someone else inserted a new list, just bail on our list and restart
-                            clds_sorted_list_destroy(bucket_list);
-                            restart_needed = true;
-                        }
-                        else
-                        {
-                            // set new list
-                            restart_needed = false;
-                        }
-                    }
-                }
-            } while (restart_needed);
+                temp_item_count++;
+            }
 
-            if (bucket_list == NULL)
+            if (temp_item_count == 0)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_171: [ If there are no items then clds_hash_table_snapshot_concurrent shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                *items = NULL;
+                *item_count = 0;
+                result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+            }
+            else if (temp_item_count > SIZE_MAX / sizeof(CLDS_HASH_TABLE_ITEM*))
             {
-                LogError("Cannot acquire bucket list");
-                result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+                /* Codes_SRS_CLDS_HASH_TABLE_01_167: [ If any error occurs, clds_hash_table_snapshot_concurrent shall release the items added to the snapshot, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                LogError("Unable to allocate array of %" PRIu64 " items, requires more than %zu bytes", temp_item_count, SIZE_MAX);
+                release_captured_items(captured_items);
+                result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
             }
             else
             {
-                HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, new_item);
-
-                hash_table_item->key = key;
-
-                /* Codes_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, old_item and only_if_exists set to false. ]*/
-                CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value = clds_sorted_list_set_value(bucket_list, clds_hazard_pointers_thread, key, (void*)new_item, (void*)old_item, sequence_number, false);
-                if (sorted_list_set_value != CLDS_SORTED_LIST_SET_VALUE_OK)
+                /* Codes_SRS_CLDS_HASH_TABLE_01_172: [ clds_hash_table_snapshot_concurrent shall allocate an array of CLDS_HASH_TABLE_ITEM* and move the items of the snapshot into it, together with the references taken on them. ]*/
+                CLDS_HASH_TABLE_ITEM** items_to_return = malloc(sizeof(CLDS_HASH_TABLE_ITEM*) * (size_t)temp_item_count);
+                if (items_to_return == NULL)
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-                    LogError("Cannot set key in sorted list");
-                    result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_167: [ If any error occurs, clds_hash_table_snapshot_concurrent shall release the items added to the snapshot, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                    LogError("malloc(%zu) failed for the items to return", sizeof(CLDS_HASH_TABLE_ITEM*) * (size_t)temp_item_count);
+                    release_captured_items(captured_items);
+                    result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
                 }
                 else
                 {
-                    if (*old_item == NULL)
+                    uint64_t i = 0;
+
+                    for (captured_item = captured_items; captured_item != NULL; captured_item = get_next_captured_item(captured_item))
                     {
-                        (void)InterlockedIncrement(&first_bucket_array->item_count);
+                        items_to_return[i++] = captured_item;
                     }
 
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-                    result = CLDS_HASH_TABLE_SET_VALUE_OK;
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_173: [ clds_hash_table_snapshot_concurrent shall store the array in items and the count of items in item_count, succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                    *items = items_to_return;
+                    *item_count = temp_item_count;
+                    result = CLDS_HASH_TABLE_SNAPSHOT_OK;
                 }
             }
         }
 
-        (void)InterlockedDecrement(&first_bucket_array->pending_insert_count);
+        (void)InterlockedExchange(&clds_hash_table->snapshot_in_progress, 0);
+        WakeByAddressAll((PVOID)&clds_hash_table->snapshot_in_progress);
+    }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_060: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
+    return result;
+}
+
+static bool capture_visited_item_at(void* context, CLDS_SORTED_LIST_ITEM* item)
+{
+    CLDS_HASH_TABLE* clds_hash_table = (CLDS_HASH_TABLE*)context;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_215: [ For each sorted list in each array of buckets, clds_hash_table_snapshot_at_current_sequence_number shall call clds_sorted_list_visit and capture each visited item that was put in the table at or before sequence_number and was not yet captured. ]*/
+    snapshot_at_capture_item(clds_hash_table, item);
+    return true;
+}
+
+// keeps only the captured items that were in the table at the snapshot sequence number and releases the others
+// the sequence numbers of all captured items are cleared, so that the next snapshot starts from a clean state
+static CLDS_HASH_TABLE_ITEM* filter_snapshot_at_items(CLDS_HASH_TABLE_ITEM* captured_items, int64_t sequence_number, uint64_t* item_count)
+{
+    CLDS_HASH_TABLE_ITEM* result = NULL;
+
+    *item_count = 0;
+
+    while (captured_items != NULL)
+    {
+        // every captured item has snapshot state
+        HASH_TABLE_ITEM_SNAPSHOT_STATE* snapshot_state = get_item_snapshot_state((void*)captured_items);
+        CLDS_HASH_TABLE_ITEM* next_captured_item = snapshot_state->next_captured;
+
+        if ((InterlockedAdd64(&snapshot_state->insert_sequence_number, 0) <= sequence_number) &&
+            (InterlockedAdd64(&snapshot_state->remove_sequence_number, 0) > sequence_number))
+        {
+            snapshot_state->next_captured = result;
+            result = captured_items;
+            (*item_count)++;
+            reset_item_sequence_numbers(captured_items);
+        }
+        else
+        {
+            reset_item_sequence_numbers(captured_items);
+            clds_sorted_list_node_release((void*)captured_items);
+        }
+
+        captured_items = next_captured_item;
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_ITEM* clds_hash_table_find(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot_at_current_sequence_number(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count, int64_t* sequence_number)
 {
-    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_035: [ If clds_hash_table is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_207: [ If clds_hash_table is NULL then clds_hash_table_snapshot_at_current_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
         (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_036: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_208: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot_at_current_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_037: [ If key is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-        (key == NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_01_209: [ If items is NULL then clds_hash_table_snapshot_at_current_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_210: [ If item_count is NULL then clds_hash_table_snapshot_at_current_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (item_count == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_269: [ If sequence_number is NULL then clds_hash_table_snapshot_at_current_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (sequence_number == NULL)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
-            clds_hash_table, clds_hazard_pointers_thread, key);
-        result = NULL;
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p, int64_t* sequence_number=%p",
+            clds_hash_table, clds_hazard_pointers_thread, items, item_count, sequence_number);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+    }
+    else if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_211: [ If no start sequence number was specified in clds_hash_table_create or the sequence number block size is non-zero, clds_hash_table_snapshot_at_current_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hash_table->sequence_number == NULL) ||
+        (InterlockedAdd(&clds_hash_table->sequence_number_block_size, 0) != 0)
+        )
+    {
+        LogError("clds_hash_table_snapshot_at_current_sequence_number requires sequence numbers that are not reserved in blocks: int64_t* sequence_number=%p, sequence_number_block_size=%" PRIu32,
+            clds_hash_table->sequence_number, (uint32_t)InterlockedAdd(&clds_hash_table->sequence_number_block_size, 0));
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
     }
     else
     {
-        CLDS_SORTED_LIST_HANDLE bucket_list;
+        bool failed = false;
+        CLDS_HASH_TABLE_ITEM* captured_items;
+        int64_t snapshot_sequence_number;
 
-        result = NULL;
+        /* Codes_SRS_CLDS_HASH_TABLE_01_212: [ clds_hash_table_snapshot_at_current_sequence_number shall wait for any other clds_hash_table_snapshot_concurrent or clds_hash_table_snapshot_at_current_sequence_number call on the same table to complete. ]*/
+        while (InterlockedCompareExchange(&clds_hash_table->snapshot_in_progress, 1, 0) != 0)
+        {
+            LONG snapshot_in_progress = 1;
+            (void)WaitOnAddress(&clds_hash_table->snapshot_in_progress, &snapshot_in_progress, sizeof(LONG), INFINITE);
+        }
 
-        // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
+        // the table does not keep the items that were taken out, so the only sequence number the snapshot can be taken at is the current one
+        // the writers are drained while it is read, so every write operation either has a sequence number up to it and is complete, or gets a later one
+        /* Codes_SRS_CLDS_HASH_TABLE_01_213: [ clds_hash_table_snapshot_at_current_sequence_number shall lock the table for writes and take the last sequence number used by the table as the snapshot sequence number. ]*/
+        internal_lock_writes(clds_hash_table);
+        snapshot_sequence_number = InterlockedAdd64(clds_hash_table->sequence_number, 0);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_214: [ clds_hash_table_snapshot_at_current_sequence_number shall start capturing the items of the table for the snapshot sequence number under a new generation of the table and unlock the table for writes. ]*/
+        (void)InterlockedExchangePointer((volatile PVOID*)&clds_hash_table->captured_items, NULL);
+        (void)InterlockedExchange(&clds_hash_table->snapshot_failed, 0);
+        (void)InterlockedExchange64(&clds_hash_table->snapshot_at_sequence_number, snapshot_sequence_number);
+        (void)InterlockedExchange64(&clds_hash_table->snapshot_at_id, InterlockedIncrement64(&clds_hash_table->write_generation) - 1);
+        (void)InterlockedExchange(&clds_hash_table->snapshot_at_capturing, 1);
+        internal_unlock_writes(clds_hash_table);
 
-        /* Codes_SRS_CLDS_HASH_TABLE_01_041: [ clds_hash_table_find shall look up the key in the biggest array of buckets. ]*/
-        BUCKET_ARRAY* current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_01_215: [ For each sorted list in each array of buckets, clds_hash_table_snapshot_at_current_sequence_number shall call clds_sorted_list_visit and capture each visited item that was put in the table at or before the snapshot sequence number and was not yet captured. ]*/
+        if (visit_bucket_lists(clds_hash_table, clds_hazard_pointers_thread, capture_visited_item_at) != 0)
         {
-            BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&current_bucket_array->next_bucket, NULL, NULL);
+            /* Codes_SRS_CLDS_HASH_TABLE_01_222: [ If any error occurs, clds_hash_table_snapshot_at_current_sequence_number shall release the captured items, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            failed = true;
+        }
 
-            if (InterlockedAdd(&current_bucket_array->item_count, 0) != 0)
-            {
-                // find the bucket
-                /* Codes_SRS_CLDS_HASH_TABLE_01_044: [ Looking up the key in the array of buckets is done by obtaining the list in the bucket correspoding to the hash and looking up the key in the list by calling clds_sorted_list_find. ]*/
-                uint64_t bucket_index = hash % InterlockedAdd(&current_bucket_array->bucket_count, 0);
+        // once the writers are drained no one can capture items or change the sequence numbers of the captured items anymore
+        /* Codes_SRS_CLDS_HASH_TABLE_01_216: [ clds_hash_table_snapshot_at_current_sequence_number shall then lock the table for writes, stop capturing items and unlock the table for writes. ]*/
+        internal_lock_writes(clds_hash_table);
+        (void)InterlockedExchange(&clds_hash_table->snapshot_at_capturing, 0);
+        captured_items = InterlockedExchangePointer((volatile PVOID*)&clds_hash_table->captured_items, NULL);
+        internal_unlock_writes(clds_hash_table);
 
-                bucket_list = InterlockedCompareExchangePointer(&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list != NULL)
+        if (InterlockedAdd(&clds_hash_table->snapshot_failed, 0) != 0)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_272: [ If allocating the state kept by the snapshots for an item fails, the write operation shall still succeed and the running clds_hash_table_snapshot_concurrent or clds_hash_table_snapshot_at_current_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            failed = true;
+        }
+
+        if (failed)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_222: [ If any error occurs, clds_hash_table_snapshot_at_current_sequence_number shall release the captured items, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            uint64_t dont_care;
+            release_captured_items(filter_snapshot_at_items(captured_items, snapshot_sequence_number, &dont_care));
+            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+        }
+        else
+        {
+            uint64_t temp_item_count;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_218: [ clds_hash_table_snapshot_at_current_sequence_number shall keep in the snapshot only the captured items that were put in the table at or before the snapshot sequence number and not taken out at or before it, and release the other captured items. ]*/
+            captured_items = filter_snapshot_at_items(captured_items, snapshot_sequence_number, &temp_item_count);
+
+            if (temp_item_count == 0)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_219: [ If there are no items then clds_hash_table_snapshot_at_current_sequence_number shall set items to NULL, item_count to 0 and sequence_number to the snapshot sequence number and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                *items = NULL;
+                *item_count = 0;
+                *sequence_number = snapshot_sequence_number;
+                result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+            }
+            else if (temp_item_count > SIZE_MAX / sizeof(CLDS_HASH_TABLE_ITEM*))
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_222: [ If any error occurs, clds_hash_table_snapshot_at_current_sequence_number shall release the captured items, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                LogError("Unable to allocate array of %" PRIu64 " items, requires more than %zu bytes", temp_item_count, SIZE_MAX);
+                release_captured_items(captured_items);
+                result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_220: [ clds_hash_table_snapshot_at_current_sequence_number shall allocate an array of CLDS_HASH_TABLE_ITEM* and move the items of the snapshot into it, together with the references taken on them. ]*/
+                CLDS_HASH_TABLE_ITEM** items_to_return = malloc(sizeof(CLDS_HASH_TABLE_ITEM*) * (size_t)temp_item_count);
+                if (items_to_return == NULL)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_222: [ If any error occurs, clds_hash_table_snapshot_at_current_sequence_number shall release the captured items, fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                    LogError("malloc(%zu) failed for the items to return", sizeof(CLDS_HASH_TABLE_ITEM*) * (size_t)temp_item_count);
+                    release_captured_items(captured_items);
+                    result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+                }
+                else
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
-                    result = (void*)clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
-                    if (result == NULL)
-                    {
-                        // go to the next level of buckets
-                    }
-                    else
+                    uint64_t i = 0;
+                    CLDS_HASH_TABLE_ITEM* captured_item;
+
+                    for (captured_item = captured_items; captured_item != NULL; captured_item = get_next_captured_item(captured_item))
                     {
-                        // found
-                        break;
+                        items_to_return[i++] = captured_item;
                     }
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_221: [ clds_hash_table_snapshot_at_current_sequence_number shall store the array in items, the count of items in item_count and the snapshot sequence number in sequence_number, succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                    *items = items_to_return;
+                    *item_count = temp_item_count;
+                    *sequence_number = snapshot_sequence_number;
+                    result = CLDS_HASH_TABLE_SNAPSHOT_OK;
                 }
             }
-
-            /* Codes_SRS_CLDS_HASH_TABLE_01_042: [ If the key is not found in the biggest array of buckets, the next bucket arrays shall be looked up. ]*/
-            current_bucket_array = next_bucket_array;
         }
 
-        if (current_bucket_array == NULL)
-        {
-            /* not found */
-            /* Codes_SRS_CLDS_HASH_TABLE_01_043: [ If the key is not found at all, clds_hash_table_find shall return NULL. ]*/
-            result = NULL;
-        }
-        else
-        {
-            // all OK
-        }
+        // the sequence numbers of the captured items were cleared, so writers can treat them as any other item from now on
+        (void)InterlockedExchange64(&clds_hash_table->snapshot_at_id, 0);
+
+        (void)InterlockedExchange(&clds_hash_table->snapshot_in_progress, 0);
+        WakeByAddressAll((PVOID)&clds_hash_table->snapshot_in_progress);
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count)
+static int compare_changes_by_sequence_number(const void* left, const void* right)
+{
+    int64_t left_sequence_number = ((const CLDS_HASH_TABLE_CHANGE*)left)->sequence_number;
+    int64_t right_sequence_number = ((const CLDS_HASH_TABLE_CHANGE*)right)->sequence_number;
+    return (left_sequence_number < right_sequence_number) ? -1 : ((left_sequence_number > right_sequence_number) ? 1 : 0);
+}
+
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot_since(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, int64_t since_sequence_number, CLDS_HASH_TABLE_CHANGE** changes, uint64_t* change_count, int64_t* last_sequence_number)
 {
     CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_42_013: [ If clds_hash_table is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_233: [ If clds_hash_table is NULL then clds_hash_table_snapshot_since shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
         (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_42_014: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_234: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot_since shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_42_015: [ If items is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-        (items == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_42_016: [ If item_count is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-        (item_count == NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_01_235: [ If changes is NULL then clds_hash_table_snapshot_since shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (changes == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_236: [ If change_count is NULL then clds_hash_table_snapshot_since shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (change_count == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_237: [ If last_sequence_number is NULL then clds_hash_table_snapshot_since shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (last_sequence_number == NULL)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p",
-            clds_hash_table, clds_hazard_pointers_thread, items, item_count);
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, int64_t since_sequence_number=%" PRId64 ", CLDS_HASH_TABLE_CHANGE** changes=%p, uint64_t* change_count=%p, int64_t* last_sequence_number=%p",
+            clds_hash_table, clds_hazard_pointers_thread, since_sequence_number, changes, change_count, last_sequence_number);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+    }
+    else if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_238: [ If no start sequence number was specified in clds_hash_table_create or the sequence number block size is non-zero, clds_hash_table_snapshot_since shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hash_table->sequence_number == NULL) ||
+        (InterlockedAdd(&clds_hash_table->sequence_number_block_size, 0) != 0)
+        )
+    {
+        LogError("clds_hash_table_snapshot_since requires sequence numbers that are not reserved in blocks: int64_t* sequence_number=%p, sequence_number_block_size=%" PRIu32,
+            clds_hash_table->sequence_number, (uint32_t)InterlockedAdd(&clds_hash_table->sequence_number_block_size, 0));
         result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
     }
     else
     {
-        internal_lock_writes(clds_hash_table);
-
-        uint64_t temp_item_count = 0;
-        bool failed = false;
-        bool need_to_unlock_all = false;
-
-        /* Codes_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
-        BUCKET_ARRAY* current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
-        {
-            BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&current_bucket_array->next_bucket, NULL, NULL);
-
-            if (InterlockedAdd(&current_bucket_array->item_count, 0) != 0)
-            {
-                LONG bucket_count = InterlockedAdd(&current_bucket_array->bucket_count, 0);
-                LONG i;
-                for (i = 0; i < bucket_count; i++)
-                {
-                    if (current_bucket_array->hash_table[i] != NULL)
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes. ]*/
-                        clds_sorted_list_lock_writes(current_bucket_array->hash_table[i]);
-                        need_to_unlock_all = true;
-
-                        /* Codes_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count and add to the running total. ]*/
-                        uint64_t list_item_count;
-                        CLDS_SORTED_LIST_GET_COUNT_RESULT count_result = clds_sorted_list_get_count(current_bucket_array->hash_table[i], clds_hazard_pointers_thread, &list_item_count);
-                        if (count_result != CLDS_SORTED_LIST_GET_COUNT_OK)
-                        {
-                            /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                            LogError("clds_sorted_list_get_count failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_COUNT_RESULT, count_result));
-                            clds_sorted_list_unlock_writes(current_bucket_array->hash_table[i]);
-                            break;
-                        }
-                        else
-                        {
-                            if (list_item_count + temp_item_count < temp_item_count)
-                            {
-                                /* Codes_SRS_CLDS_HASH_TABLE_42_022: [ If the addition of the list count causes overflow then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                                LogError("overflow in computing total count (%" PRIu64 " + %" PRIu64 ")", temp_item_count, list_item_count);
-                                clds_sorted_list_unlock_writes(current_bucket_array->hash_table[i]);
-                                break;
-                            }
-                            else
-                            {
-                                temp_item_count += list_item_count;
-                            }
-                        }
-                    }
-                }
+        CHANGE_LOG_RECORD* newest_change_log_record;
+        int64_t temp_last_sequence_number;
+        int64_t start_sequence_number;
+        bool change_log_enabled;
 
-                if (i < bucket_count)
-                {
-                    for (LONG index_to_clean = 0; index_to_clean < i; index_to_clean++)
-                    {
-                        if (current_bucket_array->hash_table[index_to_clean] != NULL)
-                        {
-                            clds_sorted_list_unlock_writes(current_bucket_array->hash_table[index_to_clean]);
-                        }
-                    }
-                    failed = true;
-                    break;
-                }
-            }
+        /* Codes_SRS_CLDS_HASH_TABLE_01_239: [ clds_hash_table_snapshot_since shall wait for any clds_hash_table_trim_change_log or other clds_hash_table_snapshot_since call on the same table to complete. ]*/
+        acquire_change_log(clds_hash_table);
 
-            current_bucket_array = next_bucket_array;
-        }
+        // all the operations with a sequence number up to the last one used are logged once the writers are drained
+        /* Codes_SRS_CLDS_HASH_TABLE_01_240: [ clds_hash_table_snapshot_since shall lock the table for writes, take the newest change in the change log, the last sequence number used by the table and the start of the change log and unlock the table for writes. ]*/
+        internal_lock_writes(clds_hash_table);
+        change_log_enabled = is_change_log_enabled(clds_hash_table);
+        newest_change_log_record = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->change_log, NULL, NULL);
+        temp_last_sequence_number = InterlockedAdd64(clds_hash_table->sequence_number, 0);
+        start_sequence_number = InterlockedAdd64(&clds_hash_table->change_log_start_sequence_number, 0);
+        internal_unlock_writes(clds_hash_table);
 
-        if (failed)
+        if (!change_log_enabled)
         {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_241: [ If the change log is not enabled, clds_hash_table_snapshot_since shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            LogError("The change log is not enabled");
             result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
         }
-        else if (temp_item_count > SIZE_MAX / sizeof(CLDS_SORTED_LIST_ITEM*))
+        else if (since_sequence_number < start_sequence_number)
         {
-            /* Codes_SRS_CLDS_HASH_TABLE_42_062: [ If the number of items multiplied by the size of CLDS_HASH_TABLE_ITEM exceeds SIZE_MAX then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-            LogError("Unable to allocate array of %" PRIu64 " items, requires more than %zu bytes", temp_item_count, SIZE_MAX);
-            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+            /* Codes_SRS_CLDS_HASH_TABLE_01_242: [ If since_sequence_number is before the start of the change log, clds_hash_table_snapshot_since shall fail and return CLDS_HASH_TABLE_SNAPSHOT_SEQ_NO_TOO_OLD. ]*/
+            LogError("Cannot return the changes since sequence number %" PRId64 ", the change log starts at sequence number %" PRId64,
+                since_sequence_number, start_sequence_number);
+            result = CLDS_HASH_TABLE_SNAPSHOT_SEQ_NO_TOO_OLD;
         }
         else
         {
-            if (temp_item_count == 0)
+            uint64_t temp_change_count = 0;
+            CHANGE_LOG_RECORD* change_log_record;
+
+            for (change_log_record = newest_change_log_record; change_log_record != NULL; change_log_record = change_log_record->next)
             {
-                /* Codes_SRS_CLDS_HASH_TABLE_42_064: [ If there are no items then clds_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-                *items = NULL;
-                *item_count = 0;
+                if ((change_log_record->change.sequence_number > since_sequence_number) &&
+                    (change_log_record->change.sequence_number <= temp_last_sequence_number))
+                {
+                    temp_change_count++;
+                }
+            }
+
+            if (temp_change_count == 0)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_246: [ If there are no changes then clds_hash_table_snapshot_since shall set changes to NULL, change_count to 0 and last_sequence_number to the last sequence number used by the table and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                *changes = NULL;
+                *change_count = 0;
+                *last_sequence_number = temp_last_sequence_number;
                 result = CLDS_HASH_TABLE_SNAPSHOT_OK;
             }
+            else if (temp_change_count > SIZE_MAX / sizeof(CLDS_HASH_TABLE_CHANGE))
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_248: [ If any error occurs, clds_hash_table_snapshot_since shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                LogError("Unable to allocate array of %" PRIu64 " changes, requires more than %zu bytes", temp_change_count, SIZE_MAX);
+                result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+            }
             else
             {
-                /* Codes_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-                CLDS_SORTED_LIST_ITEM** items_to_return = malloc(sizeof(CLDS_SORTED_LIST_ITEM*) * (size_t)temp_item_count);
-
-                if (items_to_return == NULL)
+                /* Codes_SRS_CLDS_HASH_TABLE_01_243: [ clds_hash_table_snapshot_since shall allocate an array of CLDS_HASH_TABLE_CHANGE for the changes in the change log with a sequence number after since_sequence_number and at or before the last sequence number used by the table. ]*/
+                CLDS_HASH_TABLE_CHANGE* changes_to_return = malloc(sizeof(CLDS_HASH_TABLE_CHANGE) * (size_t)temp_change_count);
+                if (changes_to_return == NULL)
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                    LogError("malloc(%zu) failed for the items to return", sizeof(CLDS_SORTED_LIST_ITEM*) * (size_t)temp_item_count);
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_248: [ If any error occurs, clds_hash_table_snapshot_since shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                    LogError("malloc(%zu) failed for the changes to return", sizeof(CLDS_HASH_TABLE_CHANGE) * (size_t)temp_change_count);
                     result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
                 }
                 else
                 {
-                    uint64_t result_index = 0;
-
-                    /* Codes_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-                    current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
-                    while (current_bucket_array != NULL)
-                    {
-                        BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&current_bucket_array->next_bucket, NULL, NULL);
-
-                        if (InterlockedAdd(&current_bucket_array->item_count, 0) != 0)
-                        {
-                            LONG bucket_count = InterlockedAdd(&current_bucket_array->bucket_count, 0);
-                            LONG i;
-                            for (i = 0; i < bucket_count; i++)
-                            {
-                                if (current_bucket_array->hash_table[i] != NULL)
-                                {
-                                    if (!failed)
-                                    {
-                                        /* Codes_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count. ]*/
-                                        uint64_t list_item_count;
-                                        CLDS_SORTED_LIST_GET_COUNT_RESULT count_result = clds_sorted_list_get_count(current_bucket_array->hash_table[i], clds_hazard_pointers_thread, &list_item_count);
-                                        if (count_result != CLDS_SORTED_LIST_GET_COUNT_OK)
-                                        {
-                                            /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                                            LogError("clds_sorted_list_get_count failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_COUNT_RESULT, count_result));
-                                            failed = true;
-                                        }
-                                        else
-                                        {
-                                            if (list_item_count == 0)
-                                            {
-                                                // skip
-                                            }
-                                            else
-                                            {
-                                                /* Codes_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array. ]*/
-                                                CLDS_SORTED_LIST_GET_ALL_RESULT get_all_result = clds_sorted_list_get_all(current_bucket_array->hash_table[i], clds_hazard_pointers_thread, list_item_count, items_to_return + result_index);
-                                                if (get_all_result != CLDS_SORTED_LIST_GET_ALL_OK)
-                                                {
-                                                    /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                                                    LogError("clds_sorted_list_get_all failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_ALL_RESULT, get_all_result));
-                                                    failed = true;
-                                                }
-                                                else
-                                                {
-                                                    result_index += list_item_count;
-                                                }
-                                            }
-                                        }
-                                    }
-
-                                    /* Codes_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes. ]*/
-                                    clds_sorted_list_unlock_writes(current_bucket_array->hash_table[i]);
-                                }
-                            }
-                        }
-
-                        current_bucket_array = next_bucket_array;
-                    }
-
-                    need_to_unlock_all = false; // Unlocked
+                    uint64_t i = 0;
 
-                    if (failed)
+                    for (change_log_record = newest_change_log_record; change_log_record != NULL; change_log_record = change_log_record->next)
                     {
-                        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
-
-                        for (uint64_t i = 0; i < result_index; i++)
+                        if ((change_log_record->change.sequence_number > since_sequence_number) &&
+                            (change_log_record->change.sequence_number <= temp_last_sequence_number))
                         {
-                            clds_sorted_list_node_release(items_to_return[i]);
+                            /* Codes_SRS_CLDS_HASH_TABLE_01_244: [ clds_hash_table_snapshot_since shall copy the changes into the array and take a reference on the item of each change. ]*/
+                            changes_to_return[i++] = change_log_record->change;
+                            (void)clds_sorted_list_node_inc_ref((CLDS_SORTED_LIST_ITEM*)change_log_record->change.item);
                         }
-                        free(items_to_return);
                     }
-                    else
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-                        *items = (CLDS_HASH_TABLE_ITEM**)items_to_return;
-                        items_to_return = NULL;
 
-                        /* Codes_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-                        *item_count = result_index;
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_245: [ clds_hash_table_snapshot_since shall sort the changes by sequence number. ]*/
+                    qsort(changes_to_return, (size_t)temp_change_count, sizeof(CLDS_HASH_TABLE_CHANGE), compare_changes_by_sequence_number);
 
-                        /* Codes_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-                        result = CLDS_HASH_TABLE_SNAPSHOT_OK;
-                    }
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_247: [ clds_hash_table_snapshot_since shall store the array in changes, the count of changes in change_count and the last sequence number used by the table in last_sequence_number, succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                    *changes = changes_to_return;
+                    *change_count = temp_change_count;
+                    *last_sequence_number = temp_last_sequence_number;
+                    result = CLDS_HASH_TABLE_SNAPSHOT_OK;
                 }
             }
         }
 
-        if (need_to_unlock_all)
+        release_change_log(clds_hash_table);
+    }
+
+    return result;
+}
+
+typedef struct SNAPSHOT_VISIT_CONTEXT_TAG
+{
+    HASH_TABLE_SNAPSHOT_VISIT_CB visit_cb;
+    void* visit_cb_context;
+} SNAPSHOT_VISIT_CONTEXT;
+
+static bool snapshot_visit_item(void* context, CLDS_SORTED_LIST_ITEM* item)
+{
+    SNAPSHOT_VISIT_CONTEXT* snapshot_visit_context = (SNAPSHOT_VISIT_CONTEXT*)context;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_179: [ clds_hash_table_snapshot_visit shall call visit_cb with visit_cb_context for each visited item, without taking a reference on it. ]*/
+    return snapshot_visit_context->visit_cb(snapshot_visit_context->visit_cb_context, (CLDS_HASH_TABLE_ITEM*)item);
+}
+
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot_visit(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, HASH_TABLE_SNAPSHOT_VISIT_CB visit_cb, void* visit_cb_context)
+{
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_174: [ If clds_hash_table is NULL then clds_hash_table_snapshot_visit shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_175: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot_visit shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_176: [ If visit_cb is NULL then clds_hash_table_snapshot_visit shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (visit_cb == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, HASH_TABLE_SNAPSHOT_VISIT_CB visit_cb=%p, void* visit_cb_context=%p",
+            clds_hash_table, clds_hazard_pointers_thread, visit_cb, visit_cb_context);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+    }
+    else
+    {
+        SNAPSHOT_VISIT_CONTEXT snapshot_visit_context;
+        snapshot_visit_context.visit_cb = visit_cb;
+        snapshot_visit_context.visit_cb_context = visit_cb_context;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_177: [ clds_hash_table_snapshot_visit shall lock the table for writes and wait for the ongoing write operations to complete. ]*/
+        internal_lock_writes(clds_hash_table);
+
+        result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+
+        // with the writers drained no array of buckets can be added or reclaimed, so no cursor is needed
+        BUCKET_ARRAY* current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (current_bucket_array != NULL)
         {
-            // Unlock all the lists that have been locked so far
-            // If we only looked at part of the table, the old "current_bucket_array" is already in a cleaned up state
-            // Otherwise it is NULL and we will unlock everything
-            BUCKET_ARRAY* bucket_array_to_clean = InterlockedCompareExchangePointer((volatile PVOID*)&clds_hash_table->first_hash_table, NULL, NULL);
-            while (bucket_array_to_clean != current_bucket_array)
+            if (InterlockedAdd(&current_bucket_array->item_count, 0) != 0)
             {
-                BUCKET_ARRAY* next_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&bucket_array_to_clean->next_bucket, NULL, NULL);
+                LONG bucket_count = InterlockedAdd(&current_bucket_array->bucket_count, 0);
+                LONG i;
 
-                if (InterlockedAdd(&bucket_array_to_clean->item_count, 0) != 0)
+                for (i = 0; i < bucket_count; i++)
                 {
-                    LONG bucket_count = InterlockedAdd(&bucket_array_to_clean->bucket_count, 0);
-                    for (LONG i = 0; i < bucket_count; i++)
+                    CLDS_SORTED_LIST_HANDLE bucket_list = InterlockedCompareExchangePointer(&current_bucket_array->hash_table[i], NULL, NULL);
+                    if (bucket_list != NULL)
                     {
-                        if (bucket_array_to_clean->hash_table[i] != NULL)
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_178: [ For each sorted list in each array of buckets, clds_hash_table_snapshot_visit shall call clds_sorted_list_visit. ]*/
+                        CLDS_SORTED_LIST_VISIT_RESULT visit_result = clds_sorted_list_visit(bucket_list, clds_hazard_pointers_thread, snapshot_visit_item, &snapshot_visit_context);
+                        if (visit_result == CLDS_SORTED_LIST_VISIT_ABORTED)
                         {
-                            clds_sorted_list_unlock_writes(bucket_array_to_clean->hash_table[i]);
+                            /* Codes_SRS_CLDS_HASH_TABLE_01_180: [ If visit_cb returns false, clds_hash_table_snapshot_visit shall stop visiting items and return CLDS_HASH_TABLE_SNAPSHOT_ABORTED. ]*/
+                            result = CLDS_HASH_TABLE_SNAPSHOT_ABORTED;
+                            break;
+                        }
+                        else if (visit_result != CLDS_SORTED_LIST_VISIT_OK)
+                        {
+                            /* Codes_SRS_CLDS_HASH_TABLE_01_181: [ If clds_sorted_list_visit fails, clds_hash_table_snapshot_visit shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                            LogError("clds_sorted_list_visit failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_VISIT_RESULT, visit_result));
+                            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+                            break;
                         }
                     }
                 }
 
-                bucket_array_to_clean = next_bucket_array;
+                if (i < bucket_count)
+                {
+                    break;
+                }
             }
+
+            current_bucket_array = InterlockedCompareExchangePointer((volatile PVOID*)&current_bucket_array->next_bucket, NULL, NULL);
         }
 
+        /* Codes_SRS_CLDS_HASH_TABLE_01_182: [ clds_hash_table_snapshot_visit shall unlock the table for writes. ]*/
         internal_unlock_writes(clds_hash_table);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_183: [ Otherwise clds_hash_table_snapshot_visit shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
     }
 
     return result;
@@ -1319,6 +4156,7 @@ CLDS_HASH_TABLE_ITEM* clds_hash_table_node_create(size_t node_size, HASH_TABLE_I
         HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
         hash_table_item->item_cleanup_callback = item_cleanup_callback;
         hash_table_item->item_cleanup_callback_context = item_cleanup_callback_context;
+        (void)InterlockedExchangePointer((volatile PVOID*)&hash_table_item->snapshot_state, NULL);
         item->item.item_cleanup_callback = sorted_list_item_cleanup;
         item->item.item_cleanup_callback_context = (void*)item;
         (void)InterlockedExchange(&item->item.ref_count, 1);
@@ -2,6 +2,7 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdbool.h>
 #include "windows.h"
 #include "azure_c_util/gballoc.h"
@@ -34,6 +35,15 @@ typedef struct CLDS_HAZARD_POINTERS_THREAD_TAG
     CLDS_RECLAIM_LIST_ENTRY* reclaim_list;
     volatile LONG active;
     size_t reclaim_list_entry_count;
+
+    // last sequence number block used by this thread, the id is checked before the block is touched as the blocks might be gone already
+    uint64_t sequence_number_blocks_id;
+    struct CLDS_SEQUENCE_NUMBER_BLOCK_TAG* sequence_number_block;
+
+    // node kept protected between operations so that the owner can start its next search there, only touched by the owning thread
+    uint64_t finger_owner_id;
+    void* finger_node;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE finger_hp;
 } CLDS_HAZARD_POINTERS_THREAD;
 
 typedef struct CLDS_HAZARD_POINTERS_TAG
@@ -42,6 +52,28 @@ typedef struct CLDS_HAZARD_POINTERS_TAG
     volatile CLDS_HAZARD_POINTERS_THREAD* head;
 } CLDS_HAZARD_POINTERS;
 
+typedef struct CLDS_SEQUENCE_NUMBER_BLOCK_TAG
+{
+    struct CLDS_SEQUENCE_NUMBER_BLOCK_TAG* next;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    // only touched by the thread that owns the block
+    int64_t next_sequence_number;
+    int64_t last_sequence_number;
+} CLDS_SEQUENCE_NUMBER_BLOCK;
+
+typedef struct CLDS_SEQUENCE_NUMBER_BLOCKS_TAG
+{
+    uint64_t id;
+    volatile int64_t* sequence_number;
+    CLDS_HAZARD_POINTERS_SKIPPED_SEQ_NO_CB skipped_seq_no_cb;
+    void* skipped_seq_no_cb_context;
+    // one block per thread that ever took a number, blocks are only freed when the owner of the counter destroys them
+    volatile CLDS_SEQUENCE_NUMBER_BLOCK* head;
+} CLDS_SEQUENCE_NUMBER_BLOCKS;
+
+// ids are never reused, so a thread never touches a block of a destroyed set even if the memory got reused
+static volatile LONG64 sequence_number_blocks_id_source = 0;
+
 static uint64_t hp_key_hash(void* key)
 {
     return (uint64_t)key;
@@ -67,6 +99,18 @@ static int hp_key_compare(void* key1, void* key2)
     return result;
 }
 
+static void release_finger(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    if (clds_hazard_pointers_thread->finger_hp != NULL)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, clds_hazard_pointers_thread->finger_hp);
+    }
+
+    clds_hazard_pointers_thread->finger_owner_id = 0;
+    clds_hazard_pointers_thread->finger_node = NULL;
+    clds_hazard_pointers_thread->finger_hp = NULL;
+}
+
 static void internal_reclaim(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
 {
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
@@ -253,6 +297,11 @@ CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_register_thread(CLDS_HAZ
             CLDS_HAZARD_POINTERS_THREAD_HANDLE current_threads_head = (CLDS_HAZARD_POINTERS_THREAD_HANDLE)InterlockedCompareExchangePointer((volatile PVOID*)&clds_hazard_pointers->head, NULL, NULL);
             clds_hazard_pointers_thread->next = current_threads_head;
             clds_hazard_pointers_thread->reclaim_list_entry_count = 0;
+            clds_hazard_pointers_thread->sequence_number_blocks_id = 0;
+            clds_hazard_pointers_thread->sequence_number_block = NULL;
+            clds_hazard_pointers_thread->finger_owner_id = 0;
+            clds_hazard_pointers_thread->finger_node = NULL;
+            clds_hazard_pointers_thread->finger_hp = NULL;
             (void)InterlockedExchangePointer((volatile PVOID*)&clds_hazard_pointers_thread->pointers, NULL);
             (void)InterlockedExchangePointer((volatile PVOID*)&clds_hazard_pointers_thread->free_pointers, NULL);
             (void)InterlockedExchangePointer((volatile PVOID*)&clds_hazard_pointers_thread->reclaim_list, NULL);
@@ -280,6 +329,9 @@ void clds_hazard_pointers_unregister_thread(CLDS_HAZARD_POINTERS_THREAD_HANDLE c
     }
     else
     {
+        // stop protecting the finger node
+        release_finger(clds_hazard_pointers_thread);
+
         // remove the thread from the thread list
         clds_hazard_pointers_thread->reclaim_list_entry_count = 0;
         clds_hazard_pointers_thread->reclaim_list = NULL;
@@ -471,3 +523,203 @@ int clds_hazard_pointers_set_reclaim_threshold(CLDS_HAZARD_POINTERS_HANDLE clds_
 
     return result;
 }
+
+CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE clds_hazard_pointers_sequence_number_blocks_create(volatile int64_t* sequence_number, CLDS_HAZARD_POINTERS_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
+{
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE result;
+
+    if (sequence_number == NULL)
+    {
+        LogError("Invalid arguments: volatile int64_t* sequence_number=%p, CLDS_HAZARD_POINTERS_SKIPPED_SEQ_NO_CB skipped_seq_no_cb=%p, void* skipped_seq_no_cb_context=%p",
+            sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+        result = NULL;
+    }
+    else
+    {
+        result = (CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE)malloc(sizeof(CLDS_SEQUENCE_NUMBER_BLOCKS));
+        if (result == NULL)
+        {
+            LogError("malloc failed");
+        }
+        else
+        {
+            result->id = (uint64_t)InterlockedIncrement64(&sequence_number_blocks_id_source);
+            result->sequence_number = sequence_number;
+            result->skipped_seq_no_cb = skipped_seq_no_cb;
+            result->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
+            (void)InterlockedExchangePointer((volatile PVOID*)&result->head, NULL);
+        }
+    }
+
+    return result;
+}
+
+void clds_hazard_pointers_sequence_number_blocks_destroy(CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks)
+{
+    if (sequence_number_blocks == NULL)
+    {
+        LogError("Invalid arguments: CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks=%p", sequence_number_blocks);
+    }
+    else
+    {
+        CLDS_SEQUENCE_NUMBER_BLOCK* block = (CLDS_SEQUENCE_NUMBER_BLOCK*)InterlockedCompareExchangePointer((volatile PVOID*)&sequence_number_blocks->head, NULL, NULL);
+        while (block != NULL)
+        {
+            CLDS_SEQUENCE_NUMBER_BLOCK* next_block = block->next;
+
+            // report all the numbers that were reserved, but never handed out
+            if (sequence_number_blocks->skipped_seq_no_cb != NULL)
+            {
+                while (block->next_sequence_number <= block->last_sequence_number)
+                {
+                    sequence_number_blocks->skipped_seq_no_cb(sequence_number_blocks->skipped_seq_no_cb_context, block->next_sequence_number);
+                    block->next_sequence_number++;
+                }
+            }
+
+            free(block);
+            block = next_block;
+        }
+
+        free(sequence_number_blocks);
+    }
+}
+
+static CLDS_SEQUENCE_NUMBER_BLOCK* get_sequence_number_block(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks)
+{
+    CLDS_SEQUENCE_NUMBER_BLOCK* result;
+
+    if (clds_hazard_pointers_thread->sequence_number_blocks_id == sequence_number_blocks->id)
+    {
+        // same counter as last time, no lookup needed
+        result = clds_hazard_pointers_thread->sequence_number_block;
+    }
+    else
+    {
+        // blocks are never removed while the set is alive, so the list can be walked without protection
+        result = (CLDS_SEQUENCE_NUMBER_BLOCK*)InterlockedCompareExchangePointer((volatile PVOID*)&sequence_number_blocks->head, NULL, NULL);
+        while ((result != NULL) && (result->clds_hazard_pointers_thread != clds_hazard_pointers_thread))
+        {
+            result = result->next;
+        }
+
+        if (result == NULL)
+        {
+            // first number taken by this thread from this counter
+            result = (CLDS_SEQUENCE_NUMBER_BLOCK*)malloc(sizeof(CLDS_SEQUENCE_NUMBER_BLOCK));
+            if (result == NULL)
+            {
+                LogError("malloc failed");
+            }
+            else
+            {
+                CLDS_SEQUENCE_NUMBER_BLOCK* current_head;
+
+                result->clds_hazard_pointers_thread = clds_hazard_pointers_thread;
+                result->next_sequence_number = 1;
+                result->last_sequence_number = 0;
+                do
+                {
+                    current_head = (CLDS_SEQUENCE_NUMBER_BLOCK*)InterlockedCompareExchangePointer((volatile PVOID*)&sequence_number_blocks->head, NULL, NULL);
+                    result->next = current_head;
+                } while (InterlockedCompareExchangePointer((volatile PVOID*)&sequence_number_blocks->head, result, current_head) != current_head);
+            }
+        }
+
+        if (result != NULL)
+        {
+            clds_hazard_pointers_thread->sequence_number_blocks_id = sequence_number_blocks->id;
+            clds_hazard_pointers_thread->sequence_number_block = result;
+        }
+    }
+
+    return result;
+}
+
+int64_t clds_hazard_pointers_thread_get_sequence_number(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks, uint32_t block_size)
+{
+    int64_t result;
+
+    if (
+        (clds_hazard_pointers_thread == NULL) ||
+        (sequence_number_blocks == NULL) ||
+        (block_size == 0)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks=%p, uint32_t block_size=%" PRIu32,
+            clds_hazard_pointers_thread, sequence_number_blocks, block_size);
+        result = 0;
+    }
+    else
+    {
+        CLDS_SEQUENCE_NUMBER_BLOCK* block = get_sequence_number_block(clds_hazard_pointers_thread, sequence_number_blocks);
+        if (block == NULL)
+        {
+            LogError("Cannot get the sequence number block of the thread");
+            result = 0;
+        }
+        else
+        {
+            if (block->next_sequence_number > block->last_sequence_number)
+            {
+                // reserve a new block with a single interlocked operation on the shared counter
+                block->last_sequence_number = InterlockedAdd64((volatile LONG64*)sequence_number_blocks->sequence_number, (LONG64)block_size);
+                block->next_sequence_number = block->last_sequence_number - block_size + 1;
+            }
+
+            result = block->next_sequence_number;
+            block->next_sequence_number++;
+        }
+    }
+
+    return result;
+}
+
+void* clds_hazard_pointers_thread_get_finger(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t owner_id)
+{
+    void* result;
+
+    if (
+        (clds_hazard_pointers_thread == NULL) ||
+        (owner_id == 0)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint64_t owner_id=%" PRIu64 "",
+            clds_hazard_pointers_thread, owner_id);
+        result = NULL;
+    }
+    else if (clds_hazard_pointers_thread->finger_owner_id != owner_id)
+    {
+        // the finger belongs to someone else (or there is none)
+        result = NULL;
+    }
+    else
+    {
+        result = clds_hazard_pointers_thread->finger_node;
+    }
+
+    return result;
+}
+
+void clds_hazard_pointers_thread_set_finger(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t owner_id, void* node, CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer_record)
+{
+    if (
+        (clds_hazard_pointers_thread == NULL) ||
+        (owner_id == 0) ||
+        (node == NULL) ||
+        (clds_hazard_pointer_record == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint64_t owner_id=%" PRIu64 ", void* node=%p, CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer_record=%p",
+            clds_hazard_pointers_thread, owner_id, node, clds_hazard_pointer_record);
+    }
+    else
+    {
+        // only one finger is kept per thread, the previous one is not protected anymore
+        release_finger(clds_hazard_pointers_thread);
+
+        clds_hazard_pointers_thread->finger_owner_id = owner_id;
+        clds_hazard_pointers_thread->finger_node = node;
+        clds_hazard_pointers_thread->finger_hp = clds_hazard_pointer_record;
+    }
+}
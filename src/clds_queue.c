@@ -0,0 +1,412 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "azure_c_util/gballoc.h"
+#include "azure_c_logging/xlogging.h"
+#include "clds/clds_queue.h"
+#include "clds/clds_atomics.h"
+#include "clds/clds_backoff.h"
+#include "clds/clds_hazard_pointers.h"
+
+/* this is a lock free FIFO queue implementation (Michael-Scott queue) */
+
+// head always points to a sentinel item, the items in the queue are the ones after the sentinel
+// when an item is dequeued it becomes the new sentinel and the previous sentinel is reclaimed
+
+typedef struct CLDS_QUEUE_TAG
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    volatile CLDS_QUEUE_ITEM* head;
+    volatile CLDS_QUEUE_ITEM* tail;
+    volatile LONG backoff_policy;
+} CLDS_QUEUE;
+
+static void internal_node_destroy(CLDS_QUEUE_ITEM* item)
+{
+    if (InterlockedDecrement(&item->ref_count) == 0)
+    {
+        /* Codes_SRS_CLDS_QUEUE_01_032: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
+        if (item->item_cleanup_callback != NULL)
+        {
+            /* Codes_SRS_CLDS_QUEUE_01_031: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_queue_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+            item->item_cleanup_callback(item->item_cleanup_callback_context, item);
+        }
+
+        free((void*)item);
+    }
+}
+
+static void reclaim_queue_node(void* node)
+{
+    internal_node_destroy((CLDS_QUEUE_ITEM*)node);
+}
+
+static void internal_node_init(volatile CLDS_QUEUE_ITEM* item, QUEUE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context)
+{
+    item->item_cleanup_callback = item_cleanup_callback;
+    item->item_cleanup_callback_context = item_cleanup_callback_context;
+    (void)InterlockedExchange(&item->ref_count, 1);
+    (void)InterlockedExchangePointer((volatile PVOID*)&item->next, NULL);
+}
+
+static CLDS_BACKOFF_POLICY get_backoff_policy(CLDS_QUEUE_HANDLE clds_queue)
+{
+    return (CLDS_BACKOFF_POLICY)InterlockedAdd(&clds_queue->backoff_policy, 0);
+}
+
+CLDS_QUEUE_HANDLE clds_queue_create(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers)
+{
+    CLDS_QUEUE_HANDLE clds_queue;
+
+    /* Codes_SRS_CLDS_QUEUE_01_003: [ If clds_hazard_pointers is NULL, clds_queue_create shall fail and return NULL. ]*/
+    if (clds_hazard_pointers == NULL)
+    {
+        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p", clds_hazard_pointers);
+        clds_queue = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_QUEUE_01_001: [ clds_queue_create shall create a new queue object and on success it shall return a non-NULL handle to the newly created queue. ]*/
+        clds_queue = (CLDS_QUEUE_HANDLE)malloc(sizeof(CLDS_QUEUE));
+        if (clds_queue == NULL)
+        {
+            /* Codes_SRS_CLDS_QUEUE_01_002: [ If any error happens, clds_queue_create shall fail and return NULL. ]*/
+            LogError("Cannot allocate memory for the queue");
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_QUEUE_01_004: [ clds_queue_create shall allocate a sentinel item and set both the head and the tail of the queue to it. ]*/
+            CLDS_QUEUE_ITEM* sentinel = (CLDS_QUEUE_ITEM*)malloc(sizeof(CLDS_QUEUE_ITEM));
+            if (sentinel == NULL)
+            {
+                /* Codes_SRS_CLDS_QUEUE_01_002: [ If any error happens, clds_queue_create shall fail and return NULL. ]*/
+                LogError("Cannot allocate memory for the queue sentinel item");
+                free(clds_queue);
+                clds_queue = NULL;
+            }
+            else
+            {
+                // all ok
+                internal_node_init(sentinel, NULL, NULL);
+
+                clds_queue->clds_hazard_pointers = clds_hazard_pointers;
+                (void)InterlockedExchange(&clds_queue->backoff_policy, CLDS_BACKOFF_POLICY_NONE);
+
+                (void)InterlockedExchangePointer((volatile PVOID*)&clds_queue->head, sentinel);
+                (void)InterlockedExchangePointer((volatile PVOID*)&clds_queue->tail, sentinel);
+            }
+        }
+    }
+
+    return clds_queue;
+}
+
+void clds_queue_destroy(CLDS_QUEUE_HANDLE clds_queue)
+{
+    if (clds_queue == NULL)
+    {
+        /* Codes_SRS_CLDS_QUEUE_01_006: [ If clds_queue is NULL, clds_queue_destroy shall return. ]*/
+        LogError("Invalid arguments: CLDS_QUEUE_HANDLE clds_queue=%p", clds_queue);
+    }
+    else
+    {
+        // start with the sentinel, it is either the one allocated at create or the last dequeued item
+        CLDS_QUEUE_ITEM* current_item = InterlockedCompareExchangePointer((volatile PVOID*)&clds_queue->head, NULL, NULL);
+
+        /* Codes_SRS_CLDS_QUEUE_01_007: [ Any items still present in the queue shall be freed. ]*/
+        // go through all the items and release the reference held by the queue
+        while (current_item != NULL)
+        {
+            CLDS_QUEUE_ITEM* next_item = InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL);
+
+            /* Codes_SRS_CLDS_QUEUE_01_008: [ For each item that is freed, the callback item_cleanup_callback passed to clds_queue_node_create shall be called, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+            /* Codes_SRS_CLDS_QUEUE_01_009: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the freed items. ]*/
+            internal_node_destroy(current_item);
+            current_item = next_item;
+        }
+
+        /* Codes_SRS_CLDS_QUEUE_01_005: [ clds_queue_destroy shall free all resources associated with the queue instance. ]*/
+        free(clds_queue);
+    }
+}
+
+int clds_queue_set_backoff_policy(CLDS_QUEUE_HANDLE clds_queue, CLDS_BACKOFF_POLICY backoff_policy)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_QUEUE_01_011: [ If clds_queue is NULL, clds_queue_set_backoff_policy shall fail and return a non-zero value. ]*/
+        (clds_queue == NULL) ||
+        /* Codes_SRS_CLDS_QUEUE_01_012: [ If backoff_policy is not a valid CLDS_BACKOFF_POLICY value, clds_queue_set_backoff_policy shall fail and return a non-zero value. ]*/
+        ((int)backoff_policy < (int)CLDS_BACKOFF_POLICY_NONE) ||
+        ((int)backoff_policy > (int)CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT)
+        )
+    {
+        LogError("Invalid arguments: CLDS_QUEUE_HANDLE clds_queue=%p, CLDS_BACKOFF_POLICY backoff_policy=%" PRI_MU_ENUM "",
+            clds_queue, MU_ENUM_VALUE(CLDS_BACKOFF_POLICY, backoff_policy));
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_QUEUE_01_010: [ clds_queue_set_backoff_policy shall set the backoff policy used by all subsequent operations on the queue when they have to retry because of a concurrent change and return 0. ]*/
+        (void)InterlockedExchange(&clds_queue->backoff_policy, (LONG)backoff_policy);
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_queue_enqueue(CLDS_QUEUE_HANDLE clds_queue, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_QUEUE_ITEM* item)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_QUEUE_01_016: [ If clds_queue is NULL, clds_queue_enqueue shall fail and return a non-zero value. ]*/
+        (clds_queue == NULL) ||
+        /* Codes_SRS_CLDS_QUEUE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_queue_enqueue shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_QUEUE_01_018: [ If item is NULL, clds_queue_enqueue shall fail and return a non-zero value. ]*/
+        (item == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_QUEUE_HANDLE clds_queue=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_QUEUE_ITEM* item=%p",
+            clds_queue, clds_hazard_pointers_thread, item);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_queue));
+
+        (void)InterlockedExchangePointer((volatile PVOID*)&item->next, NULL);
+
+        /* Codes_SRS_CLDS_QUEUE_01_014: [ clds_queue_enqueue shall add item at the tail of the queue. ]*/
+        do
+        {
+            volatile CLDS_QUEUE_ITEM* tail_item = (volatile CLDS_QUEUE_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&clds_queue->tail, NULL, NULL);
+
+            // the hazard pointer keeps the tail item from being freed while we link the new item to it
+            CLDS_HAZARD_POINTER_RECORD_HANDLE tail_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)tail_item);
+            restart_needed = false;
+
+            if (tail_item_hp == NULL)
+            {
+                /* Codes_SRS_CLDS_QUEUE_01_019: [ If any error occurs, clds_queue_enqueue shall fail and return a non-zero value. ]*/
+                LogError("Cannot acquire hazard pointer");
+                result = MU_FAILURE;
+            }
+            else
+            {
+                if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_queue->tail, NULL, NULL) != (PVOID)tail_item)
+                {
+                    // tail changed, the item might have been reclaimed before the hazard pointer was set, restart
+                    restart_needed = true;
+                }
+                else
+                {
+                    volatile CLDS_QUEUE_ITEM* tail_next = (volatile CLDS_QUEUE_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&tail_item->next, NULL, NULL);
+                    if (tail_next != NULL)
+                    {
+                        // tail is lagging behind, help the other enqueue by advancing it and restart
+                        (void)InterlockedCompareExchangePointer((volatile PVOID*)&clds_queue->tail, (PVOID)tail_next, (PVOID)tail_item);
+                        restart_needed = true;
+                    }
+                    else if (InterlockedCompareExchangePointer((volatile PVOID*)&tail_item->next, item, NULL) != NULL)
+                    {
+                        // another item was linked in the meanwhile, restart
+                        restart_needed = true;
+                    }
+                    else
+                    {
+                        // the item is in the queue, try to advance tail, if this fails someone else already helped
+                        (void)InterlockedCompareExchangePointer((volatile PVOID*)&clds_queue->tail, item, (PVOID)tail_item);
+
+                        /* Codes_SRS_CLDS_QUEUE_01_015: [ On success clds_queue_enqueue shall return 0. ]*/
+                        result = 0;
+                    }
+                }
+
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, tail_item_hp);
+            }
+
+            if (restart_needed)
+            {
+                /* Codes_SRS_CLDS_QUEUE_01_013: [ Before retrying because of a concurrent change, the queue operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the queue. ]*/
+                clds_backoff_retry(&backoff);
+            }
+        } while (restart_needed);
+    }
+
+    return result;
+}
+
+CLDS_QUEUE_DEQUEUE_RESULT clds_queue_dequeue(CLDS_QUEUE_HANDLE clds_queue, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_QUEUE_ITEM** item)
+{
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_QUEUE_01_022: [ If clds_queue is NULL, clds_queue_dequeue shall fail and return CLDS_QUEUE_DEQUEUE_ERROR. ]*/
+        (clds_queue == NULL) ||
+        /* Codes_SRS_CLDS_QUEUE_01_023: [ If clds_hazard_pointers_thread is NULL, clds_queue_dequeue shall fail and return CLDS_QUEUE_DEQUEUE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_QUEUE_01_024: [ If item is NULL, clds_queue_dequeue shall fail and return CLDS_QUEUE_DEQUEUE_ERROR. ]*/
+        (item == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_QUEUE_HANDLE clds_queue=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_QUEUE_ITEM** item=%p",
+            clds_queue, clds_hazard_pointers_thread, item);
+        result = CLDS_QUEUE_DEQUEUE_ERROR;
+    }
+    else
+    {
+        bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_queue));
+
+        /* Codes_SRS_CLDS_QUEUE_01_020: [ clds_queue_dequeue shall remove the least recently enqueued item from the queue. ]*/
+        do
+        {
+            volatile CLDS_QUEUE_ITEM* head_item = (volatile CLDS_QUEUE_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&clds_queue->head, NULL, NULL);
+            volatile CLDS_QUEUE_ITEM* previous_sentinel = NULL;
+
+            // the hazard pointer keeps the sentinel from being freed while we look at its next pointer
+            CLDS_HAZARD_POINTER_RECORD_HANDLE head_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)head_item);
+            restart_needed = false;
+
+            if (head_item_hp == NULL)
+            {
+                /* Codes_SRS_CLDS_QUEUE_01_026: [ If any error occurs, clds_queue_dequeue shall fail and return CLDS_QUEUE_DEQUEUE_ERROR. ]*/
+                LogError("Cannot acquire hazard pointer");
+                result = CLDS_QUEUE_DEQUEUE_ERROR;
+            }
+            else
+            {
+                if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_queue->head, NULL, NULL) != (PVOID)head_item)
+                {
+                    // head changed, the sentinel might have been reclaimed before the hazard pointer was set, restart
+                    restart_needed = true;
+                }
+                else
+                {
+                    volatile CLDS_QUEUE_ITEM* tail_item = (volatile CLDS_QUEUE_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&clds_queue->tail, NULL, NULL);
+                    volatile CLDS_QUEUE_ITEM* head_next = (volatile CLDS_QUEUE_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&head_item->next, NULL, NULL);
+
+                    if (head_next == NULL)
+                    {
+                        /* Codes_SRS_CLDS_QUEUE_01_025: [ If the queue is empty, clds_queue_dequeue shall return CLDS_QUEUE_DEQUEUE_EMPTY. ]*/
+                        result = CLDS_QUEUE_DEQUEUE_EMPTY;
+                    }
+                    else
+                    {
+                        // the next item becomes the new sentinel, so it needs to be protected too
+                        CLDS_HAZARD_POINTER_RECORD_HANDLE head_next_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)head_next);
+                        if (head_next_hp == NULL)
+                        {
+                            /* Codes_SRS_CLDS_QUEUE_01_026: [ If any error occurs, clds_queue_dequeue shall fail and return CLDS_QUEUE_DEQUEUE_ERROR. ]*/
+                            LogError("Cannot acquire hazard pointer");
+                            result = CLDS_QUEUE_DEQUEUE_ERROR;
+                        }
+                        else
+                        {
+                            if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_queue->head, NULL, NULL) != (PVOID)head_item)
+                            {
+                                // head moved, the next item might have been dequeued and reclaimed already, restart
+                                restart_needed = true;
+                            }
+                            else if (head_item == tail_item)
+                            {
+                                // tail is lagging behind, help the enqueue by advancing it and restart
+                                (void)InterlockedCompareExchangePointer((volatile PVOID*)&clds_queue->tail, (PVOID)head_next, (PVOID)tail_item);
+                                restart_needed = true;
+                            }
+                            else if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_queue->head, (PVOID)head_next, (PVOID)head_item) != (PVOID)head_item)
+                            {
+                                // another dequeue won, restart
+                                restart_needed = true;
+                            }
+                            else
+                            {
+                                /* Codes_SRS_CLDS_QUEUE_01_027: [ clds_queue_dequeue shall return the item with its reference count incremented, so that it can be used by the caller until it calls clds_queue_node_release. ]*/
+                                (void)InterlockedIncrement(&head_next->ref_count);
+                                *item = (CLDS_QUEUE_ITEM*)head_next;
+
+                                // the dequeued item is the new sentinel, the old sentinel can go once the hazard pointers are released
+                                previous_sentinel = head_item;
+
+                                /* Codes_SRS_CLDS_QUEUE_01_021: [ On success, clds_queue_dequeue shall return CLDS_QUEUE_DEQUEUE_OK. ]*/
+                                result = CLDS_QUEUE_DEQUEUE_OK;
+                            }
+
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, head_next_hp);
+                        }
+                    }
+                }
+
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, head_item_hp);
+
+                if (previous_sentinel != NULL)
+                {
+                    /* Codes_SRS_CLDS_QUEUE_01_028: [ The reference held by the queue on the previous sentinel item shall be released by indicating the item to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+                    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)previous_sentinel, reclaim_queue_node);
+                }
+            }
+
+            if (restart_needed)
+            {
+                /* Codes_SRS_CLDS_QUEUE_01_013: [ Before retrying because of a concurrent change, the queue operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the queue. ]*/
+                clds_backoff_retry(&backoff);
+            }
+        } while (restart_needed);
+    }
+
+    return result;
+}
+
+CLDS_QUEUE_ITEM* clds_queue_node_create(size_t node_size, QUEUE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context)
+{
+    /* Codes_SRS_CLDS_QUEUE_01_029: [ item_cleanup_callback shall be allowed to be NULL. ]*/
+    /* Codes_SRS_CLDS_QUEUE_01_030: [ item_cleanup_callback_context shall be allowed to be NULL. ]*/
+
+    void* result = malloc(node_size);
+    if (result == NULL)
+    {
+        LogError("malloc failed");
+    }
+    else
+    {
+        internal_node_init((volatile CLDS_QUEUE_ITEM*)result, item_cleanup_callback, item_cleanup_callback_context);
+    }
+
+    return result;
+}
+
+int clds_queue_node_inc_ref(CLDS_QUEUE_ITEM* item)
+{
+    int result;
+
+    if (item == NULL)
+    {
+        LogError("Invalid arguments: CLDS_QUEUE_ITEM* item=%p", item);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        (void)InterlockedIncrement(&item->ref_count);
+        result = 0;
+    }
+
+    return result;
+}
+
+void clds_queue_node_release(CLDS_QUEUE_ITEM* item)
+{
+    if (item == NULL)
+    {
+        LogError("Invalid arguments: CLDS_QUEUE_ITEM* item=%p", item);
+    }
+    else
+    {
+        internal_node_destroy(item);
+    }
+}
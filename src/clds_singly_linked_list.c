@@ -2,19 +2,43 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdbool.h>
 #include "azure_c_util/gballoc.h"
 #include "azure_c_logging/xlogging.h"
 #include "clds/clds_singly_linked_list.h"
 #include "clds/clds_atomics.h"
+#include "clds/clds_backoff.h"
 #include "clds/clds_hazard_pointers.h"
 
 /* this is a lock free singly linked list implementation */
 
+// how many times an insert that offered its item in an elimination slot checks whether a pop took it
+#define ELIMINATION_WAIT_SPIN_COUNT 128
+
+// how many times clds_singly_linked_list_for_each reads again the link of the last visited item while it is marked, before giving up
+#define FOR_EACH_MARKED_LINK_READ_COUNT 16
+
+// an elimination slot holds an item offered by an insert that collided on the head, a colliding pop can take it without touching the head
+typedef struct ELIMINATION_SLOT_TAG
+{
+    volatile CLDS_SINGLY_LINKED_LIST_ITEM* item;
+    // keep each slot on its own cache line, so that pairs meeting in different slots do not slow each other down
+    unsigned char padding[64 - sizeof(void*)];
+} ELIMINATION_SLOT;
+
+typedef struct ELIMINATION_ARRAY_TAG
+{
+    uint32_t slot_count;
+    ELIMINATION_SLOT* slots;
+} ELIMINATION_ARRAY;
+
 typedef struct CLDS_SINGLY_LINKED_LIST_TAG
 {
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
     volatile CLDS_SINGLY_LINKED_LIST_ITEM* head;
+    volatile LONG backoff_policy;
+    volatile ELIMINATION_ARRAY* elimination_array;
 } CLDS_SINGLY_LINKED_LIST;
 
 static bool compare_item_by_ptr(void* item_compare_context, CLDS_SINGLY_LINKED_LIST_ITEM* item)
@@ -53,11 +77,89 @@ static void reclaim_list_node(void* node)
     internal_node_destroy((CLDS_SINGLY_LINKED_LIST_ITEM*)node);
 }
 
+static CLDS_BACKOFF_POLICY get_backoff_policy(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list)
+{
+    return (CLDS_BACKOFF_POLICY)InterlockedAdd(&clds_singly_linked_list->backoff_policy, 0);
+}
+
+static ELIMINATION_SLOT* get_elimination_slot(ELIMINATION_ARRAY* elimination_array, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t attempt)
+{
+    // each thread starts from a slot picked by its thread handle and moves to the next slot on every collision
+    return &elimination_array->slots[(uint32_t)(((uintptr_t)clds_hazard_pointers_thread >> 4) + attempt) % elimination_array->slot_count];
+}
+
+static bool eliminate_insert(ELIMINATION_ARRAY* elimination_array, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t attempt, CLDS_SINGLY_LINKED_LIST_ITEM* item)
+{
+    bool result;
+    ELIMINATION_SLOT* slot = get_elimination_slot(elimination_array, clds_hazard_pointers_thread, attempt);
+
+    if (InterlockedCompareExchangePointer((volatile PVOID*)&slot->item, (PVOID)item, NULL) != NULL)
+    {
+        // slot is busy with the offer of another insert
+        result = false;
+    }
+    else
+    {
+        uint32_t i;
+
+        // give a pop a short window to take the item
+        for (i = 0; i < ELIMINATION_WAIT_SPIN_COUNT; i++)
+        {
+            if (InterlockedCompareExchangePointer((volatile PVOID*)&slot->item, NULL, NULL) != (PVOID)item)
+            {
+                break;
+            }
+
+            YieldProcessor();
+        }
+
+        // withdraw the offer, if that fails a pop has taken the item
+        result = (InterlockedCompareExchangePointer((volatile PVOID*)&slot->item, NULL, (PVOID)item) != (PVOID)item);
+    }
+
+    return result;
+}
+
+static CLDS_SINGLY_LINKED_LIST_ITEM* eliminate_pop(ELIMINATION_ARRAY* elimination_array, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t attempt)
+{
+    CLDS_SINGLY_LINKED_LIST_ITEM* result;
+    ELIMINATION_SLOT* slot = get_elimination_slot(elimination_array, clds_hazard_pointers_thread, attempt);
+    CLDS_SINGLY_LINKED_LIST_ITEM* offered_item = (CLDS_SINGLY_LINKED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&slot->item, NULL, NULL);
+
+    if ((offered_item != NULL) &&
+        (InterlockedCompareExchangePointer((volatile PVOID*)&slot->item, NULL, (PVOID)offered_item) == (PVOID)offered_item))
+    {
+        // the offered item was not linked by this insert, but it can be an item that was popped or deleted before and re-inserted
+        // a pop or delete that still looks at it from back then can hold a short lived delete mark, wait for it to be removed
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_103: [ An item taken from an elimination slot shall be returned with the delete mark set on its next pointer, like an item popped from the head of the list. ]*/
+        do
+        {
+            CLDS_SINGLY_LINKED_LIST_ITEM* offered_item_next = (CLDS_SINGLY_LINKED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&offered_item->next, NULL, NULL);
+            if ((((uintptr_t)offered_item_next & 0x1) == 0) &&
+                (InterlockedCompareExchangePointer((volatile PVOID*)&offered_item->next, (PVOID)((uintptr_t)offered_item_next | 1), (PVOID)offered_item_next) == (PVOID)offered_item_next))
+            {
+                break;
+            }
+
+            YieldProcessor();
+        } while (1);
+
+        result = offered_item;
+    }
+    else
+    {
+        result = NULL;
+    }
+
+    return result;
+}
+
 static CLDS_SINGLY_LINKED_LIST_DELETE_RESULT internal_delete(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_COMPARE_CB item_compare_callback, void* item_compare_callback_context)
 {
     CLDS_SINGLY_LINKED_LIST_DELETE_RESULT result = CLDS_SINGLY_LINKED_LIST_DELETE_ERROR;
 
     bool restart_needed;
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_singly_linked_list));
 
     do
     {
@@ -235,6 +337,11 @@ static CLDS_SINGLY_LINKED_LIST_DELETE_RESULT internal_delete(CLDS_SINGLY_LINKED_
                 }
             }
         } while (1);
+        if (restart_needed)
+        {
+            /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_048: [ Before retrying because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+            clds_backoff_retry(&backoff);
+        }
     } while (restart_needed);
 
     return result;
@@ -263,6 +370,8 @@ CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list_create(CLDS_HAZARD_POINTE
         {
             // all ok
             clds_singly_linked_list->clds_hazard_pointers = clds_hazard_pointers;
+            (void)InterlockedExchange(&clds_singly_linked_list->backoff_policy, CLDS_BACKOFF_POLICY_NONE);
+            (void)InterlockedExchangePointer((volatile PVOID*)&clds_singly_linked_list->elimination_array, NULL);
 
             (void)InterlockedExchangePointer((volatile PVOID*)&clds_singly_linked_list->head, NULL);
         }
@@ -281,6 +390,7 @@ void clds_singly_linked_list_destroy(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_
     else
     {
         CLDS_SINGLY_LINKED_LIST_ITEM* current_item = InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->head, NULL, NULL);
+        ELIMINATION_ARRAY* elimination_array;
 
         /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_039: [ Any items still present in the list shall be freed. ]*/
         // go through all the items and free them
@@ -294,11 +404,119 @@ void clds_singly_linked_list_destroy(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_
             current_item = next_item;
         } 
 
+        elimination_array = (ELIMINATION_ARRAY*)InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->elimination_array, NULL, NULL);
+        if (elimination_array != NULL)
+        {
+            free(elimination_array->slots);
+            free(elimination_array);
+        }
+
         /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_004: [ clds_singly_linked_list_destroy shall free all resources associated with the singly linked list instance. ]*/
         free(clds_singly_linked_list);
     }
 }
 
+int clds_singly_linked_list_set_backoff_policy(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_BACKOFF_POLICY backoff_policy)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_046: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_set_backoff_policy shall fail and return a non-zero value. ]*/
+        (clds_singly_linked_list == NULL) ||
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_047: [ If backoff_policy is not a valid CLDS_BACKOFF_POLICY value, clds_singly_linked_list_set_backoff_policy shall fail and return a non-zero value. ]*/
+        ((int)backoff_policy < (int)CLDS_BACKOFF_POLICY_NONE) ||
+        ((int)backoff_policy > (int)CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list=%p, CLDS_BACKOFF_POLICY backoff_policy=%" PRI_MU_ENUM "",
+            clds_singly_linked_list, MU_ENUM_VALUE(CLDS_BACKOFF_POLICY, backoff_policy));
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_045: [ clds_singly_linked_list_set_backoff_policy shall set the backoff policy used by all subsequent operations on the list when they have to retry because of a concurrent change and return 0. ]*/
+        (void)InterlockedExchange(&clds_singly_linked_list->backoff_policy, (LONG)backoff_policy);
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_singly_linked_list_enable_elimination(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, uint32_t slot_count)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_093: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_enable_elimination shall fail and return a non-zero value. ]*/
+        (clds_singly_linked_list == NULL) ||
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_094: [ If slot_count is 0, clds_singly_linked_list_enable_elimination shall fail and return a non-zero value. ]*/
+        (slot_count == 0)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list=%p, uint32_t slot_count=%" PRIu32 "",
+            clds_singly_linked_list, slot_count);
+        result = MU_FAILURE;
+    }
+    else if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->elimination_array, NULL, NULL) != NULL)
+    {
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_095: [ If elimination is already enabled for the list, clds_singly_linked_list_enable_elimination shall fail and return a non-zero value. ]*/
+        LogError("Elimination is already enabled for list %p", clds_singly_linked_list);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_091: [ clds_singly_linked_list_enable_elimination shall allocate an elimination array with slot_count slots, used by clds_singly_linked_list_insert and clds_singly_linked_list_pop_head when they collide on the head of the list. ]*/
+        ELIMINATION_ARRAY* elimination_array = (ELIMINATION_ARRAY*)malloc(sizeof(ELIMINATION_ARRAY));
+        if (elimination_array == NULL)
+        {
+            /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_096: [ If any error occurs, clds_singly_linked_list_enable_elimination shall fail and return a non-zero value. ]*/
+            LogError("Cannot allocate elimination array");
+            result = MU_FAILURE;
+        }
+        else
+        {
+            elimination_array->slots = (ELIMINATION_SLOT*)malloc(sizeof(ELIMINATION_SLOT) * slot_count);
+            if (elimination_array->slots == NULL)
+            {
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_096: [ If any error occurs, clds_singly_linked_list_enable_elimination shall fail and return a non-zero value. ]*/
+                LogError("Cannot allocate %" PRIu32 " elimination slots", slot_count);
+                result = MU_FAILURE;
+            }
+            else
+            {
+                uint32_t i;
+
+                elimination_array->slot_count = slot_count;
+                for (i = 0; i < slot_count; i++)
+                {
+                    elimination_array->slots[i].item = NULL;
+                }
+
+                // publish the array, operations either see no array or a fully initialized one
+                if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->elimination_array, (PVOID)elimination_array, NULL) != NULL)
+                {
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_095: [ If elimination is already enabled for the list, clds_singly_linked_list_enable_elimination shall fail and return a non-zero value. ]*/
+                    LogError("Elimination is already enabled for list %p", clds_singly_linked_list);
+                    result = MU_FAILURE;
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_092: [ On success, clds_singly_linked_list_enable_elimination shall return 0. ]*/
+                    result = 0;
+                    goto all_ok;
+                }
+
+                free(elimination_array->slots);
+            }
+
+            free(elimination_array);
+        }
+    }
+
+all_ok:
+    return result;
+}
+
 int clds_singly_linked_list_insert(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SINGLY_LINKED_LIST_ITEM* item)
 {
     int result;
@@ -321,21 +539,57 @@ int clds_singly_linked_list_insert(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_li
     else
     {
         bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_singly_linked_list));
+        uint32_t elimination_attempt = 0;
+
+        // get current head
+        volatile CLDS_SINGLY_LINKED_LIST_ITEM* current_head = (volatile CLDS_SINGLY_LINKED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->head, NULL, NULL);
+
+        // an item that was popped or deleted before keeps the delete mark on its next pointer, nobody else can set a mark on a marked pointer, so it is simply overwritten
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_102: [ clds_singly_linked_list_insert shall allow inserting an item that was popped or deleted from a list, as long as the caller holds a reference to it. ]*/
+        (void)InterlockedExchangePointer((volatile PVOID*)&item->next, (PVOID)current_head);
 
         do
         {
-            // get current head
             /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_009: [ clds_singly_linked_list_insert inserts an item in the list. ]*/
-            item->next = (CLDS_SINGLY_LINKED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->head, NULL, NULL);
-
-            if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->head, item, (PVOID)item->next) != item->next)
+            if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->head, item, (PVOID)current_head) != (PVOID)current_head)
             {
-                restart_needed = true;
+                ELIMINATION_ARRAY* elimination_array = (ELIMINATION_ARRAY*)InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->elimination_array, NULL, NULL);
+
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_097: [ If elimination is enabled and the insert collides with another operation on the head, clds_singly_linked_list_insert shall offer the item in an elimination slot for a short time. ]*/
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_098: [ If a clds_singly_linked_list_pop_head takes the offered item, clds_singly_linked_list_insert shall succeed without changing the head of the list. ]*/
+                if ((elimination_array != NULL) &&
+                    eliminate_insert(elimination_array, clds_hazard_pointers_thread, elimination_attempt++, item))
+                {
+                    restart_needed = false;
+                }
+                else
+                {
+                    restart_needed = true;
+                }
             }
             else
             {
                 restart_needed = false;
             }
+            if (restart_needed)
+            {
+                volatile CLDS_SINGLY_LINKED_LIST_ITEM* new_head;
+
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_048: [ Before retrying because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                clds_backoff_retry(&backoff);
+
+                // a pop or delete that saw the item in the list before it was popped can mark the item now that its next pointer is not marked anymore
+                // its CAS on the head fails as the item is not linked and it then removes its mark, so the mark must not be overwritten (the pop would use the stale next pointer if the item gets linked)
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_101: [ When retrying, clds_singly_linked_list_insert shall set the next pointer of item to the new head with a CAS, waiting for a concurrent clds_singly_linked_list_pop_head or delete that marked item to remove its mark. ]*/
+                new_head = (volatile CLDS_SINGLY_LINKED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->head, NULL, NULL);
+                while (InterlockedCompareExchangePointer((volatile PVOID*)&item->next, (PVOID)new_head, (PVOID)current_head) != (PVOID)current_head)
+                {
+                    clds_backoff_retry(&backoff);
+                }
+
+                current_head = new_head;
+            }
         } while (restart_needed);
 
         /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_010: [ On success clds_singly_linked_list_insert shall return 0. ]*/
@@ -399,6 +653,458 @@ CLDS_SINGLY_LINKED_LIST_DELETE_RESULT clds_singly_linked_list_delete_if(CLDS_SIN
     return result;
 }
 
+CLDS_SINGLY_LINKED_LIST_DELETE_RESULT clds_singly_linked_list_delete_all_if(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_COMPARE_CB item_compare_callback, void* item_compare_callback_context, size_t* deleted_item_count)
+{
+    CLDS_SINGLY_LINKED_LIST_DELETE_RESULT result;
+
+    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_087: [ item_compare_callback_context shall be allowed to be NULL. ]*/
+
+    if (
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_083: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_delete_all_if shall fail and return CLDS_SINGLY_LINKED_LIST_DELETE_ERROR. ]*/
+        (clds_singly_linked_list == NULL) ||
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_084: [ If clds_hazard_pointers_thread is NULL, clds_singly_linked_list_delete_all_if shall fail and return CLDS_SINGLY_LINKED_LIST_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_085: [ If item_compare_callback is NULL, clds_singly_linked_list_delete_all_if shall fail and return CLDS_SINGLY_LINKED_LIST_DELETE_ERROR. ]*/
+        (item_compare_callback == NULL) ||
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_086: [ If deleted_item_count is NULL, clds_singly_linked_list_delete_all_if shall fail and return CLDS_SINGLY_LINKED_LIST_DELETE_ERROR. ]*/
+        (deleted_item_count == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, SINGLY_LINKED_LIST_ITEM_COMPARE_CB item_compare_callback=%p, void* item_compare_callback_context=%p, size_t* deleted_item_count=%p",
+            clds_singly_linked_list, clds_hazard_pointers_thread, item_compare_callback, item_compare_callback_context, deleted_item_count);
+        result = CLDS_SINGLY_LINKED_LIST_DELETE_ERROR;
+    }
+    else
+    {
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_singly_linked_list));
+        CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+        volatile CLDS_SINGLY_LINKED_LIST_ITEM** current_item_address = &clds_singly_linked_list->head;
+        size_t deleted_count = 0;
+
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_079: [ clds_singly_linked_list_delete_all_if shall remove from the list all the items that match the criteria given by item_compare_callback in one walk of the list. ]*/
+        do
+        {
+            // get the current_item value
+            volatile CLDS_SINGLY_LINKED_LIST_ITEM* current_item = (volatile CLDS_SINGLY_LINKED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL);
+            if (((uintptr_t)current_item & 0x1) != 0)
+            {
+                // the previous (kept) item is being removed by someone else, we cannot unlink anything after it
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_089: [ If the last kept item is being removed concurrently, clds_singly_linked_list_delete_all_if shall walk the list again from the head. ]*/
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                previous_hp = NULL;
+                current_item_address = &clds_singly_linked_list->head;
+
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_048: [ Before retrying because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                clds_backoff_retry(&backoff);
+            }
+            else if (current_item == NULL)
+            {
+                if (previous_hp != NULL)
+                {
+                    // let go of previous hazard pointer
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                }
+
+                *deleted_item_count = deleted_count;
+
+                if (deleted_count == 0)
+                {
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_082: [ If no item matches the criteria, clds_singly_linked_list_delete_all_if shall set deleted_item_count to 0 and return CLDS_SINGLY_LINKED_LIST_DELETE_NOT_FOUND. ]*/
+                    result = CLDS_SINGLY_LINKED_LIST_DELETE_NOT_FOUND;
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_081: [ On success, clds_singly_linked_list_delete_all_if shall set deleted_item_count to the number of removed items and return CLDS_SINGLY_LINKED_LIST_DELETE_OK. ]*/
+                    result = CLDS_SINGLY_LINKED_LIST_DELETE_OK;
+                }
+
+                break;
+            }
+            else
+            {
+                // acquire hazard pointer
+                CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                if (current_item_hp == NULL)
+                {
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                    }
+
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_090: [ If any error occurs, clds_singly_linked_list_delete_all_if shall fail and return CLDS_SINGLY_LINKED_LIST_DELETE_ERROR. ]*/
+                    LogError("Cannot acquire hazard pointer");
+                    result = CLDS_SINGLY_LINKED_LIST_DELETE_ERROR;
+                    break;
+                }
+                else if (InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL) != (PVOID)current_item)
+                {
+                    // the link changed, read it again
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                }
+                else if (item_compare_callback(item_compare_callback_context, (CLDS_SINGLY_LINKED_LIST_ITEM*)current_item))
+                {
+                    // mark the node as deleted
+                    volatile CLDS_SINGLY_LINKED_LIST_ITEM* current_next = InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL);
+
+                    if ((((uintptr_t)current_next & 0x1) != 0) ||
+                        (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)((uintptr_t)current_next | 1), (PVOID)current_next) != (PVOID)current_next))
+                    {
+                        // someone else is deleting the item or its next item changed, look at it again
+                        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_088: [ If unlinking a matching item fails because of a concurrent change, clds_singly_linked_list_delete_all_if shall read the link to it again and continue from the same position. ]*/
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+
+                        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_048: [ Before retrying because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                        clds_backoff_retry(&backoff);
+                    }
+                    else if (InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, (PVOID)current_next, (PVOID)current_item) != (PVOID)current_item)
+                    {
+                        // the link to the item changed in the meanwhile, unlock our delete mark and look at the link again
+                        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_088: [ If unlinking a matching item fails because of a concurrent change, clds_singly_linked_list_delete_all_if shall read the link to it again and continue from the same position. ]*/
+                        (void)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)current_next, (PVOID)((uintptr_t)current_next | 1));
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+
+                        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_048: [ Before retrying because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                        clds_backoff_retry(&backoff);
+                    }
+                    else
+                    {
+                        // unlinked, the previous item stays the same and the link now points to the next item
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+
+                        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_080: [ Each removed item shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                        deleted_count++;
+                    }
+                }
+                else
+                {
+                    // the item is kept, move on to it
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                    }
+
+                    previous_hp = current_item_hp;
+                    current_item_address = (volatile CLDS_SINGLY_LINKED_LIST_ITEM**)&current_item->next;
+                }
+            }
+        } while (1);
+    }
+
+    return result;
+}
+
+CLDS_SINGLY_LINKED_LIST_POP_RESULT clds_singly_linked_list_pop_head(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SINGLY_LINKED_LIST_ITEM** item)
+{
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_051: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_pop_head shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+        (clds_singly_linked_list == NULL) ||
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_052: [ If clds_hazard_pointers_thread is NULL, clds_singly_linked_list_pop_head shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_053: [ If item is NULL, clds_singly_linked_list_pop_head shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+        (item == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SINGLY_LINKED_LIST_ITEM** item=%p",
+            clds_singly_linked_list, clds_hazard_pointers_thread, item);
+        result = CLDS_SINGLY_LINKED_LIST_POP_ERROR;
+    }
+    else
+    {
+        bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_singly_linked_list));
+
+        uint32_t elimination_attempt = 0;
+
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_049: [ clds_singly_linked_list_pop_head shall remove the most recently inserted item from the list. ]*/
+        do
+        {
+            volatile CLDS_SINGLY_LINKED_LIST_ITEM* head_item = (volatile CLDS_SINGLY_LINKED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->head, NULL, NULL);
+            restart_needed = false;
+
+            if (head_item == NULL)
+            {
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_054: [ If the list is empty, clds_singly_linked_list_pop_head shall return CLDS_SINGLY_LINKED_LIST_POP_EMPTY. ]*/
+                result = CLDS_SINGLY_LINKED_LIST_POP_EMPTY;
+            }
+            else
+            {
+                // the hazard pointer keeps the head item from being freed (and its address reused) while we look at its next pointer
+                CLDS_HAZARD_POINTER_RECORD_HANDLE head_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)head_item);
+                if (head_item_hp == NULL)
+                {
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_055: [ If any error occurs, clds_singly_linked_list_pop_head shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+                    LogError("Cannot acquire hazard pointer");
+                    result = CLDS_SINGLY_LINKED_LIST_POP_ERROR;
+                }
+                else
+                {
+                    volatile CLDS_SINGLY_LINKED_LIST_ITEM* head_next;
+
+                    if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->head, NULL, NULL) != (PVOID)head_item)
+                    {
+                        // head changed, the item might not be in the list anymore, restart
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, head_item_hp);
+                        restart_needed = true;
+                    }
+                    else
+                    {
+                        head_next = (volatile CLDS_SINGLY_LINKED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&head_item->next, NULL, NULL);
+
+                        // mark the head item as deleted, this fails if a delete of the head item is in progress
+                        if ((((uintptr_t)head_next & 0x1) != 0) ||
+                            (InterlockedCompareExchangePointer((volatile PVOID*)&head_item->next, (PVOID)((uintptr_t)head_next | 1), (PVOID)head_next) != (PVOID)head_next))
+                        {
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, head_item_hp);
+                            restart_needed = true;
+                        }
+                        else if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->head, (PVOID)head_next, (PVOID)head_item) != (PVOID)head_item)
+                        {
+                            // an item was inserted in the meanwhile, unlock our delete mark and restart
+                            (void)InterlockedCompareExchangePointer((volatile PVOID*)&head_item->next, (PVOID)head_next, (PVOID)((uintptr_t)head_next | 1));
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, head_item_hp);
+                            restart_needed = true;
+                        }
+                        else
+                        {
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, head_item_hp);
+
+                            /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_056: [ clds_singly_linked_list_pop_head shall return the item with its reference count incremented, so that it can be used by the caller until it calls clds_singly_linked_list_node_release. ]*/
+                            (void)InterlockedIncrement(&head_item->ref_count);
+
+                            /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_057: [ The reference held by the list on a popped item shall be released by indicating the item to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+                            clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)head_item, reclaim_list_node);
+
+                            /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_050: [ On success, clds_singly_linked_list_pop_head shall return CLDS_SINGLY_LINKED_LIST_POP_OK. ]*/
+                            *item = (CLDS_SINGLY_LINKED_LIST_ITEM*)head_item;
+                            result = CLDS_SINGLY_LINKED_LIST_POP_OK;
+                        }
+                    }
+                }
+            }
+
+            if (restart_needed)
+            {
+                ELIMINATION_ARRAY* elimination_array = (ELIMINATION_ARRAY*)InterlockedCompareExchangePointer((volatile PVOID*)&clds_singly_linked_list->elimination_array, NULL, NULL);
+                CLDS_SINGLY_LINKED_LIST_ITEM* eliminated_item;
+
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_099: [ If elimination is enabled and the pop collides with another operation on the head, clds_singly_linked_list_pop_head shall try to take an item offered in an elimination slot by a colliding clds_singly_linked_list_insert. ]*/
+                if ((elimination_array != NULL) &&
+                    ((eliminated_item = eliminate_pop(elimination_array, clds_hazard_pointers_thread, elimination_attempt++)) != NULL))
+                {
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_100: [ An item taken from an elimination slot shall be returned without changing its reference count, as the reference that the insert passed to the list is handed to the caller. ]*/
+                    *item = eliminated_item;
+                    result = CLDS_SINGLY_LINKED_LIST_POP_OK;
+                    restart_needed = false;
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_048: [ Before retrying because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                    clds_backoff_retry(&backoff);
+                }
+            }
+        } while (restart_needed);
+    }
+
+    return result;
+}
+
+CLDS_SINGLY_LINKED_LIST_POP_RESULT clds_singly_linked_list_pop_all(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_POPPED_CB item_popped_cb, void* item_popped_cb_context)
+{
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+
+    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_063: [ item_popped_cb_context shall be allowed to be NULL. ]*/
+
+    if (
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_060: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_pop_all shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+        (clds_singly_linked_list == NULL) ||
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_061: [ If clds_hazard_pointers_thread is NULL, clds_singly_linked_list_pop_all shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_062: [ If item_popped_cb is NULL, clds_singly_linked_list_pop_all shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+        (item_popped_cb == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, SINGLY_LINKED_LIST_ITEM_POPPED_CB item_popped_cb=%p, void* item_popped_cb_context=%p",
+            clds_singly_linked_list, clds_hazard_pointers_thread, item_popped_cb, item_popped_cb_context);
+        result = CLDS_SINGLY_LINKED_LIST_POP_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_058: [ clds_singly_linked_list_pop_all shall detach all the items from the list by exchanging the head of the list with NULL. ]*/
+        volatile CLDS_SINGLY_LINKED_LIST_ITEM* current_item = (volatile CLDS_SINGLY_LINKED_LIST_ITEM*)InterlockedExchangePointer((volatile PVOID*)&clds_singly_linked_list->head, NULL);
+
+        if (current_item == NULL)
+        {
+            /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_064: [ If the list is empty, clds_singly_linked_list_pop_all shall return CLDS_SINGLY_LINKED_LIST_POP_EMPTY. ]*/
+            result = CLDS_SINGLY_LINKED_LIST_POP_EMPTY;
+        }
+        else
+        {
+            CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_singly_linked_list));
+
+            // the detached items are kept alive by the reference of the list until they are reclaimed below, so no hazard pointers are needed to walk them
+            while (current_item != NULL)
+            {
+                volatile CLDS_SINGLY_LINKED_LIST_ITEM* current_next;
+
+                // mark each item as deleted, so that a delete that started before the exchange cannot unlink items from the detached chain
+                // such a delete can only be between marking the item and failing to unlink it (its previous item is already marked), so it clears its mark shortly
+                do
+                {
+                    current_next = (volatile CLDS_SINGLY_LINKED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL);
+                    if ((((uintptr_t)current_next & 0x1) == 0) &&
+                        (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)((uintptr_t)current_next | 1), (PVOID)current_next) == (PVOID)current_next))
+                    {
+                        break;
+                    }
+
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_048: [ Before retrying because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                    clds_backoff_retry(&backoff);
+                } while (1);
+
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_065: [ Each item shall be passed to item_popped_cb with its reference count incremented and the reference held by the list shall be released by indicating the item to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+                (void)InterlockedIncrement(&current_item->ref_count);
+                clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_059: [ clds_singly_linked_list_pop_all shall call item_popped_cb with item_popped_cb_context for each detached item, starting with the most recently inserted one. ]*/
+                item_popped_cb(item_popped_cb_context, (CLDS_SINGLY_LINKED_LIST_ITEM*)current_item);
+
+                current_item = current_next;
+            }
+
+            /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_066: [ On success, clds_singly_linked_list_pop_all shall return CLDS_SINGLY_LINKED_LIST_POP_OK. ]*/
+            result = CLDS_SINGLY_LINKED_LIST_POP_OK;
+        }
+    }
+
+    return result;
+}
+
+CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT clds_singly_linked_list_for_each(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_VISIT_CB item_visit_callback, void* item_visit_callback_context)
+{
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT result;
+
+    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_077: [ item_visit_callback_context shall be allowed to be NULL. ]*/
+
+    if (
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_074: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_for_each shall fail and return CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR. ]*/
+        (clds_singly_linked_list == NULL) ||
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_075: [ If clds_hazard_pointers_thread is NULL, clds_singly_linked_list_for_each shall fail and return CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_076: [ If item_visit_callback is NULL, clds_singly_linked_list_for_each shall fail and return CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR. ]*/
+        (item_visit_callback == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, SINGLY_LINKED_LIST_ITEM_VISIT_CB item_visit_callback=%p, void* item_visit_callback_context=%p",
+            clds_singly_linked_list, clds_hazard_pointers_thread, item_visit_callback, item_visit_callback_context);
+        result = CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR;
+    }
+    else
+    {
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_singly_linked_list));
+        CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+        volatile CLDS_SINGLY_LINKED_LIST_ITEM** current_item_address = &clds_singly_linked_list->head;
+        uint32_t marked_link_read_count = 0;
+
+        do
+        {
+            // get the current_item value
+            volatile CLDS_SINGLY_LINKED_LIST_ITEM* current_item = (volatile CLDS_SINGLY_LINKED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL);
+            if (((uintptr_t)current_item & 0x1) != 0)
+            {
+                // the last visited item is marked as deleted (the head is never marked, so there is a last visited item)
+                // a delete that fails to unlink it removes its mark shortly, so wait a bit for that
+                if (marked_link_read_count < FOR_EACH_MARKED_LINK_READ_COUNT)
+                {
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_071: [ If the last visited item is marked as being removed, clds_singly_linked_list_for_each shall read its link again, as the mark is removed if the removal fails. ]*/
+                    marked_link_read_count++;
+
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_048: [ Before retrying because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                    clds_backoff_retry(&backoff);
+                }
+                else
+                {
+                    // the item stays marked once it is out of the list and its next pointer is not safe to follow
+                    // the items after it are the ones not visited yet, but there is no way to get to them from it, and walking again from the head would visit the items before it again
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_072: [ If the last visited item stays marked as being removed, clds_singly_linked_list_for_each shall stop visiting items and return CLDS_SINGLY_LINKED_LIST_FOR_EACH_INTERRUPTED, so that no item is visited twice. ]*/
+                    result = CLDS_SINGLY_LINKED_LIST_FOR_EACH_INTERRUPTED;
+                    break;
+                }
+            }
+            else if (current_item == NULL)
+            {
+                if (previous_hp != NULL)
+                {
+                    // let go of previous hazard pointer
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                }
+
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_073: [ On success, clds_singly_linked_list_for_each shall return CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK. ]*/
+                result = CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK;
+                break;
+            }
+            else
+            {
+                // acquire hazard pointer
+                CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                if (current_item_hp == NULL)
+                {
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                    }
+
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_078: [ If any error occurs, clds_singly_linked_list_for_each shall fail and return CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR. ]*/
+                    LogError("Cannot acquire hazard pointer");
+                    result = CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR;
+                    break;
+                }
+                else if (InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL) != (PVOID)current_item)
+                {
+                    // the link changed, since items are only inserted at the head either the current item was removed or the last visited item is being removed
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_070: [ If the link to the next item changes because the next item was removed, clds_singly_linked_list_for_each shall read the link again and continue from the last visited item. ]*/
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_067: [ clds_singly_linked_list_for_each shall call item_visit_callback with item_visit_callback_context for each item in the list, starting with the most recently inserted one. ]*/
+                    /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_068: [ The item passed to item_visit_callback shall be protected by a hazard pointer for the duration of the call, so item_visit_callback can use it and can call clds_singly_linked_list_node_inc_ref to keep it. ]*/
+                    bool continue_visiting = item_visit_callback(item_visit_callback_context, (CLDS_SINGLY_LINKED_LIST_ITEM*)current_item);
+
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                    }
+
+                    if (!continue_visiting)
+                    {
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+
+                        /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_069: [ If item_visit_callback returns false, clds_singly_linked_list_for_each shall stop visiting items and return CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK. ]*/
+                        result = CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK;
+                        break;
+                    }
+
+                    // hand over hand, the current item is protected until we are done reading its next pointer
+                    previous_hp = current_item_hp;
+                    current_item_address = (volatile CLDS_SINGLY_LINKED_LIST_ITEM**)&current_item->next;
+                    marked_link_read_count = 0;
+                }
+            }
+        } while (1);
+    }
+
+    return result;
+}
+
 CLDS_SINGLY_LINKED_LIST_ITEM* clds_singly_linked_list_find(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_COMPARE_CB item_compare_callback, void* item_compare_callback_context)
 {
     CLDS_SINGLY_LINKED_LIST_ITEM* result;
@@ -423,6 +1129,7 @@ CLDS_SINGLY_LINKED_LIST_ITEM* clds_singly_linked_list_find(CLDS_SINGLY_LINKED_LI
         /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_027: [ clds_singly_linked_list_find shall find in the list the first item that matches the criteria given by a user compare function. ]*/
 
         bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_singly_linked_list));
         result = NULL;
 
         do
@@ -521,6 +1228,11 @@ CLDS_SINGLY_LINKED_LIST_ITEM* clds_singly_linked_list_find(CLDS_SINGLY_LINKED_LI
                     }
                 }
             } while (1);
+            if (restart_needed)
+            {
+                /* Codes_SRS_CLDS_SINGLY_LINKED_LIST_01_048: [ Before retrying because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                clds_backoff_retry(&backoff);
+            }
         } while (restart_needed);
     }
 
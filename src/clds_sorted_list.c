@@ -10,13 +10,22 @@
 #include "azure_c_logging/xlogging.h"
 #include "clds/clds_sorted_list.h"
 #include "clds/clds_atomics.h"
+#include "clds/clds_backoff.h"
 #include "clds/clds_hazard_pointers.h"
 
 #define ITERATION_COUNT_LOG_LIMIT 100000
 
+// bit 0 of the next pointer marks the node as deleted. Once set it is never cleared and any thread may unlink the node
+#define NEXT_DELETE_MARK 0x1
+// bit 1 of the next pointer is held by set_value while it swaps the node for a new one, it is cleared if the swap does not happen
+#define NEXT_REPLACE_LOCK 0x2
+#define NEXT_FLAGS_MASK (NEXT_DELETE_MARK | NEXT_REPLACE_LOCK)
+
 MU_DEFINE_ENUM_STRINGS(CLDS_SORTED_LIST_GET_COUNT_RESULT, CLDS_SORTED_LIST_GET_COUNT_RESULT_VALUES);
 MU_DEFINE_ENUM_STRINGS(CLDS_SORTED_LIST_GET_ALL_RESULT, CLDS_SORTED_LIST_GET_ALL_RESULT_VALUES);
 MU_DEFINE_ENUM_STRINGS(CLDS_SORTED_LIST_SET_VALUE_RESULT, CLDS_SORTED_LIST_SET_VALUE_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_SORTED_LIST_VISIT_RESULT, CLDS_SORTED_LIST_VISIT_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(SORTED_LIST_KEY_FINGERPRINT_ORDER, SORTED_LIST_KEY_FINGERPRINT_ORDER_VALUES);
 
 /* this is a lock free sorted list implementation */
 
@@ -31,14 +40,135 @@ typedef struct CLDS_SORTED_LIST_TAG
     volatile LONG64* sequence_number;
     SORTED_LIST_SKIPPED_SEQ_NO_CB skipped_seq_no_cb;
     void* skipped_seq_no_cb_context;
+    SORTED_LIST_GET_KEY_FINGERPRINT_CB get_key_fingerprint_cb;
+    void* get_key_fingerprint_cb_context;
+    SORTED_LIST_KEY_FINGERPRINT_ORDER key_fingerprint_order;
+    volatile LONG sequence_number_block_size;
+    // blocks the sequence numbers are taken from, either the list's own or the ones shared by the owner of the counter
+    volatile CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks;
+    // blocks created by the list, the unused numbers in them are reported when the list is destroyed
+    volatile CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE own_sequence_number_blocks;
+    volatile LONG backoff_policy;
+    // non-zero when inserts start from the per thread finger, identifies the fingers that belong to this list
+    volatile LONG64 finger_owner_id;
 
     // Support for locking the list for writes
     volatile LONG locked_for_write;
+    volatile LONG write_waiter_count;
     volatile LONG pending_write_operations;
 } CLDS_SORTED_LIST;
 
+// source for finger owner ids, ids are never reused so that a finger can never be mistaken for one of a destroyed list
+static volatile LONG64 finger_owner_id_source = 0;
+
 typedef int(*SORTED_LIST_ITEM_COMPARE_CB)(void* context, CLDS_SORTED_LIST_ITEM* item1, void* item_compare_target);
 
+// key and its fingerprint, used as compare target when looking up items by key
+typedef struct SORTED_LIST_KEY_COMPARE_TARGET_TAG
+{
+    void* key;
+    uint64_t key_fingerprint;
+} SORTED_LIST_KEY_COMPARE_TARGET;
+
+static uint64_t compute_key_fingerprint(CLDS_SORTED_LIST_HANDLE clds_sorted_list, void* key)
+{
+    uint64_t result;
+
+    if (clds_sorted_list->get_key_fingerprint_cb == NULL)
+    {
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_099: [ When a key fingerprint callback is set, clds_sorted_list_insert and clds_sorted_list_set_value shall compute the fingerprint of the new item key by calling get_key_fingerprint_cb and store it in the item. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_100: [ When a key fingerprint callback is set, clds_sorted_list_delete_key, clds_sorted_list_remove_key and clds_sorted_list_find_key shall compute the fingerprint of key by calling get_key_fingerprint_cb once per call. ]*/
+        result = clds_sorted_list->get_key_fingerprint_cb(clds_sorted_list->get_key_fingerprint_cb_context, key);
+    }
+
+    return result;
+}
+
+static int64_t get_next_sequence_number(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    int64_t result;
+    uint32_t block_size = (uint32_t)InterlockedAdd(&clds_sorted_list->sequence_number_block_size, 0);
+
+    if (block_size == 0)
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_106: [ If the sequence number block size is 0, each sequence number shall be obtained by incrementing the start sequence number passed to clds_sorted_list_create. ]*/
+        result = InterlockedIncrement64(clds_sorted_list->sequence_number);
+    }
+    else
+    {
+        // the blocks are always set before the block size, so they are never NULL here
+        CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks = (CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE)InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->sequence_number_blocks, NULL, NULL);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_107: [ If the sequence number block size is non-zero, each sequence number shall be obtained by calling clds_hazard_pointers_thread_get_sequence_number with clds_hazard_pointers_thread, the sequence number blocks used by the list and the block size. ]*/
+        result = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks, block_size);
+    }
+
+    return result;
+}
+
+static CLDS_BACKOFF_POLICY get_backoff_policy(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
+{
+    return (CLDS_BACKOFF_POLICY)InterlockedAdd(&clds_sorted_list->backoff_policy, 0);
+}
+
+// compares key with the key of item, returns <0 if key is before the item, 0 if equal and >0 if key is after the item
+static int compare_key_to_item(CLDS_SORTED_LIST_HANDLE clds_sorted_list, void* key, uint64_t key_fingerprint, volatile CLDS_SORTED_LIST_ITEM* item)
+{
+    int result;
+
+    if ((clds_sorted_list->get_key_fingerprint_cb != NULL) &&
+        (key_fingerprint != item->key_fingerprint))
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_101: [ When a key fingerprint callback is set, if the fingerprint of the key being looked up differs from the fingerprint of a visited item, the item shall be ordered by the fingerprint and get_item_key_cb and key_compare_cb shall not be called for that item. ]*/
+        result = (key_fingerprint < item->key_fingerprint) ? -1 : 1;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_102: [ When a key fingerprint callback is set, if the fingerprints are equal the items shall be ordered by calling get_item_key_cb and key_compare_cb. ]*/
+        void* item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)item);
+        result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, key, item_key);
+    }
+
+    return result;
+}
+
+// makes an insert walk start at the finger of the thread instead of the head, if the finger is still in the list and key sorts after it
+static void start_from_finger(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t finger_owner_id, void* key, uint64_t key_fingerprint,
+    volatile CLDS_SORTED_LIST_ITEM** previous_item, CLDS_HAZARD_POINTER_RECORD_HANDLE* previous_hp, volatile CLDS_SORTED_LIST_ITEM*** current_item_address)
+{
+    // the finger stays protected by the hazard pointer kept in the thread record, so its memory can be read
+    volatile CLDS_SORTED_LIST_ITEM* finger = (volatile CLDS_SORTED_LIST_ITEM*)clds_hazard_pointers_thread_get_finger(clds_hazard_pointers_thread, finger_owner_id);
+    if (finger != NULL)
+    {
+        // a flag on the next pointer means the finger is deleted or being replaced (a replaced node keeps the replace lock), so it cannot be used
+        /* Codes_SRS_CLDS_SORTED_LIST_01_133: [ If the finger is marked as deleted, locked for replacement or the key of item does not sort after the key of the finger, clds_sorted_list_insert shall look for the insert position starting from the head of the list. ]*/
+        // the owner id is read after the next pointer: an item being inserted again has its owner id cleared before its next pointer is reset,
+        // so an unmarked next pointer followed by a matching owner id means the item was linked in this list
+        /* Codes_SRS_CLDS_SORTED_LIST_01_173: [ If the finger owner id stored in the finger item is not the finger owner id of the list (the finger was removed and inserted again, possibly in another list), clds_sorted_list_insert shall look for the insert position starting from the head of the list. ]*/
+        if ((((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&finger->next, NULL, NULL) & NEXT_FLAGS_MASK) == 0) &&
+            ((uint64_t)InterlockedAdd64(&finger->finger_owner_id, 0) == finger_owner_id) &&
+            (compare_key_to_item(clds_sorted_list, key, key_fingerprint, finger) > 0))
+        {
+            CLDS_HAZARD_POINTER_RECORD_HANDLE finger_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)finger);
+            if (finger_hp == NULL)
+            {
+                LogError("Cannot acquire hazard pointer, starting from the head");
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_SORTED_LIST_01_132: [ If finger search is enabled and the thread has a finger for the list, clds_sorted_list_insert shall look for the insert position starting from the finger. ]*/
+                *previous_item = finger;
+                *previous_hp = finger_hp;
+                *current_item_address = (volatile CLDS_SORTED_LIST_ITEM**)&finger->next;
+            }
+        }
+    }
+}
+
 static int compare_item_by_ptr(void* context, CLDS_SORTED_LIST_ITEM* item, void* item_compare_target)
 {
     int result;
@@ -60,9 +190,19 @@ static int compare_item_by_ptr(void* context, CLDS_SORTED_LIST_ITEM* item, void*
 static int compare_item_by_key(void* context, CLDS_SORTED_LIST_ITEM* item, void* item_compare_target)
 {
     CLDS_SORTED_LIST_HANDLE clds_sorted_list = (CLDS_SORTED_LIST_HANDLE)context;
-    // get item key
-    void* item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, item);
-    return clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, item_key, item_compare_target);
+    SORTED_LIST_KEY_COMPARE_TARGET* compare_target = (SORTED_LIST_KEY_COMPARE_TARGET*)item_compare_target;
+    // only equality is relevant for the callers, so the sign follows compare_key_to_item
+    return compare_key_to_item(clds_sorted_list, compare_target->key, compare_target->key_fingerprint, item);
+}
+
+static int compare_item_first(void* context, CLDS_SORTED_LIST_ITEM* item, void* item_compare_target)
+{
+    (void)context;
+    (void)item;
+    (void)item_compare_target;
+
+    // the first item that is still linked in the list always matches
+    return 0;
 }
 
 static void internal_node_destroy(CLDS_SORTED_LIST_ITEM* item)
@@ -85,9 +225,132 @@ static void reclaim_list_node(void* node)
     internal_node_destroy((CLDS_SORTED_LIST_ITEM*)node);
 }
 
+// unlinks current_item, which is marked as deleted, by pointing its predecessor link to the node following it
+// current_item_hp is released in all cases. Returns true if this thread unlinked (and retired) the node and false if the
+// predecessor link changed in the meanwhile (the predecessor is deleted itself or something was inserted before current_item)
+static bool help_unlink_deleted_item(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, volatile CLDS_SORTED_LIST_ITEM** current_item_address, volatile CLDS_SORTED_LIST_ITEM* current_item, CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp)
+{
+    bool result;
+
+    // the next pointer of a node marked as deleted does not change anymore
+    volatile CLDS_SORTED_LIST_ITEM* current_next = (volatile CLDS_SORTED_LIST_ITEM*)((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & ~NEXT_FLAGS_MASK);
+
+    /* Codes_SRS_CLDS_SORTED_LIST_01_119: [ When a traversal of the list finds an item whose next pointer is marked as deleted, it shall unlink the item by replacing the link from the previous item (or head) to the item with the item's next pointer. ]*/
+    if (InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, (PVOID)current_next, (PVOID)current_item) != (PVOID)current_item)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+        result = false;
+    }
+    else
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_120: [ The thread that unlinks an item marked as deleted shall indicate it to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+        result = true;
+    }
+
+    return result;
+}
+
+// unlinks deleted_item when the unlink done right after marking it failed: the walk starts at the link of the predecessor the caller
+// still holds a hazard pointer on (previous_hp, released here) and unlinks any node marked as deleted until deleted_item is no longer reachable,
+// only a walk that has to restart goes back to the head, as the predecessor may have been unlinked itself
+static void unlink_deleted_item(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, volatile CLDS_SORTED_LIST_ITEM* previous_item, CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp, volatile CLDS_SORTED_LIST_ITEM* deleted_item)
+{
+    bool restart_needed;
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_sorted_list));
+    volatile CLDS_SORTED_LIST_ITEM** current_item_address = (previous_item == NULL) ? &clds_sorted_list->head : (volatile CLDS_SORTED_LIST_ITEM**)&previous_item->next;
+
+    // the caller holds a hazard pointer on deleted_item, so its key can be read
+    void* deleted_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)deleted_item);
+    uint64_t deleted_key_fingerprint = deleted_item->key_fingerprint;
+
+    do
+    {
+        restart_needed = false;
+
+        do
+        {
+            volatile CLDS_SORTED_LIST_ITEM* current_item = (volatile CLDS_SORTED_LIST_ITEM*)((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL) & ~NEXT_FLAGS_MASK);
+            if (current_item == NULL)
+            {
+                // end of the list, deleted_item has been unlinked by someone else
+                break;
+            }
+            else
+            {
+                CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                if (current_item_hp == NULL)
+                {
+                    // the node stays marked as deleted, the next traversal passing through will unlink it
+                    LogError("Cannot acquire hazard pointer");
+                    break;
+                }
+                else
+                {
+                    if (InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL) != (PVOID)current_item)
+                    {
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                        restart_needed = true;
+                        break;
+                    }
+                    else if (((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & NEXT_DELETE_MARK) != 0)
+                    {
+                        bool is_deleted_item = (current_item == deleted_item);
+
+                        if (!help_unlink_deleted_item(clds_hazard_pointers_thread, current_item_address, current_item, current_item_hp))
+                        {
+                            restart_needed = true;
+                            break;
+                        }
+                        else if (is_deleted_item)
+                        {
+                            break;
+                        }
+                        else
+                        {
+                            // continue from the same predecessor
+                        }
+                    }
+                    else if (compare_key_to_item(clds_sorted_list, deleted_key, deleted_key_fingerprint, current_item) < 0)
+                    {
+                        // the list is sorted, so deleted_item is not reachable past an item that sorts after it, someone else unlinked it
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                        break;
+                    }
+                    else
+                    {
+                        if (previous_hp != NULL)
+                        {
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        }
+
+                        previous_hp = current_item_hp;
+                        current_item_address = (volatile CLDS_SORTED_LIST_ITEM**)&current_item->next;
+                    }
+                }
+            }
+        } while (1);
+
+        if (previous_hp != NULL)
+        {
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+            previous_hp = NULL;
+        }
+        if (restart_needed)
+        {
+            current_item_address = &clds_sorted_list->head;
+
+            /* Codes_SRS_CLDS_SORTED_LIST_01_128: [ Before restarting a traversal because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+            clds_backoff_retry(&backoff);
+        }
+    } while (restart_needed);
+}
+
 static void check_lock_and_begin_write_operation(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
 {
-    ULONG locked_for_write;
+    LONG locked_for_write;
     do
     {
         (void)InterlockedIncrement(&clds_sorted_list->pending_write_operations);
@@ -95,10 +358,12 @@ static void check_lock_and_begin_write_operation(CLDS_SORTED_LIST_HANDLE clds_so
         if (locked_for_write != 0)
         {
             (void)InterlockedDecrement(&clds_sorted_list->pending_write_operations);
-            WakeByAddressAll((void*)&clds_sorted_list->pending_write_operations);
+            clds_backoff_wake_all(&clds_sorted_list->pending_write_operations);
 
-            // Wait for unlock
+            // Wait for unlock, counted so that the unlock only wakes when somebody waits
+            (void)InterlockedIncrement(&clds_sorted_list->write_waiter_count);
             (void)WaitOnAddress(&clds_sorted_list->locked_for_write, &locked_for_write, sizeof(locked_for_write), INFINITE);
+            (void)InterlockedDecrement(&clds_sorted_list->write_waiter_count);
         }
     } while (locked_for_write != 0);
 }
@@ -106,7 +371,12 @@ static void check_lock_and_begin_write_operation(CLDS_SORTED_LIST_HANDLE clds_so
 static void end_write_operation(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
 {
     (void)InterlockedDecrement(&clds_sorted_list->pending_write_operations);
-    WakeByAddressAll((void*)&clds_sorted_list->pending_write_operations);
+
+    /*Codes_SRS_CLDS_SORTED_LIST_01_155: [ Write operations shall call clds_backoff_wake_all for the count of pending write operations only if the counter to lock the list for writes is non-zero. ]*/
+    if (InterlockedAdd(&clds_sorted_list->locked_for_write, 0) != 0)
+    {
+        clds_backoff_wake_all(&clds_sorted_list->pending_write_operations);
+    }
 }
 
 static void internal_lock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
@@ -115,7 +385,7 @@ static void internal_lock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
     (void)InterlockedIncrement(&clds_sorted_list->locked_for_write);
 
     /*Codes_SRS_CLDS_SORTED_LIST_42_032: [ clds_sorted_list_lock_writes shall wait for all pending write operations to complete. ]*/
-    ULONG pending_writes;
+    LONG pending_writes;
     do
     {
         pending_writes = InterlockedAdd(&clds_sorted_list->pending_write_operations, 0);
@@ -131,7 +401,12 @@ static void internal_unlock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
 {
     /*Codes_SRS_CLDS_SORTED_LIST_42_034: [ clds_sorted_list_lock_writes shall decrement a counter to unlock the list for writes. ]*/
     (void)InterlockedDecrement(&clds_sorted_list->locked_for_write);
-    WakeByAddressAll((void*)&clds_sorted_list->locked_for_write);
+
+    /*Codes_SRS_CLDS_SORTED_LIST_01_156: [ clds_sorted_list_unlock_writes shall call clds_backoff_wake_all for the counter to lock the list for writes only if there are write operations waiting for the list to be unlocked. ]*/
+    if (InterlockedAdd(&clds_sorted_list->write_waiter_count, 0) != 0)
+    {
+        clds_backoff_wake_all(&clds_sorted_list->locked_for_write);
+    }
 }
 
 static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SORTED_LIST_ITEM_COMPARE_CB item_compare_callback, void* item_compare_target, int64_t* sequence_number)
@@ -139,6 +414,7 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
     CLDS_SORTED_LIST_DELETE_RESULT result = CLDS_SORTED_LIST_DELETE_ERROR;
 
     bool restart_needed;
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_sorted_list));
     uint64_t iteration_count = 0;
 
     do
@@ -160,7 +436,7 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
             volatile CLDS_SORTED_LIST_ITEM* current_item = (volatile CLDS_SORTED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL);
 
             // clear any delete lock bit from what we read
-            current_item = (volatile CLDS_SORTED_LIST_ITEM*)((uintptr_t)current_item & ~0x1);
+            current_item = (volatile CLDS_SORTED_LIST_ITEM*)((uintptr_t)current_item & ~NEXT_FLAGS_MASK);
 
             // if the current item is NULL (do not look at the lock bit), we are done.
             if (current_item == NULL)
@@ -213,6 +489,26 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                     }
                     else
                     {
+                        // an item marked as deleted is unlinked on the spot and the walk continues from the same predecessor
+                        if (((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & NEXT_DELETE_MARK) != 0)
+                        {
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_121: [ After unlinking an item marked as deleted the traversal shall continue from the previous item. ]*/
+                            if (!help_unlink_deleted_item(clds_hazard_pointers_thread, current_item_address, current_item, current_item_hp))
+                            {
+                                if (previous_hp != NULL)
+                                {
+                                    // let go of previous hazard pointer
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                }
+
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_122: [ If unlinking the item marked as deleted fails, the traversal shall restart from the head of the list. ]*/
+                                restart_needed = true;
+                                break;
+                            }
+
+                            continue;
+                        }
+
                         int compare_result = item_compare_callback(clds_sorted_list, (CLDS_SORTED_LIST_ITEM*)current_item, item_compare_target);
                         if (compare_result == 0)
                         {
@@ -221,10 +517,11 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                             volatile CLDS_SORTED_LIST_ITEM* current_next = InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL);
 
                             // clear any delete lock bit from what we read
-                            current_next = (volatile CLDS_SORTED_LIST_ITEM*)((uintptr_t)current_next & ~0x1);
+                            current_next = (volatile CLDS_SORTED_LIST_ITEM*)((uintptr_t)current_next & ~NEXT_FLAGS_MASK);
 
                             // mark that the node is deleted by setting the lock delete bit
-                            if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)((uintptr_t)current_next | 0x1), (PVOID)current_next) != (PVOID)current_next)
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_123: [ Once an item is marked as deleted, the mark shall not be cleared. ]*/
+                            if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)((uintptr_t)current_next | NEXT_DELETE_MARK), (PVOID)current_next) != (PVOID)current_next)
                             {
                                 // could not set the lock delete bit (some other thread modified the next value, we shall restart)
                                 if (previous_hp != NULL)
@@ -247,7 +544,7 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                                 /* Codes_SRS_CLDS_SORTED_LIST_01_071: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
                                 if (clds_sorted_list->sequence_number != NULL)
                                 {
-                                    local_seq_no = InterlockedIncrement64(clds_sorted_list->sequence_number);
+                                    local_seq_no = get_next_sequence_number(clds_sorted_list, clds_hazard_pointers_thread);
 
                                     // get a new seq no and stamp it on the node to be deleted, if any other thread deletes they will alter the seq no.
                                     (void)InterlockedExchange64(&current_item->seq_no, local_seq_no);
@@ -259,114 +556,73 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
 
                                 // If in the meanwhile someone would be deleting node Prev they would have to first set the
                                 // deleted flag on it, in which case we'd see the CAS for changing the Prev->next pointer fail
+                                bool unlinked;
 
                                 if (previous_item == NULL)
                                 {
                                     // we are removing the head, special case
-                                    if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->head, (PVOID)current_next, (PVOID)current_item) != (PVOID)current_item)
-                                    {
-                                        // head changed, restart, but make sure we unlock the delete bit for current node
-                                        (void)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)current_next, (PVOID)((uintptr_t)current_next | 1));
-
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    unlinked = (InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->head, (PVOID)current_next, (PVOID)current_item) == (PVOID)current_item);
+                                }
+                                else
+                                {
+                                    // not removing the head, set Prev->next to current_next, but clear the lock delete bit from the next pointer!
+                                    unlinked = (InterlockedCompareExchangePointer((volatile PVOID*)&previous_item->next, (PVOID)current_next, (PVOID)current_item) == (PVOID)current_item);
+                                }
 
-                                        restart_needed = true;
-                                        break;
-                                    }
-                                    else
+                                if (clds_sorted_list->sequence_number != NULL)
+                                {
+                                    int64_t temp_seq_no = InterlockedAdd64(&current_item->seq_no, 0);
+                                    if (temp_seq_no != local_seq_no)
                                     {
-                                        if (clds_sorted_list->sequence_number != NULL)
+                                        if (clds_sorted_list->skipped_seq_no_cb != NULL)
                                         {
-                                            int64_t temp_seq_no = InterlockedAdd64(&current_item->seq_no, 0);
-                                            if (temp_seq_no != local_seq_no)
-                                            {
-                                                if (clds_sorted_list->skipped_seq_no_cb != NULL)
-                                                {
-                                                    clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
-                                                }
-                                            }
-
-                                            /* Codes_SRS_CLDS_SORTED_LIST_01_064: [ If the sequence_number argument passed to clds_sorted_list_delete is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
-                                            /* Codes_SRS_CLDS_SORTED_LIST_01_067: [ If the sequence_number argument passed to clds_sorted_list_delete_key is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
-                                            if (sequence_number != NULL)
-                                            {
-                                                // since we deleted the node, simply pick up the current sequence number (has to be greater than the insert)
-                                                /* Codes_SRS_CLDS_SORTED_LIST_01_063: [ For each delete the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-                                                /* Codes_SRS_CLDS_SORTED_LIST_01_066: [ For each delete key the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-                                                *sequence_number = temp_seq_no;
-                                            }
+                                            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
                                         }
+                                    }
 
-                                        // delete succesfull
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-
-                                        // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
-                                        restart_needed = false;
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_064: [ If the sequence_number argument passed to clds_sorted_list_delete is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_067: [ If the sequence_number argument passed to clds_sorted_list_delete_key is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
+                                    if (sequence_number != NULL)
+                                    {
+                                        // since we deleted the node, simply pick up the current sequence number (has to be greater than the insert)
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_063: [ For each delete the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_066: [ For each delete key the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+                                        *sequence_number = temp_seq_no;
+                                    }
+                                }
 
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-                                        result = CLDS_SORTED_LIST_DELETE_OK;
+                                if (!unlinked)
+                                {
+                                    // the link to the node changed (an insert before it or another thread unlinking it)
+                                    // the delete mark is never cleared, so the delete is done, but make sure the node is not reachable anymore
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_124: [ If unlinking the item it marked as deleted fails, clds_sorted_list_delete_item, clds_sorted_list_delete_key, clds_sorted_list_remove_key and clds_sorted_list_remove_first shall not clear the mark and shall walk the list from the item preceding it (from the head of the list if the walk has to restart), unlinking items marked as deleted, until the item is no longer reachable. ]*/
+                                    unlink_deleted_item(clds_sorted_list, clds_hazard_pointers_thread, previous_item, previous_hp, current_item);
 
-                                        break;
-                                    }
+                                    // the node was reclaimed by whoever unlinked it
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
                                 }
                                 else
                                 {
-                                    // not removing the head, set Prev->next to current_next, but clear the lock delete bit from the next pointer!
-                                    if (InterlockedCompareExchangePointer((volatile PVOID*)&previous_item->next, (PVOID)current_next, (PVOID)current_item) != (PVOID)current_item)
+                                    if (previous_hp != NULL)
                                     {
-                                        // someone is deleting our left node, restart, but first unlock our own delete mark
-                                        (void)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)current_next, (PVOID)((uintptr_t)current_next | 1));
-
+                                        // let go of previous hazard pointer
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-
-                                        restart_needed = true;
-                                        break;
                                     }
-                                    else
-                                    {
-                                        if (clds_sorted_list->sequence_number != NULL)
-                                        {
-                                            int64_t temp_seq_no = InterlockedAdd64(&current_item->seq_no, 0);
-                                            if (temp_seq_no != local_seq_no)
-                                            {
-                                                if (clds_sorted_list->skipped_seq_no_cb != NULL)
-                                                {
-                                                    clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
-                                                }
-                                            }
-
-                                            /* Codes_SRS_CLDS_SORTED_LIST_01_064: [ If the sequence_number argument passed to clds_sorted_list_delete is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
-                                            /* Codes_SRS_CLDS_SORTED_LIST_01_067: [ If the sequence_number argument passed to clds_sorted_list_delete_key is NULL, the computed sequence number for the delete shall still be computed but it shall not be provided to the user. ]*/
-                                            if (sequence_number != NULL)
-                                            {
-                                                // since we deleted the node, simply pick up the current sequence number (has to be greater than the insert)
-                                                /* Codes_SRS_CLDS_SORTED_LIST_01_063: [ For each delete the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-                                                /* Codes_SRS_CLDS_SORTED_LIST_01_066: [ For each delete key the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-                                                *sequence_number = temp_seq_no;
-                                            }
-                                        }
-
 
-                                        // delete succesfull, no-one deleted the left node in the meanwhile
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    // delete succesfull
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
-                                        // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                    // reclaim the memory
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+                                    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                }
 
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-                                        result = CLDS_SORTED_LIST_DELETE_OK;
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+                                result = CLDS_SORTED_LIST_DELETE_OK;
 
-                                        restart_needed = false;
-                                        break;
-                                    }
-                                }
+                                restart_needed = false;
+                                break;
                             }
                         }
                         else
@@ -386,6 +642,11 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                 }
             }
         } while (1);
+        if (restart_needed)
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_128: [ Before restarting a traversal because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+            clds_backoff_retry(&backoff);
+        }
     } while (restart_needed);
 
     return result;
@@ -397,6 +658,7 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
 
     // check that the node is really in the list and obtain
     bool restart_needed;
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_sorted_list));
     uint64_t iteration_count = 0;
 
     do
@@ -417,7 +679,7 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
             volatile CLDS_SORTED_LIST_ITEM* current_item = (volatile CLDS_SORTED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL);
 
             // clear any delete lock bit from what we read
-            current_item = (void*)((uintptr_t)current_item & ~0x1);
+            current_item = (void*)((uintptr_t)current_item & ~NEXT_FLAGS_MASK);
             if (current_item == NULL)
             {
                 if (previous_hp != NULL)
@@ -467,6 +729,26 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                     }
                     else
                     {
+                        // an item marked as deleted is unlinked on the spot and the walk continues from the same predecessor
+                        if (((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & NEXT_DELETE_MARK) != 0)
+                        {
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_121: [ After unlinking an item marked as deleted the traversal shall continue from the previous item. ]*/
+                            if (!help_unlink_deleted_item(clds_hazard_pointers_thread, current_item_address, current_item, current_item_hp))
+                            {
+                                if (previous_hp != NULL)
+                                {
+                                    // let go of previous hazard pointer
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                }
+
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_122: [ If unlinking the item marked as deleted fails, the traversal shall restart from the head of the list. ]*/
+                                restart_needed = true;
+                                break;
+                            }
+
+                            continue;
+                        }
+
                         int compare_result = item_compare_callback(clds_sorted_list, (CLDS_SORTED_LIST_ITEM*)current_item, item_compare_target);
                         if (compare_result == 0)
                         {
@@ -475,10 +757,11 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                             volatile CLDS_SORTED_LIST_ITEM* current_next = InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL);
 
                             // clear any delete lock bit from what we read
-                            current_next = (void*)((uintptr_t)current_next & ~0x1);
+                            current_next = (void*)((uintptr_t)current_next & ~NEXT_FLAGS_MASK);
 
                             // mark that the node is deleted
-                            if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)((uintptr_t)current_next | 1), (PVOID)current_next) != (PVOID)current_next)
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_123: [ Once an item is marked as deleted, the mark shall not be cleared. ]*/
+                            if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)((uintptr_t)current_next | NEXT_DELETE_MARK), (PVOID)current_next) != (PVOID)current_next)
                             {
                                 if (previous_hp != NULL)
                                 {
@@ -499,7 +782,7 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                 /* Codes_SRS_CLDS_SORTED_LIST_01_073: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
                                 if (clds_sorted_list->sequence_number != NULL)
                                 {
-                                    local_seq_no = InterlockedIncrement64(clds_sorted_list->sequence_number);
+                                    local_seq_no = get_next_sequence_number(clds_sorted_list, clds_hazard_pointers_thread);
 
                                     // get a new seq no and stamp it on the node to be deleted, if any other thread deletes they will alter the seq no.
                                     /* Codes_SRS_CLDS_SORTED_LIST_01_074: [ If the sequence_number argument passed to clds_sorted_list_remove_key is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
@@ -510,112 +793,71 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
 
                                 // If in the meanwhile someone would be deleting node A they would have to first set the
                                 // deleted flag on it, in which case we'd see the CAS fail
+                                bool unlinked;
 
                                 if (previous_item == NULL)
                                 {
                                     // we are removing the head
-                                    if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->head, (PVOID)current_next, (PVOID)current_item) != (PVOID)current_item)
-                                    {
-                                        // head changed, restart
-                                        (void)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)current_next, (PVOID)((uintptr_t)current_next | 1));
+                                    unlinked = (InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->head, (PVOID)current_next, (PVOID)current_item) == (PVOID)current_item);
+                                }
+                                else
+                                {
+                                    unlinked = (InterlockedCompareExchangePointer((volatile PVOID*)&previous_item->next, (PVOID)current_next, (PVOID)current_item) == (PVOID)current_item);
+                                }
 
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
+                                *item = (CLDS_SORTED_LIST_ITEM*)current_item;
+                                clds_sorted_list_node_inc_ref(*item);
 
-                                        restart_needed = true;
-                                        break;
-                                    }
-                                    else
+                                if (clds_sorted_list->sequence_number != NULL)
+                                {
+                                    int64_t temp_seq_no = InterlockedAdd64(&current_item->seq_no, 0);
+                                    if (temp_seq_no != local_seq_no)
                                     {
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
-                                        *item = (CLDS_SORTED_LIST_ITEM*)current_item;
-                                        clds_sorted_list_node_inc_ref(*item);
-
-                                        if (clds_sorted_list->sequence_number != NULL)
+                                        if (clds_sorted_list->skipped_seq_no_cb != NULL)
                                         {
-                                            int64_t temp_seq_no = InterlockedAdd64(&current_item->seq_no, 0);
-                                            if (temp_seq_no != local_seq_no)
-                                            {
-                                                if (clds_sorted_list->skipped_seq_no_cb != NULL)
-                                                {
-                                                    clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
-                                                }
-                                            }
-
-                                            if (sequence_number != NULL)
-                                            {
-                                                // since we deleted the node, simply pick up the current sequence number (has to be greater than the insert)
-                                                /* Codes_SRS_CLDS_SORTED_LIST_01_072: [ For each remove key the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-                                                *sequence_number = temp_seq_no;
-                                            }
+                                            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
                                         }
+                                    }
 
-                                        // delete succesfull
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-
-                                        // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
-                                        restart_needed = false;
+                                    if (sequence_number != NULL)
+                                    {
+                                        // since we deleted the node, simply pick up the current sequence number (has to be greater than the insert)
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_072: [ For each remove key the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+                                        *sequence_number = temp_seq_no;
+                                    }
+                                }
 
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
-                                        result = CLDS_SORTED_LIST_REMOVE_OK;
+                                if (!unlinked)
+                                {
+                                    // the link to the node changed, the node stays marked as deleted, make sure it is not reachable anymore
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_124: [ If unlinking the item it marked as deleted fails, clds_sorted_list_delete_item, clds_sorted_list_delete_key, clds_sorted_list_remove_key and clds_sorted_list_remove_first shall not clear the mark and shall walk the list from the item preceding it (from the head of the list if the walk has to restart), unlinking items marked as deleted, until the item is no longer reachable. ]*/
+                                    unlink_deleted_item(clds_sorted_list, clds_hazard_pointers_thread, previous_item, previous_hp, current_item);
 
-                                        break;
-                                    }
+                                    // the node was reclaimed by whoever unlinked it, the reference taken above keeps it alive for the caller
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
                                 }
                                 else
                                 {
-                                    if (InterlockedCompareExchangePointer((volatile PVOID*)&previous_item->next, (PVOID)current_next, (PVOID)current_item) != (PVOID)current_item)
+                                    if (previous_hp != NULL)
                                     {
-                                        // someone is deleting our left node, restart, but first unlock our own delete mark
-                                        (void)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)current_next, (PVOID)((uintptr_t)current_next | 1));
-
+                                        // let go of previous hazard pointer
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-
-                                        restart_needed = true;
-                                        break;
                                     }
-                                    else
-                                    {
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
-                                        *item = (CLDS_SORTED_LIST_ITEM*)current_item;
-                                        clds_sorted_list_node_inc_ref(*item);
 
-                                        if (clds_sorted_list->sequence_number != NULL)
-                                        {
-                                            int64_t temp_seq_no = InterlockedAdd64(&current_item->seq_no, 0);
-                                            if (temp_seq_no != local_seq_no)
-                                            {
-                                                if (clds_sorted_list->skipped_seq_no_cb != NULL)
-                                                {
-                                                    clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
-                                                }
-                                            }
-
-                                            if (sequence_number != NULL)
-                                            {
-                                                // since we deleted the node, simply pick up the current sequence number (has to be greater than the insert)
-                                                /* Codes_SRS_CLDS_SORTED_LIST_01_072: [ For each remove key the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-                                                *sequence_number = temp_seq_no;
-                                            }
-                                        }
-
-                                        // delete succesfull, no-one deleted the left node in the meanwhile
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    // delete succesfull
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
-                                        // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                    // reclaim the memory
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+                                    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                }
 
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
-                                        result = CLDS_SORTED_LIST_REMOVE_OK;
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
+                                result = CLDS_SORTED_LIST_REMOVE_OK;
 
-                                        restart_needed = false;
-                                        break;
-                                    }
-                                }
+                                restart_needed = false;
+                                break;
                             }
                         }
                         else
@@ -635,6 +877,11 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                 }
             }
         } while (1);
+        if (restart_needed)
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_128: [ Before restarting a traversal because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+            clds_backoff_retry(&backoff);
+        }
     } while (restart_needed);
 
     return result;
@@ -685,9 +932,18 @@ CLDS_SORTED_LIST_HANDLE clds_sorted_list_create(CLDS_HAZARD_POINTERS_HANDLE clds
             clds_sorted_list->key_compare_cb_context = key_compare_cb_context;
             clds_sorted_list->skipped_seq_no_cb = skipped_seq_no_cb;
             clds_sorted_list->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
+            clds_sorted_list->get_key_fingerprint_cb = NULL;
+            clds_sorted_list->get_key_fingerprint_cb_context = NULL;
+            clds_sorted_list->key_fingerprint_order = SORTED_LIST_KEY_FINGERPRINT_ORDER_UNRELATED;
+            (void)InterlockedExchange(&clds_sorted_list->sequence_number_block_size, 0);
+            (void)InterlockedExchangePointer((volatile PVOID*)&clds_sorted_list->sequence_number_blocks, NULL);
+            (void)InterlockedExchangePointer((volatile PVOID*)&clds_sorted_list->own_sequence_number_blocks, NULL);
+            (void)InterlockedExchange(&clds_sorted_list->backoff_policy, CLDS_BACKOFF_POLICY_NONE);
+            (void)InterlockedExchange64(&clds_sorted_list->finger_owner_id, 0);
 
             (void)InterlockedExchange(&clds_sorted_list->locked_for_write, 0);
             (void)InterlockedExchange(&clds_sorted_list->pending_write_operations, 0);
+            (void)InterlockedExchange(&clds_sorted_list->write_waiter_count, 0);
 
             /* Codes_SRS_CLDS_SORTED_LIST_01_058: [ start_sequence_number shall be used by the sorted list to compute the sequence number of each operation. ]*/
             clds_sorted_list->sequence_number = start_sequence_number;
@@ -709,12 +965,19 @@ void clds_sorted_list_destroy(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
     else
     {
         CLDS_SORTED_LIST_ITEM* current_item = InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->head, NULL, NULL);
+        CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE own_sequence_number_blocks = (CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE)InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->own_sequence_number_blocks, NULL, NULL);
+
+        if (own_sequence_number_blocks != NULL)
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_165: [ If the list created its own sequence number blocks, clds_sorted_list_destroy shall report the sequence numbers reserved by threads but never used through skipped_seq_no_cb by calling clds_hazard_pointers_sequence_number_blocks_destroy. ]*/
+            clds_hazard_pointers_sequence_number_blocks_destroy(own_sequence_number_blocks);
+        }
 
         /* Codes_SRS_CLDS_SORTED_LIST_01_039: [ Any items still present in the list shall be freed. ]*/
         // go through all the items and free them
         while (current_item != NULL)
         {
-            CLDS_SORTED_LIST_ITEM* next_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & ~0x1);
+            CLDS_SORTED_LIST_ITEM* next_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & ~NEXT_FLAGS_MASK);
 
             /* Codes_SRS_CLDS_SORTED_LIST_01_040: [ For each item that is freed, the callback item_cleanup_callback passed to clds_sorted_list_node_create shall be called, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
             /* Codes_SRS_CLDS_SORTED_LIST_01_041: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the freed items. ]*/
@@ -727,6 +990,200 @@ void clds_sorted_list_destroy(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
     }
 }
 
+int clds_sorted_list_set_key_fingerprint_cb(CLDS_SORTED_LIST_HANDLE clds_sorted_list, SORTED_LIST_GET_KEY_FINGERPRINT_CB get_key_fingerprint_cb, void* get_key_fingerprint_cb_context, SORTED_LIST_KEY_FINGERPRINT_ORDER key_fingerprint_order)
+{
+    int result;
+
+    /* Codes_SRS_CLDS_SORTED_LIST_01_097: [ get_key_fingerprint_cb_context shall be allowed to be NULL. ]*/
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_095: [ If clds_sorted_list is NULL, clds_sorted_list_set_key_fingerprint_cb shall fail and return a non-zero value. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_096: [ If get_key_fingerprint_cb is NULL, clds_sorted_list_set_key_fingerprint_cb shall fail and return a non-zero value. ]*/
+        (get_key_fingerprint_cb == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_175: [ If key_fingerprint_order is not a valid SORTED_LIST_KEY_FINGERPRINT_ORDER value, clds_sorted_list_set_key_fingerprint_cb shall fail and return a non-zero value. ]*/
+        ((int)key_fingerprint_order < (int)SORTED_LIST_KEY_FINGERPRINT_ORDER_UNRELATED) ||
+        ((int)key_fingerprint_order > (int)SORTED_LIST_KEY_FINGERPRINT_ORDER_REMOVE_FIRST_BY_FINGERPRINT)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, SORTED_LIST_GET_KEY_FINGERPRINT_CB get_key_fingerprint_cb=%p, void* get_key_fingerprint_cb_context=%p, SORTED_LIST_KEY_FINGERPRINT_ORDER key_fingerprint_order=%" PRI_MU_ENUM "",
+            clds_sorted_list, get_key_fingerprint_cb, get_key_fingerprint_cb_context, MU_ENUM_VALUE(SORTED_LIST_KEY_FINGERPRINT_ORDER, key_fingerprint_order));
+        result = MU_FAILURE;
+    }
+    else
+    {
+        if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->head, NULL, NULL) != NULL)
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_098: [ If the list is not empty, clds_sorted_list_set_key_fingerprint_cb shall fail and return a non-zero value. ]*/
+            LogError("Cannot set the key fingerprint callback on a non-empty list");
+            result = MU_FAILURE;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_094: [ clds_sorted_list_set_key_fingerprint_cb shall set the key fingerprint callback and the order of the fingerprints that shall be used by all subsequent operations on the list and return 0. ]*/
+            clds_sorted_list->get_key_fingerprint_cb = get_key_fingerprint_cb;
+            clds_sorted_list->get_key_fingerprint_cb_context = get_key_fingerprint_cb_context;
+            clds_sorted_list->key_fingerprint_order = key_fingerprint_order;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+int clds_sorted_list_set_sequence_number_block_size(CLDS_SORTED_LIST_HANDLE clds_sorted_list, uint32_t block_size)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_104: [ If clds_sorted_list is NULL, clds_sorted_list_set_sequence_number_block_size shall fail and return a non-zero value. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_105: [ If block_size is non-zero and no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_set_sequence_number_block_size shall fail and return a non-zero value. ]*/
+        ((block_size != 0) && (clds_sorted_list->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, uint32_t block_size=%" PRIu32,
+            clds_sorted_list, block_size);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE own_sequence_number_blocks = (CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE)InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->own_sequence_number_blocks, NULL, NULL);
+
+        if ((block_size != 0) && (own_sequence_number_blocks == NULL))
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_166: [ If block_size is non-zero and the list does not have its own sequence number blocks yet, clds_sorted_list_set_sequence_number_block_size shall create them by calling clds_hazard_pointers_sequence_number_blocks_create with the start sequence number, skipped_seq_no_cb and skipped_seq_no_cb_context. ]*/
+            CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE new_sequence_number_blocks = clds_hazard_pointers_sequence_number_blocks_create((volatile int64_t*)clds_sorted_list->sequence_number, clds_sorted_list->skipped_seq_no_cb, clds_sorted_list->skipped_seq_no_cb_context);
+            if (new_sequence_number_blocks == NULL)
+            {
+                /* Codes_SRS_CLDS_SORTED_LIST_01_167: [ If any error occurs, clds_sorted_list_set_sequence_number_block_size shall fail and return a non-zero value. ]*/
+                LogError("Cannot create sequence number blocks");
+            }
+            else
+            {
+                own_sequence_number_blocks = (CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE)InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->own_sequence_number_blocks, new_sequence_number_blocks, NULL);
+                if (own_sequence_number_blocks == NULL)
+                {
+                    own_sequence_number_blocks = new_sequence_number_blocks;
+                }
+                else
+                {
+                    // someone else set the block size at the same time, use their blocks
+                    clds_hazard_pointers_sequence_number_blocks_destroy(new_sequence_number_blocks);
+                }
+            }
+        }
+
+        if ((block_size != 0) && (own_sequence_number_blocks == NULL))
+        {
+            result = MU_FAILURE;
+        }
+        else
+        {
+            if (block_size != 0)
+            {
+                (void)InterlockedExchangePointer((volatile PVOID*)&clds_sorted_list->sequence_number_blocks, own_sequence_number_blocks);
+            }
+
+            /* Codes_SRS_CLDS_SORTED_LIST_01_103: [ clds_sorted_list_set_sequence_number_block_size shall set the number of sequence numbers that each thread reserves at once from the start sequence number and return 0. ]*/
+            (void)InterlockedExchange(&clds_sorted_list->sequence_number_block_size, (LONG)block_size);
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+int clds_sorted_list_set_sequence_number_blocks(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks, uint32_t block_size)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_169: [ If clds_sorted_list is NULL, clds_sorted_list_set_sequence_number_blocks shall fail and return a non-zero value. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_170: [ If block_size is non-zero and sequence_number_blocks is NULL, clds_sorted_list_set_sequence_number_blocks shall fail and return a non-zero value. ]*/
+        ((block_size != 0) && (sequence_number_blocks == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks=%p, uint32_t block_size=%" PRIu32,
+            clds_sorted_list, sequence_number_blocks, block_size);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        if (block_size != 0)
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_168: [ clds_sorted_list_set_sequence_number_blocks shall make the list take its sequence numbers from sequence_number_blocks, block_size at a time per thread, and return 0. ]*/
+            (void)InterlockedExchangePointer((volatile PVOID*)&clds_sorted_list->sequence_number_blocks, sequence_number_blocks);
+        }
+
+        (void)InterlockedExchange(&clds_sorted_list->sequence_number_block_size, (LONG)block_size);
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_sorted_list_set_backoff_policy(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_BACKOFF_POLICY backoff_policy)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_126: [ If clds_sorted_list is NULL, clds_sorted_list_set_backoff_policy shall fail and return a non-zero value. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_127: [ If backoff_policy is not a valid CLDS_BACKOFF_POLICY value, clds_sorted_list_set_backoff_policy shall fail and return a non-zero value. ]*/
+        ((int)backoff_policy < (int)CLDS_BACKOFF_POLICY_NONE) ||
+        ((int)backoff_policy > (int)CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_BACKOFF_POLICY backoff_policy=%" PRI_MU_ENUM "",
+            clds_sorted_list, MU_ENUM_VALUE(CLDS_BACKOFF_POLICY, backoff_policy));
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_125: [ clds_sorted_list_set_backoff_policy shall set the backoff policy used by all subsequent operations on the list when they have to retry because of a concurrent change and return 0. ]*/
+        (void)InterlockedExchange(&clds_sorted_list->backoff_policy, (LONG)backoff_policy);
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_sorted_list_set_finger_search(CLDS_SORTED_LIST_HANDLE clds_sorted_list, bool enable)
+{
+    int result;
+
+    if (clds_sorted_list == NULL)
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_130: [ If clds_sorted_list is NULL, clds_sorted_list_set_finger_search shall fail and return a non-zero value. ]*/
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, bool enable=%d",
+            clds_sorted_list, (int)enable);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_129: [ clds_sorted_list_set_finger_search shall enable or disable for all subsequent inserts the use of a per thread finger as start point for the search of the insert position and return 0. ]*/
+        if (!enable)
+        {
+            (void)InterlockedExchange64(&clds_sorted_list->finger_owner_id, 0);
+        }
+        else if (InterlockedAdd64(&clds_sorted_list->finger_owner_id, 0) == 0)
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_131: [ Each time finger search is enabled, the list shall get a new process wide unique finger owner id, so that fingers set before are not used. ]*/
+            (void)InterlockedCompareExchange64(&clds_sorted_list->finger_owner_id, InterlockedIncrement64(&finger_owner_id_source), 0);
+        }
+        else
+        {
+            // already enabled
+        }
+
+        result = 0;
+    }
+
+    return result;
+}
+
 CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
 {
     CLDS_SORTED_LIST_INSERT_RESULT result;
@@ -756,13 +1213,27 @@ CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE c
         check_lock_and_begin_write_operation(clds_sorted_list);
 
         bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_sorted_list));
+        uint64_t finger_owner_id = (uint64_t)InterlockedAdd64(&clds_sorted_list->finger_owner_id, 0);
+        CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp = NULL;
         void* new_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, item);
+        item->key_fingerprint = compute_key_fingerprint(clds_sorted_list, new_item_key);
+
+        // the item may be a former finger that was removed and is inserted again, it must not look like a finger of this list before it is linked
+        /* Codes_SRS_CLDS_SORTED_LIST_01_174: [ clds_sorted_list_insert and clds_sorted_list_set_value shall clear the finger owner id of the item before linking it in the list. ]*/
+        (void)InterlockedExchange64(&item->finger_owner_id, 0);
+
+        if (finger_owner_id != 0)
+        {
+            // nobody else can see the item before it is linked, so it can be protected right away and become the finger once inserted
+            item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, item);
+        }
 
         /* Codes_SRS_CLDS_SORTED_LIST_01_069: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
         if (clds_sorted_list->sequence_number != NULL)
         {
             /* Codes_SRS_CLDS_SORTED_LIST_01_060: [ For each insert the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-            item->seq_no = InterlockedIncrement64(clds_sorted_list->sequence_number);
+            item->seq_no = get_next_sequence_number(clds_sorted_list, clds_hazard_pointers_thread);
 
             /* Codes_SRS_CLDS_SORTED_LIST_01_061: [ If the sequence_number argument passed to clds_sorted_list_insert is NULL, the computed sequence number for the insert shall still be computed but it shall not be provided to the user. ]*/
             if (sequence_number != NULL)
@@ -781,6 +1252,11 @@ CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE c
             result = CLDS_SORTED_LIST_INSERT_ERROR;
             uint64_t iteration_count = 0;
 
+            if (finger_owner_id != 0)
+            {
+                start_from_finger(clds_sorted_list, clds_hazard_pointers_thread, finger_owner_id, new_item_key, item->key_fingerprint, &previous_item, &previous_hp, &current_item_address);
+            }
+
             do
             {
                 if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
@@ -793,7 +1269,7 @@ CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE c
                 volatile CLDS_SORTED_LIST_ITEM* current_item = (volatile CLDS_SORTED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL);
 
                 // clear any delete lock bit from what we read
-                current_item = (volatile CLDS_SORTED_LIST_ITEM*)((uintptr_t)current_item & ~0x1);
+                current_item = (volatile CLDS_SORTED_LIST_ITEM*)((uintptr_t)current_item & ~NEXT_FLAGS_MASK);
 
                 // check if the item is NULL
                 if (current_item == NULL)
@@ -891,10 +1367,29 @@ CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE c
                         }
                         else
                         {
+                            // an item marked as deleted is unlinked on the spot and the walk continues from the same predecessor
+                            if (((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & NEXT_DELETE_MARK) != 0)
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_121: [ After unlinking an item marked as deleted the traversal shall continue from the previous item. ]*/
+                                if (!help_unlink_deleted_item(clds_hazard_pointers_thread, current_item_address, current_item, current_item_hp))
+                                {
+                                    if (previous_hp != NULL)
+                                    {
+                                        // let go of previous hazard pointer
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    }
+
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_122: [ If unlinking the item marked as deleted fails, the traversal shall restart from the head of the list. ]*/
+                                    restart_needed = true;
+                                    break;
+                                }
+
+                                continue;
+                            }
+
                             // we are in a stable state, at this point the previous node does not have a delete lock bit set
                             // compare the current item key to our key
-                            void* current_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
-                            int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, new_item_key, current_item_key);
+                            int compare_result = compare_key_to_item(clds_sorted_list, new_item_key, item->key_fingerprint, current_item);
 
                             if (compare_result == 0)
                             {
@@ -974,132 +1469,451 @@ CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE c
                                     // let go of previous hazard pointer
                                     clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                                 }
-
-                                previous_hp = current_item_hp;
-                                previous_item = current_item;
-                                current_item_address = (volatile CLDS_SORTED_LIST_ITEM**)&current_item->next;
+
+                                previous_hp = current_item_hp;
+                                previous_item = current_item;
+                                current_item_address = (volatile CLDS_SORTED_LIST_ITEM**)&current_item->next;
+                            }
+                        }
+                    }
+                }
+            } while (1);
+            if (restart_needed)
+            {
+                /* Codes_SRS_CLDS_SORTED_LIST_01_128: [ Before restarting a traversal because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                clds_backoff_retry(&backoff);
+            }
+        } while (restart_needed);
+
+        if (item_hp != NULL)
+        {
+            if (result == CLDS_SORTED_LIST_INSERT_OK)
+            {
+                (void)InterlockedExchange64(&item->finger_owner_id, (LONG64)finger_owner_id);
+
+                /* Codes_SRS_CLDS_SORTED_LIST_01_134: [ If finger search is enabled, on success clds_sorted_list_insert shall make the inserted item the finger of the thread for the list by calling clds_hazard_pointers_thread_set_finger. ]*/
+                clds_hazard_pointers_thread_set_finger(clds_hazard_pointers_thread, finger_owner_id, item, item_hp);
+            }
+            else
+            {
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp);
+            }
+        }
+
+        /*Codes_SRS_CLDS_SORTED_LIST_42_051: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_sorted_list);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_DELETE_RESULT clds_sorted_list_delete_item(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_015: [ If clds_sorted_list is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_016: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_017: [ If item is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_065: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_delete shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SORTED_LIST_ITEM* item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, item, sequence_number);
+        result = CLDS_SORTED_LIST_DELETE_ERROR;
+    }
+    else
+    {
+        /*Codes_SRS_CLDS_SORTED_LIST_42_006: [ clds_sorted_list_delete_item shall try the following until it acquires a write lock for the list: ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_007: [ clds_sorted_list_delete_item shall increment the count of pending write operations. ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_008: [ If the counter to lock the list for writes is non-zero then: ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_009: [ clds_sorted_list_delete_item shall decrement the count of pending write operations. ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_010: [ clds_sorted_list_delete_item shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
+        check_lock_and_begin_write_operation(clds_sorted_list);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
+        result = internal_delete(clds_sorted_list, clds_hazard_pointers_thread, compare_item_by_ptr, item, sequence_number);
+
+        /*Codes_SRS_CLDS_SORTED_LIST_42_011: [ clds_sorted_list_delete_item shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_sorted_list);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_DELETE_RESULT clds_sorted_list_delete_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_020: [ If clds_sorted_list is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_021: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_022: [ If key is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_068: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, key, sequence_number);
+        result = CLDS_SORTED_LIST_DELETE_ERROR;
+    }
+    else
+    {
+        /*Codes_SRS_CLDS_SORTED_LIST_42_012: [ clds_sorted_list_delete_key shall try the following until it acquires a write lock for the list: ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_013: [ clds_sorted_list_delete_key shall increment the count of pending write operations. ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_014: [ If the counter to lock the list for writes is non-zero then: ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_015: [ clds_sorted_list_delete_key shall decrement the count of pending write operations. ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_016: [ clds_sorted_list_delete_key shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
+        check_lock_and_begin_write_operation(clds_sorted_list);
+
+        SORTED_LIST_KEY_COMPARE_TARGET compare_target;
+        compare_target.key = key;
+        compare_target.key_fingerprint = compute_key_fingerprint(clds_sorted_list, key);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
+        result = internal_delete(clds_sorted_list, clds_hazard_pointers_thread, compare_item_by_key, &compare_target, sequence_number);
+
+        /*Codes_SRS_CLDS_SORTED_LIST_42_017: [ clds_sorted_list_delete_key shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_sorted_list);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_DELETE_RESULT clds_sorted_list_delete_range(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* low_key, void* high_key, SORTED_LIST_ITEM_DELETED_CB item_deleted_cb, void* item_deleted_cb_context)
+{
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+
+    /* Codes_SRS_CLDS_SORTED_LIST_01_142: [ item_deleted_cb and item_deleted_cb_context shall be allowed to be NULL. ]*/
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_136: [ If clds_sorted_list is NULL, clds_sorted_list_delete_range shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_137: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_delete_range shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_138: [ If low_key is NULL, clds_sorted_list_delete_range shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (low_key == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_139: [ If high_key is NULL, clds_sorted_list_delete_range shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (high_key == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* low_key=%p, void* high_key=%p, SORTED_LIST_ITEM_DELETED_CB item_deleted_cb=%p, void* item_deleted_cb_context=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, low_key, high_key, item_deleted_cb, item_deleted_cb_context);
+        result = CLDS_SORTED_LIST_DELETE_ERROR;
+    }
+    else if (clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, low_key, high_key) > 0)
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_140: [ If low_key sorts after high_key, clds_sorted_list_delete_range shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        LogError("Invalid key range: low_key=%p sorts after high_key=%p", low_key, high_key);
+        result = CLDS_SORTED_LIST_DELETE_ERROR;
+    }
+    else if ((clds_sorted_list->get_key_fingerprint_cb != NULL) &&
+        (clds_sorted_list->key_fingerprint_order != SORTED_LIST_KEY_FINGERPRINT_ORDER_PRESERVING))
+    {
+        // items are ordered by fingerprint first, so the items of a key range are not next to each other
+        /* Codes_SRS_CLDS_SORTED_LIST_01_141: [ If a key fingerprint callback is set on the list and the fingerprints were not declared as SORTED_LIST_KEY_FINGERPRINT_ORDER_PRESERVING, clds_sorted_list_delete_range shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        LogError("Cannot delete a key range from a list ordered by key fingerprints that do not preserve the key order");
+        result = CLDS_SORTED_LIST_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_143: [ clds_sorted_list_delete_range shall try the following until it acquires a write lock for the list: ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_144: [ clds_sorted_list_delete_range shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_145: [ If the counter to lock the list for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_146: [ clds_sorted_list_delete_range shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_147: [ clds_sorted_list_delete_range shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
+        check_lock_and_begin_write_operation(clds_sorted_list);
+
+        bool restart_needed;
+        bool failed = false;
+        uint64_t deleted_count = 0;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_sorted_list));
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_135: [ clds_sorted_list_delete_range shall delete all the items whose keys are between low_key and high_key (inclusive) in a single walk of the list. ]*/
+        do
+        {
+            CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+            volatile CLDS_SORTED_LIST_ITEM** current_item_address = &clds_sorted_list->head;
+            restart_needed = false;
+
+            do
+            {
+                volatile CLDS_SORTED_LIST_ITEM* current_item = (volatile CLDS_SORTED_LIST_ITEM*)((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL) & ~NEXT_FLAGS_MASK);
+                if (current_item == NULL)
+                {
+                    // end of the list
+                    break;
+                }
+                else
+                {
+                    CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                    if (current_item_hp == NULL)
+                    {
+                        LogError("Cannot acquire hazard pointer");
+                        failed = true;
+                        break;
+                    }
+                    else
+                    {
+                        // now make sure the item has not changed (if it has changed, then it means we can not touch the memory)
+                        if (InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL) != (PVOID)current_item)
+                        {
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            restart_needed = true;
+                            break;
+                        }
+                        else if (((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & NEXT_DELETE_MARK) != 0)
+                        {
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_121: [ After unlinking an item marked as deleted the traversal shall continue from the previous item. ]*/
+                            if (!help_unlink_deleted_item(clds_hazard_pointers_thread, current_item_address, current_item, current_item_hp))
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_122: [ If unlinking the item marked as deleted fails, the traversal shall restart from the head of the list. ]*/
+                                restart_needed = true;
+                                break;
+                            }
+                        }
+                        else
+                        {
+                            void* item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
+
+                            if (clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, item_key, high_key) > 0)
+                            {
+                                // past the range, nothing else to delete
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                break;
+                            }
+                            else if (clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, item_key, low_key) < 0)
+                            {
+                                // not in the range yet, move on
+                                if (previous_hp != NULL)
+                                {
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                }
+
+                                previous_hp = current_item_hp;
+                                current_item_address = (volatile CLDS_SORTED_LIST_ITEM**)&current_item->next;
+                            }
+                            else
+                            {
+                                volatile CLDS_SORTED_LIST_ITEM* current_next = (volatile CLDS_SORTED_LIST_ITEM*)((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & ~NEXT_FLAGS_MASK);
+
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_123: [ Once an item is marked as deleted, the mark shall not be cleared. ]*/
+                                if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)((uintptr_t)current_next | NEXT_DELETE_MARK), (PVOID)current_next) != (PVOID)current_next)
+                                {
+                                    // some other thread changed the next pointer (insert after, delete or replace), restart
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    restart_needed = true;
+                                    break;
+                                }
+                                else
+                                {
+                                    int64_t seq_no = 0;
+
+                                    if (clds_sorted_list->sequence_number != NULL)
+                                    {
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_148: [ For each deleted item the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+                                        seq_no = get_next_sequence_number(clds_sorted_list, clds_hazard_pointers_thread);
+                                        (void)InterlockedExchange64(&current_item->seq_no, seq_no);
+                                    }
+
+                                    deleted_count++;
+
+                                    if (item_deleted_cb != NULL)
+                                    {
+                                        // the hazard pointer keeps the item valid for the duration of the callback
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_149: [ For each deleted item, clds_sorted_list_delete_range shall call item_deleted_cb with item_deleted_cb_context, the item and the sequence number of the delete (0 if no start sequence number was provided in clds_sorted_list_create). ]*/
+                                        item_deleted_cb(item_deleted_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item, seq_no);
+                                    }
+
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_150: [ Each deleted item shall be unlinked and indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+                                    if (!help_unlink_deleted_item(clds_hazard_pointers_thread, current_item_address, current_item, current_item_hp))
+                                    {
+                                        // the marked item is still before the end of the range, so the walk from the head unlinks it
+                                        restart_needed = true;
+                                        break;
+                                    }
+                                }
                             }
                         }
                     }
                 }
             } while (1);
+
+            if (previous_hp != NULL)
+            {
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+            }
+
+            if (restart_needed)
+            {
+                /* Codes_SRS_CLDS_SORTED_LIST_01_128: [ Before restarting a traversal because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                clds_backoff_retry(&backoff);
+            }
         } while (restart_needed);
 
-        /*Codes_SRS_CLDS_SORTED_LIST_42_051: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
+        if (failed)
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_153: [ If any error occurs, clds_sorted_list_delete_range shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. Items already deleted shall stay deleted. ]*/
+            result = CLDS_SORTED_LIST_DELETE_ERROR;
+        }
+        else if (deleted_count == 0)
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_152: [ If no item has its key in the range, clds_sorted_list_delete_range shall return CLDS_SORTED_LIST_DELETE_NOT_FOUND. ]*/
+            result = CLDS_SORTED_LIST_DELETE_NOT_FOUND;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_151: [ On success, clds_sorted_list_delete_range shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
+            result = CLDS_SORTED_LIST_DELETE_OK;
+        }
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_154: [ clds_sorted_list_delete_range shall decrement the count of pending write operations. ]*/
         end_write_operation(clds_sorted_list);
     }
 
     return result;
 }
 
-CLDS_SORTED_LIST_DELETE_RESULT clds_sorted_list_delete_item(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
+CLDS_SORTED_LIST_REMOVE_RESULT clds_sorted_list_remove_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_number)
 {
-    CLDS_SORTED_LIST_DELETE_RESULT result;
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
 
+    /* Codes_SRS_CLDS_SORTED_LIST_01_053: [ If clds_sorted_list is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
     if (
-        /* Codes_SRS_CLDS_SORTED_LIST_01_015: [ If clds_sorted_list is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
         (clds_sorted_list == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_016: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_055: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_017: [ If item is NULL, clds_sorted_list_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-        (item == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_065: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_delete shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_056: [ If key is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_075: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
         ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
         )
     {
-        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SORTED_LIST_ITEM* item=%p, int64_t* sequence_number=%p",
-            clds_sorted_list, clds_hazard_pointers_thread, item, sequence_number);
-        result = CLDS_SORTED_LIST_DELETE_ERROR;
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SORTED_LIST_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, key, item, sequence_number);
+        result = CLDS_SORTED_LIST_REMOVE_ERROR;
     }
     else
     {
-        /*Codes_SRS_CLDS_SORTED_LIST_42_006: [ clds_sorted_list_delete_item shall try the following until it acquires a write lock for the list: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_007: [ clds_sorted_list_delete_item shall increment the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_008: [ If the counter to lock the list for writes is non-zero then: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_009: [ clds_sorted_list_delete_item shall decrement the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_010: [ clds_sorted_list_delete_item shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_018: [ clds_sorted_list_remove_key shall try the following until it acquires a write lock for the list: ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_019: [ clds_sorted_list_remove_key shall increment the count of pending write operations. ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_020: [ If the counter to lock the list for writes is non-zero then: ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_021: [ clds_sorted_list_remove_key shall decrement the count of pending write operations. ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_022: [ clds_sorted_list_remove_key shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
         check_lock_and_begin_write_operation(clds_sorted_list);
 
-        /* Codes_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
-        result = internal_delete(clds_sorted_list, clds_hazard_pointers_thread, compare_item_by_ptr, item, sequence_number);
+        SORTED_LIST_KEY_COMPARE_TARGET compare_target;
+        compare_target.key = key;
+        compare_target.key_fingerprint = compute_key_fingerprint(clds_sorted_list, key);
 
-        /*Codes_SRS_CLDS_SORTED_LIST_42_011: [ clds_sorted_list_delete_item shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
+        result = internal_remove(clds_sorted_list, clds_hazard_pointers_thread, compare_item_by_key, &compare_target, item, sequence_number);
+
+        /*Codes_SRS_CLDS_SORTED_LIST_42_023: [ clds_sorted_list_remove_key shall decrement the count of pending write operations. ]*/
         end_write_operation(clds_sorted_list);
     }
 
     return result;
 }
 
-CLDS_SORTED_LIST_DELETE_RESULT clds_sorted_list_delete_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+CLDS_SORTED_LIST_REMOVE_RESULT clds_sorted_list_remove_item(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
 {
-    CLDS_SORTED_LIST_DELETE_RESULT result;
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
 
     if (
-        /* Codes_SRS_CLDS_SORTED_LIST_01_020: [ If clds_sorted_list is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_180: [ If clds_sorted_list is NULL, clds_sorted_list_remove_item shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
         (clds_sorted_list == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_021: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_181: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_remove_item shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_022: [ If key is NULL, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_068: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_182: [ If item is NULL, clds_sorted_list_remove_item shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_183: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_remove_item shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
         ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
         )
     {
-        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
-            clds_sorted_list, clds_hazard_pointers_thread, key, sequence_number);
-        result = CLDS_SORTED_LIST_DELETE_ERROR;
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SORTED_LIST_ITEM* item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, item, sequence_number);
+        result = CLDS_SORTED_LIST_REMOVE_ERROR;
     }
     else
     {
-        /*Codes_SRS_CLDS_SORTED_LIST_42_012: [ clds_sorted_list_delete_key shall try the following until it acquires a write lock for the list: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_013: [ clds_sorted_list_delete_key shall increment the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_014: [ If the counter to lock the list for writes is non-zero then: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_015: [ clds_sorted_list_delete_key shall decrement the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_016: [ clds_sorted_list_delete_key shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_185: [ clds_sorted_list_remove_item shall try the following until it acquires a write lock for the list: ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_186: [ clds_sorted_list_remove_item shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_187: [ If the counter to lock the list for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_188: [ clds_sorted_list_remove_item shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_189: [ clds_sorted_list_remove_item shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
         check_lock_and_begin_write_operation(clds_sorted_list);
 
-        /* Codes_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
-        result = internal_delete(clds_sorted_list, clds_hazard_pointers_thread, compare_item_by_key, key, sequence_number);
+        CLDS_SORTED_LIST_ITEM* removed_item;
 
-        /*Codes_SRS_CLDS_SORTED_LIST_42_017: [ clds_sorted_list_delete_key shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_178: [ clds_sorted_list_remove_item shall remove an item from the list by its pointer and hand the reference that the list held on the item to the caller. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_179: [ On success, clds_sorted_list_remove_item shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_184: [ If the item is not found in the list, clds_sorted_list_remove_item shall return CLDS_SORTED_LIST_REMOVE_NOT_FOUND. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_190: [ For each remove item the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+        result = internal_remove(clds_sorted_list, clds_hazard_pointers_thread, compare_item_by_ptr, item, &removed_item, sequence_number);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_191: [ clds_sorted_list_remove_item shall decrement the count of pending write operations. ]*/
         end_write_operation(clds_sorted_list);
     }
 
     return result;
 }
 
-CLDS_SORTED_LIST_REMOVE_RESULT clds_sorted_list_remove_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_number)
+CLDS_SORTED_LIST_REMOVE_RESULT clds_sorted_list_remove_first(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_number)
 {
     CLDS_SORTED_LIST_REMOVE_RESULT result;
 
-    /* Codes_SRS_CLDS_SORTED_LIST_01_053: [ If clds_sorted_list is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
     if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_112: [ If clds_sorted_list is NULL, clds_sorted_list_remove_first shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
         (clds_sorted_list == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_055: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_113: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_remove_first shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_056: [ If key is NULL, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_075: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_114: [ If item is NULL, clds_sorted_list_remove_first shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_115: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_remove_first shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
         ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
         )
     {
-        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SORTED_LIST_ITEM** item=%p, int64_t* sequence_number=%p",
-            clds_sorted_list, clds_hazard_pointers_thread, key, item, sequence_number);
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SORTED_LIST_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, item, sequence_number);
+        result = CLDS_SORTED_LIST_REMOVE_ERROR;
+    }
+    else if ((clds_sorted_list->get_key_fingerprint_cb != NULL) &&
+        (clds_sorted_list->key_fingerprint_order == SORTED_LIST_KEY_FINGERPRINT_ORDER_UNRELATED))
+    {
+        // the first item has the smallest fingerprint, which is not the smallest key
+        /* Codes_SRS_CLDS_SORTED_LIST_01_176: [ If a key fingerprint callback is set on the list and the fingerprints were declared as SORTED_LIST_KEY_FINGERPRINT_ORDER_UNRELATED, clds_sorted_list_remove_first shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+        LogError("Cannot remove the first item of a list ordered by key fingerprints that do not preserve the key order");
         result = CLDS_SORTED_LIST_REMOVE_ERROR;
     }
     else
     {
-        /*Codes_SRS_CLDS_SORTED_LIST_42_018: [ clds_sorted_list_remove_key shall try the following until it acquires a write lock for the list: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_019: [ clds_sorted_list_remove_key shall increment the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_020: [ If the counter to lock the list for writes is non-zero then: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_021: [ clds_sorted_list_remove_key shall decrement the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_022: [ clds_sorted_list_remove_key shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_052: [ clds_sorted_list_remove_first shall try the following until it acquires a write lock for the list: ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_053: [ clds_sorted_list_remove_first shall increment the count of pending write operations. ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_054: [ If the counter to lock the list for writes is non-zero then: ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_055: [ clds_sorted_list_remove_first shall decrement the count of pending write operations. ]*/
+        /*Codes_SRS_CLDS_SORTED_LIST_42_056: [ clds_sorted_list_remove_first shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
         check_lock_and_begin_write_operation(clds_sorted_list);
 
-        /* Codes_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
-        result = internal_remove(clds_sorted_list, clds_hazard_pointers_thread, compare_item_by_key, key, item, sequence_number);
-
-        /*Codes_SRS_CLDS_SORTED_LIST_42_023: [ clds_sorted_list_remove_key shall decrement the count of pending write operations. ]*/
+        // The first item matches without any key compare. If another thread marks it first, the mark CAS fails and
+        // the retry picks up the new head, which is the next item once the other thread unlinked it.
+        /* Codes_SRS_CLDS_SORTED_LIST_01_109: [ clds_sorted_list_remove_first shall remove the first item in the list (the item with the smallest key) and return it in item. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_110: [ On success, clds_sorted_list_remove_first shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_177: [ If the fingerprints were declared as SORTED_LIST_KEY_FINGERPRINT_ORDER_REMOVE_FIRST_BY_FINGERPRINT, clds_sorted_list_remove_first shall remove the item with the smallest fingerprint. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_111: [ If the list is empty, clds_sorted_list_remove_first shall return CLDS_SORTED_LIST_REMOVE_NOT_FOUND. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_116: [ If another thread removes the first item concurrently, clds_sorted_list_remove_first shall retry with the item that became the first item, without calling get_item_key_cb or key_compare_cb. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_117: [ For each remove first the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_118: [ If the sequence_number argument passed to clds_sorted_list_remove_first is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
+        result = internal_remove(clds_sorted_list, clds_hazard_pointers_thread, compare_item_first, NULL, item, sequence_number);
+
+        /*Codes_SRS_CLDS_SORTED_LIST_42_057: [ clds_sorted_list_remove_first shall decrement the count of pending write operations. ]*/
         end_write_operation(clds_sorted_list);
     }
 
@@ -1128,8 +1942,10 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
         /* Codes_SRS_CLDS_SORTED_LIST_01_027: [ clds_sorted_list_find shall find in the list the first item that matches the criteria given by a user compare function. ]*/
 
         bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_sorted_list));
         result = NULL;
         uint64_t iteration_count = 0;
+        uint64_t key_fingerprint = compute_key_fingerprint(clds_sorted_list, key);
 
         do
         {
@@ -1149,7 +1965,7 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
                 volatile CLDS_SORTED_LIST_ITEM* current_item = (volatile CLDS_SORTED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL);
 
                 // clear any delete lock bit from what we read
-                current_item = (void*)((uintptr_t)current_item & ~0x1);
+                current_item = (void*)((uintptr_t)current_item & ~NEXT_FLAGS_MASK);
 
                 if (current_item == NULL)
                 {
@@ -1202,8 +2018,27 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
                         }
                         else
                         {
-                            void* item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
-                            int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, key, item_key);
+                            // an item marked as deleted is unlinked on the spot and the walk continues from the same predecessor
+                            if (((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & NEXT_DELETE_MARK) != 0)
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_121: [ After unlinking an item marked as deleted the traversal shall continue from the previous item. ]*/
+                                if (!help_unlink_deleted_item(clds_hazard_pointers_thread, current_item_address, current_item, current_item_hp))
+                                {
+                                    if (previous_hp != NULL)
+                                    {
+                                        // let go of previous hazard pointer
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    }
+
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_122: [ If unlinking the item marked as deleted fails, the traversal shall restart from the head of the list. ]*/
+                                    restart_needed = true;
+                                    break;
+                                }
+
+                                continue;
+                            }
+
+                            int compare_result = compare_key_to_item(clds_sorted_list, key, key_fingerprint, current_item);
                             if (compare_result == 0)
                             {
                                 if (previous_hp != NULL)
@@ -1239,6 +2074,11 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
                     }
                 }
             } while (1);
+            if (restart_needed)
+            {
+                /* Codes_SRS_CLDS_SORTED_LIST_01_128: [ Before restarting a traversal because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                clds_backoff_retry(&backoff);
+            }
         } while (restart_needed);
     }
 
@@ -1278,14 +2118,19 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
         check_lock_and_begin_write_operation(clds_sorted_list);
 
         bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_sorted_list));
         void* new_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, new_item);
         int64_t insert_seq_no = 0;
-        
+        new_item->key_fingerprint = compute_key_fingerprint(clds_sorted_list, new_item_key);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_174: [ clds_sorted_list_insert and clds_sorted_list_set_value shall clear the finger owner id of the item before linking it in the list. ]*/
+        (void)InterlockedExchange64(&new_item->finger_owner_id, 0);
+
         /* Codes_SRS_CLDS_SORTED_LIST_01_091: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
         if (clds_sorted_list->sequence_number != NULL)
         {
             /* Codes_SRS_CLDS_SORTED_LIST_01_090: [ For each set value the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-            insert_seq_no = InterlockedIncrement64(clds_sorted_list->sequence_number);
+            insert_seq_no = get_next_sequence_number(clds_sorted_list, clds_hazard_pointers_thread);
 
             /* Codes_SRS_CLDS_SORTED_LIST_01_092: [ If the sequence_number argument passed to clds_sorted_list_set_value is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
             if (sequence_number != NULL)
@@ -1315,7 +2160,7 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                 volatile CLDS_SORTED_LIST_ITEM* current_item = (volatile CLDS_SORTED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL);
 
                 // clear any delete lock bit from what we read
-                current_item = (void*)((uintptr_t)current_item & ~0x1);
+                current_item = (void*)((uintptr_t)current_item & ~NEXT_FLAGS_MASK);
 
                 if (current_item == NULL)
                 {
@@ -1420,9 +2265,28 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                         }
                         else
                         {
+                            // an item marked as deleted is unlinked on the spot and the walk continues from the same predecessor
+                            if (((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & NEXT_DELETE_MARK) != 0)
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_121: [ After unlinking an item marked as deleted the traversal shall continue from the previous item. ]*/
+                                if (!help_unlink_deleted_item(clds_hazard_pointers_thread, current_item_address, current_item, current_item_hp))
+                                {
+                                    if (previous_hp != NULL)
+                                    {
+                                        // let go of previous hazard pointer
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    }
+
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_122: [ If unlinking the item marked as deleted fails, the traversal shall restart from the head of the list. ]*/
+                                    restart_needed = true;
+                                    break;
+                                }
+
+                                continue;
+                            }
+
                             // we are in a stable state, compare the current item key to our key
-                            void* current_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
-                            int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, new_item_key, current_item_key);
+                            int compare_result = compare_key_to_item(clds_sorted_list, new_item_key, new_item->key_fingerprint, current_item);
 
                             if (compare_result == 0)
                             {
@@ -1431,9 +2295,9 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                 volatile CLDS_SORTED_LIST_ITEM* current_next = InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL);
 
                                 // clear any delete lock bit from what we read
-                                current_next = (void*)((uintptr_t)current_next & ~0x1);
+                                current_next = (void*)((uintptr_t)current_next & ~NEXT_FLAGS_MASK);
 
-                                if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)((uintptr_t)current_next | 0x1), (PVOID)current_next) != (PVOID)current_next)
+                                if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)((uintptr_t)current_next | NEXT_REPLACE_LOCK), (PVOID)current_next) != (PVOID)current_next)
                                 {
                                     if (previous_item != NULL)
                                     {
@@ -1445,7 +2309,9 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                     break;
                                 }
 
-                                if (clds_sorted_list->sequence_number != NULL)
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_108: [ If the sequence number block size is non-zero, clds_sorted_list_set_value shall not obtain a new sequence number when other operations took sequence numbers while it was in progress. ]*/
+                                if ((clds_sorted_list->sequence_number != NULL) &&
+                                    (InterlockedAdd(&clds_sorted_list->sequence_number_block_size, 0) == 0))
                                 {
                                     if (InterlockedAdd64(clds_sorted_list->sequence_number, 0) != insert_seq_no)
                                     {
@@ -1455,7 +2321,7 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                         }
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_090: [ For each set value the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-                                        insert_seq_no = InterlockedIncrement64(clds_sorted_list->sequence_number);
+                                        insert_seq_no = get_next_sequence_number(clds_sorted_list, clds_hazard_pointers_thread);
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_092: [ If the sequence_number argument passed to clds_sorted_list_set_value is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
                                         if (sequence_number != NULL)
@@ -1468,7 +2334,7 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                 // same item!, locked, noone changes it now, so we can set the seq no.
                                 if (current_item == new_item)
                                 {
-                                    if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)current_next, (PVOID)((uintptr_t)current_next | 0x1)) != (PVOID)((uintptr_t)current_next | 0x1))
+                                    if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)current_next, (PVOID)((uintptr_t)current_next | NEXT_REPLACE_LOCK)) != (PVOID)((uintptr_t)current_next | NEXT_REPLACE_LOCK))
                                     {
                                         LogError("This should not happen");
                                         if (previous_item != NULL)
@@ -1515,7 +2381,7 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                     // have a previous item
                                     if (InterlockedCompareExchangePointer((volatile PVOID*)&previous_item->next, (PVOID)new_item, (PVOID)current_item) != current_item)
                                     {
-                                        if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)current_next, (PVOID)((uintptr_t)current_next | 0x1)) != (PVOID)((uintptr_t)current_next | 0x1))
+                                        if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)current_next, (PVOID)((uintptr_t)current_next | NEXT_REPLACE_LOCK)) != (PVOID)((uintptr_t)current_next | NEXT_REPLACE_LOCK))
                                         {
                                             LogError("This should not happen");
                                             clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
@@ -1554,7 +2420,7 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                 {
                                     if (InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->head, (PVOID)new_item, (PVOID)current_item) != current_item)
                                     {
-                                        if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)current_next, (PVOID)((uintptr_t)current_next | 0x1)) != (PVOID)((uintptr_t)current_next | 0x1))
+                                        if (InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, (PVOID)current_next, (PVOID)((uintptr_t)current_next | NEXT_REPLACE_LOCK)) != (PVOID)((uintptr_t)current_next | NEXT_REPLACE_LOCK))
                                         {
                                             LogError("This should not happen");
                                             clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
@@ -1679,6 +2545,11 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                     }
                 }
             } while (1);
+            if (restart_needed)
+            {
+                /* Codes_SRS_CLDS_SORTED_LIST_01_128: [ Before restarting a traversal because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                clds_backoff_retry(&backoff);
+            }
         } while (restart_needed);
 
         /*Codes_SRS_CLDS_SORTED_LIST_42_029: [ clds_sorted_list_set_value shall decrement the count of pending write operations. ]*/
@@ -1753,13 +2624,20 @@ CLDS_SORTED_LIST_GET_COUNT_RESULT clds_sorted_list_get_count(CLDS_SORTED_LIST_HA
         {
             /*Codes_SRS_CLDS_SORTED_LIST_42_039: [ clds_sorted_list_get_count shall iterate over the items in the list and count them in item_count. ]*/
             uint64_t count = 0;
-            CLDS_SORTED_LIST_ITEM* current_item = InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->head, NULL, NULL);
+            CLDS_SORTED_LIST_ITEM* current_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->head, NULL, NULL) & ~NEXT_FLAGS_MASK);
 
             while (current_item != NULL)
             {
-                count++;
-                CLDS_SORTED_LIST_ITEM* next_item = InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL);
-                current_item = next_item;
+                // the flags are not part of the address of the next item
+                uintptr_t next_value = (uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL);
+
+                /* Codes_SRS_CLDS_SORTED_LIST_01_171: [ clds_sorted_list_get_count shall not count the items marked as deleted that are still linked in the list. ]*/
+                if ((next_value & NEXT_DELETE_MARK) == 0)
+                {
+                    count++;
+                }
+
+                current_item = (CLDS_SORTED_LIST_ITEM*)(next_value & ~NEXT_FLAGS_MASK);
             }
 
             *item_count = count;
@@ -1806,11 +2684,20 @@ CLDS_SORTED_LIST_GET_ALL_RESULT clds_sorted_list_get_all(CLDS_SORTED_LIST_HANDLE
 
             /*Codes_SRS_CLDS_SORTED_LIST_42_046: [ For each item in the list: ]*/
             uint64_t current_index = 0;
-            CLDS_SORTED_LIST_ITEM* current_item = InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->head, NULL, NULL);
+            CLDS_SORTED_LIST_ITEM* current_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&clds_sorted_list->head, NULL, NULL) & ~NEXT_FLAGS_MASK);
 
             while (current_item != NULL)
             {
-                CLDS_SORTED_LIST_ITEM* next_item = InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL);
+                // the flags are not part of the address of the next item
+                uintptr_t next_value = (uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL);
+                CLDS_SORTED_LIST_ITEM* next_item = (CLDS_SORTED_LIST_ITEM*)(next_value & ~NEXT_FLAGS_MASK);
+
+                if ((next_value & NEXT_DELETE_MARK) != 0)
+                {
+                    /* Codes_SRS_CLDS_SORTED_LIST_01_172: [ clds_sorted_list_get_all shall skip the items marked as deleted that are still linked in the list. ]*/
+                    current_item = next_item;
+                    continue;
+                }
 
                 if (current_index + 1 > item_count)
                 {
@@ -1858,6 +2745,153 @@ CLDS_SORTED_LIST_GET_ALL_RESULT clds_sorted_list_get_all(CLDS_SORTED_LIST_HANDLE
     return result;
 }
 
+CLDS_SORTED_LIST_VISIT_RESULT clds_sorted_list_visit(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SORTED_LIST_VISIT_CB visit_cb, void* visit_cb_context)
+{
+    CLDS_SORTED_LIST_VISIT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_157: [ If clds_sorted_list is NULL, clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_158: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_159: [ If visit_cb is NULL, clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+        (visit_cb == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, SORTED_LIST_VISIT_CB visit_cb=%p, void* visit_cb_context=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, visit_cb, visit_cb_context);
+        result = CLDS_SORTED_LIST_VISIT_ERROR;
+    }
+    else
+    {
+        bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(get_backoff_policy(clds_sorted_list));
+        uint64_t iteration_count = 0;
+
+        do
+        {
+            if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
+            {
+                LogInfo("clds_sorted_list_visit spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
+                iteration_count = 0;
+            }
+
+            CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+            volatile CLDS_SORTED_LIST_ITEM** current_item_address = &clds_sorted_list->head;
+
+            do
+            {
+                // get the current_item value
+                volatile CLDS_SORTED_LIST_ITEM* current_item = (volatile CLDS_SORTED_LIST_ITEM*)InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, NULL, NULL);
+
+                // clear any delete lock bit from what we read
+                current_item = (void*)((uintptr_t)current_item & ~NEXT_FLAGS_MASK);
+
+                if (current_item == NULL)
+                {
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                    }
+
+                    /* Codes_SRS_CLDS_SORTED_LIST_01_162: [ If the walk reaches the end of the list, clds_sorted_list_visit shall succeed and return CLDS_SORTED_LIST_VISIT_OK. ]*/
+                    restart_needed = false;
+                    result = CLDS_SORTED_LIST_VISIT_OK;
+                    break;
+                }
+                else
+                {
+                    // acquire hazard pointer
+                    CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                    if (current_item_hp == NULL)
+                    {
+                        if (previous_hp != NULL)
+                        {
+                            // let go of previous hazard pointer
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        }
+
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_163: [ If acquiring a hazard pointer fails, clds_sorted_list_visit shall fail and return CLDS_SORTED_LIST_VISIT_ERROR. ]*/
+                        LogError("Cannot acquire hazard pointer");
+                        restart_needed = false;
+                        result = CLDS_SORTED_LIST_VISIT_ERROR;
+                        break;
+                    }
+                    else
+                    {
+                        // now make sure the item has not changed
+                        if (InterlockedCompareExchangePointer((volatile PVOID*)current_item_address, (PVOID)current_item, (PVOID)current_item) != (PVOID)current_item)
+                        {
+                            if (previous_hp != NULL)
+                            {
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                            }
+
+                            // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_164: [ If the walk restarts from the head of the list because of a concurrent change, items already visited may be passed again to visit_cb. ]*/
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            restart_needed = true;
+                            break;
+                        }
+                        else
+                        {
+                            // an item marked as deleted is unlinked on the spot and the walk continues from the same predecessor
+                            if (((uintptr_t)InterlockedCompareExchangePointer((volatile PVOID*)&current_item->next, NULL, NULL) & NEXT_DELETE_MARK) != 0)
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_121: [ After unlinking an item marked as deleted the traversal shall continue from the previous item. ]*/
+                                if (!help_unlink_deleted_item(clds_hazard_pointers_thread, current_item_address, current_item, current_item_hp))
+                                {
+                                    if (previous_hp != NULL)
+                                    {
+                                        // let go of previous hazard pointer
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    }
+
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_122: [ If unlinking the item marked as deleted fails, the traversal shall restart from the head of the list. ]*/
+                                    restart_needed = true;
+                                    break;
+                                }
+
+                                continue;
+                            }
+
+                            if (previous_hp != NULL)
+                            {
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                            }
+
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_160: [ clds_sorted_list_visit shall walk the list from the head and for each item that is not marked as deleted call visit_cb with visit_cb_context and the item, while holding a hazard pointer on the item. ]*/
+                            if (!visit_cb(visit_cb_context, (CLDS_SORTED_LIST_ITEM*)current_item))
+                            {
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_161: [ If visit_cb returns false, clds_sorted_list_visit shall stop the walk and return CLDS_SORTED_LIST_VISIT_ABORTED. ]*/
+                                restart_needed = false;
+                                result = CLDS_SORTED_LIST_VISIT_ABORTED;
+                                break;
+                            }
+
+                            previous_hp = current_item_hp;
+                            current_item_address = (volatile CLDS_SORTED_LIST_ITEM**)&current_item->next;
+                        }
+                    }
+                }
+            } while (1);
+
+            if (restart_needed)
+            {
+                /* Codes_SRS_CLDS_SORTED_LIST_01_128: [ Before restarting a traversal because of a concurrent change, the list operations shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the list. ]*/
+                clds_backoff_retry(&backoff);
+            }
+        } while (restart_needed);
+    }
+
+    return result;
+}
+
 CLDS_SORTED_LIST_ITEM* clds_sorted_list_node_create(size_t node_size, SORTED_LIST_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context)
 {
     /* Codes_SRS_CLDS_SORTED_LIST_01_036: [ item_cleanup_callback shall be allowed to be NULL. ]*/
@@ -1872,6 +2906,8 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_node_create(size_t node_size, SORTED_LIS
         volatile CLDS_SORTED_LIST_ITEM* item = (volatile CLDS_SORTED_LIST_ITEM*)((unsigned char*)result);
         item->item_cleanup_callback = item_cleanup_callback;
         item->item_cleanup_callback_context = item_cleanup_callback_context;
+        item->key_fingerprint = 0;
+        (void)InterlockedExchange64(&item->finger_owner_id, 0);
         (void)InterlockedExchange(&item->ref_count, 1);
         (void)InterlockedExchangePointer((volatile PVOID*)&item->next, NULL);
     }
@@ -7,12 +7,14 @@
 #include "azure_c_logging/xlogging.h"
 #include "clds/lock_free_set.h"
 #include "clds/clds_atomics.h"
+#include "clds/clds_backoff.h"
 
 /* this is a lock free set that is backed by a doubly linked list */
 
 typedef struct LOCK_FREE_SET_TAG
 {
     volatile CLDS_ATOMIC(intptr_t) head;
+    volatile CLDS_ATOMIC(long) backoff_policy;
 } LOCK_FREE_SET;
 
 static void internal_purge_not_thread_safe(LOCK_FREE_SET_HANDLE lock_free_set, NODE_CLEANUP_FUNC node_cleanup_callback, void* context)
@@ -53,6 +55,7 @@ LOCK_FREE_SET_HANDLE lock_free_set_create(void)
     {
         /* Codes_SRS_LOCK_FREE_SET_01_002: [ On success, lock_free_set_create shall return a non-NULL handle to the newly created set. ]*/
         lock_free_set->head = (CLDS_ATOMIC(intptr_t))NULL;
+        clds_atomic_store_long(&lock_free_set->backoff_policy, CLDS_BACKOFF_POLICY_NONE);
     }
 
     return lock_free_set;
@@ -75,6 +78,32 @@ void lock_free_set_destroy(LOCK_FREE_SET_HANDLE lock_free_set, NODE_CLEANUP_FUNC
     }
 }
 
+int lock_free_set_set_backoff_policy(LOCK_FREE_SET_HANDLE lock_free_set, CLDS_BACKOFF_POLICY backoff_policy)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_LOCK_FREE_SET_01_026: [ If lock_free_set is NULL, lock_free_set_set_backoff_policy shall fail and return a non-zero value. ]*/
+        (lock_free_set == NULL) ||
+        /* Codes_SRS_LOCK_FREE_SET_01_027: [ If backoff_policy is not a valid CLDS_BACKOFF_POLICY value, lock_free_set_set_backoff_policy shall fail and return a non-zero value. ]*/
+        ((int)backoff_policy < (int)CLDS_BACKOFF_POLICY_NONE) ||
+        ((int)backoff_policy > (int)CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT)
+        )
+    {
+        LogError("Invalid arguments: LOCK_FREE_SET_HANDLE lock_free_set=%p, CLDS_BACKOFF_POLICY backoff_policy=%" PRI_MU_ENUM "",
+            lock_free_set, MU_ENUM_VALUE(CLDS_BACKOFF_POLICY, backoff_policy));
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_LOCK_FREE_SET_01_025: [ lock_free_set_set_backoff_policy shall set the backoff policy used by all subsequent inserts and removes when they have to retry because of a concurrent change and return 0. ]*/
+        clds_atomic_store_long(&lock_free_set->backoff_policy, (long)backoff_policy);
+        result = 0;
+    }
+
+    return result;
+}
+
 int lock_free_set_insert(LOCK_FREE_SET_HANDLE lock_free_set, LOCK_FREE_SET_ITEM* item)
 {
     int result;
@@ -92,6 +121,7 @@ int lock_free_set_insert(LOCK_FREE_SET_HANDLE lock_free_set, LOCK_FREE_SET_ITEM*
     else
     {
         bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER((CLDS_BACKOFF_POLICY)clds_atomic_load_long(&lock_free_set->backoff_policy));
         result = MU_FAILURE;
 
         /* Codes_SRS_LOCK_FREE_SET_01_013: [ lock_free_set_insert and lock_free_set_remove shall be safe to be called from multiple threads. ]*/
@@ -153,9 +183,19 @@ int lock_free_set_insert(LOCK_FREE_SET_HANDLE lock_free_set, LOCK_FREE_SET_ITEM*
                             restart_needed = false;
                             result = 0;
                         }
+                        if (wait_for_next_node)
+                        {
+                            /* Codes_SRS_LOCK_FREE_SET_01_028: [ Before retrying because of a concurrent change, lock_free_set_insert and lock_free_set_remove shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the set. ]*/
+                            clds_backoff_retry(&backoff);
+                        }
                     } while (wait_for_next_node);
                 }
             }
+            if (restart_needed)
+            {
+                /* Codes_SRS_LOCK_FREE_SET_01_028: [ Before retrying because of a concurrent change, lock_free_set_insert and lock_free_set_remove shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the set. ]*/
+                clds_backoff_retry(&backoff);
+            }
         } while (restart_needed);
     }
 
@@ -179,6 +219,7 @@ int lock_free_set_remove(LOCK_FREE_SET_HANDLE lock_free_set, LOCK_FREE_SET_ITEM*
     else
     {
         bool restart_needed;
+        CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER((CLDS_BACKOFF_POLICY)clds_atomic_load_long(&lock_free_set->backoff_policy));
 
         /* Codes_SRS_LOCK_FREE_SET_01_013: [ lock_free_set_insert and lock_free_set_remove shall be safe to be called from multiple threads. ]*/
 
@@ -354,6 +395,11 @@ int lock_free_set_remove(LOCK_FREE_SET_HANDLE lock_free_set, LOCK_FREE_SET_ITEM*
                                             restart_needed = false;
                                             result = 0;
                                         }
+                                        if (wait_for_next_node)
+                                        {
+                                            /* Codes_SRS_LOCK_FREE_SET_01_028: [ Before retrying because of a concurrent change, lock_free_set_insert and lock_free_set_remove shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the set. ]*/
+                                            clds_backoff_retry(&backoff);
+                                        }
                                     } while (wait_for_next_node);
                                 }
                             }
@@ -682,6 +728,11 @@ int lock_free_set_remove(LOCK_FREE_SET_HANDLE lock_free_set, LOCK_FREE_SET_ITEM*
                                                             }
                                                         }
                                                     }
+                                                    if (wait_for_next_node)
+                                                    {
+                                                        /* Codes_SRS_LOCK_FREE_SET_01_028: [ Before retrying because of a concurrent change, lock_free_set_insert and lock_free_set_remove shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the set. ]*/
+                                                        clds_backoff_retry(&backoff);
+                                                    }
                                                 } while (wait_for_next_node);
                                             }
                                         }
@@ -692,6 +743,11 @@ int lock_free_set_remove(LOCK_FREE_SET_HANDLE lock_free_set, LOCK_FREE_SET_ITEM*
                     }
                 }
             }
+            if (restart_needed)
+            {
+                /* Codes_SRS_LOCK_FREE_SET_01_028: [ Before retrying because of a concurrent change, lock_free_set_insert and lock_free_set_remove shall call clds_backoff_retry with a backoff state initialized with the backoff policy of the set. ]*/
+                clds_backoff_retry(&backoff);
+            }
         } while (restart_needed);
     }
 
@@ -0,0 +1,243 @@
+// Copyright (c) Microsoft. All rights reserved.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstdint>
+#else
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#endif
+
+#include "azure_macro_utils/macro_utils.h"
+#include "testrunnerswitcher.h"
+
+#include "umock_c/umock_c.h"
+#include "clds/clds_backoff.h"
+
+static TEST_MUTEX_HANDLE test_serialize_mutex;
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%" PRI_MU_ENUM "", MU_ENUM_VALUE(UMOCK_C_ERROR_CODE, error_code));
+}
+
+BEGIN_TEST_SUITE(clds_backoff_unittests)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+
+    umock_c_init(on_umock_c_error);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+/* clds_backoff_retry */
+
+/* Tests_SRS_CLDS_BACKOFF_01_002: [ If backoff is NULL, clds_backoff_retry shall return. ]*/
+TEST_FUNCTION(clds_backoff_retry_with_NULL_backoff_returns)
+{
+    // arrange
+
+    // act
+    clds_backoff_retry(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_BACKOFF_01_001: [ clds_backoff_retry shall delay the calling thread according to the policy in backoff and the number of attempts already made. ]*/
+/* Tests_SRS_CLDS_BACKOFF_01_004: [ If the policy is CLDS_BACKOFF_POLICY_NONE, clds_backoff_retry shall return immediately. ]*/
+TEST_FUNCTION(clds_backoff_retry_with_policy_NONE_does_not_count_attempts)
+{
+    // arrange
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(CLDS_BACKOFF_POLICY_NONE);
+
+    // act
+    clds_backoff_retry(&backoff);
+    clds_backoff_retry(&backoff);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(uint32_t, 0, backoff.attempt_count);
+}
+
+/* Tests_SRS_CLDS_BACKOFF_01_003: [ If the policy in backoff is not a valid CLDS_BACKOFF_POLICY value, clds_backoff_retry shall behave as for CLDS_BACKOFF_POLICY_NONE. ]*/
+TEST_FUNCTION(clds_backoff_retry_with_invalid_policy_does_not_count_attempts)
+{
+    // arrange
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER((CLDS_BACKOFF_POLICY)(CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT + 1));
+
+    // act
+    clds_backoff_retry(&backoff);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(uint32_t, 0, backoff.attempt_count);
+}
+
+/* Tests_SRS_CLDS_BACKOFF_01_005: [ If the policy is CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD, clds_backoff_retry shall execute a number of CPU pause instructions that doubles with each attempt, starting at 1 and up to 512. ]*/
+/* Tests_SRS_CLDS_BACKOFF_01_006: [ After 10 attempts, clds_backoff_retry shall yield the time slice of the calling thread instead. ]*/
+TEST_FUNCTION(clds_backoff_retry_with_policy_EXPONENTIAL_YIELD_stops_counting_after_10_attempts)
+{
+    // arrange
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD);
+    uint32_t i;
+
+    // act
+    for (i = 0; i < 12; i++)
+    {
+        clds_backoff_retry(&backoff);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(uint32_t, 10, backoff.attempt_count);
+}
+
+/* Tests_SRS_CLDS_BACKOFF_01_007: [ If the policy is CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT, for the first 32 attempts clds_backoff_retry shall execute 64 CPU pause instructions. ]*/
+/* Tests_SRS_CLDS_BACKOFF_01_008: [ After 32 attempts, clds_backoff_retry shall yield the time slice of the calling thread. ]*/
+TEST_FUNCTION(clds_backoff_retry_with_policy_SPIN_THEN_WAIT_stops_counting_after_32_attempts)
+{
+    // arrange
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT);
+    uint32_t i;
+
+    // act
+    for (i = 0; i < 34; i++)
+    {
+        clds_backoff_retry(&backoff);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(uint32_t, 32, backoff.attempt_count);
+}
+
+/* clds_backoff_wait_while_equal */
+
+/* Tests_SRS_CLDS_BACKOFF_01_010: [ If backoff is NULL, clds_backoff_wait_while_equal shall return. ]*/
+TEST_FUNCTION(clds_backoff_wait_while_equal_with_NULL_backoff_returns)
+{
+    // arrange
+    volatile LONG value = 1;
+
+    // act
+    clds_backoff_wait_while_equal(NULL, &value, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_BACKOFF_01_011: [ If address is NULL, clds_backoff_wait_while_equal shall return. ]*/
+TEST_FUNCTION(clds_backoff_wait_while_equal_with_NULL_address_returns)
+{
+    // arrange
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT);
+
+    // act
+    clds_backoff_wait_while_equal(&backoff, NULL, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(uint32_t, 0, backoff.attempt_count);
+}
+
+/* Tests_SRS_CLDS_BACKOFF_01_012: [ If the value at address is different than value, clds_backoff_wait_while_equal shall return immediately. ]*/
+TEST_FUNCTION(clds_backoff_wait_while_equal_when_the_value_is_different_returns_without_counting_an_attempt)
+{
+    // arrange
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT);
+    volatile LONG value = 2;
+
+    // act
+    clds_backoff_wait_while_equal(&backoff, &value, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(uint32_t, 0, backoff.attempt_count);
+}
+
+/* Tests_SRS_CLDS_BACKOFF_01_009: [ clds_backoff_wait_while_equal shall delay the calling thread according to the policy in backoff, in the same way as clds_backoff_retry. ]*/
+TEST_FUNCTION(clds_backoff_wait_while_equal_when_the_value_is_equal_counts_an_attempt)
+{
+    // arrange
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD);
+    volatile LONG value = 1;
+
+    // act
+    clds_backoff_wait_while_equal(&backoff, &value, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(uint32_t, 1, backoff.attempt_count);
+}
+
+/* Tests_SRS_CLDS_BACKOFF_01_013: [ After 32 attempts with the policy CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT, clds_backoff_wait_while_equal shall block the calling thread (WaitOnAddress) until the value at address changes, clds_backoff_wake_all is called for address or 1 ms elapses. ]*/
+TEST_FUNCTION(clds_backoff_wait_while_equal_after_the_spin_attempts_returns_after_the_wait_times_out)
+{
+    // arrange
+    CLDS_BACKOFF backoff = CLDS_BACKOFF_INITIALIZER(CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT);
+    volatile LONG value = 1;
+    backoff.attempt_count = 32;
+
+    // act
+    clds_backoff_wait_while_equal(&backoff, &value, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(uint32_t, 32, backoff.attempt_count);
+}
+
+/* clds_backoff_wake_all */
+
+/* Tests_SRS_CLDS_BACKOFF_01_015: [ If address is NULL, clds_backoff_wake_all shall return. ]*/
+TEST_FUNCTION(clds_backoff_wake_all_with_NULL_address_returns)
+{
+    // arrange
+
+    // act
+    clds_backoff_wake_all(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_BACKOFF_01_014: [ clds_backoff_wake_all shall wake all threads blocked in clds_backoff_wait_while_equal on address. ]*/
+TEST_FUNCTION(clds_backoff_wake_all_with_no_waiters_succeeds)
+{
+    // arrange
+    volatile LONG value = 1;
+
+    // act
+    clds_backoff_wake_all(&value);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+END_TEST_SUITE(clds_backoff_unittests)
@@ -0,0 +1,11 @@
+// Copyright (c) Microsoft. All rights reserved.
+
+#include <stddef.h>
+#include "testrunnerswitcher.h"
+
+int main(void)
+{
+    size_t failedTestCount = 0;
+    RUN_TEST_SUITE(clds_backoff_unittests, failedTestCount);
+    return failedTestCount;
+}
@@ -0,0 +1,363 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstring>
+#include <cinttypes>
+#else
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#endif
+
+#include "azure_macro_utils/macro_utils.h"
+#include "testrunnerswitcher.h"
+
+#include "windows.h"
+#include "azure_c_util/gballoc.h"
+#include "azure_c_util/threadapi.h"
+#include "azure_c_logging/xlogging.h"
+#include "clds/clds_hazard_pointers.h"
+#include "clds/clds_flat_hash_table.h"
+
+static TEST_MUTEX_HANDLE test_serialize_mutex;
+
+TEST_DEFINE_ENUM_TYPE(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
+
+typedef struct TEST_ITEM_TAG
+{
+    uint32_t thread_index;
+    uint32_t key_index;
+} TEST_ITEM;
+
+DECLARE_FLAT_HASH_TABLE_NODE_TYPE(TEST_ITEM)
+
+#define THREAD_COUNT        4
+#define KEYS_PER_THREAD     20000
+
+static uint64_t test_compute_hash(void* key)
+{
+    // spread the small integer keys over all the groups and fragments
+    return (uint64_t)key * 0x9E3779B97F4A7C15ULL;
+}
+
+static int test_key_compare(void* key1, void* key2)
+{
+    int result;
+
+    if ((uintptr_t)key1 < (uintptr_t)key2)
+    {
+        result = -1;
+    }
+    else if ((uintptr_t)key1 > (uintptr_t)key2)
+    {
+        result = 1;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+typedef struct TEST_CONTEXT_TAG
+{
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table;
+    volatile LONG inserted_count[KEYS_PER_THREAD];
+} TEST_CONTEXT;
+
+typedef struct THREAD_DATA_TAG
+{
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    THREAD_HANDLE thread_handle;
+    TEST_CONTEXT* test_context;
+    uint32_t thread_index;
+} THREAD_DATA;
+
+// each thread inserts, finds and deletes its own keys, the table starts small so that the groups are rebuilt while the other threads use them
+static int insert_find_delete_thread(void* arg)
+{
+    THREAD_DATA* thread_data = (THREAD_DATA*)arg;
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = thread_data->test_context->flat_hash_table;
+    int result = 0;
+    uint32_t i;
+
+    for (i = 0; i < KEYS_PER_THREAD; i++)
+    {
+        void* key = (void*)(uintptr_t)((thread_data->thread_index * KEYS_PER_THREAD) + i + 1);
+        CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        if (item == NULL)
+        {
+            LogError("Error allocating test item");
+            result = MU_FAILURE;
+            break;
+        }
+        else
+        {
+            TEST_ITEM* test_item = CLDS_FLAT_HASH_TABLE_GET_VALUE(TEST_ITEM, item);
+            test_item->thread_index = thread_data->thread_index;
+            test_item->key_index = i;
+
+            if (clds_flat_hash_table_insert(flat_hash_table, thread_data->clds_hazard_pointers_thread, key, item, NULL) != CLDS_FLAT_HASH_TABLE_INSERT_OK)
+            {
+                LogError("Error inserting");
+                CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+                result = MU_FAILURE;
+                break;
+            }
+        }
+    }
+
+    if (result == 0)
+    {
+        for (i = 0; i < KEYS_PER_THREAD; i++)
+        {
+            void* key = (void*)(uintptr_t)((thread_data->thread_index * KEYS_PER_THREAD) + i + 1);
+            CLDS_FLAT_HASH_TABLE_ITEM* item = clds_flat_hash_table_find(flat_hash_table, thread_data->clds_hazard_pointers_thread, key);
+            if (item == NULL)
+            {
+                LogError("Key %" PRIu32 " of thread %" PRIu32 " not found", i, thread_data->thread_index);
+                result = MU_FAILURE;
+                break;
+            }
+            else
+            {
+                TEST_ITEM* test_item = CLDS_FLAT_HASH_TABLE_GET_VALUE(TEST_ITEM, item);
+                bool is_match = (test_item->thread_index == thread_data->thread_index) && (test_item->key_index == i);
+                CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+
+                if (!is_match)
+                {
+                    LogError("Key %" PRIu32 " of thread %" PRIu32 " found the wrong item", i, thread_data->thread_index);
+                    result = MU_FAILURE;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (result == 0)
+    {
+        for (i = 0; i < KEYS_PER_THREAD; i++)
+        {
+            void* key = (void*)(uintptr_t)((thread_data->thread_index * KEYS_PER_THREAD) + i + 1);
+            if (clds_flat_hash_table_delete(flat_hash_table, thread_data->clds_hazard_pointers_thread, key, NULL) != CLDS_FLAT_HASH_TABLE_DELETE_OK)
+            {
+                LogError("Error deleting");
+                result = MU_FAILURE;
+                break;
+            }
+        }
+    }
+
+    ThreadAPI_Exit(result);
+    return result;
+}
+
+// all threads insert the same keys, only one insert can win for each key
+static int insert_same_keys_thread(void* arg)
+{
+    THREAD_DATA* thread_data = (THREAD_DATA*)arg;
+    TEST_CONTEXT* test_context = thread_data->test_context;
+    int result = 0;
+    uint32_t i;
+
+    for (i = 0; i < KEYS_PER_THREAD; i++)
+    {
+        CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        if (item == NULL)
+        {
+            LogError("Error allocating test item");
+            result = MU_FAILURE;
+            break;
+        }
+        else
+        {
+            CLDS_FLAT_HASH_TABLE_INSERT_RESULT insert_result = clds_flat_hash_table_insert(test_context->flat_hash_table, thread_data->clds_hazard_pointers_thread, (void*)(uintptr_t)(i + 1), item, NULL);
+            if (insert_result == CLDS_FLAT_HASH_TABLE_INSERT_OK)
+            {
+                (void)InterlockedIncrement(&test_context->inserted_count[i]);
+            }
+            else if (insert_result == CLDS_FLAT_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS)
+            {
+                CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+            }
+            else
+            {
+                LogError("Error inserting");
+                CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+                result = MU_FAILURE;
+                break;
+            }
+        }
+    }
+
+    ThreadAPI_Exit(result);
+    return result;
+}
+
+static void run_threads(TEST_CONTEXT* test_context, CLDS_HAZARD_POINTERS_HANDLE hazard_pointers, THREAD_START_FUNC thread_func)
+{
+    THREAD_DATA threads[THREAD_COUNT];
+    size_t i;
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        threads[i].test_context = test_context;
+        threads[i].thread_index = (uint32_t)i;
+        threads[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+        ASSERT_IS_NOT_NULL(threads[i].clds_hazard_pointers_thread);
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Create(&threads[i].thread_handle, thread_func, &threads[i]));
+    }
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        int thread_result;
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Join(threads[i].thread_handle, &thread_result));
+        ASSERT_ARE_EQUAL(int, 0, thread_result, "Thread %zu failed", i);
+        clds_hazard_pointers_unregister_thread(threads[i].clds_hazard_pointers_thread);
+    }
+}
+
+BEGIN_TEST_SUITE(clds_flat_hash_table_inttests)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+TEST_FUNCTION(clds_flat_hash_table_create_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table;
+
+    // act
+    flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare, 1024, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_IS_NOT_NULL(flat_hash_table);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_flat_hash_table_finds_the_inserted_items_across_rebuilds_and_not_the_deleted_ones)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item;
+    uint32_t i;
+    ASSERT_IS_NOT_NULL(flat_hash_table);
+
+    for (i = 0; i < 10000; i++)
+    {
+        item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_IS_NOT_NULL(item);
+        CLDS_FLAT_HASH_TABLE_GET_VALUE(TEST_ITEM, item)->key_index = i;
+        ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)(uintptr_t)(i + 1), item, NULL));
+    }
+
+    // act
+    for (i = 0; i < 10000; i += 2)
+    {
+        ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_OK, clds_flat_hash_table_delete(flat_hash_table, hazard_pointers_thread, (void*)(uintptr_t)(i + 1), NULL));
+    }
+
+    // assert
+    for (i = 0; i < 10000; i++)
+    {
+        item = clds_flat_hash_table_find(flat_hash_table, hazard_pointers_thread, (void*)(uintptr_t)(i + 1));
+        if ((i % 2) == 0)
+        {
+            ASSERT_IS_NULL(item, "Deleted key %" PRIu32 " was found", i);
+        }
+        else
+        {
+            ASSERT_IS_NOT_NULL(item, "Key %" PRIu32 " was not found", i);
+            ASSERT_ARE_EQUAL(uint32_t, i, CLDS_FLAT_HASH_TABLE_GET_VALUE(TEST_ITEM, item)->key_index);
+            CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+        }
+    }
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_106: [ The count of pending write operations shall be split in per processor counters that do not share a cache line, and each write operation shall increment and decrement the counter picked by the processor it started on. ]*/
+TEST_FUNCTION(clds_flat_hash_table_with_multiple_threads_inserting_finding_and_deleting_their_own_keys_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    TEST_CONTEXT* test_context = (TEST_CONTEXT*)malloc(sizeof(TEST_CONTEXT));
+    ASSERT_IS_NOT_NULL(test_context);
+
+    // a small table so that the groups are rebuilt a number of times while all threads are writing
+    test_context->flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(test_context->flat_hash_table);
+
+    // act
+    // assert
+    run_threads(test_context, hazard_pointers, insert_find_delete_thread);
+
+    // cleanup
+    clds_flat_hash_table_destroy(test_context->flat_hash_table);
+    free(test_context);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_flat_hash_table_with_multiple_threads_inserting_the_same_keys_inserts_each_key_exactly_once)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    TEST_CONTEXT* test_context = (TEST_CONTEXT*)malloc(sizeof(TEST_CONTEXT));
+    size_t i;
+    ASSERT_IS_NOT_NULL(test_context);
+
+    (void)memset((void*)test_context->inserted_count, 0, sizeof(test_context->inserted_count));
+    test_context->flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(test_context->flat_hash_table);
+
+    // act
+    run_threads(test_context, hazard_pointers, insert_same_keys_thread);
+
+    // assert
+    for (i = 0; i < KEYS_PER_THREAD; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 1, (int)test_context->inserted_count[i], "Key %zu was inserted %d times", i, (int)test_context->inserted_count[i]);
+    }
+
+    // cleanup
+    clds_flat_hash_table_destroy(test_context->flat_hash_table);
+    free(test_context);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+END_TEST_SUITE(clds_flat_hash_table_inttests)
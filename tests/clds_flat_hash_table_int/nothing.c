@@ -0,0 +1,2 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+int nothing4C553292_5C39_4118_8AC6_62EEB4E366C9 = 0;
\ No newline at end of file
@@ -0,0 +1,16 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_FLAT_HASH_TABLE_PERF_H
+#define CLDS_FLAT_HASH_TABLE_PERF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int clds_flat_hash_table_perf_main(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLDS_FLAT_HASH_TABLE_PERF_H */
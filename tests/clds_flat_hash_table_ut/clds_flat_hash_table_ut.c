@@ -0,0 +1,2152 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cinttypes>
+#include <cstdlib>
+#else
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#endif
+
+#include "azure_macro_utils/macro_utils.h"
+#include "testrunnerswitcher.h"
+
+void* real_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+void real_free(void* ptr)
+{
+    free(ptr);
+}
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umocktypes_stdint.h"
+
+#define ENABLE_MOCKS
+
+#include "azure_c_util/gballoc.h"
+#include "clds/clds_st_hash_set.h"
+#include "clds/clds_hazard_pointers.h"
+
+#undef ENABLE_MOCKS
+
+#include "clds/clds_flat_hash_table.h"
+#include "../reals/real_clds_st_hash_set.h"
+#include "../reals/real_clds_hazard_pointers.h"
+
+static TEST_MUTEX_HANDLE test_serialize_mutex;
+
+TEST_DEFINE_ENUM_TYPE(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, CLDS_FLAT_HASH_TABLE_REMOVE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, CLDS_FLAT_HASH_TABLE_REMOVE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT_VALUES);
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%" PRI_MU_ENUM "", MU_ENUM_VALUE(UMOCK_C_ERROR_CODE, error_code));
+}
+
+MOCK_FUNCTION_WITH_CODE(, void, test_item_cleanup_func, void*, context, struct CLDS_FLAT_HASH_TABLE_ITEM_TAG*, item)
+MOCK_FUNCTION_END()
+
+// the keys used in the tests are small integers, so the hash is the key itself:
+// the low 7 bits are the fragment and the rest picks the home group
+MOCK_FUNCTION_WITH_CODE(, uint64_t, test_compute_hash, void*, key)
+    (void)key;
+MOCK_FUNCTION_END((uint64_t)key)
+
+MOCK_FUNCTION_WITH_CODE(, void, test_skipped_seq_no_cb, void*, context, int64_t, skipped_seq_no)
+MOCK_FUNCTION_END()
+
+static size_t test_key_compare_call_count;
+
+static int test_key_compare_func(void* key_1, void* key_2)
+{
+    int result;
+
+    test_key_compare_call_count++;
+
+    if (key_1 < key_2)
+    {
+        result = -1;
+    }
+    else if (key_1 > key_2)
+    {
+        result = 1;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+typedef struct TEST_ITEM_TAG
+{
+    int dummy;
+} TEST_ITEM;
+
+DECLARE_FLAT_HASH_TABLE_NODE_TYPE(TEST_ITEM)
+
+// an initial size of 7 gives 1 group of 8 slots, the groups are rebuilt when the 8th slot would be used
+#define ONE_GROUP_INITIAL_SIZE 7
+
+BEGIN_TEST_SUITE(clds_flat_hash_table_unittests)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result, "umock_c_init failed");
+
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result, "umocktypes_stdint_register_types failed");
+
+    REGISTER_CLDS_ST_HASH_SET_GLOBAL_MOCK_HOOKS();
+    REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS();
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, real_malloc);
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, real_free);
+
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTER_RECORD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_ST_HASH_SET_COMPUTE_HASH_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_ST_HASH_SET_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_ST_HASH_SET_KEY_COMPARE_FUNC, void*);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+
+    test_key_compare_call_count = 0;
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+/* clds_flat_hash_table_create */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_001: [ clds_flat_hash_table_create shall create a new flat hash table object and on success it shall return a non-NULL handle to the newly created flat hash table. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_007: [ clds_flat_hash_table_create shall allocate an array of groups of 8 slots, with the number of groups being the smallest power of 2 that keeps initial_bucket_size items under 7 out of 8 used slots, all slots being empty. ]*/
+TEST_FUNCTION(clds_flat_hash_table_create_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table;
+    volatile int64_t sequence_number = 45;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, &sequence_number, test_skipped_seq_no_cb, (void*)0x5556);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(flat_hash_table);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_002: [ If any error happens, clds_flat_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_for_the_flat_hash_table_fails_clds_flat_hash_table_create_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(flat_hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_002: [ If any error happens, clds_flat_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_the_groups_fails_clds_flat_hash_table_create_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(flat_hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_003: [ If compute_hash is NULL, clds_flat_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_create_with_NULL_compute_hash_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    flat_hash_table = clds_flat_hash_table_create(NULL, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(flat_hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_004: [ If key_compare_func is NULL, clds_flat_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_create_with_NULL_key_compare_func_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    flat_hash_table = clds_flat_hash_table_create(test_compute_hash, NULL, 1024, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(flat_hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_005: [ If initial_bucket_size is 0, clds_flat_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_create_with_0_initial_bucket_size_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 0, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(flat_hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_006: [ If clds_hazard_pointers is NULL, clds_flat_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_create_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table;
+
+    // act
+    flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, NULL, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(flat_hash_table);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_009: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_010: [ skipped_seq_no_cb shall be allowed to be NULL. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_011: [ skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_create_with_NULL_start_sequence_number_and_NULL_skipped_seq_no_cb_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(flat_hash_table);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_012: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_flat_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_create_with_NULL_start_sequence_number_and_non_NULL_skipped_seq_no_cb_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, test_skipped_seq_no_cb, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(flat_hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_flat_hash_table_destroy */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_013: [ clds_flat_hash_table_destroy shall free all resources associated with the flat hash table instance. ]*/
+TEST_FUNCTION(clds_flat_hash_table_destroy_frees_the_allocated_resources)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // groups
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    // table
+    STRICT_EXPECTED_CALL(free(flat_hash_table));
+
+    // act
+    clds_flat_hash_table_destroy(flat_hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_014: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_destroy shall return. ]*/
+TEST_FUNCTION(clds_flat_hash_table_destroy_with_NULL_handle_returns)
+{
+    // arrange
+
+    // act
+    clds_flat_hash_table_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_015: [ clds_flat_hash_table_destroy shall release the reference held by the table on each item still in the table. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_095: [ When the reference count reaches 0, the item_cleanup_callback passed to clds_flat_hash_table_node_create shall be called with item_cleanup_callback_context and the item, and the item shall be freed. ]*/
+TEST_FUNCTION(clds_flat_hash_table_destroy_with_2_items_frees_the_items_and_triggers_user_cleanup_callback)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, ONE_GROUP_INITIAL_SIZE, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_1 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_2 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(free(item_1));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4243, item_2));
+    STRICT_EXPECTED_CALL(free(item_2));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(flat_hash_table));
+
+    // act
+    clds_flat_hash_table_destroy(flat_hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_096: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the freed item. ]*/
+TEST_FUNCTION(clds_flat_hash_table_destroy_with_NULL_item_cleanup_callback_does_not_trigger_any_callback)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, ONE_GROUP_INITIAL_SIZE, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(item));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(flat_hash_table));
+
+    // act
+    clds_flat_hash_table_destroy(flat_hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_flat_hash_table_set_backoff_policy */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_016: [ clds_flat_hash_table_set_backoff_policy shall set the backoff policy used by all subsequent operations on the table when they have to retry because of a concurrent change and return 0. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_backoff_policy_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_set_backoff_policy(flat_hash_table, CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_017: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_set_backoff_policy shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_backoff_policy_with_NULL_handle_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = clds_flat_hash_table_set_backoff_policy(NULL, CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_018: [ If backoff_policy is not a valid CLDS_BACKOFF_POLICY value, clds_flat_hash_table_set_backoff_policy shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_backoff_policy_with_invalid_policy_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_set_backoff_policy(flat_hash_table, (CLDS_BACKOFF_POLICY)(CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT + 1));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_flat_hash_table_insert */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_028: [ On success clds_flat_hash_table_insert shall return CLDS_FLAT_HASH_TABLE_INSERT_OK. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_034: [ clds_flat_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_flat_hash_table_create. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_037: [ The item shall be put in the table by changing the first never used slot of the probe sequence from NULL to the item with a compare exchange and then setting the control byte of the slot to the fragment of the hash. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // the table is empty, so the first slot probed was never used and no item is looked at
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_035: [ clds_flat_hash_table_insert shall store the key and its hash in value. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_stores_the_key_and_its_hash_in_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x4201, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4201, item->key);
+    ASSERT_ARE_EQUAL(uint64_t, 0x4201, item->hash);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_028: [ On success clds_flat_hash_table_insert shall return CLDS_FLAT_HASH_TABLE_INSERT_OK. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_023: [ An item with a different hash than the key shall be skipped without calling key_compare_func. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_with_the_same_fragment_and_a_different_hash_succeeds_without_comparing_keys)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, ONE_GROUP_INITIAL_SIZE, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_1 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_2 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    umock_c_reset_all_calls();
+
+    // 0x1 and 0x81 have the same fragment, so item_1 is looked at, but not compared
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x81));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x81, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_key_compare_call_count);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_107: [ The high 32 bits of the hash of the item shall be kept in the group next to its slot, and they shall be stored before the control byte of the slot is set to the fragment. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_108: [ A slot whose control byte is not the empty marker and whose kept hash bits are different than the ones of the key shall be skipped without acquiring a hazard pointer and without looking at its item. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_with_the_same_fragment_and_different_high_hash_bits_does_not_look_at_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, ONE_GROUP_INITIAL_SIZE, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_1 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_2 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    umock_c_reset_all_calls();
+
+    // the 2 hashes have the same fragment and home group, but different high 32 bits
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2))
+        .SetReturn(0x100000001);
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_key_compare_call_count);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_022: [ The control bytes of a group shall be matched against the fragment of the key and against the empty marker 8 at a time with 64-bit integer operations, and only the slots with a matching control byte shall be looked at. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_does_not_look_at_items_with_a_different_fragment)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, ONE_GROUP_INITIAL_SIZE, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_1 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_2 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_3 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_029: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_with_NULL_flat_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_insert(NULL, hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_030: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_with_NULL_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, NULL, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_031: [ If key is NULL, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, NULL, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_032: [ If value is NULL, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_with_NULL_value_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_033: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_flat_hash_table_create, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_with_non_NULL_sequence_number_and_no_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_036: [ If the key already exists in the table, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_024: [ An item shall only be looked at while protected by a hazard pointer acquired with clds_hazard_pointers_acquire, and only if after acquiring it the slot still holds the item and the array of groups is still the current one. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_with_an_existing_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_1 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_2 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_key_compare_call_count);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_025: [ If acquiring a hazard pointer fails, the operation shall fail and return its ERROR result, or NULL for clds_flat_hash_table_find. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_040: [ If any error occurs, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(when_acquiring_the_hazard_pointer_fails_clds_flat_hash_table_insert_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_1 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_2 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1))
+        .SetReturn(NULL);
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_008: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every attempt of a write operation to publish its change. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_055: [ If a start sequence number was given to clds_flat_hash_table_create, the sequence number shall be incremented right before the compare exchange publishing the change and on success stored in sequence_number if sequence_number is not NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_increments_the_sequence_number)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile int64_t sequence_number = 42;
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, &sequence_number, test_skipped_seq_no_cb, (void*)0x5556);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_1 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_2 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    int64_t insert_seq_no_1 = 0;
+    int64_t insert_seq_no_2 = 0;
+    umock_c_reset_all_calls();
+
+    // act
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_1, &insert_seq_no_1));
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x2, item_2, &insert_seq_no_2));
+
+    // assert
+    ASSERT_ARE_EQUAL(int64_t, 43, insert_seq_no_1);
+    ASSERT_ARE_EQUAL(int64_t, 44, insert_seq_no_2);
+    ASSERT_ARE_EQUAL(int64_t, 44, sequence_number);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_039: [ If putting the item in the table would make more than 7 out of 8 slots used by items or tombstones, the groups shall be rebuilt and the operation shall be retried. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_044: [ The items shall be placed in the new array of groups by using the hash stored in each item, without calling compute_hash, and the tombstones shall be dropped. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_046: [ The new array of groups shall replace the old one and the old one shall be released by calling clds_hazard_pointers_reclaim, since readers might still be looking at it. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_of_the_8th_item_in_a_group_rebuilds_the_groups)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, ONE_GROUP_INITIAL_SIZE, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item;
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    uintptr_t i;
+
+    for (i = 1; i <= 7; i++)
+    {
+        item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)i, item, NULL));
+    }
+
+    item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x8));
+    // new groups
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    // old groups
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x8, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, result);
+
+    for (i = 1; i <= 8; i++)
+    {
+        item = clds_flat_hash_table_find(flat_hash_table, hazard_pointers_thread, (void*)i);
+        ASSERT_IS_NOT_NULL(item, "Item %" PRIuPTR " not found after rebuild", i);
+        CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    }
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_055: [ If a start sequence number was given to clds_flat_hash_table_create, the sequence number shall be incremented right before the compare exchange publishing the change and on success stored in sequence_number if sequence_number is not NULL. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_105: [ If the compare exchange publishing the change fails or the item cannot be put in a slot, the sequence number taken for it shall be reported by calling skipped_seq_no_cb with skipped_seq_no_cb_context and the sequence number. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_that_rebuilds_the_groups_reports_the_sequence_number_of_the_first_attempt_as_skipped)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile int64_t sequence_number = 42;
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, ONE_GROUP_INITIAL_SIZE, hazard_pointers, &sequence_number, test_skipped_seq_no_cb, (void*)0x5556);
+    CLDS_FLAT_HASH_TABLE_ITEM* item;
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    int64_t insert_seq_no = 0;
+    uintptr_t i;
+
+    for (i = 1; i <= 7; i++)
+    {
+        item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)i, item, NULL));
+    }
+
+    item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x8));
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb((void*)0x5556, 50));
+    // new groups
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    // old groups
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x8, item, &insert_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 51, insert_seq_no);
+    ASSERT_ARE_EQUAL(int64_t, 51, sequence_number);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_045: [ If allocating the new array of groups fails, the operation that needed it shall fail and return its ERROR result. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_040: [ If any error occurs, clds_flat_hash_table_insert shall fail and return CLDS_FLAT_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(when_allocating_the_new_groups_fails_clds_flat_hash_table_insert_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, ONE_GROUP_INITIAL_SIZE, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item;
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    uintptr_t i;
+
+    for (i = 1; i <= 7; i++)
+    {
+        item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)i, item, NULL));
+    }
+
+    item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x8));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x8, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* clds_flat_hash_table_delete */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_056: [ clds_flat_hash_table_delete shall delete the item with the key key from the table and return CLDS_FLAT_HASH_TABLE_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_050: [ clds_flat_hash_table_delete, clds_flat_hash_table_delete_key_value and clds_flat_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_flat_hash_table_create. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_052: [ The item shall be taken out of the table by changing its slot to a tombstone with a compare exchange and setting the control byte of the slot to the deleted marker, the slot shall not be used again until the groups are rebuilt. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_054: [ The reference held by the table on the item shall be released by calling clds_hazard_pointers_reclaim. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_deletes_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    result = clds_flat_hash_table_delete(flat_hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_OK, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_052: [ The item shall be taken out of the table by changing its slot to a tombstone with a compare exchange and setting the control byte of the slot to the deleted marker, the slot shall not be used again until the groups are rebuilt. ]*/
+TEST_FUNCTION(clds_flat_hash_table_insert_after_delete_of_the_same_key_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_1 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_2 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* found_item;
+    CLDS_FLAT_HASH_TABLE_INSERT_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_flat_hash_table_delete(flat_hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+    umock_c_reset_all_calls();
+
+    // the tombstone left by the delete is skipped, no item is looked at
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
+    // act
+    result = clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_INSERT_RESULT, CLDS_FLAT_HASH_TABLE_INSERT_OK, result);
+    found_item = clds_flat_hash_table_find(flat_hash_table, hazard_pointers_thread, (void*)0x1);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, found_item);
+
+    // cleanup
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_051: [ If the key is not found, clds_flat_hash_table_delete, clds_flat_hash_table_delete_key_value and clds_flat_hash_table_remove shall return their respective NOT_FOUND result. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_with_a_key_that_is_not_in_the_table_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
+    // act
+    result = clds_flat_hash_table_delete(flat_hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_051: [ If the key is not found, clds_flat_hash_table_delete, clds_flat_hash_table_delete_key_value and clds_flat_hash_table_remove shall return their respective NOT_FOUND result. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_of_an_already_deleted_key_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    (void)clds_flat_hash_table_delete(flat_hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
+    // act
+    result = clds_flat_hash_table_delete(flat_hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_057: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_delete shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_with_NULL_flat_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_delete(NULL, hazard_pointers_thread, (void*)0x1, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_058: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_delete shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_with_NULL_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_delete(flat_hash_table, NULL, (void*)0x1, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_059: [ If key is NULL, clds_flat_hash_table_delete shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_delete(flat_hash_table, hazard_pointers_thread, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_060: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_flat_hash_table_create, clds_flat_hash_table_delete shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_with_non_NULL_sequence_number_and_no_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_delete(flat_hash_table, hazard_pointers_thread, (void*)0x1, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_055: [ If a start sequence number was given to clds_flat_hash_table_create, the sequence number shall be incremented right before the compare exchange publishing the change and on success stored in sequence_number if sequence_number is not NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_increments_the_sequence_number)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile int64_t sequence_number = 42;
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    int64_t delete_seq_no = 0;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_delete(flat_hash_table, hazard_pointers_thread, (void*)0x1, &delete_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 44, delete_seq_no);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_flat_hash_table_delete_key_value */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_061: [ clds_flat_hash_table_delete_key_value shall delete the item with the key key from the table only if the item is value and return CLDS_FLAT_HASH_TABLE_DELETE_OK. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_key_value_deletes_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    result = clds_flat_hash_table_delete_key_value(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_OK, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_067: [ If the item in the table for key is not value, clds_flat_hash_table_delete_key_value shall return CLDS_FLAT_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_key_value_with_a_different_value_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_1 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_2 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_table_delete_key_value(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_062: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_delete_key_value shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_key_value_with_NULL_flat_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_delete_key_value(NULL, hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_063: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_delete_key_value shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_key_value_with_NULL_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_delete_key_value(flat_hash_table, NULL, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_064: [ If key is NULL, clds_flat_hash_table_delete_key_value shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_key_value_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_delete_key_value(flat_hash_table, hazard_pointers_thread, NULL, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_065: [ If value is NULL, clds_flat_hash_table_delete_key_value shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_key_value_with_NULL_value_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_delete_key_value(flat_hash_table, hazard_pointers_thread, (void*)0x1, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_flat_hash_table_create, clds_flat_hash_table_delete_key_value shall fail and return CLDS_FLAT_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_delete_key_value_with_non_NULL_sequence_number_and_no_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_DELETE_RESULT result;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_delete_key_value(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_DELETE_RESULT, CLDS_FLAT_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* clds_flat_hash_table_remove */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_068: [ clds_flat_hash_table_remove shall take the item with the key key out of the table and return CLDS_FLAT_HASH_TABLE_REMOVE_OK. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_069: [ clds_flat_hash_table_remove shall return the removed item in item with its reference count incremented. ]*/
+TEST_FUNCTION(clds_flat_hash_table_remove_removes_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_FLAT_HASH_TABLE_ITEM* removed_item;
+    CLDS_FLAT_HASH_TABLE_REMOVE_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    // the caller holds a reference, so the item is not freed
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_table_remove(flat_hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, CLDS_FLAT_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item, removed_item);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_051: [ If the key is not found, clds_flat_hash_table_delete, clds_flat_hash_table_delete_key_value and clds_flat_hash_table_remove shall return their respective NOT_FOUND result. ]*/
+TEST_FUNCTION(clds_flat_hash_table_remove_with_a_key_that_is_not_in_the_table_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* removed_item;
+    CLDS_FLAT_HASH_TABLE_REMOVE_RESULT result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
+    // act
+    result = clds_flat_hash_table_remove(flat_hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, CLDS_FLAT_HASH_TABLE_REMOVE_NOT_FOUND, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_070: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_remove shall fail and return CLDS_FLAT_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_remove_with_NULL_flat_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_ITEM* removed_item;
+    CLDS_FLAT_HASH_TABLE_REMOVE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_remove(NULL, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, CLDS_FLAT_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_071: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_remove shall fail and return CLDS_FLAT_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_remove_with_NULL_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* removed_item;
+    CLDS_FLAT_HASH_TABLE_REMOVE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_remove(flat_hash_table, NULL, (void*)0x1, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, CLDS_FLAT_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_072: [ If key is NULL, clds_flat_hash_table_remove shall fail and return CLDS_FLAT_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_remove_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* removed_item;
+    CLDS_FLAT_HASH_TABLE_REMOVE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_remove(flat_hash_table, hazard_pointers_thread, NULL, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, CLDS_FLAT_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_073: [ If item is NULL, clds_flat_hash_table_remove shall fail and return CLDS_FLAT_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_remove_with_NULL_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_REMOVE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_remove(flat_hash_table, hazard_pointers_thread, (void*)0x1, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, CLDS_FLAT_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_074: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_flat_hash_table_create, clds_flat_hash_table_remove shall fail and return CLDS_FLAT_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_remove_with_non_NULL_sequence_number_and_no_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* removed_item;
+    CLDS_FLAT_HASH_TABLE_REMOVE_RESULT result;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_remove(flat_hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_REMOVE_RESULT, CLDS_FLAT_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_flat_hash_table_set_value */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_075: [ On success clds_flat_hash_table_set_value shall return CLDS_FLAT_HASH_TABLE_SET_VALUE_OK. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_082: [ clds_flat_hash_table_set_value shall hash the key by calling the compute_hash function passed to clds_flat_hash_table_create and store the key and its hash in new_item. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_084: [ If the key is not in the table, clds_flat_hash_table_set_value shall put new_item in the table the same way clds_flat_hash_table_insert does and set old_item to NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_value_with_a_new_key_inserts_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* old_item = (CLDS_FLAT_HASH_TABLE_ITEM*)0x4242;
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
+    // act
+    result = clds_flat_hash_table_set_value(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_IS_NULL(old_item);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x1, item->key);
+    ASSERT_ARE_EQUAL(uint64_t, 0x1, item->hash);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_075: [ On success clds_flat_hash_table_set_value shall return CLDS_FLAT_HASH_TABLE_SET_VALUE_OK. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_083: [ If the key is in the table, clds_flat_hash_table_set_value shall replace the item in its slot with new_item with a compare exchange, return the replaced item in old_item with its reference count incremented and release the reference held by the table on the replaced item by calling clds_hazard_pointers_reclaim. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_value_with_an_existing_key_replaces_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_1 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_2 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* old_item;
+    CLDS_FLAT_HASH_TABLE_ITEM* found_item;
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    // the caller holds a reference to the old item, so it is not freed
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_table_set_value(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_2, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, old_item);
+    found_item = clds_flat_hash_table_find(flat_hash_table, hazard_pointers_thread, (void*)0x1);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, found_item);
+
+    // cleanup
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, old_item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_055: [ If a start sequence number was given to clds_flat_hash_table_create, the sequence number shall be incremented right before the compare exchange publishing the change and on success stored in sequence_number if sequence_number is not NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_value_increments_the_sequence_number)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile int64_t sequence_number = 42;
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* old_item;
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no = 0;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_set_value(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, &old_item, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 43, set_value_seq_no);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_076: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_value_with_NULL_flat_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* old_item;
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_set_value(NULL, hazard_pointers_thread, (void*)0x1, item, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_077: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_value_with_NULL_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* old_item;
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_set_value(flat_hash_table, NULL, (void*)0x1, item, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_078: [ If key is NULL, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_value_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* old_item;
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_set_value(flat_hash_table, hazard_pointers_thread, NULL, item, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_079: [ If new_item is NULL, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_value_with_NULL_new_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* old_item;
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_set_value(flat_hash_table, hazard_pointers_thread, (void*)0x1, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_080: [ If old_item is NULL, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_value_with_NULL_old_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_set_value(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_081: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_flat_hash_table_create, clds_flat_hash_table_set_value shall fail and return CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_flat_hash_table_set_value_with_non_NULL_sequence_number_and_no_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* old_item;
+    CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_set_value(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, &old_item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT, CLDS_FLAT_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* clds_flat_hash_table_find */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_087: [ clds_flat_hash_table_find shall return the item with the key key with its reference count incremented. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_092: [ clds_flat_hash_table_find shall hash the key by calling the compute_hash function passed to clds_flat_hash_table_create. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_094: [ clds_flat_hash_table_find shall protect the array of groups it looks at by calling clds_hazard_pointers_acquire, since the groups can be rebuilt while it looks at them. ]*/
+TEST_FUNCTION(clds_flat_hash_table_find_finds_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    // groups
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_table_find(flat_hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, item, result);
+
+    // cleanup
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_087: [ clds_flat_hash_table_find shall return the item with the key key with its reference count incremented. ]*/
+TEST_FUNCTION(clds_flat_hash_table_find_finds_each_of_the_items_sharing_a_fragment)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, ONE_GROUP_INITIAL_SIZE, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_1 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item_2 = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* result_1;
+    CLDS_FLAT_HASH_TABLE_ITEM* result_2;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x81, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result_1 = clds_flat_hash_table_find(flat_hash_table, hazard_pointers_thread, (void*)0x1);
+    result_2 = clds_flat_hash_table_find(flat_hash_table, hazard_pointers_thread, (void*)0x81);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, item_1, result_1);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, result_2);
+    // only the item with the same hash as the key is compared
+    ASSERT_ARE_EQUAL(size_t, 2, test_key_compare_call_count);
+
+    // cleanup
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result_1);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result_2);
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_091: [ If the key is not found, clds_flat_hash_table_find shall return NULL. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_093: [ clds_flat_hash_table_find shall not wait for write operations or for the groups to be rebuilt. ]*/
+TEST_FUNCTION(clds_flat_hash_table_find_with_a_key_that_is_not_in_the_table_returns_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_table_find(flat_hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_025: [ If acquiring a hazard pointer fails, the operation shall fail and return its ERROR result, or NULL for clds_flat_hash_table_find. ]*/
+TEST_FUNCTION(when_acquiring_the_hazard_pointer_on_the_groups_fails_clds_flat_hash_table_find_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = clds_flat_hash_table_find(flat_hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_025: [ If acquiring a hazard pointer fails, the operation shall fail and return its ERROR result, or NULL for clds_flat_hash_table_find. ]*/
+TEST_FUNCTION(when_acquiring_the_hazard_pointer_on_the_item_fails_clds_flat_hash_table_find_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* result;
+    (void)clds_flat_hash_table_insert(flat_hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_flat_hash_table_find(flat_hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_088: [ If clds_flat_hash_table is NULL, clds_flat_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_find_with_NULL_flat_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_ITEM* result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_find(NULL, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_089: [ If clds_hazard_pointers_thread is NULL, clds_flat_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_find_with_NULL_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_find(flat_hash_table, NULL, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_090: [ If key is NULL, clds_flat_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_find_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_FLAT_HASH_TABLE_HANDLE flat_hash_table = clds_flat_hash_table_create(test_compute_hash, test_key_compare_func, 1024, hazard_pointers, NULL, NULL, NULL);
+    CLDS_FLAT_HASH_TABLE_ITEM* result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_flat_hash_table_find(flat_hash_table, hazard_pointers_thread, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_flat_hash_table_destroy(flat_hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_flat_hash_table_node_create */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_099: [ clds_flat_hash_table_node_create shall allocate node_size bytes for the node and set its reference count to 1. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_097: [ item_cleanup_callback shall be allowed to be NULL. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_098: [ item_cleanup_callback_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_flat_hash_table_node_create_with_NULL_item_cleanup_callback_succeeds)
+{
+    // arrange
+    CLDS_FLAT_HASH_TABLE_ITEM* item;
+
+    STRICT_EXPECTED_CALL(malloc(sizeof(FLAT_HASH_TABLE_NODE_TEST_ITEM)));
+
+    // act
+    item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(item);
+
+    // cleanup
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_100: [ If allocating memory fails, clds_flat_hash_table_node_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_clds_flat_hash_table_node_create_fails)
+{
+    // arrange
+    CLDS_FLAT_HASH_TABLE_ITEM* item;
+
+    STRICT_EXPECTED_CALL(malloc(sizeof(FLAT_HASH_TABLE_NODE_TEST_ITEM)))
+        .SetReturn(NULL);
+
+    // act
+    item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(item);
+}
+
+/* clds_flat_hash_table_node_inc_ref */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_101: [ clds_flat_hash_table_node_inc_ref shall increment the reference count of item and return 0. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_104: [ clds_flat_hash_table_node_release shall decrement the reference count of item. ]*/
+TEST_FUNCTION(clds_flat_hash_table_node_inc_ref_keeps_the_item_alive_until_the_last_release)
+{
+    // arrange
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = CLDS_FLAT_HASH_TABLE_NODE_INC_REF(TEST_ITEM, item);
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_102: [ If item is NULL, clds_flat_hash_table_node_inc_ref shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_flat_hash_table_node_inc_ref_with_NULL_item_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = clds_flat_hash_table_node_inc_ref(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* clds_flat_hash_table_node_release */
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_104: [ clds_flat_hash_table_node_release shall decrement the reference count of item. ]*/
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_095: [ When the reference count reaches 0, the item_cleanup_callback passed to clds_flat_hash_table_node_create shall be called with item_cleanup_callback_context and the item, and the item shall be freed. ]*/
+TEST_FUNCTION(clds_flat_hash_table_node_release_of_the_last_reference_frees_the_item)
+{
+    // arrange
+    CLDS_FLAT_HASH_TABLE_ITEM* item = CLDS_FLAT_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    CLDS_FLAT_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_FLAT_HASH_TABLE_01_103: [ If item is NULL, clds_flat_hash_table_node_release shall return. ]*/
+TEST_FUNCTION(clds_flat_hash_table_node_release_with_NULL_item_returns)
+{
+    // arrange
+
+    // act
+    clds_flat_hash_table_node_release(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+END_TEST_SUITE(clds_flat_hash_table_unittests)
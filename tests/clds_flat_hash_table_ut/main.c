@@ -0,0 +1,11 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include "testrunnerswitcher.h"
+
+int main(void)
+{
+    size_t failedTestCount = 0;
+    RUN_TEST_SUITE(clds_flat_hash_table_unittests, failedTestCount);
+    return failedTestCount;
+}
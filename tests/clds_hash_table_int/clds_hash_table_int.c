@@ -28,6 +28,7 @@ TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESU
 TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_CHANGE_TYPE, CLDS_HASH_TABLE_CHANGE_TYPE_VALUES);
 TEST_DEFINE_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
 
 #define THREAD_COUNT 4
@@ -338,6 +339,31 @@ static int continuous_find_thread(void* arg)
 
 
 
+// many more threads than cores, so that inserters get preempted while other inserters wait for them
+#define OVERSUBSCRIBED_THREAD_COUNT 64
+#define OVERSUBSCRIBED_INSERT_COUNT 2000
+
+static int fixed_count_insert_thread(void* arg)
+{
+    THREAD_DATA* thread_data = (THREAD_DATA*)arg;
+    int result;
+    uint32_t i;
+
+    for (i = 0; i < OVERSUBSCRIBED_INSERT_COUNT; i++)
+    {
+        uint32_t key = thread_data->key + (i * thread_data->increment);
+        CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_IS_NOT_NULL(item);
+        CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, item)->key = key;
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, (void*)(INT_PTR)(key + 1), item, NULL));
+    }
+
+    result = 0;
+
+    ThreadAPI_Exit(result);
+    return result;
+}
+
 static void fill_hash_table_sequentially(CLDS_HASH_TABLE_HANDLE hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread, uint32_t count)
 {
     for (uint32_t i = 0; i < count; i++)
@@ -446,6 +472,33 @@ static void cleanup_snapshot(CLDS_HASH_TABLE_ITEM** items, uint64_t item_count)
     free(items);
 }
 
+typedef struct COLLECT_VISITED_ITEMS_CONTEXT_TAG
+{
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    uint64_t capacity;
+} COLLECT_VISITED_ITEMS_CONTEXT;
+
+static bool collect_visited_item(void* context, CLDS_HASH_TABLE_ITEM* item)
+{
+    COLLECT_VISITED_ITEMS_CONTEXT* collect_context = (COLLECT_VISITED_ITEMS_CONTEXT*)context;
+    bool result;
+
+    if (collect_context->item_count == collect_context->capacity)
+    {
+        result = false;
+    }
+    else
+    {
+        // the item is only guaranteed to be alive during the call, keep it by taking a reference
+        ASSERT_ARE_EQUAL(int, 0, clds_hash_table_node_inc_ref(item));
+        collect_context->items[collect_context->item_count++] = item;
+        result = true;
+    }
+
+    return result;
+}
+
 typedef struct CHAOS_TEST_ITEM_DATA_TAG
 {
     CLDS_HASH_TABLE_ITEM* item;
@@ -769,9 +822,86 @@ TEST_FUNCTION(clds_hash_table_snapshot_works_with_10000_sequential_key_items)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* Tests_SRS_CLDS_HASH_TABLE_01_189: [ For each phase, clds_hash_table_snapshot_parallel shall start thread_count - 1 worker threads with ThreadAPI_Create, run the worker with index 0 on the calling thread and wait for the worker threads with ThreadAPI_Join. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_190: [ Each array of buckets shall be split in thread_count ranges of consecutive buckets of about the same size, the range with index i being processed by the worker with index i using clds_hazard_pointers_threads[i]. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_198: [ clds_hash_table_snapshot_parallel shall store the array of items in items (NULL if there are no items) and the count of items in item_count, succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_parallel_works_with_10000_sequential_key_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_threads[THREAD_COUNT];
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        hazard_pointers_threads[i] = clds_hazard_pointers_register_thread(hazard_pointers);
+        ASSERT_IS_NOT_NULL(hazard_pointers_threads[i]);
+    }
+    volatile int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_threads[0], original_count);
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_parallel(hash_table, hazard_pointers_threads, THREAD_COUNT, &items, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    verify_all_items_present(original_count, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_177: [ clds_hash_table_snapshot_visit shall lock the table for writes and wait for the ongoing write operations to complete. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_178: [ For each sorted list in each array of buckets, clds_hash_table_snapshot_visit shall call clds_sorted_list_visit. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_179: [ clds_hash_table_snapshot_visit shall call visit_cb with visit_cb_context for each visited item, without taking a reference on it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_183: [ Otherwise clds_hash_table_snapshot_visit shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_visit_works_with_10000_sequential_key_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    COLLECT_VISITED_ITEMS_CONTEXT collect_context;
+    collect_context.capacity = original_count;
+    collect_context.item_count = 0;
+    collect_context.items = (CLDS_HASH_TABLE_ITEM**)malloc(sizeof(CLDS_HASH_TABLE_ITEM*) * original_count);
+    ASSERT_IS_NOT_NULL(collect_context.items);
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_visit(hash_table, hazard_pointers_thread, collect_visited_item, &collect_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    verify_all_items_present(original_count, collect_context.items, collect_context.item_count);
+
+    // cleanup
+    cleanup_snapshot(collect_context.items, collect_context.item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 /* Tests_SRS_CLDS_HASH_TABLE_42_017: [ clds_hash_table_snapshot shall increment a counter to lock the table for writes. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_42_018: [ clds_hash_table_snapshot shall wait for the ongoing write operations to complete. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_42_030: [ clds_hash_table_snapshot shall decrement the counter to unlock the table for writes. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_156: [ The count of pending write operations shall be split in per processor counters that do not share a cache line, and each write operation shall increment and decrement the counter picked by the processor it started on. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_157: [ Write operations shall call clds_backoff_wake_all for the count of pending write operations only if the counter to lock the table for writes is non-zero. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_158: [ clds_hash_table_snapshot shall call clds_backoff_wake_all for the counter to lock the table for writes only if there are write operations waiting for the table to be unlocked. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_42_032: [ clds_hash_table_insert shall try the following until it acquires a write lock for the table: ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_42_033: [ clds_hash_table_insert shall increment the count of pending write operations. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_42_034: [ If the counter to lock the table for writes is non-zero then: ]*/
@@ -1289,6 +1419,266 @@ TEST_FUNCTION(clds_hash_table_snapshot_works_with_multiple_concurrent_find)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* Tests_SRS_CLDS_HASH_TABLE_01_165: [ For each sorted list in each array of buckets, clds_hash_table_snapshot_concurrent shall call clds_sorted_list_visit and add to the snapshot each visited item that was put in the table at or before the snapshot generation and was not yet added to the snapshot. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_168: [ clds_hash_table_insert and clds_hash_table_set_value shall stamp the item they put in the table with the current generation of the table. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_169: [ While a snapshot taken with clds_hash_table_snapshot_concurrent is running, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove, clds_hash_table_set_value and the migration of items shall add each item they take out of the table to the snapshot, if the item was in the table when the snapshot started and was not yet added to it. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_returns_exactly_one_item_per_key_with_multiple_concurrent_set_value)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore /*This is noisy with set_value*/, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    // Start threads to set value on th existing items
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+
+    THREAD_DATA set_thread_data[THREAD_COUNT];
+    THREAD_HANDLE set_thread[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)InterlockedExchange(&shared[i].last_written_key, original_count - 1);
+
+        initialize_thread_data(&set_thread_data[i], &shared[i], hash_table, hazard_pointers, i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&set_thread[i], continuous_set_value_thread, &set_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning set value test thread %" PRIu32, i);
+        }
+    }
+
+    // Make sure set value has started
+    ThreadAPI_Sleep(1000);
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, hazard_pointers_thread, &items, &item_count);
+
+    // Set value continues to run a bit longer to make sure we are in a good state
+    ThreadAPI_Sleep(1000);
+
+    // Stop set value
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)InterlockedExchange(&set_thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(set_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    verify_all_items_present(original_count, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_165: [ For each sorted list in each array of buckets, clds_hash_table_snapshot_concurrent shall call clds_sorted_list_visit and add to the snapshot each visited item that was put in the table at or before the snapshot generation and was not yet added to the snapshot. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_168: [ clds_hash_table_insert and clds_hash_table_set_value shall stamp the item they put in the table with the current generation of the table. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_169: [ While a snapshot taken with clds_hash_table_snapshot_concurrent is running, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove, clds_hash_table_set_value and the migration of items shall add each item they take out of the table to the snapshot, if the item was in the table when the snapshot started and was not yet added to it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_170: [ While a snapshot taken with clds_hash_table_snapshot_concurrent is running, clds_hash_table_delete shall call clds_sorted_list_remove_key instead of clds_sorted_list_delete_key and release the removed item after adding it to the snapshot. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_concurrent_works_with_multiple_concurrent_deletes)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    // Write additional items that will get deleted
+    uint32_t original_count = 10000;
+    uint32_t next_insert = original_count + 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, next_insert);
+
+    // Start threads to insert additional items and delete
+    THREAD_DATA insert_thread_data[THREAD_COUNT];
+    THREAD_HANDLE insert_thread[THREAD_COUNT];
+
+    SHARED_KEY_INFO shared[THREAD_COUNT];
+
+    THREAD_DATA delete_thread_data[THREAD_COUNT];
+    THREAD_HANDLE delete_thread[THREAD_COUNT];
+
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)InterlockedExchange(&shared[i].last_written_key, next_insert - 1);
+
+        initialize_thread_data(&insert_thread_data[i], &shared[i], hash_table, hazard_pointers, next_insert + i, THREAD_COUNT);
+
+        initialize_thread_data(&delete_thread_data[i], &shared[i], hash_table, hazard_pointers, next_insert + i, THREAD_COUNT);
+
+        if (ThreadAPI_Create(&insert_thread[i], continuous_insert_thread, &insert_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning insert test thread %" PRIu32, i);
+        }
+
+        if (ThreadAPI_Create(&delete_thread[i], continuous_delete_thread, &delete_thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning delete test thread %" PRIu32, i);
+        }
+    }
+
+    // Make sure inserts and deletes have started
+    ThreadAPI_Sleep(1000);
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_concurrent(hash_table, hazard_pointers_thread, &items, &item_count);
+
+    // Inserts and deletes continue to run a bit longer to make sure we are in a good state
+    ThreadAPI_Sleep(1000);
+
+    // Stop inserts
+    for (uint32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        (void)InterlockedExchange(&delete_thread_data[i].stop, 1);
+        (void)InterlockedExchange(&insert_thread_data[i].stop, 1);
+
+        int thread_result;
+        (void)ThreadAPI_Join(delete_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+
+        (void)ThreadAPI_Join(insert_thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    verify_all_items_present_ignore_extras(original_count, items, item_count);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_213: [ clds_hash_table_snapshot_at_current_sequence_number shall lock the table for writes and take the last sequence number used by the table as the snapshot sequence number. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_215: [ For each sorted list in each array of buckets, clds_hash_table_snapshot_at_current_sequence_number shall call clds_sorted_list_visit and capture each visited item that was put in the table at or before the snapshot sequence number and was not yet captured. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_216: [ clds_hash_table_snapshot_at_current_sequence_number shall then lock the table for writes, stop capturing items and unlock the table for writes. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_218: [ clds_hash_table_snapshot_at_current_sequence_number shall keep in the snapshot only the captured items that were put in the table at or before the snapshot sequence number and not taken out at or before it, and release the other captured items. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_current_sequence_number_works_with_10000_sequential_key_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    uint32_t original_count = 10000;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t snapshot_sequence_number;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_current_sequence_number(hash_table, hazard_pointers_thread, &items, &item_count, &snapshot_sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, sequence_number, snapshot_sequence_number);
+    verify_all_items_present(original_count, items, item_count);
+
+    // the next write operation comes after the snapshot
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    ASSERT_IS_NOT_NULL(item);
+    int64_t insert_seq_no;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(INT_PTR)(original_count + 1), item, &insert_seq_no));
+    ASSERT_ARE_EQUAL(int64_t, snapshot_sequence_number + 1, insert_seq_no);
+
+    // cleanup
+    cleanup_snapshot(items, item_count);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hash_table_snapshot_since_returns_the_changes_done_to_10000_sequential_key_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    volatile int64_t sequence_number = 45;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_ignore, (void*)0x5556);
+    ASSERT_IS_NOT_NULL(hash_table);
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_change_log_enabled(hash_table, true));
+
+    int64_t start_sequence_number = sequence_number;
+    uint32_t original_count = 10000;
+    uint32_t delete_count = 100;
+    fill_hash_table_sequentially(hash_table, hazard_pointers_thread, original_count);
+
+    CLDS_HASH_TABLE_CHANGE* changes;
+    uint64_t change_count;
+    int64_t last_sequence_number;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_since(hash_table, hazard_pointers_thread, start_sequence_number, &changes, &change_count, &last_sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, original_count, change_count);
+    ASSERT_ARE_EQUAL(int64_t, sequence_number, last_sequence_number);
+    for (uint64_t i = 0; i < change_count; i++)
+    {
+        // the keys were inserted in order, one sequence number each
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_CHANGE_TYPE, CLDS_HASH_TABLE_CHANGE_INSERT, changes[i].change_type);
+        ASSERT_ARE_EQUAL(int64_t, start_sequence_number + (int64_t)i + 1, changes[i].sequence_number);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(INT_PTR)(i + 1), changes[i].key);
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, changes[i].item);
+    }
+    free(changes);
+
+    // only the deletes come after the last sequence number returned
+    int64_t previous_last_sequence_number = last_sequence_number;
+    for (uint32_t i = 0; i < delete_count; i++)
+    {
+        int64_t delete_seq_no;
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)(INT_PTR)(i + 1), &delete_seq_no));
+    }
+
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, clds_hash_table_snapshot_since(hash_table, hazard_pointers_thread, previous_last_sequence_number, &changes, &change_count, &last_sequence_number));
+    ASSERT_ARE_EQUAL(uint64_t, delete_count, change_count);
+    for (uint64_t i = 0; i < change_count; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_CHANGE_TYPE, CLDS_HASH_TABLE_CHANGE_DELETE, changes[i].change_type);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(INT_PTR)(i + 1), changes[i].key);
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, changes[i].item);
+    }
+    free(changes);
+
+    // once trimmed the older changes cannot be returned anymore
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_trim_change_log(hash_table, previous_last_sequence_number));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_SEQ_NO_TOO_OLD, clds_hash_table_snapshot_since(hash_table, hazard_pointers_thread, start_sequence_number, &changes, &change_count, &last_sequence_number));
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 TEST_FUNCTION(clds_hash_table_set_value_with_the_same_value_succeeds_with_initial_bucket_size_1)
 {
     // arrange
@@ -1407,6 +1797,56 @@ TEST_FUNCTION(clds_hash_table_set_value_with_same_item_after_bucket_count_increa
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* Tests_SRS_CLDS_HASH_TABLE_01_125: [ While waiting for the pending inserts in the lower level bucket arrays to complete, clds_hash_table_insert and clds_hash_table_set_value shall call clds_backoff_wait_while_equal with a backoff state initialized with the backoff policy of the hash table (CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT if the backoff policy is CLDS_BACKOFF_POLICY_NONE) and the pending insert count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_126: [ If the pending insert count reaches 0 and there are threads waiting for the pending inserts, clds_hash_table_insert and clds_hash_table_set_value shall call clds_backoff_wake_all for the pending insert count. ]*/
+TEST_FUNCTION(clds_hash_table_insert_with_oversubscribed_threads_growing_the_table_inserts_all_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    ASSERT_IS_NOT_NULL(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    ASSERT_IS_NOT_NULL(hazard_pointers_thread);
+    // start with 1 bucket so that the table grows many times and the inserts keep waiting for the inserts in the lower levels
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare, 1, hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(hash_table);
+    THREAD_DATA* thread_data = (THREAD_DATA*)malloc(sizeof(THREAD_DATA) * OVERSUBSCRIBED_THREAD_COUNT);
+    ASSERT_IS_NOT_NULL(thread_data);
+    THREAD_HANDLE thread[OVERSUBSCRIBED_THREAD_COUNT];
+    SHARED_KEY_INFO shared;
+    uint32_t i;
+
+    // act
+    for (i = 0; i < OVERSUBSCRIBED_THREAD_COUNT; i++)
+    {
+        initialize_thread_data(&thread_data[i], &shared, hash_table, hazard_pointers, i, OVERSUBSCRIBED_THREAD_COUNT);
+        if (ThreadAPI_Create(&thread[i], fixed_count_insert_thread, &thread_data[i]) != THREADAPI_OK)
+        {
+            ASSERT_FAIL("Error spawning insert test thread %" PRIu32, i);
+        }
+    }
+
+    for (i = 0; i < OVERSUBSCRIBED_THREAD_COUNT; i++)
+    {
+        int thread_result;
+        (void)ThreadAPI_Join(thread[i], &thread_result);
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+
+    // assert
+    for (i = 0; i < OVERSUBSCRIBED_THREAD_COUNT * OVERSUBSCRIBED_INSERT_COUNT; i++)
+    {
+        CLDS_HASH_TABLE_ITEM* item = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)(INT_PTR)(i + 1));
+        ASSERT_IS_NOT_NULL(item, "Key %" PRIu32 " was not found", i + 1);
+        ASSERT_ARE_EQUAL(uint32_t, i, CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, item)->key);
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    }
+
+    // cleanup
+    free(thread_data);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 static bool get_item_and_change_state(CHAOS_TEST_ITEM_DATA* items, int item_count, LONG new_item_state, LONG old_item_state, int* selected_item_index)
 {
     int item_index = (rand() * (item_count - 1)) / RAND_MAX;
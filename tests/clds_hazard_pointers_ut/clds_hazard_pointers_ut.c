@@ -2,8 +2,10 @@
 
 #ifdef __cplusplus
 #include <cstdlib>
+#include <cstdint>
 #else
 #include <stdlib.h>
+#include <stdint.h>
 #endif
 
 #include "azure_macro_utils/macro_utils.h"
@@ -20,6 +22,7 @@ void real_free(void* ptr)
 }
 
 #include "umock_c/umock_c.h"
+#include "umock_c/umocktypes_stdint.h"
 
 #define ENABLE_MOCKS
 
@@ -40,6 +43,8 @@ static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
 
 MOCK_FUNCTION_WITH_CODE(, void, test_reclaim_func, void*, node)
 MOCK_FUNCTION_END()
+MOCK_FUNCTION_WITH_CODE(, void, test_skipped_seq_no_cb, void*, context, int64_t, skipped_sequence_no)
+MOCK_FUNCTION_END()
 
 BEGIN_TEST_SUITE(clds_hazard_pointers_unittests)
 
@@ -49,6 +54,7 @@ TEST_SUITE_INITIALIZE(suite_init)
     ASSERT_IS_NOT_NULL(test_serialize_mutex);
 
     umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, umocktypes_stdint_register_types());
 
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, real_malloc);
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, real_free);
@@ -237,4 +243,447 @@ TEST_FUNCTION(clds_hazard_pointers_reclaim_with_a_pointer_that_is_not_acquired_r
     clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
+/* clds_hazard_pointers_sequence_number_blocks_create */
+
+TEST_FUNCTION(clds_hazard_pointers_sequence_number_blocks_create_succeeds)
+{
+    // arrange
+    volatile int64_t sequence_number = 42;
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    sequence_number_blocks = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number, test_skipped_seq_no_cb, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(sequence_number_blocks);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
+
+    // cleanup
+    clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_sequence_number_blocks_create_with_NULL_sequence_number_fails)
+{
+    // arrange
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks;
+
+    // act
+    sequence_number_blocks = clds_hazard_pointers_sequence_number_blocks_create(NULL, test_skipped_seq_no_cb, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(sequence_number_blocks);
+}
+
+TEST_FUNCTION(when_malloc_fails_clds_hazard_pointers_sequence_number_blocks_create_fails)
+{
+    // arrange
+    volatile int64_t sequence_number = 42;
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    sequence_number_blocks = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number, test_skipped_seq_no_cb, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(sequence_number_blocks);
+}
+
+/* clds_hazard_pointers_sequence_number_blocks_destroy */
+
+TEST_FUNCTION(clds_hazard_pointers_sequence_number_blocks_destroy_with_NULL_returns)
+{
+    // arrange
+
+    // act
+    clds_hazard_pointers_sequence_number_blocks_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(clds_hazard_pointers_sequence_number_blocks_destroy_reports_the_unused_sequence_numbers_of_all_threads_as_skipped)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_1 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    volatile int64_t sequence_number = 42;
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number, test_skipped_seq_no_cb, (void*)0x4242);
+    (void)clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread_1, sequence_number_blocks, 3);
+    (void)clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread_2, sequence_number_blocks, 3);
+    umock_c_reset_all_calls();
+
+    // the block of the second thread is the head of the list
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb((void*)0x4242, 47));
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb((void*)0x4242, 48));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb((void*)0x4242, 44));
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb((void*)0x4242, 45));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_sequence_number_blocks_destroy_after_the_thread_was_unregistered_reports_the_unused_sequence_numbers_as_skipped)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    volatile int64_t sequence_number = 42;
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number, test_skipped_seq_no_cb, (void*)0x4242);
+    (void)clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks, 2);
+    clds_hazard_pointers_unregister_thread(clds_hazard_pointers_thread);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb((void*)0x4242, 44));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_thread_get_sequence_number */
+
+TEST_FUNCTION(clds_hazard_pointers_thread_get_sequence_number_hands_out_numbers_from_a_reserved_block)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    volatile int64_t sequence_number = 42;
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number, test_skipped_seq_no_cb, (void*)0x4242);
+    int64_t seq_no_1;
+    int64_t seq_no_2;
+    int64_t seq_no_3;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    seq_no_1 = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks, 2);
+    seq_no_2 = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks, 2);
+    seq_no_3 = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks, 2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int64_t, 43, seq_no_1);
+    ASSERT_ARE_EQUAL(int64_t, 44, seq_no_2);
+    ASSERT_ARE_EQUAL(int64_t, 45, seq_no_3);
+    ASSERT_ARE_EQUAL(int64_t, 46, sequence_number);
+
+    // cleanup
+    clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_thread_get_sequence_number_alternating_between_counters_keeps_the_blocks)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    volatile int64_t sequence_number_1 = 42;
+    volatile int64_t sequence_number_2 = 100;
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks_1 = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number_1, test_skipped_seq_no_cb, (void*)0x4242);
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks_2 = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number_2, test_skipped_seq_no_cb, (void*)0x4243);
+    int64_t seq_no_1;
+    int64_t seq_no_2;
+    int64_t seq_no_3;
+    int64_t seq_no_4;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    seq_no_1 = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks_1, 3);
+    seq_no_2 = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks_2, 3);
+    seq_no_3 = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks_1, 3);
+    seq_no_4 = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks_2, 3);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int64_t, 43, seq_no_1);
+    ASSERT_ARE_EQUAL(int64_t, 101, seq_no_2);
+    ASSERT_ARE_EQUAL(int64_t, 44, seq_no_3);
+    ASSERT_ARE_EQUAL(int64_t, 102, seq_no_4);
+    // only one block was reserved from each counter
+    ASSERT_ARE_EQUAL(int64_t, 45, sequence_number_1);
+    ASSERT_ARE_EQUAL(int64_t, 103, sequence_number_2);
+
+    // cleanup
+    clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks_1);
+    clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks_2);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_thread_get_sequence_number_after_the_previous_blocks_were_destroyed_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    volatile int64_t sequence_number_1 = 42;
+    volatile int64_t sequence_number_2 = 100;
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks_1 = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number_1, test_skipped_seq_no_cb, (void*)0x4242);
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks_2;
+    int64_t seq_no;
+    (void)clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks_1, 3);
+    clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks_1);
+    sequence_number_blocks_2 = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number_2, test_skipped_seq_no_cb, (void*)0x4243);
+    umock_c_reset_all_calls();
+
+    // the thread does not reuse the block it had in the destroyed set
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    seq_no = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks_2, 3);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int64_t, 101, seq_no);
+
+    // cleanup
+    clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks_2);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(when_malloc_fails_clds_hazard_pointers_thread_get_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    volatile int64_t sequence_number = 42;
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number, test_skipped_seq_no_cb, (void*)0x4242);
+    int64_t seq_no;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    seq_no = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks, 2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int64_t, 0, seq_no);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
+
+    // cleanup
+    clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_thread_get_sequence_number_with_NULL_thread_fails)
+{
+    // arrange
+    volatile int64_t sequence_number = 42;
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number, test_skipped_seq_no_cb, (void*)0x4242);
+    int64_t seq_no;
+    umock_c_reset_all_calls();
+
+    // act
+    seq_no = clds_hazard_pointers_thread_get_sequence_number(NULL, sequence_number_blocks, 2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int64_t, 0, seq_no);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
+
+    // cleanup
+    clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_thread_get_sequence_number_with_NULL_sequence_number_blocks_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    int64_t seq_no;
+    umock_c_reset_all_calls();
+
+    // act
+    seq_no = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, NULL, 2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int64_t, 0, seq_no);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_thread_get_sequence_number_with_block_size_0_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    volatile int64_t sequence_number = 42;
+    CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks = clds_hazard_pointers_sequence_number_blocks_create(&sequence_number, test_skipped_seq_no_cb, (void*)0x4242);
+    int64_t seq_no;
+    umock_c_reset_all_calls();
+
+    // act
+    seq_no = clds_hazard_pointers_thread_get_sequence_number(clds_hazard_pointers_thread, sequence_number_blocks, 0);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int64_t, 0, seq_no);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
+
+    // cleanup
+    clds_hazard_pointers_sequence_number_blocks_destroy(sequence_number_blocks);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_thread_get_finger */
+
+TEST_FUNCTION(clds_hazard_pointers_thread_get_finger_returns_the_node_set_for_the_owner)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    void* result;
+    clds_hazard_pointers_thread_set_finger(clds_hazard_pointers_thread, 42, pointer_1, clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1));
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hazard_pointers_thread_get_finger(clds_hazard_pointers_thread, 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, pointer_1, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_thread_get_finger_for_a_different_owner_returns_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    void* result;
+    clds_hazard_pointers_thread_set_finger(clds_hazard_pointers_thread, 42, pointer_1, clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1));
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hazard_pointers_thread_get_finger(clds_hazard_pointers_thread, 43);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_thread_get_finger_without_a_finger_returns_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hazard_pointers_thread_get_finger(clds_hazard_pointers_thread, 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_thread_get_finger_with_NULL_thread_returns_NULL)
+{
+    // arrange
+    void* result;
+
+    // act
+    result = clds_hazard_pointers_thread_get_finger(NULL, 42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+}
+
+/* clds_hazard_pointers_thread_set_finger */
+
+TEST_FUNCTION(clds_hazard_pointers_thread_set_finger_releases_the_hazard_pointer_of_the_previous_finger)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    clds_hazard_pointers_thread_set_finger(clds_hazard_pointers_thread, 42, pointer_1, clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1));
+    clds_hazard_pointers_thread_set_finger(clds_hazard_pointers_thread, 42, pointer_2, clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_2));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_reclaim_func(pointer_1));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, pointer_2, clds_hazard_pointers_thread_get_finger(clds_hazard_pointers_thread, 42));
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_thread_set_finger_with_NULL_node_does_not_change_the_finger)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    void* pointer_1 = (void*)0x4242;
+    clds_hazard_pointers_thread_set_finger(clds_hazard_pointers_thread, 42, pointer_1, clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1));
+    umock_c_reset_all_calls();
+
+    // act
+    clds_hazard_pointers_thread_set_finger(clds_hazard_pointers_thread, 42, NULL, (CLDS_HAZARD_POINTER_RECORD_HANDLE)0x4243);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, pointer_1, clds_hazard_pointers_thread_get_finger(clds_hazard_pointers_thread, 42));
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
 END_TEST_SUITE(clds_hazard_pointers_unittests)
@@ -0,0 +1,288 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstring>
+#include <cinttypes>
+#else
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#endif
+
+#include "azure_macro_utils/macro_utils.h"
+#include "testrunnerswitcher.h"
+
+#include "windows.h"
+#include "azure_c_util/gballoc.h"
+#include "azure_c_util/threadapi.h"
+#include "azure_c_logging/xlogging.h"
+#include "clds/clds_hazard_pointers.h"
+#include "clds/clds_queue.h"
+
+static TEST_MUTEX_HANDLE test_serialize_mutex;
+
+TEST_DEFINE_ENUM_TYPE(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
+
+typedef struct TEST_ITEM_TAG
+{
+    uint32_t producer_index;
+    uint32_t sequence_number;
+} TEST_ITEM;
+
+DECLARE_QUEUE_NODE_TYPE(TEST_ITEM)
+
+#define PRODUCER_COUNT      4
+#define CONSUMER_COUNT      4
+#define ITEMS_PER_PRODUCER  100000
+
+typedef struct MPMC_TEST_CONTEXT_TAG
+{
+    CLDS_QUEUE_HANDLE queue;
+    volatile LONG dequeued_count;
+    volatile LONG seen[PRODUCER_COUNT][ITEMS_PER_PRODUCER];
+} MPMC_TEST_CONTEXT;
+
+typedef struct MPMC_THREAD_DATA_TAG
+{
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    THREAD_HANDLE thread_handle;
+    MPMC_TEST_CONTEXT* mpmc_test_context;
+    uint32_t producer_index;
+    bool out_of_order;
+} MPMC_THREAD_DATA;
+
+static int producer_thread(void* arg)
+{
+    MPMC_THREAD_DATA* thread_data = (MPMC_THREAD_DATA*)arg;
+    int result = 0;
+    uint32_t i;
+
+    for (i = 0; i < ITEMS_PER_PRODUCER; i++)
+    {
+        CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        if (item == NULL)
+        {
+            LogError("Error allocating test item");
+            result = MU_FAILURE;
+            break;
+        }
+        else
+        {
+            TEST_ITEM* test_item = CLDS_QUEUE_GET_VALUE(TEST_ITEM, item);
+            test_item->producer_index = thread_data->producer_index;
+            test_item->sequence_number = i;
+
+            if (clds_queue_enqueue(thread_data->mpmc_test_context->queue, thread_data->clds_hazard_pointers_thread, item) != 0)
+            {
+                LogError("Error enqueueing");
+                CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, item);
+                result = MU_FAILURE;
+                break;
+            }
+        }
+    }
+
+    ThreadAPI_Exit(result);
+    return result;
+}
+
+static int consumer_thread(void* arg)
+{
+    MPMC_THREAD_DATA* thread_data = (MPMC_THREAD_DATA*)arg;
+    MPMC_TEST_CONTEXT* mpmc_test_context = thread_data->mpmc_test_context;
+    int64_t last_sequence_number[PRODUCER_COUNT];
+    int result = 0;
+    size_t i;
+
+    for (i = 0; i < PRODUCER_COUNT; i++)
+    {
+        last_sequence_number[i] = -1;
+    }
+
+    thread_data->out_of_order = false;
+
+    while (InterlockedAdd(&mpmc_test_context->dequeued_count, 0) < PRODUCER_COUNT * ITEMS_PER_PRODUCER)
+    {
+        CLDS_QUEUE_ITEM* item;
+        CLDS_QUEUE_DEQUEUE_RESULT dequeue_result = clds_queue_dequeue(mpmc_test_context->queue, thread_data->clds_hazard_pointers_thread, &item);
+        if (dequeue_result == CLDS_QUEUE_DEQUEUE_ERROR)
+        {
+            LogError("Error dequeueing");
+            result = MU_FAILURE;
+            break;
+        }
+        else if (dequeue_result == CLDS_QUEUE_DEQUEUE_OK)
+        {
+            TEST_ITEM* test_item = CLDS_QUEUE_GET_VALUE(TEST_ITEM, item);
+
+            // items from the same producer have to come out in the order they were enqueued
+            if ((int64_t)test_item->sequence_number <= last_sequence_number[test_item->producer_index])
+            {
+                thread_data->out_of_order = true;
+            }
+            last_sequence_number[test_item->producer_index] = test_item->sequence_number;
+
+            (void)InterlockedIncrement(&mpmc_test_context->seen[test_item->producer_index][test_item->sequence_number]);
+            (void)InterlockedIncrement(&mpmc_test_context->dequeued_count);
+
+            CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, item);
+        }
+    }
+
+    ThreadAPI_Exit(result);
+    return result;
+}
+
+BEGIN_TEST_SUITE(clds_queue_inttests)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+TEST_FUNCTION(clds_queue_create_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_QUEUE_HANDLE queue;
+
+    // act
+    queue = clds_queue_create(hazard_pointers);
+
+    // assert
+    ASSERT_IS_NOT_NULL(queue);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_queue_dequeues_the_items_in_the_order_they_were_enqueued)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item;
+    uint32_t i;
+    ASSERT_IS_NOT_NULL(queue);
+
+    for (i = 0; i < 1000; i++)
+    {
+        item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_IS_NOT_NULL(item);
+        CLDS_QUEUE_GET_VALUE(TEST_ITEM, item)->sequence_number = i;
+        ASSERT_ARE_EQUAL(int, 0, clds_queue_enqueue(queue, hazard_pointers_thread, item));
+    }
+
+    // act
+    // assert
+    for (i = 0; i < 1000; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_OK, clds_queue_dequeue(queue, hazard_pointers_thread, &item));
+        ASSERT_ARE_EQUAL(uint32_t, i, CLDS_QUEUE_GET_VALUE(TEST_ITEM, item)->sequence_number);
+        CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, item);
+    }
+
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_EMPTY, clds_queue_dequeue(queue, hazard_pointers_thread, &item));
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_queue_with_multiple_producers_and_consumers_dequeues_each_item_exactly_once)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    MPMC_THREAD_DATA producers[PRODUCER_COUNT];
+    MPMC_THREAD_DATA consumers[CONSUMER_COUNT];
+    MPMC_TEST_CONTEXT* mpmc_test_context = (MPMC_TEST_CONTEXT*)malloc(sizeof(MPMC_TEST_CONTEXT));
+    size_t i;
+    size_t j;
+    ASSERT_IS_NOT_NULL(mpmc_test_context);
+
+    (void)memset((void*)mpmc_test_context->seen, 0, sizeof(mpmc_test_context->seen));
+    (void)InterlockedExchange(&mpmc_test_context->dequeued_count, 0);
+    mpmc_test_context->queue = clds_queue_create(hazard_pointers);
+    ASSERT_IS_NOT_NULL(mpmc_test_context->queue);
+
+    // act
+    for (i = 0; i < CONSUMER_COUNT; i++)
+    {
+        consumers[i].mpmc_test_context = mpmc_test_context;
+        consumers[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+        ASSERT_IS_NOT_NULL(consumers[i].clds_hazard_pointers_thread);
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Create(&consumers[i].thread_handle, consumer_thread, &consumers[i]));
+    }
+
+    for (i = 0; i < PRODUCER_COUNT; i++)
+    {
+        producers[i].mpmc_test_context = mpmc_test_context;
+        producers[i].producer_index = (uint32_t)i;
+        producers[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+        ASSERT_IS_NOT_NULL(producers[i].clds_hazard_pointers_thread);
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Create(&producers[i].thread_handle, producer_thread, &producers[i]));
+    }
+
+    // assert
+    for (i = 0; i < PRODUCER_COUNT; i++)
+    {
+        int thread_result;
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Join(producers[i].thread_handle, &thread_result));
+        ASSERT_ARE_EQUAL(int, 0, thread_result, "Producer %zu failed", i);
+    }
+
+    for (i = 0; i < CONSUMER_COUNT; i++)
+    {
+        int thread_result;
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Join(consumers[i].thread_handle, &thread_result));
+        ASSERT_ARE_EQUAL(int, 0, thread_result, "Consumer %zu failed", i);
+        ASSERT_IS_FALSE(consumers[i].out_of_order, "Consumer %zu got items from the same producer out of order", i);
+    }
+
+    for (i = 0; i < PRODUCER_COUNT; i++)
+    {
+        for (j = 0; j < ITEMS_PER_PRODUCER; j++)
+        {
+            ASSERT_ARE_EQUAL(int, 1, (int)mpmc_test_context->seen[i][j], "Item %zu from producer %zu was dequeued %d times", j, i, (int)mpmc_test_context->seen[i][j]);
+        }
+    }
+
+    // cleanup
+    clds_queue_destroy(mpmc_test_context->queue);
+    for (i = 0; i < PRODUCER_COUNT; i++)
+    {
+        clds_hazard_pointers_unregister_thread(producers[i].clds_hazard_pointers_thread);
+    }
+    for (i = 0; i < CONSUMER_COUNT; i++)
+    {
+        clds_hazard_pointers_unregister_thread(consumers[i].clds_hazard_pointers_thread);
+    }
+    free(mpmc_test_context);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+END_TEST_SUITE(clds_queue_inttests)
@@ -0,0 +1,353 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "clds/clds_queue.h"
+#include "azure_c_util/threadapi.h"
+#include "azure_c_util/timer.h"
+#include "azure_c_logging/xlogging.h"
+#include "clds_queue_perf.h"
+
+// THREAD_COUNT has to be even, half of the threads are producers and half consumers in the MPMC test
+#define THREAD_COUNT 10
+#define INSERT_COUNT 100000
+
+typedef struct TEST_ITEM_TAG
+{
+    uint64_t value;
+} TEST_ITEM;
+
+DECLARE_QUEUE_NODE_TYPE(TEST_ITEM);
+
+typedef struct THREAD_DATA_TAG
+{
+    CLDS_QUEUE_HANDLE queue;
+    CLDS_QUEUE_ITEM* items[INSERT_COUNT];
+    double runtime;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+} THREAD_DATA;
+
+static int enqueue_thread(void* arg)
+{
+    size_t i;
+    THREAD_DATA* thread_data = (THREAD_DATA*)arg;
+    int result;
+
+    double start_time = timer_global_get_elapsed_ms();
+    for (i = 0; i < INSERT_COUNT; i++)
+    {
+        if (clds_queue_enqueue(thread_data->queue, thread_data->clds_hazard_pointers_thread, thread_data->items[i]) != 0)
+        {
+            LogError("Error enqueueing");
+            break;
+        }
+    }
+
+    if (i < INSERT_COUNT)
+    {
+        LogError("Error in test");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        thread_data->runtime = timer_global_get_elapsed_ms() - start_time;
+        result = 0;
+    }
+
+    ThreadAPI_Exit(result);
+    return result;
+}
+
+static int dequeue_thread(void* arg)
+{
+    size_t i;
+    THREAD_DATA* thread_data = (THREAD_DATA*)arg;
+    int result;
+
+    double start_time = timer_global_get_elapsed_ms();
+    for (i = 0; i < INSERT_COUNT; i++)
+    {
+        CLDS_QUEUE_ITEM* item;
+        CLDS_QUEUE_DEQUEUE_RESULT dequeue_result;
+
+        // in the MPMC test the consumers can get ahead of the producers, so keep trying while the queue is empty
+        do
+        {
+            dequeue_result = clds_queue_dequeue(thread_data->queue, thread_data->clds_hazard_pointers_thread, &item);
+        } while (dequeue_result == CLDS_QUEUE_DEQUEUE_EMPTY);
+
+        if (dequeue_result != CLDS_QUEUE_DEQUEUE_OK)
+        {
+            LogError("Error dequeueing");
+            break;
+        }
+
+        CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, item);
+    }
+
+    if (i < INSERT_COUNT)
+    {
+        LogError("Error in test");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        thread_data->runtime = timer_global_get_elapsed_ms() - start_time;
+        result = 0;
+    }
+
+    ThreadAPI_Exit(result);
+    return result;
+}
+
+static int create_items(THREAD_DATA* thread_data, size_t thread_index)
+{
+    int result;
+    size_t j;
+
+    for (j = 0; j < INSERT_COUNT; j++)
+    {
+        thread_data->items[j] = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        if (thread_data->items[j] == NULL)
+        {
+            LogError("Error allocating test item");
+            break;
+        }
+        else
+        {
+            TEST_ITEM* test_item = CLDS_QUEUE_GET_VALUE(TEST_ITEM, thread_data->items[j]);
+            test_item->value = ((uint64_t)thread_index << 32) | j;
+        }
+    }
+
+    if (j < INSERT_COUNT)
+    {
+        size_t k;
+
+        for (k = 0; k < j; k++)
+        {
+            CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, thread_data->items[k]);
+        }
+
+        result = MU_FAILURE;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+// runs thread_funcs[i] on thread_data[i] for all threads and sums up the per thread runtimes
+static int run_threads(THREAD_DATA* thread_data, THREAD_START_FUNC* thread_funcs, double* runtime)
+{
+    THREAD_HANDLE threads[THREAD_COUNT];
+    int result;
+    size_t i;
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        if (ThreadAPI_Create(&threads[i], thread_funcs[i], &thread_data[i]) != THREADAPI_OK)
+        {
+            LogError("Error spawning test thread");
+            break;
+        }
+    }
+
+    if (i < THREAD_COUNT)
+    {
+        size_t j;
+
+        for (j = 0; j < i; j++)
+        {
+            int dont_care;
+            (void)ThreadAPI_Join(threads[j], &dont_care);
+        }
+
+        result = MU_FAILURE;
+    }
+    else
+    {
+        bool is_error = false;
+        *runtime = 0.0;
+
+        for (i = 0; i < THREAD_COUNT; i++)
+        {
+            int thread_result;
+            (void)ThreadAPI_Join(threads[i], &thread_result);
+            if (thread_result != 0)
+            {
+                is_error = true;
+            }
+            else
+            {
+                *runtime += thread_data[i].runtime;
+            }
+        }
+
+        result = is_error ? MU_FAILURE : 0;
+    }
+
+    return result;
+}
+
+int clds_queue_perf_main(void)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    CLDS_QUEUE_HANDLE queue;
+    THREAD_START_FUNC thread_funcs[THREAD_COUNT];
+    THREAD_DATA* thread_data;
+    size_t i;
+
+    clds_hazard_pointers = clds_hazard_pointers_create();
+    if (clds_hazard_pointers == NULL)
+    {
+        LogError("Error creating hazard pointers");
+    }
+    else
+    {
+        queue = clds_queue_create(clds_hazard_pointers);
+        if (queue == NULL)
+        {
+            LogError("Error creating queue");
+        }
+        else
+        {
+            thread_data = (THREAD_DATA*)malloc(sizeof(THREAD_DATA) * THREAD_COUNT);
+            if (thread_data == NULL)
+            {
+                LogError("Error allocating thread data array");
+            }
+            else
+            {
+                for (i = 0; i < THREAD_COUNT; i++)
+                {
+                    thread_data[i].queue = queue;
+                    thread_data[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+                    if (thread_data[i].clds_hazard_pointers_thread == NULL)
+                    {
+                        LogError("Error registering thread with harzard pointers");
+                        break;
+                    }
+                    else if (create_items(&thread_data[i], i) != 0)
+                    {
+                        clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
+                        break;
+                    }
+                }
+
+                if (i < THREAD_COUNT)
+                {
+                    size_t j;
+
+                    LogError("Error creating test thread data");
+
+                    for (j = 0; j < i; j++)
+                    {
+                        size_t k;
+
+                        for (k = 0; k < INSERT_COUNT; k++)
+                        {
+                            CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, thread_data[j].items[k]);
+                        }
+
+                        clds_hazard_pointers_unregister_thread(thread_data[j].clds_hazard_pointers_thread);
+                    }
+                }
+                else
+                {
+                    double runtime;
+
+                    // enqueue test, all threads are producers
+                    LogInfo("Start enqueue test");
+
+                    for (i = 0; i < THREAD_COUNT; i++)
+                    {
+                        thread_funcs[i] = enqueue_thread;
+                    }
+
+                    if (run_threads(thread_data, thread_funcs, &runtime) == 0)
+                    {
+                        LogInfo("Enqueue test done in %.02f ms, %.02f enqueues/s/thread, %.02f enqueues/s on all threads",
+                            runtime,
+                            ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
+                            ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+
+                        // dequeue test, all threads are consumers
+                        LogInfo("Start dequeue test");
+
+                        for (i = 0; i < THREAD_COUNT; i++)
+                        {
+                            thread_funcs[i] = dequeue_thread;
+                        }
+
+                        if (run_threads(thread_data, thread_funcs, &runtime) == 0)
+                        {
+                            LogInfo("Dequeue test done in %.02f ms, %.02f dequeues/s/thread, %.02f dequeues/s on all threads",
+                                runtime,
+                                ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
+                                ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+
+                            // MPMC test, half of the threads enqueue while the other half dequeue
+                            for (i = 0; i < THREAD_COUNT / 2; i++)
+                            {
+                                if (create_items(&thread_data[i], i) != 0)
+                                {
+                                    break;
+                                }
+
+                                thread_funcs[i] = enqueue_thread;
+                                thread_funcs[(THREAD_COUNT / 2) + i] = dequeue_thread;
+                            }
+
+                            if (i < THREAD_COUNT / 2)
+                            {
+                                size_t j;
+
+                                LogError("Error creating MPMC test items");
+
+                                for (j = 0; j < i; j++)
+                                {
+                                    size_t k;
+
+                                    for (k = 0; k < INSERT_COUNT; k++)
+                                    {
+                                        CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, thread_data[j].items[k]);
+                                    }
+                                }
+                            }
+                            else
+                            {
+                                LogInfo("Start MPMC test");
+
+                                if (run_threads(thread_data, thread_funcs, &runtime) == 0)
+                                {
+                                    LogInfo("MPMC test done in %.02f ms, %.02f operations/s/thread, %.02f operations/s on all threads",
+                                        runtime,
+                                        ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
+                                        ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+                                }
+                            }
+                        }
+                    }
+
+                    for (i = 0; i < THREAD_COUNT; i++)
+                    {
+                        clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
+                    }
+                }
+
+                free(thread_data);
+            }
+
+            clds_queue_destroy(queue);
+        }
+
+        clds_hazard_pointers_destroy(clds_hazard_pointers);
+    }
+
+    return 0;
+}
@@ -0,0 +1,16 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_QUEUE_PERF_H
+#define CLDS_QUEUE_PERF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int clds_queue_perf_main(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLDS_QUEUE_PERF_H */
@@ -0,0 +1,10 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include "clds_queue_perf.h"
+
+int main(void)
+{
+    clds_queue_perf_main();
+    return 0;
+}
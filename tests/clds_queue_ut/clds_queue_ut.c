@@ -0,0 +1,1039 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#else
+#include <stdlib.h>
+#endif
+
+#include "azure_macro_utils/macro_utils.h"
+#include "testrunnerswitcher.h"
+
+void* real_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+void real_free(void* ptr)
+{
+    free(ptr);
+}
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umocktypes_stdint.h"
+
+#define ENABLE_MOCKS
+
+#include "azure_c_util/gballoc.h"
+#include "clds/clds_st_hash_set.h"
+#include "clds/clds_hazard_pointers.h"
+
+#undef ENABLE_MOCKS
+
+#include "clds/clds_queue.h"
+#include "../reals/real_clds_st_hash_set.h"
+#include "../reals/real_clds_hazard_pointers.h"
+
+static TEST_MUTEX_HANDLE test_serialize_mutex;
+
+TEST_DEFINE_ENUM_TYPE(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_RESULT_VALUES);
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%" PRI_MU_ENUM "", MU_ENUM_VALUE(UMOCK_C_ERROR_CODE, error_code));
+}
+
+MOCK_FUNCTION_WITH_CODE(, void, test_item_cleanup_func, void*, context, CLDS_QUEUE_ITEM*, item)
+MOCK_FUNCTION_END()
+
+typedef struct TEST_ITEM_TAG
+{
+    int dummy;
+} TEST_ITEM;
+
+DECLARE_QUEUE_NODE_TYPE(TEST_ITEM)
+
+BEGIN_TEST_SUITE(clds_queue_unittests)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    test_serialize_mutex = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(test_serialize_mutex);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result, "umock_c_init failed");
+
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result, "umocktypes_stdint_register_types failed");
+
+    REGISTER_CLDS_ST_HASH_SET_GLOBAL_MOCK_HOOKS();
+    REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS();
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, real_malloc);
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, real_free);
+
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTER_RECORD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_ST_HASH_SET_COMPUTE_HASH_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_ST_HASH_SET_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_ST_HASH_SET_KEY_COMPARE_FUNC, void*);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(test_serialize_mutex);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(test_serialize_mutex))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(test_serialize_mutex);
+}
+
+/* clds_queue_create */
+
+/* Tests_SRS_CLDS_QUEUE_01_001: [ clds_queue_create shall create a new queue object and on success it shall return a non-NULL handle to the newly created queue. ]*/
+/* Tests_SRS_CLDS_QUEUE_01_004: [ clds_queue_create shall allocate a sentinel item and set both the head and the tail of the queue to it. ]*/
+TEST_FUNCTION(clds_queue_create_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_QUEUE_HANDLE queue;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(sizeof(CLDS_QUEUE_ITEM)));
+
+    // act
+    queue = clds_queue_create(hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(queue);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_002: [ If any error happens, clds_queue_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_clds_queue_create_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_QUEUE_HANDLE queue;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    queue = clds_queue_create(hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(queue);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_002: [ If any error happens, clds_queue_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_the_sentinel_item_fails_clds_queue_create_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_QUEUE_HANDLE queue;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(sizeof(CLDS_QUEUE_ITEM)))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    queue = clds_queue_create(hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(queue);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_003: [ If clds_hazard_pointers is NULL, clds_queue_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_queue_create_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+    CLDS_QUEUE_HANDLE queue;
+
+    // act
+    queue = clds_queue_create(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(queue);
+}
+
+/* clds_queue_destroy */
+
+/* Tests_SRS_CLDS_QUEUE_01_005: [ clds_queue_destroy shall free all resources associated with the queue instance. ]*/
+TEST_FUNCTION(clds_queue_destroy_frees_the_allocated_queue_resources)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_QUEUE_HANDLE queue;
+    queue = clds_queue_create(hazard_pointers);
+    umock_c_reset_all_calls();
+
+    // sentinel
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    // queue
+    STRICT_EXPECTED_CALL(free(queue));
+
+    // act
+    clds_queue_destroy(queue);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_006: [ If clds_queue is NULL, clds_queue_destroy shall return. ]*/
+TEST_FUNCTION(clds_queue_destroy_with_NULL_handle_returns)
+{
+    // arrange
+
+    // act
+    clds_queue_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_007: [ Any items still present in the queue shall be freed. ]*/
+/* Tests_SRS_CLDS_QUEUE_01_008: [ For each item that is freed, the callback item_cleanup_callback passed to clds_queue_node_create shall be called, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_queue_destroy_with_1_item_in_the_queue_frees_the_item_and_triggers_user_cleanup_callback)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+    STRICT_EXPECTED_CALL(free(queue));
+
+    // act
+    clds_queue_destroy(queue);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_007: [ Any items still present in the queue shall be freed. ]*/
+/* Tests_SRS_CLDS_QUEUE_01_008: [ For each item that is freed, the callback item_cleanup_callback passed to clds_queue_node_create shall be called, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_queue_destroy_with_2_items_in_the_queue_frees_the_items_and_triggers_user_cleanup_callback)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item_1 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* item_2 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(free(item_1));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4243, item_2));
+    STRICT_EXPECTED_CALL(free(item_2));
+    STRICT_EXPECTED_CALL(free(queue));
+
+    // act
+    clds_queue_destroy(queue);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_009: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the freed items. ]*/
+TEST_FUNCTION(clds_queue_destroy_with_NULL_item_cleanup_callback_does_not_trigger_any_callback_for_the_freed_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(item));
+    STRICT_EXPECTED_CALL(free(queue));
+
+    // act
+    clds_queue_destroy(queue);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_007: [ Any items still present in the queue shall be freed. ]*/
+TEST_FUNCTION(clds_queue_destroy_after_a_dequeue_releases_the_reference_on_the_dequeued_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* dequeued_item;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item);
+    (void)clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item);
+    umock_c_reset_all_calls();
+
+    // the dequeued item is the sentinel now, the caller still holds a reference so it is not freed
+    STRICT_EXPECTED_CALL(free(queue));
+
+    // act
+    clds_queue_destroy(queue);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item);
+}
+
+/* clds_queue_set_backoff_policy */
+
+/* Tests_SRS_CLDS_QUEUE_01_010: [ clds_queue_set_backoff_policy shall set the backoff policy used by all subsequent operations on the queue when they have to retry because of a concurrent change and return 0. ]*/
+TEST_FUNCTION(clds_queue_set_backoff_policy_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_QUEUE_HANDLE queue;
+    int result;
+    queue = clds_queue_create(hazard_pointers);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_queue_set_backoff_policy(queue, CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_011: [ If clds_queue is NULL, clds_queue_set_backoff_policy shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_queue_set_backoff_policy_with_NULL_handle_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = clds_queue_set_backoff_policy(NULL, CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_012: [ If backoff_policy is not a valid CLDS_BACKOFF_POLICY value, clds_queue_set_backoff_policy shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_queue_set_backoff_policy_with_invalid_policy_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_QUEUE_HANDLE queue;
+    int result;
+    queue = clds_queue_create(hazard_pointers);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_queue_set_backoff_policy(queue, (CLDS_BACKOFF_POLICY)(CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT + 1));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_queue_enqueue */
+
+/* Tests_SRS_CLDS_QUEUE_01_014: [ clds_queue_enqueue shall add item at the tail of the queue. ]*/
+/* Tests_SRS_CLDS_QUEUE_01_015: [ On success clds_queue_enqueue shall return 0. ]*/
+TEST_FUNCTION(clds_queue_enqueue_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    int result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_queue_enqueue(queue, hazard_pointers_thread, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_014: [ clds_queue_enqueue shall add item at the tail of the queue. ]*/
+/* Tests_SRS_CLDS_QUEUE_01_015: [ On success clds_queue_enqueue shall return 0. ]*/
+TEST_FUNCTION(clds_queue_enqueue_2_items_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item_1 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* item_2 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    int result_1;
+    int result_2;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result_1 = clds_queue_enqueue(queue, hazard_pointers_thread, item_1);
+    result_2 = clds_queue_enqueue(queue, hazard_pointers_thread, item_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result_1);
+    ASSERT_ARE_EQUAL(int, 0, result_2);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_016: [ If clds_queue is NULL, clds_queue_enqueue shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_queue_enqueue_with_NULL_queue_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_queue_enqueue(NULL, hazard_pointers_thread, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_queue_enqueue shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_queue_enqueue_with_NULL_hazard_pointers_thread_handle_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_queue_enqueue(queue, NULL, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_018: [ If item is NULL, clds_queue_enqueue shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_queue_enqueue_with_NULL_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_queue_enqueue(queue, hazard_pointers_thread, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_019: [ If any error occurs, clds_queue_enqueue shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_acquiring_the_hazard_pointer_fails_clds_queue_enqueue_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    int result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = clds_queue_enqueue(queue, hazard_pointers_thread, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* clds_queue_dequeue */
+
+/* Tests_SRS_CLDS_QUEUE_01_020: [ clds_queue_dequeue shall remove the least recently enqueued item from the queue. ]*/
+/* Tests_SRS_CLDS_QUEUE_01_021: [ On success, clds_queue_dequeue shall return CLDS_QUEUE_DEQUEUE_OK. ]*/
+/* Tests_SRS_CLDS_QUEUE_01_028: [ The reference held by the queue on the previous sentinel item shall be released by indicating the item to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+TEST_FUNCTION(clds_queue_dequeue_dequeues_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* dequeued_item;
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    // the sentinel allocated at create is reclaimed
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item, dequeued_item);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_020: [ clds_queue_dequeue shall remove the least recently enqueued item from the queue. ]*/
+TEST_FUNCTION(clds_queue_dequeue_dequeues_the_items_in_FIFO_order)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item_1 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* item_2 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_QUEUE_ITEM* item_3 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    CLDS_QUEUE_ITEM* dequeued_item_1;
+    CLDS_QUEUE_ITEM* dequeued_item_2;
+    CLDS_QUEUE_ITEM* dequeued_item_3;
+    CLDS_QUEUE_DEQUEUE_RESULT result_1;
+    CLDS_QUEUE_DEQUEUE_RESULT result_2;
+    CLDS_QUEUE_DEQUEUE_RESULT result_3;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_2);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    // the dequeued items are still referenced by the test
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+
+    // act
+    result_1 = clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_1);
+    result_2 = clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_2);
+    result_3 = clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_3);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_OK, result_1);
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_OK, result_2);
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_OK, result_3);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, dequeued_item_1);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, dequeued_item_2);
+    ASSERT_ARE_EQUAL(void_ptr, item_3, dequeued_item_3);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_1);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_2);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_3);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_020: [ clds_queue_dequeue shall remove the least recently enqueued item from the queue. ]*/
+TEST_FUNCTION(clds_queue_dequeue_after_enqueue_on_a_drained_queue_returns_the_new_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item_1 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* item_2 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_QUEUE_ITEM* dequeued_item_1;
+    CLDS_QUEUE_ITEM* dequeued_item_2;
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_1);
+    (void)clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+
+    // act
+    result = clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, dequeued_item_2);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_1);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_2);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_022: [ If clds_queue is NULL, clds_queue_dequeue shall fail and return CLDS_QUEUE_DEQUEUE_ERROR. ]*/
+TEST_FUNCTION(clds_queue_dequeue_with_NULL_queue_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_ITEM* dequeued_item;
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_queue_dequeue(NULL, hazard_pointers_thread, &dequeued_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_023: [ If clds_hazard_pointers_thread is NULL, clds_queue_dequeue shall fail and return CLDS_QUEUE_DEQUEUE_ERROR. ]*/
+TEST_FUNCTION(clds_queue_dequeue_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* dequeued_item;
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_queue_dequeue(queue, NULL, &dequeued_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_ERROR, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_024: [ If item is NULL, clds_queue_dequeue shall fail and return CLDS_QUEUE_DEQUEUE_ERROR. ]*/
+TEST_FUNCTION(clds_queue_dequeue_with_NULL_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_queue_dequeue(queue, hazard_pointers_thread, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_ERROR, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_025: [ If the queue is empty, clds_queue_dequeue shall return CLDS_QUEUE_DEQUEUE_EMPTY. ]*/
+TEST_FUNCTION(clds_queue_dequeue_on_an_empty_queue_returns_EMPTY)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* dequeued_item;
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_EMPTY, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_025: [ If the queue is empty, clds_queue_dequeue shall return CLDS_QUEUE_DEQUEUE_EMPTY. ]*/
+TEST_FUNCTION(clds_queue_dequeue_after_all_items_were_dequeued_returns_EMPTY)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* dequeued_item_1;
+    CLDS_QUEUE_ITEM* dequeued_item_2;
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item);
+    (void)clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_EMPTY, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_1);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_026: [ If any error occurs, clds_queue_dequeue shall fail and return CLDS_QUEUE_DEQUEUE_ERROR. ]*/
+TEST_FUNCTION(when_acquiring_the_hazard_pointer_for_the_sentinel_fails_clds_queue_dequeue_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* dequeued_item;
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_ERROR, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_026: [ If any error occurs, clds_queue_dequeue shall fail and return CLDS_QUEUE_DEQUEUE_ERROR. ]*/
+TEST_FUNCTION(when_acquiring_the_hazard_pointer_for_the_item_fails_clds_queue_dequeue_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* dequeued_item;
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_ERROR, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_027: [ clds_queue_dequeue shall return the item with its reference count incremented, so that it can be used by the caller until it calls clds_queue_node_release. ]*/
+TEST_FUNCTION(clds_queue_dequeued_item_is_freed_only_after_the_caller_releases_it_and_it_is_no_longer_the_sentinel)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item_1 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* item_2 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_QUEUE_ITEM* dequeued_item_1;
+    CLDS_QUEUE_ITEM* dequeued_item_2;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_2);
+    (void)clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_1);
+    umock_c_reset_all_calls();
+
+    // no free for item_1, it is still the sentinel
+
+    // act
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    (void)clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_2);
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_2);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_028: [ The reference held by the queue on the previous sentinel item shall be released by indicating the item to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+/* Tests_SRS_CLDS_QUEUE_01_031: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_queue_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+TEST_FUNCTION(clds_queue_dequeue_reclaims_the_previously_dequeued_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item_1 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_QUEUE_ITEM* item_2 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_QUEUE_ITEM* dequeued_item_1;
+    CLDS_QUEUE_ITEM* dequeued_item_2;
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_2);
+    (void)clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_1);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(free(item_1));
+
+    // act
+    result = clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, dequeued_item_2);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_2);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_032: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
+TEST_FUNCTION(clds_queue_dequeue_reclaims_the_previously_dequeued_item_with_NULL_cleanup_callback)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_QUEUE_HANDLE queue = clds_queue_create(hazard_pointers);
+    CLDS_QUEUE_ITEM* item_1 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_QUEUE_ITEM* item_2 = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_QUEUE_ITEM* dequeued_item_1;
+    CLDS_QUEUE_ITEM* dequeued_item_2;
+    CLDS_QUEUE_DEQUEUE_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_1);
+    (void)clds_queue_enqueue(queue, hazard_pointers_thread, item_2);
+    (void)clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_1);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(item_1));
+
+    // act
+    result = clds_queue_dequeue(queue, hazard_pointers_thread, &dequeued_item_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_QUEUE_DEQUEUE_RESULT, CLDS_QUEUE_DEQUEUE_OK, result);
+
+    // cleanup
+    clds_queue_destroy(queue);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, dequeued_item_2);
+}
+
+/* clds_queue_node_create */
+
+/* Tests_SRS_CLDS_QUEUE_01_029: [ item_cleanup_callback shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_queue_node_create_with_NULL_item_cleanup_callback_succeeds)
+{
+    // arrange
+    CLDS_QUEUE_ITEM* item;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, NULL, (void*)0x4242);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(item);
+
+    // cleanup
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_QUEUE_01_030: [ item_cleanup_callback_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_queue_node_create_with_NULL_item_cleanup_callback_context_succeeds)
+{
+    // arrange
+    CLDS_QUEUE_ITEM* item;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    item = CLDS_QUEUE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(item);
+
+    // cleanup
+    CLDS_QUEUE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+END_TEST_SUITE(clds_queue_unittests)
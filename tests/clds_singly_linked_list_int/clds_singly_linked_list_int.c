@@ -2,10 +2,12 @@
 
 #ifdef __cplusplus
 #include <cstdlib>
+#include <cstring>
 #include <cinttypes>
 #include <ctime>
 #else
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 #include <stdbool.h>
 #include <time.h>
@@ -27,6 +29,7 @@ static TEST_MUTEX_HANDLE test_serialize_mutex;
 #define XTEST_FUNCTION(A) void A(void)
 
 TEST_DEFINE_ENUM_TYPE(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
 
 typedef struct TEST_ITEM_TAG
@@ -93,6 +96,24 @@ MU_DEFINE_ENUM(TEST_LIST_ITEM_STATE, TEST_LIST_ITEM_STATE_VALUES);
 
 MU_DEFINE_ENUM_WITHOUT_INVALID(CHAOS_TEST_ACTION, CHAOS_TEST_ACTION_VALUES);
 
+#define PUSH_POP_THREAD_COUNT       8
+#define PUSH_POP_ITEMS_PER_THREAD   100000
+
+typedef struct PUSH_POP_TEST_CONTEXT_TAG
+{
+    CLDS_SINGLY_LINKED_LIST_HANDLE singly_linked_list;
+    bool reinsert_popped_items;
+    volatile LONG seen[PUSH_POP_THREAD_COUNT][PUSH_POP_ITEMS_PER_THREAD];
+} PUSH_POP_TEST_CONTEXT;
+
+typedef struct PUSH_POP_THREAD_DATA_TAG
+{
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    THREAD_HANDLE thread_handle;
+    PUSH_POP_TEST_CONTEXT* push_pop_test_context;
+    int thread_index;
+} PUSH_POP_THREAD_DATA;
+
 BEGIN_TEST_SUITE(clds_singly_linked_list_inttests)
 
 TEST_SUITE_INITIALIZE(suite_init)
@@ -264,6 +285,207 @@ static int chaos_thread(void* arg)
     return result;
 }
 
+static int pop_and_check_delete_mark(PUSH_POP_THREAD_DATA* thread_data, CLDS_SINGLY_LINKED_LIST_ITEM** item)
+{
+    int result;
+    PUSH_POP_TEST_CONTEXT* push_pop_test_context = thread_data->push_pop_test_context;
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT pop_result = clds_singly_linked_list_pop_head(push_pop_test_context->singly_linked_list, thread_data->clds_hazard_pointers_thread, item);
+    if (pop_result != CLDS_SINGLY_LINKED_LIST_POP_OK)
+    {
+        // the list cannot be empty here, as this thread has pushed one more item than it has popped
+        LogError("Error popping: %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SINGLY_LINKED_LIST_POP_RESULT, pop_result));
+        result = MU_FAILURE;
+    }
+    else if (((uintptr_t)(*item)->next & 0x1) == 0)
+    {
+        // popped items (also the ones taken from an elimination slot) keep the delete mark, so that a stale pop or delete cannot mark them
+        LogError("Popped item %p does not have the delete mark", *item);
+        CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, *item);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+static int push_pop_thread(void* arg)
+{
+    PUSH_POP_THREAD_DATA* thread_data = (PUSH_POP_THREAD_DATA*)arg;
+    PUSH_POP_TEST_CONTEXT* push_pop_test_context = thread_data->push_pop_test_context;
+    int result = 0;
+    int i;
+
+    // each thread pushes one of its items and then pops one item, so that pushes and pops collide on the head
+    for (i = 0; i < PUSH_POP_ITEMS_PER_THREAD; i++)
+    {
+        CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, NULL);
+        if (item == NULL)
+        {
+            LogError("Error allocating test item");
+            result = MU_FAILURE;
+            break;
+        }
+        else
+        {
+            TEST_ITEM* test_item = CLDS_SINGLY_LINKED_LIST_GET_VALUE(TEST_ITEM, item);
+            test_item->value = (thread_data->thread_index * PUSH_POP_ITEMS_PER_THREAD) + i;
+
+            if (clds_singly_linked_list_insert(push_pop_test_context->singly_linked_list, thread_data->clds_hazard_pointers_thread, item) != 0)
+            {
+                LogError("Error inserting");
+                CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item);
+                result = MU_FAILURE;
+                break;
+            }
+
+            if (pop_and_check_delete_mark(thread_data, &item) != 0)
+            {
+                result = MU_FAILURE;
+                break;
+            }
+
+            if (push_pop_test_context->reinsert_popped_items)
+            {
+                // the popped item (possibly pushed by another thread) goes back in the list with the reference returned by the pop
+                // only the item popped after that is counted and released, so that each item is still counted exactly once
+                if (clds_singly_linked_list_insert(push_pop_test_context->singly_linked_list, thread_data->clds_hazard_pointers_thread, item) != 0)
+                {
+                    LogError("Error inserting popped item");
+                    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item);
+                    result = MU_FAILURE;
+                    break;
+                }
+
+                if (pop_and_check_delete_mark(thread_data, &item) != 0)
+                {
+                    result = MU_FAILURE;
+                    break;
+                }
+            }
+
+            test_item = CLDS_SINGLY_LINKED_LIST_GET_VALUE(TEST_ITEM, item);
+            (void)InterlockedIncrement(&push_pop_test_context->seen[test_item->value / PUSH_POP_ITEMS_PER_THREAD][test_item->value % PUSH_POP_ITEMS_PER_THREAD]);
+            CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item);
+        }
+    }
+
+    ThreadAPI_Exit(result);
+    return result;
+}
+
+TEST_FUNCTION(clds_singly_linked_list_with_elimination_pops_each_pushed_item_exactly_once)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    PUSH_POP_THREAD_DATA thread_data[PUSH_POP_THREAD_COUNT];
+    PUSH_POP_TEST_CONTEXT* push_pop_test_context = (PUSH_POP_TEST_CONTEXT*)malloc(sizeof(PUSH_POP_TEST_CONTEXT));
+    CLDS_SINGLY_LINKED_LIST_ITEM* item;
+    size_t i;
+    size_t j;
+    ASSERT_IS_NOT_NULL(push_pop_test_context);
+
+    (void)memset((void*)push_pop_test_context->seen, 0, sizeof(push_pop_test_context->seen));
+    push_pop_test_context->reinsert_popped_items = false;
+    push_pop_test_context->singly_linked_list = clds_singly_linked_list_create(hazard_pointers);
+    ASSERT_IS_NOT_NULL(push_pop_test_context->singly_linked_list);
+    ASSERT_ARE_EQUAL(int, 0, clds_singly_linked_list_enable_elimination(push_pop_test_context->singly_linked_list, PUSH_POP_THREAD_COUNT / 2));
+
+    // act
+    for (i = 0; i < PUSH_POP_THREAD_COUNT; i++)
+    {
+        thread_data[i].push_pop_test_context = push_pop_test_context;
+        thread_data[i].thread_index = (int)i;
+        thread_data[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+        ASSERT_IS_NOT_NULL(thread_data[i].clds_hazard_pointers_thread);
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Create(&thread_data[i].thread_handle, push_pop_thread, &thread_data[i]));
+    }
+
+    // assert
+    for (i = 0; i < PUSH_POP_THREAD_COUNT; i++)
+    {
+        int thread_result;
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Join(thread_data[i].thread_handle, &thread_result));
+        ASSERT_ARE_EQUAL(int, 0, thread_result, "Thread %zu failed", i);
+    }
+
+    for (i = 0; i < PUSH_POP_THREAD_COUNT; i++)
+    {
+        for (j = 0; j < PUSH_POP_ITEMS_PER_THREAD; j++)
+        {
+            ASSERT_ARE_EQUAL(int, 1, (int)push_pop_test_context->seen[i][j], "Item %zu from thread %zu was popped %d times", j, i, (int)push_pop_test_context->seen[i][j]);
+        }
+    }
+
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_EMPTY, clds_singly_linked_list_pop_head(push_pop_test_context->singly_linked_list, thread_data[0].clds_hazard_pointers_thread, &item));
+
+    // cleanup
+    clds_singly_linked_list_destroy(push_pop_test_context->singly_linked_list);
+    for (i = 0; i < PUSH_POP_THREAD_COUNT; i++)
+    {
+        clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
+    }
+    free(push_pop_test_context);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_singly_linked_list_with_elimination_reinserting_popped_items_keeps_the_delete_mark_on_popped_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    PUSH_POP_THREAD_DATA thread_data[PUSH_POP_THREAD_COUNT];
+    PUSH_POP_TEST_CONTEXT* push_pop_test_context = (PUSH_POP_TEST_CONTEXT*)malloc(sizeof(PUSH_POP_TEST_CONTEXT));
+    CLDS_SINGLY_LINKED_LIST_ITEM* item;
+    size_t i;
+    size_t j;
+    ASSERT_IS_NOT_NULL(push_pop_test_context);
+
+    (void)memset((void*)push_pop_test_context->seen, 0, sizeof(push_pop_test_context->seen));
+    push_pop_test_context->reinsert_popped_items = true;
+    push_pop_test_context->singly_linked_list = clds_singly_linked_list_create(hazard_pointers);
+    ASSERT_IS_NOT_NULL(push_pop_test_context->singly_linked_list);
+    ASSERT_ARE_EQUAL(int, 0, clds_singly_linked_list_enable_elimination(push_pop_test_context->singly_linked_list, PUSH_POP_THREAD_COUNT / 2));
+
+    // act
+    for (i = 0; i < PUSH_POP_THREAD_COUNT; i++)
+    {
+        thread_data[i].push_pop_test_context = push_pop_test_context;
+        thread_data[i].thread_index = (int)i;
+        thread_data[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+        ASSERT_IS_NOT_NULL(thread_data[i].clds_hazard_pointers_thread);
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Create(&thread_data[i].thread_handle, push_pop_thread, &thread_data[i]));
+    }
+
+    // assert
+    for (i = 0; i < PUSH_POP_THREAD_COUNT; i++)
+    {
+        int thread_result;
+        ASSERT_ARE_EQUAL(THREADAPI_RESULT, THREADAPI_OK, ThreadAPI_Join(thread_data[i].thread_handle, &thread_result));
+        ASSERT_ARE_EQUAL(int, 0, thread_result, "Thread %zu failed", i);
+    }
+
+    for (i = 0; i < PUSH_POP_THREAD_COUNT; i++)
+    {
+        for (j = 0; j < PUSH_POP_ITEMS_PER_THREAD; j++)
+        {
+            ASSERT_ARE_EQUAL(int, 1, (int)push_pop_test_context->seen[i][j], "Item %zu from thread %zu was popped %d times", j, i, (int)push_pop_test_context->seen[i][j]);
+        }
+    }
+
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_EMPTY, clds_singly_linked_list_pop_head(push_pop_test_context->singly_linked_list, thread_data[0].clds_hazard_pointers_thread, &item));
+
+    // cleanup
+    clds_singly_linked_list_destroy(push_pop_test_context->singly_linked_list);
+    for (i = 0; i < PUSH_POP_THREAD_COUNT; i++)
+    {
+        clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
+    }
+    free(push_pop_test_context);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 #if 0
 // This test needs reenabling, it does crash!
 TEST_FUNCTION(clds_singly_linked_list_chaos_knight_test)
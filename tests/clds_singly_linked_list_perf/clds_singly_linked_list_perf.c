@@ -13,6 +13,10 @@
 #define THREAD_COUNT 10
 #define INSERT_COUNT 1000
 
+// the push/pop test is run with 2, 4, 8 and 16 threads, with and without elimination
+#define PUSH_POP_MAX_THREAD_COUNT 16
+#define PUSH_POP_COUNT 100000
+
 typedef struct TEST_ITEM_TAG
 {
     char key[20];
@@ -28,6 +32,14 @@ typedef struct THREAD_DATA_TAG
     CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
 } THREAD_DATA;
 
+typedef struct PUSH_POP_THREAD_DATA_TAG
+{
+    CLDS_SINGLY_LINKED_LIST_HANDLE singly_linked_list;
+    CLDS_SINGLY_LINKED_LIST_ITEM* items[PUSH_POP_COUNT];
+    double runtime;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+} PUSH_POP_THREAD_DATA;
+
 static int insert_thread(void* arg)
 {
     size_t i;
@@ -90,6 +102,191 @@ static int delete_thread(void* arg)
     return result;
 }
 
+static int push_pop_thread(void* arg)
+{
+    size_t i;
+    PUSH_POP_THREAD_DATA* thread_data = (PUSH_POP_THREAD_DATA*)arg;
+    int result;
+
+    double start_time = timer_global_get_elapsed_ms();
+    for (i = 0; i < PUSH_POP_COUNT; i++)
+    {
+        CLDS_SINGLY_LINKED_LIST_ITEM* item;
+
+        if (clds_singly_linked_list_insert(thread_data->singly_linked_list, thread_data->clds_hazard_pointers_thread, thread_data->items[i]) != 0)
+        {
+            LogError("Error inserting");
+            break;
+        }
+
+        if (clds_singly_linked_list_pop_head(thread_data->singly_linked_list, thread_data->clds_hazard_pointers_thread, &item) != CLDS_SINGLY_LINKED_LIST_POP_OK)
+        {
+            LogError("Error popping");
+            break;
+        }
+
+        CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item);
+    }
+
+    if (i < PUSH_POP_COUNT)
+    {
+        LogError("Error in test");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        thread_data->runtime = timer_global_get_elapsed_ms() - start_time;
+        result = 0;
+    }
+
+    ThreadAPI_Exit(result);
+    return result;
+}
+
+// runs thread_count threads that each push an item and pop an item PUSH_POP_COUNT times, all on the head of the same list
+static void run_push_pop_test(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, size_t thread_count, bool use_elimination)
+{
+    CLDS_SINGLY_LINKED_LIST_HANDLE singly_linked_list;
+    THREAD_HANDLE threads[PUSH_POP_MAX_THREAD_COUNT];
+    PUSH_POP_THREAD_DATA* thread_data;
+    size_t i;
+    size_t j;
+
+    singly_linked_list = clds_singly_linked_list_create(clds_hazard_pointers);
+    if (singly_linked_list == NULL)
+    {
+        LogError("Error creating singly linked list");
+    }
+    else
+    {
+        if (use_elimination &&
+            (clds_singly_linked_list_enable_elimination(singly_linked_list, (uint32_t)(thread_count / 2)) != 0))
+        {
+            LogError("Error enabling elimination");
+        }
+        else
+        {
+            thread_data = (PUSH_POP_THREAD_DATA*)malloc(sizeof(PUSH_POP_THREAD_DATA) * thread_count);
+            if (thread_data == NULL)
+            {
+                LogError("Error allocating thread data array");
+            }
+            else
+            {
+                for (i = 0; i < thread_count; i++)
+                {
+                    thread_data[i].singly_linked_list = singly_linked_list;
+                    thread_data[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+                    if (thread_data[i].clds_hazard_pointers_thread == NULL)
+                    {
+                        LogError("Error registering thread with harzard pointers");
+                        break;
+                    }
+                    else
+                    {
+                        for (j = 0; j < PUSH_POP_COUNT; j++)
+                        {
+                            thread_data[i].items[j] = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+                            if (thread_data[i].items[j] == NULL)
+                            {
+                                LogError("Error allocating test item");
+                                break;
+                            }
+                        }
+
+                        if (j < PUSH_POP_COUNT)
+                        {
+                            size_t k;
+
+                            for (k = 0; k < j; k++)
+                            {
+                                CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, thread_data[i].items[k]);
+                            }
+
+                            clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
+                            break;
+                        }
+                    }
+                }
+
+                if (i < thread_count)
+                {
+                    LogError("Error creating test thread data");
+
+                    for (j = 0; j < i; j++)
+                    {
+                        size_t k;
+
+                        for (k = 0; k < PUSH_POP_COUNT; k++)
+                        {
+                            CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, thread_data[j].items[k]);
+                        }
+
+                        clds_hazard_pointers_unregister_thread(thread_data[j].clds_hazard_pointers_thread);
+                    }
+                }
+                else
+                {
+                    for (i = 0; i < thread_count; i++)
+                    {
+                        if (ThreadAPI_Create(&threads[i], push_pop_thread, &thread_data[i]) != THREADAPI_OK)
+                        {
+                            LogError("Error spawning test thread");
+                            break;
+                        }
+                    }
+
+                    if (i < thread_count)
+                    {
+                        for (j = 0; j < i; j++)
+                        {
+                            int dont_care;
+                            (void)ThreadAPI_Join(threads[j], &dont_care);
+                        }
+                    }
+                    else
+                    {
+                        bool is_error = false;
+                        double runtime = 0.0;
+
+                        for (i = 0; i < thread_count; i++)
+                        {
+                            int thread_result;
+                            (void)ThreadAPI_Join(threads[i], &thread_result);
+                            if (thread_result != 0)
+                            {
+                                is_error = true;
+                            }
+                            else
+                            {
+                                runtime += thread_data[i].runtime;
+                            }
+                        }
+
+                        if (!is_error)
+                        {
+                            LogInfo("Push/pop test with %zu threads, elimination %s, done in %.02f ms, %.02f push/pop pairs/s/thread, %.02f push/pop pairs/s on all threads",
+                                thread_count, use_elimination ? "on" : "off",
+                                runtime,
+                                ((double)thread_count * (double)PUSH_POP_COUNT) / (double)runtime * 1000.0,
+                                ((double)thread_count * (double)PUSH_POP_COUNT) / ((double)runtime / thread_count) * 1000.0);
+                        }
+                    }
+
+                    for (i = 0; i < thread_count; i++)
+                    {
+                        clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
+                    }
+                }
+
+                free(thread_data);
+            }
+        }
+
+        clds_singly_linked_list_destroy(singly_linked_list);
+    }
+}
+
 int clds_singly_linked_list_perf_main(void)
 {
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
@@ -272,6 +469,15 @@ int clds_singly_linked_list_perf_main(void)
             clds_singly_linked_list_destroy(singly_linked_list);
         }
 
+        // push/pop test, all threads work on the head of the list
+        LogInfo("Start push/pop test");
+
+        for (i = 2; i <= PUSH_POP_MAX_THREAD_COUNT; i *= 2)
+        {
+            run_push_pop_test(clds_hazard_pointers, i, false);
+            run_push_pop_test(clds_hazard_pointers, i, true);
+        }
+
         clds_hazard_pointers_destroy(clds_hazard_pointers);
     }
 
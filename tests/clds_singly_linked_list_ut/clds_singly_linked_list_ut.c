@@ -38,6 +38,10 @@ static TEST_MUTEX_HANDLE test_serialize_mutex;
 
 TEST_DEFINE_ENUM_TYPE(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT_VALUES);
 
 MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
 
@@ -49,6 +53,9 @@ static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
 MOCK_FUNCTION_WITH_CODE(, void, test_item_cleanup_func, void*, context, CLDS_SINGLY_LINKED_LIST_ITEM*, item)
 MOCK_FUNCTION_END()
 
+MOCK_FUNCTION_WITH_CODE(, void, test_item_popped_cb, void*, context, CLDS_SINGLY_LINKED_LIST_ITEM*, item)
+MOCK_FUNCTION_END()
+
 MOCK_FUNCTION_WITH_CODE(, uint64_t, test_compute_hash, void*, key)
     (void)key;
 MOCK_FUNCTION_END(0)
@@ -72,6 +79,50 @@ static bool test_item_compare_find_always(void* item_compare_context, struct CLD
     return true;
 }
 
+static bool test_item_compare_by_cleanup_context(void* item_compare_context, struct CLDS_SINGLY_LINKED_LIST_ITEM_TAG* item)
+{
+    return (item->item_cleanup_callback_context == item_compare_context) ? true : false;
+}
+
+typedef struct TEST_VISIT_CONTEXT_TAG
+{
+    size_t stop_after_count;
+    size_t visited_count;
+    CLDS_SINGLY_LINKED_LIST_ITEM* visited_items[3];
+} TEST_VISIT_CONTEXT;
+
+static bool test_item_visit(void* context, struct CLDS_SINGLY_LINKED_LIST_ITEM_TAG* item)
+{
+    TEST_VISIT_CONTEXT* visit_context = (TEST_VISIT_CONTEXT*)context;
+    visit_context->visited_items[visit_context->visited_count] = item;
+    visit_context->visited_count++;
+    return (visit_context->visited_count < visit_context->stop_after_count) ? true : false;
+}
+
+typedef struct TEST_DELETE_VISITED_CONTEXT_TAG
+{
+    CLDS_SINGLY_LINKED_LIST_HANDLE list;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread;
+    TEST_VISIT_CONTEXT visit_context;
+} TEST_DELETE_VISITED_CONTEXT;
+
+static bool test_item_visit_and_delete(void* context, struct CLDS_SINGLY_LINKED_LIST_ITEM_TAG* item)
+{
+    TEST_DELETE_VISITED_CONTEXT* delete_visited_context = (TEST_DELETE_VISITED_CONTEXT*)context;
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_OK, clds_singly_linked_list_delete(delete_visited_context->list, delete_visited_context->hazard_pointers_thread, item));
+    return test_item_visit(&delete_visited_context->visit_context, item);
+}
+
+static size_t visited_without_context_count;
+
+static bool test_item_visit_without_context(void* context, struct CLDS_SINGLY_LINKED_LIST_ITEM_TAG* item)
+{
+    (void)item;
+    ASSERT_IS_NULL(context);
+    visited_without_context_count++;
+    return true;
+}
+
 typedef struct TEST_ITEM_TAG
 {
     int dummy;
@@ -312,6 +363,245 @@ TEST_FUNCTION(clds_singly_linked_list_destroy_with_NULL_item_cleanup_callback_do
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* clds_singly_linked_list_set_backoff_policy */
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_045: [ clds_singly_linked_list_set_backoff_policy shall set the backoff policy used by all subsequent operations on the list when they have to retry because of a concurrent change and return 0. ]*/
+TEST_FUNCTION(clds_singly_linked_list_set_backoff_policy_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SINGLY_LINKED_LIST_HANDLE list;
+    int result;
+    list = clds_singly_linked_list_create(hazard_pointers);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_set_backoff_policy(list, CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_046: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_set_backoff_policy shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_singly_linked_list_set_backoff_policy_with_NULL_handle_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = clds_singly_linked_list_set_backoff_policy(NULL, CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_047: [ If backoff_policy is not a valid CLDS_BACKOFF_POLICY value, clds_singly_linked_list_set_backoff_policy shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_singly_linked_list_set_backoff_policy_with_invalid_policy_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SINGLY_LINKED_LIST_HANDLE list;
+    int result;
+    list = clds_singly_linked_list_create(hazard_pointers);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_set_backoff_policy(list, (CLDS_BACKOFF_POLICY)(CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT + 1));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_singly_linked_list_enable_elimination */
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_091: [ clds_singly_linked_list_enable_elimination shall allocate an elimination array with slot_count slots, used by clds_singly_linked_list_insert and clds_singly_linked_list_pop_head when they collide on the head of the list. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_092: [ On success, clds_singly_linked_list_enable_elimination shall return 0. ]*/
+TEST_FUNCTION(clds_singly_linked_list_enable_elimination_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SINGLY_LINKED_LIST_HANDLE list;
+    int result;
+    list = clds_singly_linked_list_create(hazard_pointers);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    result = clds_singly_linked_list_enable_elimination(list, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_093: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_enable_elimination shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_singly_linked_list_enable_elimination_with_NULL_handle_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = clds_singly_linked_list_enable_elimination(NULL, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_094: [ If slot_count is 0, clds_singly_linked_list_enable_elimination shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_singly_linked_list_enable_elimination_with_0_slot_count_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SINGLY_LINKED_LIST_HANDLE list;
+    int result;
+    list = clds_singly_linked_list_create(hazard_pointers);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_enable_elimination(list, 0);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_095: [ If elimination is already enabled for the list, clds_singly_linked_list_enable_elimination shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_singly_linked_list_enable_elimination_when_already_enabled_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SINGLY_LINKED_LIST_HANDLE list;
+    int result;
+    list = clds_singly_linked_list_create(hazard_pointers);
+    (void)clds_singly_linked_list_enable_elimination(list, 4);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_enable_elimination(list, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_096: [ If any error occurs, clds_singly_linked_list_enable_elimination shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_the_elimination_array_fails_clds_singly_linked_list_enable_elimination_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SINGLY_LINKED_LIST_HANDLE list;
+    int result;
+    list = clds_singly_linked_list_create(hazard_pointers);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = clds_singly_linked_list_enable_elimination(list, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_096: [ If any error occurs, clds_singly_linked_list_enable_elimination shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_the_elimination_slots_fails_clds_singly_linked_list_enable_elimination_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SINGLY_LINKED_LIST_HANDLE list;
+    int result;
+    list = clds_singly_linked_list_create(hazard_pointers);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = clds_singly_linked_list_enable_elimination(list, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_049: [ clds_singly_linked_list_pop_head shall remove the most recently inserted item from the list. ]*/
+TEST_FUNCTION(clds_singly_linked_list_insert_and_pop_head_with_elimination_enabled_use_the_head_when_there_is_no_collision)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item_1;
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item_2;
+    (void)clds_singly_linked_list_enable_elimination(list, 4);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+
+    // act
+    ASSERT_ARE_EQUAL(int, 0, clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1));
+    ASSERT_ARE_EQUAL(int, 0, clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2));
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_OK, clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item_2));
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_OK, clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item_1));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, item_2, popped_item_2);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, popped_item_1);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, popped_item_1);
+    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, popped_item_2);
+}
+
 /* clds_singly_linked_list_insert */
 
 /* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_009: [ clds_singly_linked_list_insert inserts an item in the list. ]*/
@@ -1259,6 +1549,1036 @@ TEST_FUNCTION(clds_singly_linked_list_delete_if_after_the_item_was_deleted_yield
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* clds_singly_linked_list_delete_all_if */
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_079: [ clds_singly_linked_list_delete_all_if shall remove from the list all the items that match the criteria given by item_compare_callback in one walk of the list. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_080: [ Each removed item shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_081: [ On success, clds_singly_linked_list_delete_all_if shall set deleted_item_count to the number of removed items and return CLDS_SINGLY_LINKED_LIST_DELETE_OK. ]*/
+TEST_FUNCTION(clds_singly_linked_list_delete_all_if_deletes_all_the_matching_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_3 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_DELETE_RESULT result;
+    size_t deleted_item_count;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_3, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_3));
+    STRICT_EXPECTED_CALL(free(item_3));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(free(item_1));
+
+    // act
+    result = clds_singly_linked_list_delete_all_if(list, hazard_pointers_thread, test_item_compare_by_cleanup_context, (void*)0x4242, &deleted_item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 2, deleted_item_count);
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_OK, clds_singly_linked_list_delete(list, hazard_pointers_thread, item_2));
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_079: [ clds_singly_linked_list_delete_all_if shall remove from the list all the items that match the criteria given by item_compare_callback in one walk of the list. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_081: [ On success, clds_singly_linked_list_delete_all_if shall set deleted_item_count to the number of removed items and return CLDS_SINGLY_LINKED_LIST_DELETE_OK. ]*/
+TEST_FUNCTION(clds_singly_linked_list_delete_all_if_can_delete_all_the_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_3 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_DELETE_RESULT result;
+    size_t deleted_item_count;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_3, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_3));
+    STRICT_EXPECTED_CALL(free(item_3));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4243, item_2));
+    STRICT_EXPECTED_CALL(free(item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(free(item_1));
+
+    // act
+    result = clds_singly_linked_list_delete_all_if(list, hazard_pointers_thread, test_item_compare_delete_always, (void*)0x4244, &deleted_item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 3, deleted_item_count);
+    ASSERT_IS_NULL(clds_singly_linked_list_find(list, hazard_pointers_thread, test_item_compare_find_always, NULL));
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_087: [ item_compare_callback_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_singly_linked_list_delete_all_if_with_NULL_item_compare_callback_context_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_3 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_DELETE_RESULT result;
+    size_t deleted_item_count;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_3, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_3));
+    STRICT_EXPECTED_CALL(free(item_3));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4243, item_2));
+    STRICT_EXPECTED_CALL(free(item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
+    STRICT_EXPECTED_CALL(free(item_1));
+
+    // act
+    result = clds_singly_linked_list_delete_all_if(list, hazard_pointers_thread, test_item_compare_delete_always, NULL, &deleted_item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 3, deleted_item_count);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_082: [ If no item matches the criteria, clds_singly_linked_list_delete_all_if shall set deleted_item_count to 0 and return CLDS_SINGLY_LINKED_LIST_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_singly_linked_list_delete_all_if_when_no_item_matches_yields_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_3 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_DELETE_RESULT result;
+    size_t deleted_item_count;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_singly_linked_list_delete_all_if(list, hazard_pointers_thread, test_item_compare_by_cleanup_context, (void*)0x4244, &deleted_item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(size_t, 0, deleted_item_count);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_082: [ If no item matches the criteria, clds_singly_linked_list_delete_all_if shall set deleted_item_count to 0 and return CLDS_SINGLY_LINKED_LIST_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_singly_linked_list_delete_all_if_on_an_empty_list_yields_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_DELETE_RESULT result;
+    size_t deleted_item_count;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_delete_all_if(list, hazard_pointers_thread, test_item_compare_delete_always, NULL, &deleted_item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(size_t, 0, deleted_item_count);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_083: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_delete_all_if shall fail and return CLDS_SINGLY_LINKED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_delete_all_if_with_NULL_list_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_3 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_DELETE_RESULT result;
+    size_t deleted_item_count;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_delete_all_if(NULL, hazard_pointers_thread, test_item_compare_delete_always, NULL, &deleted_item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_ERROR, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_084: [ If clds_hazard_pointers_thread is NULL, clds_singly_linked_list_delete_all_if shall fail and return CLDS_SINGLY_LINKED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_delete_all_if_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_3 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_DELETE_RESULT result;
+    size_t deleted_item_count;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_delete_all_if(list, NULL, test_item_compare_delete_always, NULL, &deleted_item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_ERROR, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_085: [ If item_compare_callback is NULL, clds_singly_linked_list_delete_all_if shall fail and return CLDS_SINGLY_LINKED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_delete_all_if_with_NULL_item_compare_callback_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_3 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_DELETE_RESULT result;
+    size_t deleted_item_count;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_delete_all_if(list, hazard_pointers_thread, NULL, NULL, &deleted_item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_ERROR, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_086: [ If deleted_item_count is NULL, clds_singly_linked_list_delete_all_if shall fail and return CLDS_SINGLY_LINKED_LIST_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_delete_all_if_with_NULL_deleted_item_count_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_3 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_DELETE_RESULT result;
+    size_t deleted_item_count;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_delete_all_if(list, hazard_pointers_thread, test_item_compare_delete_always, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_DELETE_RESULT, CLDS_SINGLY_LINKED_LIST_DELETE_ERROR, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_singly_linked_list_pop_head */
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_049: [ clds_singly_linked_list_pop_head shall remove the most recently inserted item from the list. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_050: [ On success, clds_singly_linked_list_pop_head shall return CLDS_SINGLY_LINKED_LIST_POP_OK. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_056: [ clds_singly_linked_list_pop_head shall return the item with its reference count incremented, so that it can be used by the caller until it calls clds_singly_linked_list_node_release. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_057: [ The reference held by the list on a popped item shall be released by indicating the item to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_head_pops_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item;
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+
+    // no item cleanup and free should happen here
+
+    // act
+    result = clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item, popped_item);
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_EMPTY, clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item));
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_049: [ clds_singly_linked_list_pop_head shall remove the most recently inserted item from the list. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_head_pops_the_items_in_LIFO_order)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item_1;
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item_2;
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result_1;
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result_2;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+
+    // act
+    result_1 = clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item_1);
+    result_2 = clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_OK, result_1);
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_OK, result_2);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, popped_item_1);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, popped_item_2);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item_2);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_102: [ clds_singly_linked_list_insert shall allow inserting an item that was popped or deleted from a list, as long as the caller holds a reference to it. ]*/
+TEST_FUNCTION(clds_singly_linked_list_insert_of_a_popped_item_links_it_again_at_the_head)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item;
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item_1;
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item_2;
+    int result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item);
+    umock_c_reset_all_calls();
+
+    // act
+    // the reference returned by the pop is handed back to the list
+    result = clds_singly_linked_list_insert(list, hazard_pointers_thread, popped_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    // the delete mark left by the pop is gone
+    ASSERT_ARE_EQUAL(void_ptr, item_1, (void*)item_2->next);
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_OK, clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item_2));
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_OK, clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item_1));
+    ASSERT_ARE_EQUAL(void_ptr, item_2, popped_item_2);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, popped_item_1);
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_EMPTY, clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item));
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item_2);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_056: [ clds_singly_linked_list_pop_head shall return the item with its reference count incremented, so that it can be used by the caller until it calls clds_singly_linked_list_node_release. ]*/
+TEST_FUNCTION(clds_singly_linked_list_node_release_on_a_popped_item_frees_it)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    (void)clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, popped_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_054: [ If the list is empty, clds_singly_linked_list_pop_head shall return CLDS_SINGLY_LINKED_LIST_POP_EMPTY. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_head_on_an_empty_list_returns_EMPTY)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item;
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_EMPTY, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_051: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_pop_head shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_head_with_NULL_list_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item;
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_pop_head(NULL, hazard_pointers_thread, &popped_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_ERROR, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_052: [ If clds_hazard_pointers_thread is NULL, clds_singly_linked_list_pop_head shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_head_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item;
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_pop_head(list, NULL, &popped_item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_ERROR, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_053: [ If item is NULL, clds_singly_linked_list_pop_head shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_head_with_NULL_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_pop_head(list, hazard_pointers_thread, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_ERROR, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_singly_linked_list_pop_all */
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_058: [ clds_singly_linked_list_pop_all shall detach all the items from the list by exchanging the head of the list with NULL. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_059: [ clds_singly_linked_list_pop_all shall call item_popped_cb with item_popped_cb_context for each detached item, starting with the most recently inserted one. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_065: [ Each item shall be passed to item_popped_cb with its reference count incremented and the reference held by the list shall be released by indicating the item to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_066: [ On success, clds_singly_linked_list_pop_all shall return CLDS_SINGLY_LINKED_LIST_POP_OK. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_all_pops_all_the_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* popped_item;
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_popped_cb((void*)0x4244, item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_popped_cb((void*)0x4244, item_1));
+
+    // act
+    result = clds_singly_linked_list_pop_all(list, hazard_pointers_thread, test_item_popped_cb, (void*)0x4244);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_EMPTY, clds_singly_linked_list_pop_head(list, hazard_pointers_thread, &popped_item));
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item_1);
+    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item_2);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_063: [ item_popped_cb_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_all_with_NULL_item_popped_cb_context_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_popped_cb(NULL, item));
+
+    // act
+    result = clds_singly_linked_list_pop_all(list, hazard_pointers_thread, test_item_popped_cb, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_OK, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_064: [ If the list is empty, clds_singly_linked_list_pop_all shall return CLDS_SINGLY_LINKED_LIST_POP_EMPTY. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_all_on_an_empty_list_returns_EMPTY)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_pop_all(list, hazard_pointers_thread, test_item_popped_cb, (void*)0x4244);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_EMPTY, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_060: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_pop_all shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_all_with_NULL_list_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_pop_all(NULL, hazard_pointers_thread, test_item_popped_cb, (void*)0x4244);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_ERROR, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_061: [ If clds_hazard_pointers_thread is NULL, clds_singly_linked_list_pop_all shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_all_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_pop_all(list, NULL, test_item_popped_cb, (void*)0x4244);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_ERROR, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_062: [ If item_popped_cb is NULL, clds_singly_linked_list_pop_all shall fail and return CLDS_SINGLY_LINKED_LIST_POP_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_pop_all_with_NULL_item_popped_cb_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_POP_RESULT result;
+    (void)clds_hazard_pointers_set_reclaim_threshold(hazard_pointers, 1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_pop_all(list, hazard_pointers_thread, NULL, (void*)0x4244);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_POP_RESULT, CLDS_SINGLY_LINKED_LIST_POP_ERROR, result);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_singly_linked_list_for_each */
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_067: [ clds_singly_linked_list_for_each shall call item_visit_callback with item_visit_callback_context for each item in the list, starting with the most recently inserted one. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_073: [ On success, clds_singly_linked_list_for_each shall return CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK. ]*/
+TEST_FUNCTION(clds_singly_linked_list_for_each_visits_all_the_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_3 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    TEST_VISIT_CONTEXT visit_context = { 3, 0 };
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT result;
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_singly_linked_list_for_each(list, hazard_pointers_thread, test_item_visit, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 3, visit_context.visited_count);
+    ASSERT_ARE_EQUAL(void_ptr, item_3, visit_context.visited_items[0]);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, visit_context.visited_items[1]);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, visit_context.visited_items[2]);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_069: [ If item_visit_callback returns false, clds_singly_linked_list_for_each shall stop visiting items and return CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK. ]*/
+TEST_FUNCTION(clds_singly_linked_list_for_each_stops_when_the_visit_callback_returns_false)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_3 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    TEST_VISIT_CONTEXT visit_context = { 2, 0 };
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT result;
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_singly_linked_list_for_each(list, hazard_pointers_thread, test_item_visit, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 2, visit_context.visited_count);
+    ASSERT_ARE_EQUAL(void_ptr, item_3, visit_context.visited_items[0]);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, visit_context.visited_items[1]);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_071: [ If the last visited item is marked as being removed, clds_singly_linked_list_for_each shall read its link again, as the mark is removed if the removal fails. ]*/
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_072: [ If the last visited item stays marked as being removed, clds_singly_linked_list_for_each shall stop visiting items and return CLDS_SINGLY_LINKED_LIST_FOR_EACH_INTERRUPTED, so that no item is visited twice. ]*/
+TEST_FUNCTION(clds_singly_linked_list_for_each_when_the_last_visited_item_is_removed_stops_without_visiting_again)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_3 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    TEST_DELETE_VISITED_CONTEXT delete_visited_context = { list, hazard_pointers_thread, { 3, 0 } };
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT result;
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_3);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_3, IGNORED_ARG));
+
+    // act
+    // the visited item is deleted while it is visited, so its next pointer keeps the delete mark
+    result = clds_singly_linked_list_for_each(list, hazard_pointers_thread, test_item_visit_and_delete, &delete_visited_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_INTERRUPTED, result);
+    ASSERT_ARE_EQUAL(size_t, 1, delete_visited_context.visit_context.visited_count);
+    ASSERT_ARE_EQUAL(void_ptr, item_3, delete_visited_context.visit_context.visited_items[0]);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_068: [ The item passed to item_visit_callback shall be protected by a hazard pointer for the duration of the call, so item_visit_callback can use it and can call clds_singly_linked_list_node_inc_ref to keep it. ]*/
+TEST_FUNCTION(clds_singly_linked_list_for_each_protects_the_visited_item_with_a_hazard_pointer)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_VISIT_CONTEXT visit_context = { 3, 0 };
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT result;
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_singly_linked_list_for_each(list, hazard_pointers_thread, test_item_visit, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 1, visit_context.visited_count);
+    ASSERT_ARE_EQUAL(void_ptr, item, visit_context.visited_items[0]);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_073: [ On success, clds_singly_linked_list_for_each shall return CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK. ]*/
+TEST_FUNCTION(clds_singly_linked_list_for_each_on_an_empty_list_visits_nothing)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    TEST_VISIT_CONTEXT visit_context = { 3, 0 };
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_for_each(list, hazard_pointers_thread, test_item_visit, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 0, visit_context.visited_count);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_077: [ item_visit_callback_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_singly_linked_list_for_each_with_NULL_item_visit_callback_context_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_1 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item_2 = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT result;
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_1);
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item_2);
+    visited_without_context_count = 0;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_singly_linked_list_for_each(list, hazard_pointers_thread, test_item_visit_without_context, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_OK, result);
+    ASSERT_ARE_EQUAL(size_t, 2, visited_without_context_count);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_074: [ If clds_singly_linked_list is NULL, clds_singly_linked_list_for_each shall fail and return CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_for_each_with_NULL_list_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_VISIT_CONTEXT visit_context = { 3, 0 };
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT result;
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_for_each(NULL, hazard_pointers_thread, test_item_visit, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 0, visit_context.visited_count);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_075: [ If clds_hazard_pointers_thread is NULL, clds_singly_linked_list_for_each shall fail and return CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_for_each_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_VISIT_CONTEXT visit_context = { 3, 0 };
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT result;
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_for_each(list, NULL, test_item_visit, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 0, visit_context.visited_count);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_076: [ If item_visit_callback is NULL, clds_singly_linked_list_for_each shall fail and return CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR. ]*/
+TEST_FUNCTION(clds_singly_linked_list_for_each_with_NULL_item_visit_callback_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_HANDLE list = clds_singly_linked_list_create(hazard_pointers);
+    CLDS_SINGLY_LINKED_LIST_ITEM* item = CLDS_SINGLY_LINKED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_VISIT_CONTEXT visit_context = { 3, 0 };
+    CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT result;
+    (void)clds_singly_linked_list_insert(list, hazard_pointers_thread, item);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_singly_linked_list_for_each(list, hazard_pointers_thread, NULL, &visit_context);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SINGLY_LINKED_LIST_FOR_EACH_RESULT, CLDS_SINGLY_LINKED_LIST_FOR_EACH_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 0, visit_context.visited_count);
+
+    // cleanup
+    clds_singly_linked_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 /* clds_singly_linked_list_find */
 
 /* Tests_SRS_CLDS_SINGLY_LINKED_LIST_01_027: [ clds_singly_linked_list_find shall find in the list the first item that matches the criteria given by a user compare function. ]*/
@@ -3,11 +3,13 @@
 #ifdef __cplusplus
 #include <cstdlib>
 #include <cinttypes>
+#include <cstring>
 #include <ctime>
 #else
 #include <stdlib.h>
 #include <inttypes.h>
 #include <stdbool.h>
+#include <string.h>
 #include <time.h>
 #endif
 
@@ -100,6 +102,22 @@ static void test_item_cleanup_func_with_sleep(void* context, CLDS_SORTED_LIST_IT
     (void)item;
 }
 
+typedef struct TEST_INT_KEY_ITEM_TAG
+{
+    int32_t key;
+} TEST_INT_KEY_ITEM;
+
+DECLARE_SORTED_LIST_NODE_TYPE(TEST_INT_KEY_ITEM)
+DECLARE_CLDS_INTEGER_KEY_SORTED_LIST(test_int_key_list, TEST_INT_KEY_ITEM, int32_t, key)
+
+typedef struct TEST_STRING_KEY_ITEM_TAG
+{
+    char key[20];
+} TEST_STRING_KEY_ITEM;
+
+DECLARE_SORTED_LIST_NODE_TYPE(TEST_STRING_KEY_ITEM)
+DECLARE_CLDS_TYPED_SORTED_LIST(test_string_key_list, TEST_STRING_KEY_ITEM, char, key, strcmp(key1, key2))
+
 typedef struct SEQUENCE_NO_MAP_TAG
 {
     volatile LONG* sequence_no_map;
@@ -375,6 +393,7 @@ static int single_insert_thread(void* arg)
 /*Tests_SRS_CLDS_SORTED_LIST_42_003: [ If the counter to lock the list for writes is non-zero then: ]*/
 /*Tests_SRS_CLDS_SORTED_LIST_42_004: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
 /*Tests_SRS_CLDS_SORTED_LIST_42_005: [ clds_sorted_list_insert shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
+/*Tests_SRS_CLDS_SORTED_LIST_01_156: [ clds_sorted_list_unlock_writes shall call clds_backoff_wake_all for the counter to lock the list for writes only if there are write operations waiting for the list to be unlocked. ]*/
 TEST_FUNCTION(clds_sorted_list_insert_blocks_when_write_lock)
 {
     // arrange
@@ -842,6 +861,7 @@ static int lock_write_thread(void* arg)
 /*Tests_SRS_CLDS_SORTED_LIST_42_032: [ clds_sorted_list_lock_writes shall wait for all pending write operations to complete. ]*/
 /*Tests_SRS_CLDS_SORTED_LIST_42_002: [ clds_sorted_list_insert shall increment the count of pending write operations. ]*/
 /*Tests_SRS_CLDS_SORTED_LIST_42_051: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
+/*Tests_SRS_CLDS_SORTED_LIST_01_155: [ Write operations shall call clds_backoff_wake_all for the count of pending write operations only if the counter to lock the list for writes is non-zero. ]*/
 TEST_FUNCTION(clds_sorted_list_lock_writes_waits_for_pending_clds_sorted_list_insert)
 {
     // arrange
@@ -1241,6 +1261,102 @@ TEST_FUNCTION(clds_sorted_list_set_value_with_same_item_succeeds)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+TEST_FUNCTION(clds_integer_key_sorted_list_keeps_the_items_ordered_by_key)
+{
+    // arrange
+    static const int32_t keys[] = { 3, -2, 100, 0, -1000, 7 };
+    static const int32_t sorted_keys[] = { -1000, -2, 0, 3, 7, 100 };
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list;
+    CLDS_SORTED_LIST_ITEM* items[(sizeof(keys) / sizeof(keys[0]))];
+    size_t i;
+    int32_t key;
+
+    list = test_int_key_list_create(hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(list);
+
+    // act
+    for (i = 0; i < (sizeof(keys) / sizeof(keys[0])); i++)
+    {
+        CLDS_SORTED_LIST_ITEM* item = test_int_key_list_node_create(test_item_cleanup_func, NULL);
+        ASSERT_IS_NOT_NULL(item);
+        test_int_key_list_get_value(item)->key = keys[i];
+        ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, test_int_key_list_insert(list, hazard_pointers_thread, item, NULL));
+    }
+
+    // assert
+    clds_sorted_list_lock_writes(list);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_GET_ALL_RESULT, CLDS_SORTED_LIST_GET_ALL_OK, clds_sorted_list_get_all(list, hazard_pointers_thread, (sizeof(keys) / sizeof(keys[0])), items));
+    clds_sorted_list_unlock_writes(list);
+    for (i = 0; i < (sizeof(keys) / sizeof(keys[0])); i++)
+    {
+        ASSERT_ARE_EQUAL(int, sorted_keys[i], test_int_key_list_get_value(items[i])->key);
+        clds_sorted_list_node_release(items[i]);
+    }
+
+    key = -2;
+    CLDS_SORTED_LIST_ITEM* found_item = test_int_key_list_find_key(list, hazard_pointers_thread, &key);
+    ASSERT_IS_NOT_NULL(found_item);
+    ASSERT_ARE_EQUAL(int, -2, test_int_key_list_get_value(found_item)->key);
+    clds_sorted_list_node_release(found_item);
+
+    key = 5;
+    ASSERT_IS_NULL(test_int_key_list_find_key(list, hazard_pointers_thread, &key));
+
+    key = -1000;
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_OK, test_int_key_list_delete_key(list, hazard_pointers_thread, &key, NULL));
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_NOT_FOUND, test_int_key_list_delete_key(list, hazard_pointers_thread, &key, NULL));
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+TEST_FUNCTION(clds_typed_sorted_list_uses_the_compare_expression)
+{
+    // arrange
+    static const char* keys[] = { "pear", "apple", "plum" };
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list;
+    CLDS_SORTED_LIST_ITEM* items[(sizeof(keys) / sizeof(keys[0]))];
+    CLDS_SORTED_LIST_ITEM* removed_item;
+    size_t i;
+
+    list = test_string_key_list_create(hazard_pointers, NULL, NULL, NULL);
+    ASSERT_IS_NOT_NULL(list);
+
+    // act
+    for (i = 0; i < (sizeof(keys) / sizeof(keys[0])); i++)
+    {
+        CLDS_SORTED_LIST_ITEM* item = test_string_key_list_node_create(test_item_cleanup_func, NULL);
+        ASSERT_IS_NOT_NULL(item);
+        (void)strcpy(test_string_key_list_get_value(item)->key, keys[i]);
+        ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, test_string_key_list_insert(list, hazard_pointers_thread, item, NULL));
+    }
+
+    // assert
+    clds_sorted_list_lock_writes(list);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_GET_ALL_RESULT, CLDS_SORTED_LIST_GET_ALL_OK, clds_sorted_list_get_all(list, hazard_pointers_thread, (sizeof(keys) / sizeof(keys[0])), items));
+    clds_sorted_list_unlock_writes(list);
+    ASSERT_ARE_EQUAL(char_ptr, "apple", test_string_key_list_get_value(items[0])->key);
+    ASSERT_ARE_EQUAL(char_ptr, "pear", test_string_key_list_get_value(items[1])->key);
+    ASSERT_ARE_EQUAL(char_ptr, "plum", test_string_key_list_get_value(items[2])->key);
+    for (i = 0; i < (sizeof(keys) / sizeof(keys[0])); i++)
+    {
+        clds_sorted_list_node_release(items[i]);
+    }
+
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REMOVE_OK, test_string_key_list_remove_key(list, hazard_pointers_thread, "pear", &removed_item, NULL));
+    ASSERT_ARE_EQUAL(char_ptr, "pear", test_string_key_list_get_value(removed_item)->key);
+    clds_sorted_list_node_release(removed_item);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 static bool get_item_and_change_state(CHAOS_TEST_ITEM_DATA* items, int item_count, LONG new_item_state, LONG old_item_state, int* selected_item_index)
 {
     int item_index = (rand() * (item_count - 1)) / RAND_MAX;
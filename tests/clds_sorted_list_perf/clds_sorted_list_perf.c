@@ -16,10 +16,14 @@
 typedef struct TEST_ITEM_TAG
 {
     char key[20];
+    int64_t int_key;
 } TEST_ITEM;
 
 DECLARE_SORTED_LIST_NODE_TYPE(TEST_ITEM);
 
+// the same items in a list ordered by int_key, to compare the string key list with an integer key list
+DECLARE_CLDS_INTEGER_KEY_SORTED_LIST(test_int_key_list, TEST_ITEM, int64_t, int_key);
+
 typedef struct THREAD_DATA_TAG
 {
     CLDS_SORTED_LIST_HANDLE sorted_list;
@@ -106,88 +110,118 @@ static int delete_thread(void* arg)
     return result;
 }
 
-int clds_sorted_list_perf_main(void)
+static void run_insert_delete_test(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, CLDS_SORTED_LIST_HANDLE sorted_list, const char* key_kind)
 {
-    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
-    CLDS_SORTED_LIST_HANDLE sorted_list;
     THREAD_HANDLE threads[THREAD_COUNT];
     THREAD_DATA* thread_data;
     size_t i;
     size_t j;
-    volatile int64_t sequence_number;
 
-    clds_hazard_pointers = clds_hazard_pointers_create();
-    if (clds_hazard_pointers == NULL)
+    thread_data = (THREAD_DATA*)malloc(sizeof(THREAD_DATA) * THREAD_COUNT);
+    if (thread_data == NULL)
     {
-        LogError("Error creating hazard pointers");
+        LogError("Error allocating thread data array");
     }
     else
     {
-        sorted_list = clds_sorted_list_create(clds_hazard_pointers, test_get_item_key, NULL, test_key_compare, NULL, &sequence_number, NULL, NULL);
-        if (sorted_list == NULL)
-        {
-            LogError("Error creating sorted list");
-        }
-        else
+        for (i = 0; i < THREAD_COUNT; i++)
         {
-            thread_data = (THREAD_DATA*)malloc(sizeof(THREAD_DATA) * THREAD_COUNT);
-            if (thread_data == NULL)
+            thread_data[i].sorted_list = sorted_list;
+            thread_data[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+            if (thread_data[i].clds_hazard_pointers_thread == NULL)
             {
-                LogError("Error allocating thread data array");
+                LogError("Error registering thread with harzard pointers");
+                break;
             }
             else
             {
-                for (i = 0; i < THREAD_COUNT; i++)
+                for (j = 0; j < INSERT_COUNT; j++)
                 {
-                    thread_data[i].sorted_list = sorted_list;
-                    thread_data[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
-                    if (thread_data[i].clds_hazard_pointers_thread == NULL)
+                    thread_data[i].items[j] = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
+                    if (thread_data[i].items[j] == NULL)
                     {
-                        LogError("Error registering thread with harzard pointers");
+                        LogError("Error allocating test item");
                         break;
                     }
                     else
                     {
-                        for (j = 0; j < INSERT_COUNT; j++)
-                        {
-                            thread_data[i].items[j] = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, NULL, NULL);
-                            if (thread_data[i].items[j] == NULL)
-                            {
-                                LogError("Error allocating test item");
-                                break;
-                            }
-                            else
-                            {
-                                TEST_ITEM* test_item = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, thread_data[i].items[j]);
-                                (void)sprintf(test_item->key, "%zu_%zu", i, j);
-                            }
-                        }
+                        TEST_ITEM* test_item = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, thread_data[i].items[j]);
+                        (void)sprintf(test_item->key, "%zu_%zu", i, j);
+                        test_item->int_key = (int64_t)(i * INSERT_COUNT + j);
+                    }
+                }
 
-                        if (j < INSERT_COUNT)
-                        {
-                            size_t k;
+                if (j < INSERT_COUNT)
+                {
+                    size_t k;
 
-                            for (k = 0; k < j; k++)
-                            {
-                                CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, thread_data[i].items[k]);
-                            }
-                            break;
-                        }
+                    for (k = 0; k < j; k++)
+                    {
+                        CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, thread_data[i].items[k]);
                     }
+                    break;
                 }
+            }
+        }
+
+        if (i < THREAD_COUNT)
+        {
+            LogError("Error creating test thread data");
+        }
+        else
+        {
+            // insert test
+            LogInfo("Start insert test with %s keys", key_kind);
 
-                if (i < THREAD_COUNT)
+            for (i = 0; i < THREAD_COUNT; i++)
+            {
+                if (ThreadAPI_Create(&threads[i], insert_thread, &thread_data[i]) != THREADAPI_OK)
                 {
-                    LogError("Error creating test thread data");
+                    LogError("Error spawning test thread");
+                    break;
+                }
+            }
+
+            if (i < THREAD_COUNT)
+            {
+                for (j = 0; j < i; j++)
+                {
+                    int dont_care;
+                    (void)ThreadAPI_Join(threads[j], &dont_care);
+                }
+            }
+            else
+            {
+                bool is_error = false;
+                double runtime = 0.0;
+
+                for (i = 0; i < THREAD_COUNT; i++)
+                {
+                    int thread_result;
+                    (void)ThreadAPI_Join(threads[i], &thread_result);
+                    if (thread_result != 0)
+                    {
+                        is_error = true;
+                    }
+                    else
+                    {
+                        runtime += thread_data[i].runtime;
+                    }
                 }
-                else
+
+                if (!is_error)
                 {
-                    // insert test
-                    LogInfo("Start insert test");
+                    LogInfo("Insert test with %s keys done in %.02f ms, %.02f inserts/s/thread, %.02f inserts/s on all threads",
+                        key_kind,
+                        runtime,
+                        ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
+                        ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+
+                    // delete test
 
                     for (i = 0; i < THREAD_COUNT; i++)
                     {
-                        if (ThreadAPI_Create(&threads[i], insert_thread, &thread_data[i]) != THREADAPI_OK)
+                        if (ThreadAPI_Create(&threads[i], delete_thread, &thread_data[i]) != THREADAPI_OK)
                         {
                             LogError("Error spawning test thread");
                             break;
@@ -204,8 +238,8 @@ int clds_sorted_list_perf_main(void)
                     }
                     else
                     {
-                        bool is_error = false;
-                        double runtime = 0.0;
+                        is_error = false;
+                        runtime = 0;
 
                         for (i = 0; i < THREAD_COUNT; i++)
                         {
@@ -223,69 +257,58 @@ int clds_sorted_list_perf_main(void)
 
                         if (!is_error)
                         {
-                            LogInfo("Insert test done in %.02f ms, %.02f inserts/s/thread, %.02f inserts/s on all threads",
+                            LogInfo("Delete test with %s keys done in %.02f ms, %.02f deletes/s/thread, %.02f deletes/s on all threads",
+                                key_kind,
                                 runtime,
                                 ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
                                 ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
-
-                            // delete test
-
-                            for (i = 0; i < THREAD_COUNT; i++)
-                            {
-                                if (ThreadAPI_Create(&threads[i], delete_thread, &thread_data[i]) != THREADAPI_OK)
-                                {
-                                    LogError("Error spawning test thread");
-                                    break;
-                                }
-                            }
-
-                            if (i < THREAD_COUNT)
-                            {
-                                for (j = 0; j < i; j++)
-                                {
-                                    int dont_care;
-                                    (void)ThreadAPI_Join(threads[j], &dont_care);
-                                }
-                            }
-                            else
-                            {
-                                is_error = false;
-                                runtime = 0;
-
-                                for (i = 0; i < THREAD_COUNT; i++)
-                                {
-                                    int thread_result;
-                                    (void)ThreadAPI_Join(threads[i], &thread_result);
-                                    if (thread_result != 0)
-                                    {
-                                        is_error = true;
-                                    }
-                                    else
-                                    {
-                                        runtime += thread_data[i].runtime;
-                                    }
-                                }
-
-                                if (!is_error)
-                                {
-                                    LogInfo("Delete test done in %.02f ms, %.02f deletes/s/thread, %.02f deletes/s on all threads",
-                                        runtime,
-                                        ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
-                                        ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
-                                }
-                            }
                         }
                     }
-
-                    for (i = 0; i < THREAD_COUNT; i++)
-                    {
-                        clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
-                    }
-
-                    free(thread_data);
                 }
             }
 
+            for (i = 0; i < THREAD_COUNT; i++)
+            {
+                clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
+            }
+
+            free(thread_data);
+        }
+    }
+}
+
+int clds_sorted_list_perf_main(void)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    CLDS_SORTED_LIST_HANDLE sorted_list;
+    volatile int64_t sequence_number;
+
+    clds_hazard_pointers = clds_hazard_pointers_create();
+    if (clds_hazard_pointers == NULL)
+    {
+        LogError("Error creating hazard pointers");
+    }
+    else
+    {
+        sorted_list = clds_sorted_list_create(clds_hazard_pointers, test_get_item_key, NULL, test_key_compare, NULL, &sequence_number, NULL, NULL);
+        if (sorted_list == NULL)
+        {
+            LogError("Error creating sorted list");
+        }
+        else
+        {
+            run_insert_delete_test(clds_hazard_pointers, sorted_list, "string");
+            clds_sorted_list_destroy(sorted_list);
+        }
+
+        sorted_list = test_int_key_list_create(clds_hazard_pointers, &sequence_number, NULL, NULL);
+        if (sorted_list == NULL)
+        {
+            LogError("Error creating integer key sorted list");
+        }
+        else
+        {
+            run_insert_delete_test(clds_hazard_pointers, sorted_list, "integer");
             clds_sorted_list_destroy(sorted_list);
         }
 
@@ -255,6 +255,60 @@ TEST_FUNCTION(lock_free_set_destroy_with_1_item_calls_the_node_free_callback_NUL
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
+/* lock_free_set_set_backoff_policy */
+
+/* Tests_SRS_LOCK_FREE_SET_01_025: [ lock_free_set_set_backoff_policy shall set the backoff policy used by all subsequent inserts and removes when they have to retry because of a concurrent change and return 0. ]*/
+TEST_FUNCTION(lock_free_set_set_backoff_policy_succeeds)
+{
+    // arrange
+    LOCK_FREE_SET_HANDLE set = lock_free_set_create();
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = lock_free_set_set_backoff_policy(set, CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    lock_free_set_destroy(set, NULL, NULL);
+}
+
+/* Tests_SRS_LOCK_FREE_SET_01_026: [ If lock_free_set is NULL, lock_free_set_set_backoff_policy shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(lock_free_set_set_backoff_policy_with_NULL_handle_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = lock_free_set_set_backoff_policy(NULL, CLDS_BACKOFF_POLICY_EXPONENTIAL_YIELD);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_LOCK_FREE_SET_01_027: [ If backoff_policy is not a valid CLDS_BACKOFF_POLICY value, lock_free_set_set_backoff_policy shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(lock_free_set_set_backoff_policy_with_invalid_policy_fails)
+{
+    // arrange
+    LOCK_FREE_SET_HANDLE set = lock_free_set_create();
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = lock_free_set_set_backoff_policy(set, (CLDS_BACKOFF_POLICY)(CLDS_BACKOFF_POLICY_SPIN_THEN_WAIT + 1));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    lock_free_set_destroy(set, NULL, NULL);
+}
+
 /* lock_free_set_insert */
 
 /* Tests_SRS_LOCK_FREE_SET_01_009: [ lock_free_set_insert shall insert the item item in the set. ]*/
@@ -0,0 +1,5 @@
+// Copyright (c) Microsoft. All rights reserved.
+
+#include "real_clds_backoff_renames.h"
+
+#include "../src/clds_backoff.c"
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft. All rights reserved.
+
+#ifndef REAL_CLDS_BACKOFF_H
+#define REAL_CLDS_BACKOFF_H
+
+#include "azure_macro_utils/macro_utils.h"
+#include "clds/clds_backoff.h"
+
+#define R2(X) REGISTER_GLOBAL_MOCK_HOOK(X, real_##X);
+
+#define REGISTER_CLDS_BACKOFF_GLOBAL_MOCK_HOOKS() \
+    MU_FOR_EACH_1(R2, \
+        clds_backoff_retry, \
+        clds_backoff_wait_while_equal, \
+        clds_backoff_wake_all \
+    )
+
+#ifdef __cplusplus
+#include <cstdint>
+extern "C"
+{
+#else
+#include <stdint.h>
+#endif
+
+void real_clds_backoff_retry(CLDS_BACKOFF* backoff);
+void real_clds_backoff_wait_while_equal(CLDS_BACKOFF* backoff, volatile LONG* address, LONG value);
+void real_clds_backoff_wake_all(volatile LONG* address);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAL_CLDS_BACKOFF_H
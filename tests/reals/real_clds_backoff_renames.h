@@ -0,0 +1,5 @@
+// Copyright (c) Microsoft. All rights reserved.
+
+#define clds_backoff_retry real_clds_backoff_retry
+#define clds_backoff_wait_while_equal real_clds_backoff_wait_while_equal
+#define clds_backoff_wake_all real_clds_backoff_wake_all
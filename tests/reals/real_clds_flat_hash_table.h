@@ -0,0 +1,56 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#ifndef REAL_CLDS_FLAT_HASH_TABLE_H
+#define REAL_CLDS_FLAT_HASH_TABLE_H
+
+#include "azure_macro_utils/macro_utils.h"
+#include "clds/clds_flat_hash_table.h"
+
+#define R2(X) REGISTER_GLOBAL_MOCK_HOOK(X, real_##X);
+
+#define REGISTER_CLDS_FLAT_HASH_TABLE_GLOBAL_MOCK_HOOKS() \
+    MU_FOR_EACH_1(R2, \
+        clds_flat_hash_table_create, \
+        clds_flat_hash_table_destroy, \
+        clds_flat_hash_table_set_backoff_policy, \
+        clds_flat_hash_table_insert, \
+        clds_flat_hash_table_delete, \
+        clds_flat_hash_table_delete_key_value, \
+        clds_flat_hash_table_remove, \
+        clds_flat_hash_table_set_value, \
+        clds_flat_hash_table_find, \
+        clds_flat_hash_table_node_create, \
+        clds_flat_hash_table_node_inc_ref, \
+        clds_flat_hash_table_node_release \
+    )
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+extern "C"
+{
+#else
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+CLDS_FLAT_HASH_TABLE_HANDLE real_clds_flat_hash_table_create(FLAT_HASH_TABLE_COMPUTE_HASH_FUNC compute_hash, FLAT_HASH_TABLE_KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile int64_t* start_sequence_number, FLAT_HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context);
+void real_clds_flat_hash_table_destroy(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table);
+int real_clds_flat_hash_table_set_backoff_policy(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_BACKOFF_POLICY backoff_policy);
+
+CLDS_FLAT_HASH_TABLE_INSERT_RESULT real_clds_flat_hash_table_insert(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_FLAT_HASH_TABLE_ITEM* value, int64_t* sequence_number);
+CLDS_FLAT_HASH_TABLE_DELETE_RESULT real_clds_flat_hash_table_delete(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number);
+CLDS_FLAT_HASH_TABLE_DELETE_RESULT real_clds_flat_hash_table_delete_key_value(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_FLAT_HASH_TABLE_ITEM* value, int64_t* sequence_number);
+CLDS_FLAT_HASH_TABLE_REMOVE_RESULT real_clds_flat_hash_table_remove(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_FLAT_HASH_TABLE_ITEM** item, int64_t* sequence_number);
+CLDS_FLAT_HASH_TABLE_SET_VALUE_RESULT real_clds_flat_hash_table_set_value(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const void* key, CLDS_FLAT_HASH_TABLE_ITEM* new_item, CLDS_FLAT_HASH_TABLE_ITEM** old_item, int64_t* sequence_number);
+CLDS_FLAT_HASH_TABLE_ITEM* real_clds_flat_hash_table_find(CLDS_FLAT_HASH_TABLE_HANDLE clds_flat_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key);
+
+CLDS_FLAT_HASH_TABLE_ITEM* real_clds_flat_hash_table_node_create(size_t node_size, FLAT_HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context);
+int real_clds_flat_hash_table_node_inc_ref(CLDS_FLAT_HASH_TABLE_ITEM* item);
+void real_clds_flat_hash_table_node_release(CLDS_FLAT_HASH_TABLE_ITEM* item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAL_CLDS_FLAT_HASH_TABLE_H
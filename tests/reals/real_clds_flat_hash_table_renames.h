@@ -0,0 +1,15 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#define clds_flat_hash_table_create real_clds_flat_hash_table_create
+#define clds_flat_hash_table_destroy real_clds_flat_hash_table_destroy
+#define clds_flat_hash_table_set_backoff_policy real_clds_flat_hash_table_set_backoff_policy
+#define clds_flat_hash_table_insert real_clds_flat_hash_table_insert
+#define clds_flat_hash_table_delete real_clds_flat_hash_table_delete
+#define clds_flat_hash_table_delete_key_value real_clds_flat_hash_table_delete_key_value
+#define clds_flat_hash_table_remove real_clds_flat_hash_table_remove
+#define clds_flat_hash_table_set_value real_clds_flat_hash_table_set_value
+#define clds_flat_hash_table_find real_clds_flat_hash_table_find
+
+#define clds_flat_hash_table_node_create real_clds_flat_hash_table_node_create
+#define clds_flat_hash_table_node_inc_ref real_clds_flat_hash_table_node_inc_ref
+#define clds_flat_hash_table_node_release real_clds_flat_hash_table_node_release
@@ -18,6 +18,13 @@
     MU_FOR_EACH_1(R2, \
         clds_hash_table_create, \
         clds_hash_table_destroy, \
+        clds_hash_table_set_sequence_number_block_size, \
+        clds_hash_table_set_backoff_policy, \
+        clds_hash_table_set_migration_batch_size, \
+        clds_hash_table_set_shrink_load_factor, \
+        clds_hash_table_set_bloom_filter_bits_per_bucket, \
+        clds_hash_table_set_change_log_enabled, \
+        clds_hash_table_trim_change_log, \
         clds_hash_table_insert, \
         clds_hash_table_delete, \
         clds_hash_table_delete_key_value, \
@@ -27,7 +34,12 @@
         clds_hash_table_node_create, \
         clds_hash_table_node_inc_ref, \
         clds_hash_table_node_release, \
-        clds_hash_table_snapshot \
+        clds_hash_table_snapshot, \
+        clds_hash_table_snapshot_parallel, \
+        clds_hash_table_snapshot_concurrent, \
+        clds_hash_table_snapshot_at_current_sequence_number, \
+        clds_hash_table_snapshot_since, \
+        clds_hash_table_snapshot_visit \
     )
 
 #ifdef __cplusplus
@@ -36,6 +48,13 @@ extern "C" {
 
 CLDS_HASH_TABLE_HANDLE real_clds_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context);
 void real_clds_hash_table_destroy(CLDS_HASH_TABLE_HANDLE clds_hash_table);
+int real_clds_hash_table_set_sequence_number_block_size(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t block_size);
+int real_clds_hash_table_set_backoff_policy(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_BACKOFF_POLICY backoff_policy);
+int real_clds_hash_table_set_migration_batch_size(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t batch_size);
+int real_clds_hash_table_set_shrink_load_factor(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t load_factor_percent);
+int real_clds_hash_table_set_bloom_filter_bits_per_bucket(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t bits_per_bucket);
+int real_clds_hash_table_set_change_log_enabled(CLDS_HASH_TABLE_HANDLE clds_hash_table, bool enabled);
+int real_clds_hash_table_trim_change_log(CLDS_HASH_TABLE_HANDLE clds_hash_table, int64_t sequence_number);
 CLDS_HASH_TABLE_INSERT_RESULT real_clds_hash_table_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number);
 CLDS_HASH_TABLE_DELETE_RESULT real_clds_hash_table_delete(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number);
 CLDS_HASH_TABLE_DELETE_RESULT real_clds_hash_table_delete_key_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number);
@@ -43,6 +62,11 @@ CLDS_HASH_TABLE_REMOVE_RESULT real_clds_hash_table_remove(CLDS_HASH_TABLE_HANDLE
 CLDS_HASH_TABLE_ITEM* real_clds_hash_table_find(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key);
 CLDS_HASH_TABLE_SET_VALUE_RESULT real_clds_hash_table_set_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const void* key, CLDS_HASH_TABLE_ITEM* new_item, CLDS_HASH_TABLE_ITEM** old_item, int64_t* sequence_number);
 CLDS_HASH_TABLE_SNAPSHOT_RESULT real_clds_hash_table_snapshot(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count);
+CLDS_HASH_TABLE_SNAPSHOT_RESULT real_clds_hash_table_snapshot_parallel(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE* clds_hazard_pointers_threads, uint32_t thread_count, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count);
+CLDS_HASH_TABLE_SNAPSHOT_RESULT real_clds_hash_table_snapshot_concurrent(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count);
+CLDS_HASH_TABLE_SNAPSHOT_RESULT real_clds_hash_table_snapshot_at_current_sequence_number(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count, int64_t* sequence_number);
+CLDS_HASH_TABLE_SNAPSHOT_RESULT real_clds_hash_table_snapshot_since(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, int64_t since_sequence_number, CLDS_HASH_TABLE_CHANGE** changes, uint64_t* change_count, int64_t* last_sequence_number);
+CLDS_HASH_TABLE_SNAPSHOT_RESULT real_clds_hash_table_snapshot_visit(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, HASH_TABLE_SNAPSHOT_VISIT_CB visit_cb, void* visit_cb_context);
 
 // helper APIs for creating/destroying a hash table node
 CLDS_HASH_TABLE_ITEM* real_clds_hash_table_node_create(size_t node_size, HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context);
@@ -2,6 +2,11 @@
 
 #define clds_hash_table_create real_clds_hash_table_create
 #define clds_hash_table_destroy real_clds_hash_table_destroy
+#define clds_hash_table_set_sequence_number_block_size real_clds_hash_table_set_sequence_number_block_size
+#define clds_hash_table_set_backoff_policy real_clds_hash_table_set_backoff_policy
+#define clds_hash_table_set_migration_batch_size real_clds_hash_table_set_migration_batch_size
+#define clds_hash_table_set_shrink_load_factor real_clds_hash_table_set_shrink_load_factor
+#define clds_hash_table_set_bloom_filter_bits_per_bucket real_clds_hash_table_set_bloom_filter_bits_per_bucket
 #define clds_hash_table_insert real_clds_hash_table_insert
 #define clds_hash_table_delete real_clds_hash_table_delete
 #define clds_hash_table_delete_key_value real_clds_hash_table_delete_key_value
@@ -11,4 +16,11 @@
 #define clds_hash_table_node_create real_clds_hash_table_node_create
 #define clds_hash_table_node_inc_ref real_clds_hash_table_node_inc_ref
 #define clds_hash_table_node_release real_clds_hash_table_node_release
-#define clds_hash_table_snapshot real_clds_hash_table_snapshot
\ No newline at end of file
+#define clds_hash_table_snapshot real_clds_hash_table_snapshot
+#define clds_hash_table_snapshot_concurrent real_clds_hash_table_snapshot_concurrent
+#define clds_hash_table_snapshot_visit real_clds_hash_table_snapshot_visit
+#define clds_hash_table_snapshot_parallel real_clds_hash_table_snapshot_parallel
+#define clds_hash_table_snapshot_at_current_sequence_number real_clds_hash_table_snapshot_at_current_sequence_number
+#define clds_hash_table_set_change_log_enabled real_clds_hash_table_set_change_log_enabled
+#define clds_hash_table_trim_change_log real_clds_hash_table_trim_change_log
+#define clds_hash_table_snapshot_since real_clds_hash_table_snapshot_since
\ No newline at end of file
@@ -17,7 +17,12 @@
         clds_hazard_pointers_acquire, \
         clds_hazard_pointers_release, \
         clds_hazard_pointers_reclaim, \
-        clds_hazard_pointers_set_reclaim_threshold \
+        clds_hazard_pointers_set_reclaim_threshold, \
+        clds_hazard_pointers_sequence_number_blocks_create, \
+        clds_hazard_pointers_sequence_number_blocks_destroy, \
+        clds_hazard_pointers_thread_get_sequence_number, \
+        clds_hazard_pointers_thread_get_finger, \
+        clds_hazard_pointers_thread_set_finger \
     )
 
 #ifdef __cplusplus
@@ -36,6 +41,11 @@ CLDS_HAZARD_POINTER_RECORD_HANDLE real_clds_hazard_pointers_acquire(CLDS_HAZARD_
 void real_clds_hazard_pointers_release(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer_record);
 void real_clds_hazard_pointers_reclaim(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node, RECLAIM_FUNC reclaim_func);
 int real_clds_hazard_pointers_set_reclaim_threshold(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, size_t reclaim_threshold);
+CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE real_clds_hazard_pointers_sequence_number_blocks_create(volatile int64_t* sequence_number, CLDS_HAZARD_POINTERS_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context);
+void real_clds_hazard_pointers_sequence_number_blocks_destroy(CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks);
+int64_t real_clds_hazard_pointers_thread_get_sequence_number(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks, uint32_t block_size);
+void* real_clds_hazard_pointers_thread_get_finger(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t owner_id);
+void real_clds_hazard_pointers_thread_set_finger(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t owner_id, void* node, CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer_record);
 
 #ifdef __cplusplus
 }
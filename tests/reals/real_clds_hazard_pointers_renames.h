@@ -8,4 +8,9 @@
 #define clds_hazard_pointers_release real_clds_hazard_pointers_release
 #define clds_hazard_pointers_reclaim real_clds_hazard_pointers_reclaim
 #define clds_hazard_pointers_set_reclaim_threshold real_clds_hazard_pointers_set_reclaim_threshold
+#define clds_hazard_pointers_sequence_number_blocks_create real_clds_hazard_pointers_sequence_number_blocks_create
+#define clds_hazard_pointers_sequence_number_blocks_destroy real_clds_hazard_pointers_sequence_number_blocks_destroy
+#define clds_hazard_pointers_thread_get_sequence_number real_clds_hazard_pointers_thread_get_sequence_number
+#define clds_hazard_pointers_thread_get_finger real_clds_hazard_pointers_thread_get_finger
+#define clds_hazard_pointers_thread_set_finger real_clds_hazard_pointers_thread_set_finger
 
@@ -0,0 +1,7 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include "real_clds_queue_renames.h"
+
+#define GBALLOC_H
+
+#include "../src/clds_queue.c"
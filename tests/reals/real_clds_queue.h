@@ -0,0 +1,46 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#ifndef REAL_CLDS_QUEUE_H
+#define REAL_CLDS_QUEUE_H
+
+#include "azure_macro_utils/macro_utils.h"
+#include "clds/clds_queue.h"
+
+#define R2(X) REGISTER_GLOBAL_MOCK_HOOK(X, real_##X);
+
+#define REGISTER_CLDS_QUEUE_GLOBAL_MOCK_HOOKS() \
+    MU_FOR_EACH_1(R2, \
+        clds_queue_create, \
+        clds_queue_destroy, \
+        clds_queue_set_backoff_policy, \
+        clds_queue_enqueue, \
+        clds_queue_dequeue, \
+        clds_queue_node_create, \
+        clds_queue_node_inc_ref, \
+        clds_queue_node_release \
+    )
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C"
+{
+#else
+#include <stddef.h>
+#endif
+
+CLDS_QUEUE_HANDLE real_clds_queue_create(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers);
+void real_clds_queue_destroy(CLDS_QUEUE_HANDLE clds_queue);
+int real_clds_queue_set_backoff_policy(CLDS_QUEUE_HANDLE clds_queue, CLDS_BACKOFF_POLICY backoff_policy);
+
+int real_clds_queue_enqueue(CLDS_QUEUE_HANDLE clds_queue, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_QUEUE_ITEM* item);
+CLDS_QUEUE_DEQUEUE_RESULT real_clds_queue_dequeue(CLDS_QUEUE_HANDLE clds_queue, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_QUEUE_ITEM** item);
+
+CLDS_QUEUE_ITEM* real_clds_queue_node_create(size_t node_size, QUEUE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context);
+int real_clds_queue_node_inc_ref(CLDS_QUEUE_ITEM* item);
+void real_clds_queue_node_release(CLDS_QUEUE_ITEM* item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAL_CLDS_QUEUE_H
@@ -0,0 +1,11 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#define clds_queue_create real_clds_queue_create
+#define clds_queue_destroy real_clds_queue_destroy
+#define clds_queue_set_backoff_policy real_clds_queue_set_backoff_policy
+#define clds_queue_enqueue real_clds_queue_enqueue
+#define clds_queue_dequeue real_clds_queue_dequeue
+
+#define clds_queue_node_create real_clds_queue_node_create
+#define clds_queue_node_inc_ref real_clds_queue_node_inc_ref
+#define clds_queue_node_release real_clds_queue_node_release
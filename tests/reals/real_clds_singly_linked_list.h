@@ -12,9 +12,15 @@
     MU_FOR_EACH_1(R2, \
         clds_singly_linked_list_create, \
         clds_singly_linked_list_destroy, \
+        clds_singly_linked_list_set_backoff_policy, \
+        clds_singly_linked_list_enable_elimination, \
         clds_singly_linked_list_insert, \
         clds_singly_linked_list_delete, \
         clds_singly_linked_list_delete_if, \
+        clds_singly_linked_list_delete_all_if, \
+        clds_singly_linked_list_pop_head, \
+        clds_singly_linked_list_pop_all, \
+        clds_singly_linked_list_for_each, \
         clds_singly_linked_list_find, \
         clds_singly_linked_list_node_create, \
         clds_singly_linked_list_node_inc_ref, \
@@ -31,10 +37,16 @@ extern "C"
 
 CLDS_SINGLY_LINKED_LIST_HANDLE real_clds_singly_linked_list_create(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers);
 void real_clds_singly_linked_list_destroy(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list);
+int real_clds_singly_linked_list_set_backoff_policy(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_BACKOFF_POLICY backoff_policy);
+int real_clds_singly_linked_list_enable_elimination(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, uint32_t slot_count);
 
 int real_clds_singly_linked_list_insert(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SINGLY_LINKED_LIST_ITEM* item);
 CLDS_SINGLY_LINKED_LIST_DELETE_RESULT real_clds_singly_linked_list_delete(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SINGLY_LINKED_LIST_ITEM* item);
 CLDS_SINGLY_LINKED_LIST_DELETE_RESULT real_clds_singly_linked_list_delete_if(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_COMPARE_CB item_compare_callback, void* item_compare_callback_context);
+CLDS_SINGLY_LINKED_LIST_DELETE_RESULT real_clds_singly_linked_list_delete_all_if(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_COMPARE_CB item_compare_callback, void* item_compare_callback_context, size_t* deleted_item_count);
+CLDS_SINGLY_LINKED_LIST_POP_RESULT real_clds_singly_linked_list_pop_head(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SINGLY_LINKED_LIST_ITEM** item);
+CLDS_SINGLY_LINKED_LIST_POP_RESULT real_clds_singly_linked_list_pop_all(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_POPPED_CB item_popped_cb, void* item_popped_cb_context);
+int real_clds_singly_linked_list_for_each(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_VISIT_CB item_visit_callback, void* item_visit_callback_context);
 CLDS_SINGLY_LINKED_LIST_ITEM* real_clds_singly_linked_list_find(CLDS_SINGLY_LINKED_LIST_HANDLE clds_singly_linked_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SINGLY_LINKED_LIST_ITEM_COMPARE_CB item_compare_callback, void* item_compare_callback_context);
 
 CLDS_SINGLY_LINKED_LIST_ITEM* real_clds_singly_linked_list_node_create(size_t node_size, SINGLY_LINKED_LIST_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context);
@@ -2,9 +2,15 @@
 
 #define clds_singly_linked_list_create real_clds_singly_linked_list_create
 #define clds_singly_linked_list_destroy real_clds_singly_linked_list_destroy
+#define clds_singly_linked_list_set_backoff_policy real_clds_singly_linked_list_set_backoff_policy
+#define clds_singly_linked_list_enable_elimination real_clds_singly_linked_list_enable_elimination
 #define clds_singly_linked_list_insert real_clds_singly_linked_list_insert
 #define clds_singly_linked_list_delete real_clds_singly_linked_list_delete
 #define clds_singly_linked_list_delete_if real_clds_singly_linked_list_delete_if
+#define clds_singly_linked_list_delete_all_if real_clds_singly_linked_list_delete_all_if
+#define clds_singly_linked_list_pop_head real_clds_singly_linked_list_pop_head
+#define clds_singly_linked_list_pop_all real_clds_singly_linked_list_pop_all
+#define clds_singly_linked_list_for_each real_clds_singly_linked_list_for_each
 #define clds_singly_linked_list_find real_clds_singly_linked_list_find
 
 #define clds_singly_linked_list_node_create real_clds_singly_linked_list_node_create
@@ -19,16 +19,25 @@
     MU_FOR_EACH_1(R2, \
         clds_sorted_list_create, \
         clds_sorted_list_destroy, \
+        clds_sorted_list_set_key_fingerprint_cb, \
+        clds_sorted_list_set_sequence_number_block_size, \
+        clds_sorted_list_set_sequence_number_blocks, \
+        clds_sorted_list_set_backoff_policy, \
+        clds_sorted_list_set_finger_search, \
         clds_sorted_list_insert, \
         clds_sorted_list_delete_item, \
         clds_sorted_list_delete_key, \
+        clds_sorted_list_delete_range, \
         clds_sorted_list_remove_key, \
+        clds_sorted_list_remove_item, \
+        clds_sorted_list_remove_first, \
         clds_sorted_list_find_key, \
         clds_sorted_list_set_value, \
         clds_sorted_list_lock_writes, \
         clds_sorted_list_unlock_writes, \
         clds_sorted_list_get_count, \
         clds_sorted_list_get_all, \
+        clds_sorted_list_visit, \
         clds_sorted_list_node_create, \
         clds_sorted_list_node_inc_ref, \
         clds_sorted_list_node_release \
@@ -41,17 +50,26 @@ extern "C"
 
 CLDS_SORTED_LIST_HANDLE real_clds_sorted_list_create(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, SORTED_LIST_GET_ITEM_KEY_CB get_item_key_cb, void* get_item_key_cb_context, SORTED_LIST_KEY_COMPARE_CB key_compare_cb, void* key_compare_cb_context, volatile int64_t* sequence_no, SORTED_LIST_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context);
 void real_clds_sorted_list_destroy(CLDS_SORTED_LIST_HANDLE clds_sorted_list);
+int real_clds_sorted_list_set_key_fingerprint_cb(CLDS_SORTED_LIST_HANDLE clds_sorted_list, SORTED_LIST_GET_KEY_FINGERPRINT_CB get_key_fingerprint_cb, void* get_key_fingerprint_cb_context, SORTED_LIST_KEY_FINGERPRINT_ORDER key_fingerprint_order);
+int real_clds_sorted_list_set_sequence_number_block_size(CLDS_SORTED_LIST_HANDLE clds_sorted_list, uint32_t block_size);
+int real_clds_sorted_list_set_sequence_number_blocks(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SEQUENCE_NUMBER_BLOCKS_HANDLE sequence_number_blocks, uint32_t block_size);
+int real_clds_sorted_list_set_backoff_policy(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_BACKOFF_POLICY backoff_policy);
+int real_clds_sorted_list_set_finger_search(CLDS_SORTED_LIST_HANDLE clds_sorted_list, bool enable);
 
 CLDS_SORTED_LIST_INSERT_RESULT real_clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_no);
 CLDS_SORTED_LIST_DELETE_RESULT real_clds_sorted_list_delete_item(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_no);
 CLDS_SORTED_LIST_DELETE_RESULT real_clds_sorted_list_delete_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_no);
+CLDS_SORTED_LIST_DELETE_RESULT real_clds_sorted_list_delete_range(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* low_key, void* high_key, SORTED_LIST_ITEM_DELETED_CB item_deleted_cb, void* item_deleted_cb_context);
 CLDS_SORTED_LIST_REMOVE_RESULT real_clds_sorted_list_remove_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_no);
+CLDS_SORTED_LIST_REMOVE_RESULT real_clds_sorted_list_remove_item(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_no);
+CLDS_SORTED_LIST_REMOVE_RESULT real_clds_sorted_list_remove_first(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_no);
 CLDS_SORTED_LIST_ITEM* real_clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key);
 CLDS_SORTED_LIST_SET_VALUE_RESULT real_clds_sorted_list_set_value(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const void* key, CLDS_SORTED_LIST_ITEM* new_item, CLDS_SORTED_LIST_ITEM** old_item, int64_t* sequence_number, bool only_if_exists);
 void real_clds_sorted_list_lock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list);
 void real_clds_sorted_list_unlock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list);
 CLDS_SORTED_LIST_GET_COUNT_RESULT real_clds_sorted_list_get_count(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t* item_count);
 CLDS_SORTED_LIST_GET_ALL_RESULT real_clds_sorted_list_get_all(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t item_count, CLDS_SORTED_LIST_ITEM** items);
+CLDS_SORTED_LIST_VISIT_RESULT real_clds_sorted_list_visit(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SORTED_LIST_VISIT_CB visit_cb, void* visit_cb_context);
 
 // helper APIs for creating/destroying a singly linked list node
 CLDS_SORTED_LIST_ITEM* real_clds_sorted_list_node_create(size_t node_size, SORTED_LIST_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context);
@@ -2,16 +2,25 @@
 
 #define clds_sorted_list_create real_clds_sorted_list_create
 #define clds_sorted_list_destroy real_clds_sorted_list_destroy
+#define clds_sorted_list_set_key_fingerprint_cb real_clds_sorted_list_set_key_fingerprint_cb
+#define clds_sorted_list_set_sequence_number_block_size real_clds_sorted_list_set_sequence_number_block_size
+#define clds_sorted_list_set_sequence_number_blocks real_clds_sorted_list_set_sequence_number_blocks
+#define clds_sorted_list_set_backoff_policy real_clds_sorted_list_set_backoff_policy
+#define clds_sorted_list_set_finger_search real_clds_sorted_list_set_finger_search
 #define clds_sorted_list_insert real_clds_sorted_list_insert
 #define clds_sorted_list_delete_item real_clds_sorted_list_delete_item
 #define clds_sorted_list_delete_key real_clds_sorted_list_delete_key
+#define clds_sorted_list_delete_range real_clds_sorted_list_delete_range
 #define clds_sorted_list_remove_key real_clds_sorted_list_remove_key
+#define clds_sorted_list_remove_item real_clds_sorted_list_remove_item
+#define clds_sorted_list_remove_first real_clds_sorted_list_remove_first
 #define clds_sorted_list_find_key real_clds_sorted_list_find_key
 #define clds_sorted_list_set_value real_clds_sorted_list_set_value
 #define clds_sorted_list_lock_writes real_clds_sorted_list_lock_writes
 #define clds_sorted_list_unlock_writes real_clds_sorted_list_unlock_writes
 #define clds_sorted_list_get_count real_clds_sorted_list_get_count
 #define clds_sorted_list_get_all real_clds_sorted_list_get_all
+#define clds_sorted_list_visit real_clds_sorted_list_visit
 
 #define clds_sorted_list_node_create real_clds_sorted_list_node_create
 #define clds_sorted_list_node_inc_ref real_clds_sorted_list_node_inc_ref
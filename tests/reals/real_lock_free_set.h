@@ -12,6 +12,7 @@
     MU_FOR_EACH_1(R2, \
         lock_free_set_create, \
         lock_free_set_destroy, \
+        lock_free_set_set_backoff_policy, \
         lock_free_set_insert, \
         lock_free_set_remove, \
         lock_free_set_purge_not_thread_safe \
@@ -27,6 +28,7 @@ extern "C"
 
 LOCK_FREE_SET_HANDLE real_lock_free_set_create(void);
 void real_lock_free_set_destroy(LOCK_FREE_SET_HANDLE lock_free_set, NODE_CLEANUP_FUNC node_cleanup_callback, void* context);
+int real_lock_free_set_set_backoff_policy(LOCK_FREE_SET_HANDLE lock_free_set, CLDS_BACKOFF_POLICY backoff_policy);
 int real_lock_free_set_insert(LOCK_FREE_SET_HANDLE lock_free_set, LOCK_FREE_SET_ITEM* item);
 int real_lock_free_set_remove(LOCK_FREE_SET_HANDLE lock_free_set, LOCK_FREE_SET_ITEM* item);
 int real_lock_free_set_purge_not_thread_safe(LOCK_FREE_SET_HANDLE lock_free_set, NODE_CLEANUP_FUNC node_cleanup_callback, void* context);
@@ -6,9 +6,12 @@
 
 #define ENABLE_MOCKS
 
+#include "clds/clds_backoff.h"
 #if defined _MSC_VER
+#include "clds/clds_flat_hash_table.h"
 #include "clds/clds_hazard_pointers.h"
 #include "clds/clds_hash_table.h"
+#include "clds/clds_queue.h"
 #include "clds/clds_singly_linked_list.h"
 #include "clds/clds_sorted_list.h"
 #include "clds/clds_st_hash_set.h"
@@ -17,9 +20,12 @@
 
 #undef ENABLE_MOCKS
 
+#include "../tests/reals/real_clds_backoff.h"
 #if defined _MSC_VER
+#include "../tests/reals/real_clds_flat_hash_table.h"
 #include "../tests/reals/real_clds_hazard_pointers.h"
 #include "../tests/reals/real_clds_hash_table.h"
+#include "../tests/reals/real_clds_queue.h"
 #include "../tests/reals/real_clds_singly_linked_list.h"
 #include "../tests/reals/real_clds_sorted_list.h"
 #include "../tests/reals/real_clds_st_hash_set.h"
@@ -35,9 +41,12 @@ TEST_FUNCTION(check_all_c_util_reals)
     // arrange
 
     // act
+    REGISTER_CLDS_BACKOFF_GLOBAL_MOCK_HOOKS();
 #if defined _MSC_VER
+    REGISTER_CLDS_FLAT_HASH_TABLE_GLOBAL_MOCK_HOOKS();
     REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS();
     REGISTER_CLDS_HASH_TABLE_GLOBAL_MOCK_HOOKS();
+    REGISTER_CLDS_QUEUE_GLOBAL_MOCK_HOOKS();
     REGISTER_CLDS_SINGLY_LINKED_LIST_GLOBAL_MOCK_HOOKS();
     REGISTER_CLDS_SORTED_LIST_GLOBAL_MOCK_HOOKS();
     REGISTER_CLDS_ST_HASH_SET_GLOBAL_MOCK_HOOKS();